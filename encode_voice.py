@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+Beszédhang klipek kódolása a VoicePrompt számára (IMA ADPCM, .adp)
+
+Bemenet: mono, 16 bites PCM WAV. Ha a mintavétel eltér a --rate értéktől, lineáris interpolációval átmintavételez.
+Kimenet: 12 bájtos fejléc ("VPA1", sampleRate u16, reserved u16, sampleCount u32, little-endian), utána a 4 bites
+kódszavak, bájtonként először az alsó nibble. A minták száma mindig páros (szükség esetén egy csend minta kerül a végére).
+
+A kódoló a dekóder lépését (include/ImaAdpcm.h, decodeNibble) pontosan követi, így az eszközön dekódolt minták bitre
+azonosak a kódoló által rekonstruált mintákkal. A --decode kapcsoló egy .adp fájlt WAV-vá alakít vissza meghallgatáshoz.
+
+Használat:
+    python encode_voice.py traffipax.wav data/voice/traffipax.adp
+    python encode_voice.py --decode data/voice/traffipax.adp check.wav
+    python encode_voice.py --test-vectors test/test_ima_adpcm/adpcm_vectors.h
+
+A --test-vectors kapcsoló egy rögzített, szintetikus klipet kódol, és a kódolt bájtokat a Python dekóder mintáival
+együtt C++ fejlécbe írja: a test_ima_adpcm host teszt ezekkel veti össze az ImaAdpcm::decode kimenetét.
+
+A szükséges klipek (data/voice/<név>.adp): traffipax, 100, 200, ... 900, 1000, meter
+Feltöltés: pio run --target uploadfs
+"""
+
+import argparse
+import math
+import struct
+import sys
+import wave
+
+INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60,
+    66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544,
+    598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+    5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+]
+
+HEADER = struct.Struct("<4sHHI")
+MAGIC = b"VPA1"
+DEFAULT_RATE = 8000
+
+
+class State:
+    def __init__(self):
+        self.predictor = 0
+        self.index = 0
+
+
+def decode_nibble(state, nibble):
+    """ImaAdpcm::decodeNibble megfelelője"""
+    step = STEP_TABLE[state.index]
+    diff = step >> 3
+    if nibble & 4:
+        diff += step
+    if nibble & 2:
+        diff += step >> 1
+    if nibble & 1:
+        diff += step >> 2
+    predictor = state.predictor - diff if nibble & 8 else state.predictor + diff
+    state.predictor = max(-32768, min(32767, predictor))
+    state.index = max(0, min(88, state.index + INDEX_TABLE[nibble & 7]))
+    return state.predictor
+
+
+def encode_sample(state, sample):
+    """A mintához legközelebbi kódszó, az állapot a dekóderrel azonos módon lép"""
+    step = STEP_TABLE[state.index]
+    delta = sample - state.predictor
+    nibble = 0
+    if delta < 0:
+        nibble = 8
+        delta = -delta
+    if delta >= step:
+        nibble |= 4
+        delta -= step
+    if delta >= step >> 1:
+        nibble |= 2
+        delta -= step >> 1
+    if delta >= step >> 2:
+        nibble |= 1
+    decode_nibble(state, nibble)
+    return nibble
+
+
+def read_wav(path, rate):
+    with wave.open(path, "rb") as wav:
+        if wav.getnchannels() != 1 or wav.getsampwidth() != 2:
+            sys.exit(f"{path}: mono, 16 bites WAV kell")
+        source_rate = wav.getframerate()
+        frames = wav.readframes(wav.getnframes())
+    samples = list(struct.unpack(f"<{len(frames) // 2}h", frames))
+
+    if source_rate != rate and samples:
+        count = int(len(samples) * rate / source_rate)
+        resampled = []
+        for i in range(count):
+            pos = i * source_rate / rate
+            left = int(pos)
+            right = min(left + 1, len(samples) - 1)
+            frac = pos - left
+            resampled.append(int(round(samples[left] * (1 - frac) + samples[right] * frac)))
+        samples = resampled
+    return samples
+
+
+def encode(samples, rate):
+    if len(samples) % 2:
+        samples = samples + [0]
+    state = State()
+    data = bytearray()
+    for i in range(0, len(samples), 2):
+        low = encode_sample(state, samples[i])
+        high = encode_sample(state, samples[i + 1])
+        data.append(low | (high << 4))
+    return HEADER.pack(MAGIC, rate, 0, len(samples)) + bytes(data)
+
+
+def decode(blob):
+    magic, rate, _, count = HEADER.unpack_from(blob)
+    if magic != MAGIC:
+        sys.exit("nem VPA1 fájl")
+    state = State()
+    samples = []
+    for byte in blob[HEADER.size:HEADER.size + count // 2]:
+        samples.append(decode_nibble(state, byte & 0x0F))
+        samples.append(decode_nibble(state, byte >> 4))
+    return rate, samples
+
+
+def synthetic_clip():
+    """Rögzített tesztjel: csend, teljes kivezérlésű négyszög (a prediktor korlátozása, index 88), csirp, zaj, csend (index 0)"""
+    samples = [0] * 200
+    for i in range(400):
+        samples.append(32767 if (i // 100) % 2 == 0 else -32768)
+    for i in range(800):
+        samples.append(int(12000 * math.sin(2 * math.pi * (100 + 2.5 * i) * i / DEFAULT_RATE)))
+    seed = 12345
+    for _ in range(400):
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        samples.append((seed >> 8) % 40001 - 20000)
+    samples += [0] * 200
+    return samples
+
+
+def c_array(values, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def write_test_vectors(path):
+    blob = encode(synthetic_clip(), DEFAULT_RATE)
+    _, samples = decode(blob)
+    with open(path, "w") as f:
+        f.write("// Az encode_voice.py --test-vectors kimenete, kézzel nem szerkesztendő\n")
+        f.write("#pragma once\n\n#include <stdint.h>\n\nnamespace AdpcmVectors {\n\n")
+        f.write(f"static constexpr uint32_t CLIP_SIZE = {len(blob)};\n")
+        f.write(f"static constexpr uint32_t SAMPLE_COUNT = {len(samples)};\n\n")
+        f.write("// A teljes .adp fájl (fejléc + ADPCM adat)\n")
+        f.write(f"static const uint8_t CLIP[CLIP_SIZE] = {{\n{c_array(list(blob), 16)}\n}};\n\n")
+        f.write("// A Python dekóder (decode_nibble) mintái\n")
+        f.write(f"static const int16_t EXPECTED[SAMPLE_COUNT] = {{\n{c_array(samples, 12)}\n}};\n\n")
+        f.write("} // namespace AdpcmVectors\n")
+    print(f"{path}: {len(samples)} minta")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="WAV -> IMA ADPCM (.adp) a VoicePrompt-hoz")
+    parser.add_argument("input", nargs="?")
+    parser.add_argument("output", nargs="?")
+    parser.add_argument("--rate", type=int, default=DEFAULT_RATE, help="mintavételi frekvencia (Hz), minden klipnél azonos legyen")
+    parser.add_argument("--decode", action="store_true", help=".adp -> WAV visszaalakítás")
+    parser.add_argument("--test-vectors", metavar="HEADER", help="a szintetikus tesztklip C++ fejlécbe (a test_ima_adpcm tesztnek)")
+    args = parser.parse_args()
+
+    if args.test_vectors:
+        write_test_vectors(args.test_vectors)
+        return
+    if not args.input or not args.output:
+        parser.error("a bemenet és a kimenet megadása kötelező")
+
+    if args.decode:
+        with open(args.input, "rb") as f:
+            rate, samples = decode(f.read())
+        with wave.open(args.output, "wb") as wav:
+            wav.setnchannels(1)
+            wav.setsampwidth(2)
+            wav.setframerate(rate)
+            wav.writeframes(struct.pack(f"<{len(samples)}h", *samples))
+        return
+
+    blob = encode(read_wav(args.input, args.rate), args.rate)
+    with open(args.output, "wb") as f:
+        f.write(blob)
+    print(f"{args.output}: {len(blob)} bájt")
+
+
+if __name__ == "__main__":
+    main()
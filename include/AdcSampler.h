@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * @brief Szabadon futó, DMA-val gyűjtött ADC mintavétel túlmintavételezéssel (feszültségek, fényérzékelő, processzor hőmérséklet)
+ *
+ * Az ADC round-robin módban, hardveres ütemezéssel konvertálja a csatornákat; a mintákat két egymást láncoló DMA csatorna
+ * írja egy gyűrű pufferbe, így a CPU egyetlen mintánál sem vesz részt és egyik mag sem blokkol analogRead()-ben.
+ * Az update() csatornánként összegzi a gyűrű mintáit (boxcar + decimálás): 64-szeres túlmintavételezés, +3 bit felbontás.
+ * A szűrt értékek atomi írással/olvasással kerülnek át, bármelyik magról zár nélkül olvashatók.
+ *
+ * Az analogRead() / analogReadTemp() ezután már NEM használható, mert az ADC-t ez az osztály foglalja.
+ */
+class AdcSampler {
+
+  public:
+    /**
+     * @brief A mintavételezett csatornák (a round-robin sorrendjében, azaz növekvő ADC bemenet szerint)
+     */
+    enum class Channel : uint8_t {
+        VBus,            // A0: külső VBUS osztó
+        LightSensor,     // A1: fényérzékelő
+        VSys,            // A2: külső VSYS osztó
+        CoreTemperature, // ADC4: belső hőmérő
+        Count,
+    };
+
+    static constexpr uint8_t CHANNEL_COUNT = static_cast<uint8_t>(Channel::Count);
+    static constexpr uint16_t SAMPLES_PER_CHANNEL = 64;                             // Túlmintavételezés aránya
+    static constexpr uint16_t RING_SAMPLES = CHANNEL_COUNT * SAMPLES_PER_CHANNEL;   // A gyűrű puffer mérete (mintákban)
+    static constexpr uint32_t SAMPLE_RATE = 4000;                                   // Összes konverzió/sec (csatornánként 1kHz)
+    static constexpr uint16_t RING_PERIOD_MS = RING_SAMPLES * 1000UL / SAMPLE_RATE; // Egy teljes gyűrű (egy szűrő ablak) ideje
+    static constexpr uint16_t FULL_SCALE = 0xFFFF;                                  // A szűrt értékek skálája (16 bit)
+    static constexpr float V_REFERENCE = 3.3f;
+
+    /**
+     * @brief ADC, DMA csatornák beállítása és a folyamatos mintavétel indítása
+     */
+    void begin();
+
+    /**
+     * @brief A szűrt értékek frissítése a gyűrű pufferből (RING_PERIOD_MS-enként hívandó)
+     */
+    void update();
+
+    /**
+     * @brief A csatorna szűrt értéke 16 bites skálán (0..FULL_SCALE)
+     */
+    uint16_t getRaw(Channel channel) const { return filtered[static_cast<uint8_t>(channel)].load(std::memory_order_relaxed); }
+
+    /**
+     * @brief A csatorna szűrt feszültsége az ADC bemeneten (Volt)
+     */
+    float getVoltage(Channel channel) const { return getRaw(channel) * V_REFERENCE / (FULL_SCALE + 1); }
+
+  private:
+    int dmaChannelA = -1;
+    int dmaChannelB = -1;
+    uint32_t startMillis = 0;
+
+    // A gyűrű puffer: a DMA ring módjához a méretével igazítva
+    alignas(RING_SAMPLES * sizeof(uint16_t)) volatile uint16_t ring[RING_SAMPLES] = {};
+
+    std::atomic<uint16_t> filtered[CHANNEL_COUNT] = {};
+};
+
+extern AdcSampler adcSampler;
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <Arduino.h>
+#include <pico/critical_section.h>
+#include <pico/time.h>
+
+/**
+ * @brief A hangszóró egy hangszakasza: állandó hang, csúszó hang (chirp) vagy szünet
+ */
+struct AudioSegment {
+    uint16_t startFreq; // Kezdő frekvencia (Hz), 0: szünet
+    uint16_t endFreq;   // Záró frekvencia (Hz), a szakasz alatt lineárisan csúszik ide
+    uint16_t durationMs;
+};
+
+/**
+ * @brief Nem blokkoló hangmotor a buzzerhez
+ *
+ * A hangokat előre kiszámolt szakasz táblákból játssza le: a négyszögjelet a buzzer lábának hardveres PWM szelete adja,
+ * a frekvenciát egy 1 ms-os ismétlődő időzítő megszakítás lépteti (csúszó hangnál szakaszon belül is). A lejátszás így
+ * független a loop()-ok időzítésétől: rajzolás közben sem akad meg a sziréna, és a hívó soha nem vár.
+ *
+ * A kérések egy kis prioritási sorba kerülnek: a magasabb prioritású hang (pl. traffipax sziréna) azonnal félbeszakítja
+ * az alacsonyabbat (pl. érintés pittyenés), az alacsonyabb vagy azonos prioritású megvárja az aktuálisat.
+ * Ha nincs mit játszani, az időzítő leáll, így nem ébreszti fölöslegesen a Core0-t.
+ */
+class AudioEngine {
+
+  public:
+    /**
+     * @brief Az előre definiált hangok
+     */
+    enum class Sound : uint8_t {
+        Tick,  // Érintés / nyugtázás pittyenés
+        Error, // Hiba hangjelzés
+        Alert, // Traffipax figyelmeztető dallam
+        Siren, // Traffipax sziréna (felfutó-lefutó, 2 ciklus)
+        COUNT
+    };
+
+    /**
+     * @brief Lejátszási prioritás (a nagyobb félbeszakítja a kisebbet)
+     */
+    enum Priority : uint8_t { PRIORITY_UI = 0, PRIORITY_NOTIFY = 1, PRIORITY_ALARM = 2 };
+
+    static constexpr uint8_t QUEUE_SIZE = 4;  // Várakozó hangok max. száma
+    static constexpr uint8_t TICK_MS = 1;     // A frekvencia léptetés időzítője
+    static constexpr uint8_t PWM_CLKDIV = 64; // PWM órajel osztó (133MHz / 64 ~ 2MHz: 32Hz..20kHz TOP-pal lefedhető)
+
+    /**
+     * @brief PWM és időzítő inicializálása (Core0, a setup elején)
+     */
+    void begin();
+
+    /**
+     * @brief Hang lejátszásának kérése (nem blokkol)
+     * @return false, ha a kérés eldobásra került (tele sor)
+     */
+    bool play(Sound sound);
+
+    /**
+     * @brief Egy hang leállítása: ha épp szól, elhallgat (a következő várakozó indul), ha vár, kikerül a sorból
+     */
+    void stop(Sound sound);
+
+    /**
+     * @brief Szól-e éppen az adott hang?
+     */
+    bool isPlaying(Sound sound) const { return playing && currentSound == sound; }
+
+    /**
+     * @brief A PWM szelet átadása PCM lejátszáshoz (VoicePrompt): a szóló hang elhallgat, az új kérések a sorban várnak
+     * @param top A vivő TOP értéke (a PCM felbontása), a szelet órajel osztás nélkül fut
+     */
+    void acquirePcm(uint16_t top);
+
+    /**
+     * @brief A PWM szelet visszavétele a PCM lejátszástól: a várakozó hangok folytatódnak
+     */
+    void releasePcm();
+
+    /**
+     * @brief A buzzer PWM szelete és csatornája (a PCM lejátszás DMA céljához)
+     */
+    uint getPwmSlice() const { return slice; }
+    uint getPwmChannel() const { return channel; }
+
+  private:
+    /**
+     * @brief Egy hang leírása: szakasz tábla, ismétlésszám, prioritás
+     */
+    struct SoundDefinition {
+        const AudioSegment *segments;
+        uint8_t segmentCount;
+        uint8_t repeat;
+        Priority priority;
+    };
+    static const SoundDefinition SOUNDS[static_cast<uint8_t>(Sound::COUNT)];
+
+    uint slice = 0;
+    uint channel = 0;
+    uint32_t pwmClockHz = 0;
+
+    // Lejátszási állapot (a zár alatt, ill. az időzítő megszakításban)
+    critical_section_t lock;
+    repeating_timer_t timer;
+    volatile bool timerRunning = false;
+    volatile bool playing = false;
+    volatile bool pcmActive = false; // A szelet a VoicePrompt-é
+    Sound currentSound = Sound::Tick;
+    uint8_t segmentIndex = 0;
+    uint8_t repeatsLeft = 0;
+    uint16_t segmentElapsedMs = 0;
+    uint16_t currentFreq = 0;
+
+    // Várakozó hangok, prioritás szerint csökkenő sorrendben
+    Sound queue[QUEUE_SIZE];
+    uint8_t queueCount = 0;
+
+    /**
+     * @brief Az időzítő megszakítás belépési pontja
+     */
+    static bool onTimer(repeating_timer_t *rt);
+
+    /**
+     * @brief Egy 1 ms-os lépés (megszakításból, a zár alatt)
+     * @return false, ha nincs több lejátszandó hang (az időzítő leáll)
+     */
+    bool tick();
+
+    /**
+     * @brief Hang indítása az elejéről (a zár alatt)
+     */
+    void start(Sound sound);
+
+    /**
+     * @brief A következő várakozó hang indítása, vagy elhallgatás (a zár alatt)
+     */
+    void startNext();
+
+    /**
+     * @brief Az időzítő indítása, ha van mit játszani és még nem fut (a záron kívül)
+     */
+    void startTimerIfNeeded();
+
+    /**
+     * @brief A PWM frekvencia beállítása (0: csend)
+     */
+    void setFrequency(uint16_t freq);
+};
+
+extern AudioEngine audioEngine;
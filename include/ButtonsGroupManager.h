@@ -170,7 +170,7 @@ class ButtonsGroupManager {
                 int16_t btnHeight = (def.height > 0) ? def.height : defaultButtonHeightRef;
 
                 Rect bounds(currentLayoutX, currentLayoutY, btnWidth, btnHeight);
-                auto button = std::make_shared<UIButton>(def.id, bounds, def.label, def.type, def.initialState, def.callback, UIColorPalette::createDefaultButtonScheme(), autoSizeBtn);
+                auto button = self->template makeComponent<UIButton>(def.id, bounds, def.label, def.type, def.initialState, def.callback, UIColorPalette::createDefaultButtonScheme(), autoSizeBtn);
                 self->addChild(button);
                 if (out_createdButtons) {
                     out_createdButtons->push_back(button);
@@ -354,7 +354,7 @@ class ButtonsGroupManager {
                 }
 
                 Rect bounds(currentLayoutX, currentLayoutY, btnWidth, btnHeight);
-                auto button = std::make_shared<UIButton>(def.id, bounds, def.label, def.type, def.initialState, def.callback, UIColorPalette::createDefaultButtonScheme(), autoSizeBtn);
+                auto button = self->template makeComponent<UIButton>(def.id, bounds, def.label, def.type, def.initialState, def.callback, UIColorPalette::createDefaultButtonScheme(), autoSizeBtn);
                 self->addChild(button);
                 if (out_createdButtons) {
                     out_createdButtons->push_back(button);
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "defines.h"
+
+/**
+ * @brief XIP cache találati arány mérése és (__CODE_PROFILE esetén) mintavételező PC profilozó
+ *
+ * Minden flash-ből futó kód és konstans adat a 16KB-os XIP cache-en keresztül olvasódik, amit a két mag közösen használ.
+ * A cache hardveres számlálói (hozzáférés, találat) alapján mérjük a találati arányt: ez mutatja, mennyire szorítja ki
+ * a rajzolás a GPS feldolgozás kódját (és fordítva), illetve az SRAM-ba helyezés (sram_hotlist.txt) hatását.
+ *
+ * __CODE_PROFILE esetén magonként egy hardveres alarm PROFILE_SAMPLE_HZ frekvenciával mintavételezi a megszakított
+ * utasításcímet (PC). A flash-beli címek PROFILE_BUCKET_SHIFT felbontású vödrökbe kerülnek; a soros portra írt
+ * "PCPROF" sorokból a sram_profile.py rangsorolja a függvényeket, és javaslatot tesz az sram_hotlist.txt-re.
+ */
+class CodeProfiler {
+
+  public:
+    static constexpr uint32_t PROFILE_SAMPLE_HZ = 2000;      // Mintavételi frekvencia magonként
+    static constexpr uint8_t PROFILE_BUCKET_SHIFT = 5;       // 32 bájtos címvödrök
+    static constexpr uint16_t PROFILE_TABLE_SIZE = 256;      // Vödrök magonként (hash tábla, 2 hatvány)
+    static constexpr uint8_t PROFILE_MAX_PROBE = 8;          // Ennyi ütközés után a minta eldobódik
+    static constexpr uint32_t XIP_SAMPLE_INTERVAL_MS = 1000; // A cache számlálók kiolvasási periódusa (Core0 feladat)
+
+    /**
+     * @brief A cache számlálók kiolvasása és nullázása (Core0 feladat, XIP_SAMPLE_INTERVAL_MS-enként)
+     *
+     * A 32 bites hardveres számlálók néhány tíz másodperc alatt túlcsordulnának, ezért ablakonként gyűjtjük őket.
+     */
+    void sampleXipCache();
+
+    /**
+     * @brief Az utolsó ablak találati aránya ezrelékben (0, ha nem volt hozzáférés)
+     */
+    uint16_t getXipHitPermille() const { return xipWindowHitPermille; }
+
+    /**
+     * @brief A nullázás óta összesített találati arány ezrelékben
+     */
+    uint16_t getXipTotalHitPermille() const { return xipTotalAccesses ? (uint16_t)(xipTotalHits * 1000 / xipTotalAccesses) : 0; }
+
+    /**
+     * @brief A cache statisztika (és a PC minták) nullázása
+     */
+    void reset();
+
+    /**
+     * @brief Mintavételezés indítása a hívó magon (magonként egyszer, a saját setup-jában)
+     */
+    void begin();
+
+    /**
+     * @brief A cache statisztika és a PC profil kiírása a soros portra
+     */
+    void dump() const;
+
+#ifdef __CODE_PROFILE
+    /**
+     * @brief Egy PC minta rögzítése (a mintavételező alarm megszakításából hívódik)
+     */
+    void onSample(uint32_t pc);
+#endif
+
+  private:
+    // XIP cache (csak a Core0 írja)
+    uint64_t xipTotalAccesses = 0;
+    uint64_t xipTotalHits = 0;
+    volatile uint16_t xipWindowHitPermille = 0;
+
+#ifdef __CODE_PROFILE
+    /**
+     * @brief Egy mag mintái (csak az adott mag megszakítása írja)
+     */
+    struct CoreProfile {
+        int8_t alarm = -1;
+        uint32_t bucketKey[PROFILE_TABLE_SIZE]; // (PC >> PROFILE_BUCKET_SHIFT) + 1, 0: üres
+        uint32_t bucketCount[PROFILE_TABLE_SIZE];
+        uint32_t flashSamples;   // XIP-ből futó kódban
+        uint32_t ramSamples;     // Már SRAM-ban futó kódban
+        uint32_t romSamples;     // Bootrom (pl. float/double rutinok)
+        uint32_t droppedSamples; // Betelt hash tábla miatt eldobva
+    };
+    CoreProfile profiles[2] = {};
+#endif
+};
+
+extern CodeProfiler codeProfiler;
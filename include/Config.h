@@ -2,20 +2,31 @@
 
 #include <functional>
 #include <memory>
-#include <vector>
+#include <pico/critical_section.h>
 
 #include "ConfigData.h"
 #include "DebugDataInspector.h"
+#include "SpscQueue.h"
 #include "StoreBase.h"
 
 // Alapértelmezett konfigurációs adatok (readonly, const)
 extern const Config_t DEFAULT_CONFIG;
 
-// Callback típus definíció a konfiguráció változásának jelzésére
-using ConfigChangeCallback = std::function<void()>;
+// Callback típus definíció a konfiguráció változásának jelzésére (a megváltozott mezők ConfigField bitjeit kapja)
+using ConfigChangeCallback = std::function<void(ConfigFieldMask changed)>;
+
+/**
+ * @brief A mag, amelyiken a feliratkozó callback-je fut
+ */
+enum class ConfigCore : uint8_t { Core0 = 0, Core1 = 1, Current = 0xFF };
 
 /**
  * Konfigurációs adatok kezelése
+ *
+ * A változás értesítés mező szintű: mentéskor az előző értesítéshez képest megváltozott mezők bitmaszkja megy ki,
+ * és csak azok a feliratkozók kapják meg, amelyek az érintett mezők valamelyikére iratkoztak fel.
+ * Minden feliratkozó egy maghoz kötött: a saját magon azonnal hívódik, a másik magnak szóló változás
+ * a mag postaládájába kerül, és a mag loop-jában hívott dispatchPending() kézbesíti.
  */
 class Config : public StoreBase<Config_t> {
   public:
@@ -23,14 +34,57 @@ class Config : public StoreBase<Config_t> {
     // Szándékosan public, nem kell a sok getter egy embedded rendszerben
     Config_t data;
 
+    // Érvénytelen callback id (pl. még nem regisztrált komponens), az unregisterCallback() figyelmen kívül hagyja
+    static constexpr size_t INVALID_CALLBACK_ID = SIZE_MAX;
+
   private:
-    // Vektor a változást figyelő callback függvények tárolására
-    std::vector<ConfigChangeCallback> changeCallbacks;
+    static constexpr uint8_t MAX_CHANGE_CALLBACKS = 16;
+    static constexpr uint8_t CORE_COUNT = 2;
+
+    /**
+     * @brief Feliratkozói slot (slot-map: a felszabadult slot újrahasznosul, a generáció védi a régi id-ket)
+     */
+    struct CallbackSlot {
+        ConfigChangeCallback callback;
+        ConfigFieldMask fields = 0; // A figyelt mezők
+        uint8_t core = 0;           // A mag, amelyiken a callback fut
+        uint8_t generation = 0;     // Minden felszabadításkor nő
+        bool used = false;
+    };
+    CallbackSlot callbackSlots[MAX_CHANGE_CALLBACKS];
+
+    // A slotok foglalását/felszabadítását védi a két mag között (a callback-ek hívása a zár nélkül történik)
+    critical_section_t registryLock;
+
+    // Az utoljára értesített adatok (ehhez képest számoljuk a megváltozott mezőket)
+    Config_t notifiedData;
+
+    // Magonkénti postaláda: a másik mag által jelzett, még nem kézbesített változások (mindig a másik mag a termelő)
+    SpscQueue<ConfigFieldMask, 8> mailbox[CORE_COUNT];
+
+    // Tele postaláda esetén a ki nem küldött változások (a termelő mag írja, a következő dispatchPending() újraküldi)
+    ConfigFieldMask undelivered[CORE_COUNT] = {0, 0};
 
     /**
      * @brief Értesíti a feliratkozott komponenseket a változásról
+     * @param changed A megváltozott mezők (ConfigField bitek)
+     */
+    void notifyChange(ConfigFieldMask changed);
+
+    /**
+     * @brief Változás küldése a másik mag postaládájába
      */
-    void notifyChange();
+    void post(uint8_t core, ConfigFieldMask changed);
+
+    /**
+     * @brief Az adott maghoz kötött, érintett feliratkozók meghívása (csak az adott magon hívható)
+     */
+    void invokeCallbacks(uint8_t core, ConfigFieldMask changed);
+
+    /**
+     * @brief A két adatpéldány között eltérő mezők bitmaszkja
+     */
+    static ConfigFieldMask changedFields(const Config_t &a, const Config_t &b);
 
   protected:
     const char *getClassName() const override { return "Config"; }
@@ -51,15 +105,16 @@ class Config : public StoreBase<Config_t> {
      * Mentési művelet
      */
     uint16_t performSave() override {
-        uint16_t savedCrc = StoreEepromBase<Config_t>::save(getData(), 0, getClassName());
+        uint16_t savedCrc = StoreJournalBase<Config_t>::save(getData(), getClassName());
 #ifdef __DEBUG
         if (savedCrc != 0) {
             DebugDataInspector::printConfigData(getData());
         }
 #endif
-        // Csak akkor értesítünk, ha a mentés sikeres volt (CRC nem nulla)
+        // Csak akkor értesítünk, ha a mentés sikeres volt (CRC nem nulla), és csak a megváltozott mezőkről
+        // (a checkSave() már értesített, ez a kényszerített mentést és a közben történt változásokat fedi le)
         if (savedCrc != 0) {
-            notifyChange();
+            notifyChange(changedFields(data, notifiedData));
         }
         return savedCrc;
     }
@@ -68,7 +123,7 @@ class Config : public StoreBase<Config_t> {
      *  Betöltési művelet
      */
     uint16_t performLoad() override {
-        uint16_t loadedCrc = StoreEepromBase<Config_t>::load(getData(), 0, getClassName());
+        uint16_t loadedCrc = StoreJournalBase<Config_t>::load(getData(), getClassName());
 
         // Min/Max érték korlátozása
         data.tftManualBrightnessValue = constrain(data.tftManualBrightnessValue, 0, TFT_BACKGROUND_LED_MAX_BRIGHTNESS);
@@ -78,7 +133,7 @@ class Config : public StoreBase<Config_t> {
 #endif
 
         // Betöltés után is értesítünk, hogy a komponensek felvegyék a friss értékeket
-        notifyChange();
+        notifyChange(ConfigField::ALL);
 
         return loadedCrc;
     }
@@ -88,7 +143,7 @@ class Config : public StoreBase<Config_t> {
      * Konstruktor
      * @param pData Pointer a konfigurációs adatokhoz
      */
-    Config() : StoreBase<Config_t>(), data(DEFAULT_CONFIG) {}
+    Config() : StoreBase<Config_t>(), data(DEFAULT_CONFIG), notifiedData(DEFAULT_CONFIG) { critical_section_init(&registryLock); }
 
     /**
      * Alapértelmezett adatok betöltése
@@ -96,21 +151,40 @@ class Config : public StoreBase<Config_t> {
     void loadDefaults() override {
         memcpy(&data, &DEFAULT_CONFIG, sizeof(Config_t));
         // Alapértelmezett értékek betöltésekor is értesítünk
-        notifyChange();
+        notifyChange(ConfigField::ALL);
+    }
+
+    /**
+     * @brief Változás esetén a feliratkozók azonnal értesülnek, a flash mentés a következő biztonságos pontig várhat
+     */
+    void checkSave() override {
+        notifyChange(changedFields(data, notifiedData));
+        StoreBase<Config_t>::checkSave();
     }
 
     /**
      * @brief Feliratkoztat egy komponenst a konfiguráció változásainak figyelésére
-     * @param callback A függvény, amit változáskor meg kell hívni
-     * @return Index a leiratkozáshoz
+     * @param callback A függvény, amit változáskor meg kell hívni (a megváltozott figyelt mezőket kapja)
+     * @param fields A figyelt mezők (ConfigField bitek)
+     * @param core A mag, amelyiken a callback fut (alapértelmezés: a hívó magja)
+     * @return Azonosító a leiratkozáshoz (INVALID_CALLBACK_ID, ha nincs szabad slot)
      */
-    size_t registerChangeCallback(ConfigChangeCallback callback);
+    size_t registerChangeCallback(ConfigChangeCallback callback, ConfigFieldMask fields = ConfigField::ALL, ConfigCore core = ConfigCore::Current);
 
     /**
-     * @brief Leiratkoztat egy komponenst index alapján
-     * @param callbackId A registerChangeCallback által visszaadott index
+     * @brief Leiratkoztat egy komponenst azonosító alapján
+     * @param callbackId A registerChangeCallback által visszaadott azonosító
+     *
+     * A feliratkozó magján (vagy amikor az a mag még nem kézbesít) hívandó, hogy ne fusson közben a callback-je.
      */
     void unregisterCallback(size_t callbackId);
+
+    /**
+     * @brief A hívó mag postaládájában várakozó változások kézbesítése
+     *
+     * Mindkét mag loop-ja hívja; üres postaládánál csak egy index összehasonlítás.
+     */
+    void dispatchPending();
 };
 
 // Globális config példány deklaráció
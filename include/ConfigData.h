@@ -20,7 +20,7 @@ struct Config_t {
     bool gpsTraffiSirenAlarmEnabled; // GPS traffipax sziréna riasztás engedélyezése
 
     //--- Debug
-    bool debugGpsSerialOnInternalFastLed; //  Az RGB LED villogtatása, ha van GPS soros adat
+    bool debugGpsSerialOnInternalFastLed; //  A GPS állapot (fix mód, hibakódok) kijelzése a belső RGB LED-en
     bool debugGpsSerialData;              //  GPS adatok kiírása a Soros portra
     bool debugGpsSatellitesDatabase;      //  GPS műhold adatbázis debug logolása
 
@@ -28,3 +28,37 @@ struct Config_t {
     bool externalTemperatureMode = true; // Hőmérsékleti mód: true = külső hőmérséklet, false = CPU hőmérséklet, true = external, false = CPU
     bool externalVoltageMode = true;     // Feszültségmérő mód: true = VBus, false = VSys, true = external, false = CPU
 };
+
+// A Config_t mezőinek változás bitjei (a config változás értesítés ezekkel jelzi, mi változott)
+using ConfigFieldMask = uint16_t;
+
+namespace ConfigField {
+//--- TFT
+constexpr ConfigFieldMask TFT_CALIBRATE_DATA = 1 << 0;
+constexpr ConfigFieldMask TFT_AUTO_BRIGHTNESS_ACTIVE = 1 << 1;
+constexpr ConfigFieldMask TFT_MANUAL_BRIGHTNESS_VALUE = 1 << 2;
+
+//--- System
+constexpr ConfigFieldMask BEEPER_ENABLED = 1 << 3;
+constexpr ConfigFieldMask SCREEN_SAVER_TIMEOUT = 1 << 4;
+
+// GPS traffipax riasztási beállítások
+constexpr ConfigFieldMask GPS_TRAFFI_ALARM_DISTANCE = 1 << 5;
+constexpr ConfigFieldMask GPS_TRAFFI_ALARM_ENABLED = 1 << 6;
+constexpr ConfigFieldMask GPS_TRAFFI_SIREN_ALARM_ENABLED = 1 << 7;
+
+//--- Debug
+constexpr ConfigFieldMask DEBUG_GPS_SERIAL_ON_INTERNAL_FAST_LED = 1 << 8;
+constexpr ConfigFieldMask DEBUG_GPS_SERIAL_DATA = 1 << 9;
+constexpr ConfigFieldMask DEBUG_GPS_SATELLITES_DATABASE = 1 << 10;
+
+//--- Nem állítható de perszisztens adatok ->  MainScreen
+constexpr ConfigFieldMask EXTERNAL_TEMPERATURE_MODE = 1 << 11;
+constexpr ConfigFieldMask EXTERNAL_VOLTAGE_MODE = 1 << 12;
+
+// Csoportok
+constexpr ConfigFieldMask TFT_BRIGHTNESS = TFT_AUTO_BRIGHTNESS_ACTIVE | TFT_MANUAL_BRIGHTNESS_VALUE;
+constexpr ConfigFieldMask GPS_TRAFFI = GPS_TRAFFI_ALARM_DISTANCE | GPS_TRAFFI_ALARM_ENABLED | GPS_TRAFFI_SIREN_ALARM_ENABLED;
+constexpr ConfigFieldMask DEBUG_GPS = DEBUG_GPS_SERIAL_ON_INTERNAL_FAST_LED | DEBUG_GPS_SERIAL_DATA | DEBUG_GPS_SATELLITES_DATABASE;
+constexpr ConfigFieldMask ALL = (1 << 13) - 1;
+} // namespace ConfigField
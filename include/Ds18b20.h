@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "OneWirePio.h"
+
+/**
+ * @brief DS18B20 hőmérő szenzorok nem blokkoló kezelése a PIO OneWire buszon
+ *
+ * Az indításkor felderített szenzorok egyszerre mérnek (Skip ROM + Convert T), a konverzió végét nem a buszon pollozzuk,
+ * hanem kivárjuk a 12 bites felbontás konverziós idejét, majd szenzoronként (Match ROM + Read Scratchpad) kiolvassuk az eredményt.
+ * Egy loop() hívás csak a PIO FIFO-kat tölti/üríti, így nem blokkol és nem tilt megszakítást.
+ */
+class Ds18b20 {
+
+  public:
+    static constexpr uint8_t MAX_SENSORS = 4;           // Ennyi szenzort kezelünk egy buszon
+    static constexpr uint16_t CONVERSION_TIME_MS = 750; // Konverziós idő 12 bites (gyári alapértelmezett) felbontásnál
+    static constexpr uint16_t READ_INTERVAL_MS = 1500;  // Két mérési ciklus kezdete közötti idő
+
+    /**
+     * @brief A busz indítása és a szenzorok felderítése (blokkoló, a setup-ban hívandó)
+     * @return A talált szenzorok száma
+     */
+    uint8_t begin(uint8_t pin);
+
+    /**
+     * @brief A mérési állapotgép léptetése (nem blokkol, ~20ms-enként hívandó)
+     */
+    void loop();
+
+    /**
+     * @brief A talált szenzorok száma
+     */
+    uint8_t getSensorCount() const { return sensorCount; }
+
+    /**
+     * @brief Van-e már érvényes mérés az adott szenzortól
+     */
+    bool isValid(uint8_t index) const { return index < sensorCount && valid[index]; }
+
+    /**
+     * @brief Az adott szenzor utolsó érvényes mérése (Celsius, 0.0 ha még nincs)
+     */
+    float getTemperature(uint8_t index) const { return index < sensorCount ? rawTemperature[index] / 16.0f : 0.0f; }
+
+  private:
+    /**
+     * @brief A mérési ciklus állapotai
+     */
+    enum class State : uint8_t { Idle, StartConversion, Converting, ReadScratchpad };
+
+    OneWirePio bus;
+    uint64_t roms[MAX_SENSORS];
+    uint8_t sensorCount = 0;
+
+    // A mérési eredmények (a Core1 írja, a Core0 olvassa; 16 bites, igazított írás/olvasás)
+    volatile int16_t rawTemperature[MAX_SENSORS] = {};
+    volatile bool valid[MAX_SENSORS] = {};
+
+    State state = State::Idle;
+    uint8_t readIndex = 0;     // Az éppen kiolvasott szenzor indexe
+    uint32_t cycleStartMs = 0; // Az utolsó mérési ciklus kezdete
+    uint32_t conversionStartMs = 0;
+
+    /**
+     * @brief A következő szenzor scratchpad olvasásának indítása
+     */
+    void startReadScratchpad();
+
+    /**
+     * @brief A kiolvasott scratchpad ellenőrzése és az eredmény eltárolása
+     */
+    void storeScratchpad(const uint8_t *scratchpad);
+};
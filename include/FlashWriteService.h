@@ -0,0 +1,156 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "TaskScheduler.h"
+
+/**
+ * @brief Flash írások ütemezése biztonságos pontokra, a leállás mérésével
+ *
+ * Flash törlés/programozás alatt az XIP áll: a flash-ből futó kód egyik magon sem futhat. A GPS UART FIFO-ja 32 bájt
+ * (9600 baud mellett ~33ms), egy szektor törlés ennél jóval tovább tarthat, így az NMEA adatfolyam közepén írva a Core1
+ * bájtokat veszítene. Ezért az írási kérések (request()) sorba kerülnek, és csak biztonságos ponton futnak (Core0 feladat),
+ * aktív riasztás alatt soha:
+ * - közvetlenül egy fix epocha feldolgozása után (SAFE_WINDOW_US): ekkor még jön a GSA/GSV/GLL sorozat, ezért itt csak lap
+ *   programozás (~1ms, a FIFO bőven kibírja) futhat. A szektor törlést (~45ms) igénylő feladat deferToEraseWindow()-val
+ *   a sorban marad,
+ * - az epocha sorozata utáni csendes szakaszban: QUIET_GAP_US óta nem jött bájt, és az epocha óta még nem telt el
+ *   ERASE_DEADLINE_US (a következő sorozat előtt a törlés befejeződik). Itt törlés is futhat; a Core1 GPS feladata
+ *   (onGpsPoll()) ébreszti a feladatot, ha törlés vár,
+ * - vagy ha hosszabb ideje nincs fix epocha (nincs mit elveszíteni).
+ *
+ * A flash műveletek (eraseSector(), programPage()) alatt a másik mag az arduino-pico idleOtherCore() RAM-ban futó
+ * FIFO megszakításában parkol, a hívó magon a megszakítások tiltva vannak. Minden művelet leállási idejét mérjük.
+ */
+class FlashWriteService {
+
+  public:
+    /**
+     * @brief Egy írási feladat (a biztonságos ponton, a Core0-n fut)
+     */
+    using Job = void (*)(void *context);
+
+    static constexpr uint8_t MAX_JOBS = 4;                // Egyszerre várakozó írási feladatok
+    static constexpr uint32_t SAFE_WINDOW_US = 300000;    // A fix epocha után ennyi ideig futhat lap programozás
+    static constexpr uint32_t QUIET_GAP_US = 20000;       // Ennyi ideje nem jött bájt: az epocha sorozata véget ért
+    static constexpr uint32_t ERASE_DEADLINE_US = 700000; // Törlés csak eddig az epocha után (a következő sorozat előtt)
+    static constexpr uint32_t NO_FIX_TIMEOUT_MS = 3000;   // Ennyi ideje nincs fix epocha: a GPS adat nem értékes
+    static constexpr uint32_t PROCESS_INTERVAL_MS = 1000; // A Core0 feladat periódusa (a fix epocha ébreszti is)
+
+    /**
+     * @brief A Core0 feladat azonosítója (a Core1 ezzel ébreszti a fix epocha után)
+     */
+    void begin(uint8_t processTaskId) { this->processTaskId = processTaskId; }
+
+    /**
+     * @brief Írási feladat kérése (Core0; ugyanaz a feladat + context csak egyszer kerül a sorba)
+     * @return false, ha a sor tele van
+     */
+    bool request(Job job, void *context);
+
+    /**
+     * @brief Fix epocha jelzése (Core1, a GPS feladatból, az epocha feldolgozása után)
+     * @param alertActive Aktív-e traffipax riasztás (akkor nem írunk)
+     */
+    void onFixEpoch(bool alertActive);
+
+    /**
+     * @brief A GPS UART kiolvasása után (Core1, minden GPS feladat körben): ébreszt, ha törlés vár és beállt a csend
+     * @param lastRxMicros A legutóbb beolvasott bájt ideje
+     */
+    void onGpsPoll(uint32_t lastRxMicros);
+
+    /**
+     * @brief Futhat-e most szektor törlés (a feladatból; a process()-en kívül, pl. induláskor mindig)
+     */
+    bool mayErase() const { return eraseAllowed; }
+
+    /**
+     * @brief A futó feladat törlést igényel, de most nem futhat: a sorban marad a csendes szakaszig
+     */
+    void deferToEraseWindow() { jobDeferred = true; }
+
+    /**
+     * @brief A várakozó feladatok futtatása, ha biztonságos pont van (Core0 feladat)
+     */
+    void process();
+
+    /**
+     * @brief Egy 4KB-os szektor törlése (a másik mag parkolva, a leállás mérve)
+     */
+    void eraseSector(uint32_t flashOffset);
+
+    /**
+     * @brief Egy 256 bájtos lap programozása (a másik mag parkolva, a leállás mérve)
+     */
+    void programPage(uint32_t flashOffset, const uint8_t *page);
+
+    /**
+     * @brief Az utolsó írási feladat teljes leállási ideje (µs)
+     */
+    uint32_t getLastStallMicros() const { return lastStallMicros.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief A leghosszabb egyedi flash művelet leállási ideje (µs)
+     */
+    uint32_t getMaxStallMicros() const { return maxStallMicros.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief A lefutott írási feladatok száma
+     */
+    uint32_t getWriteCount() const { return writeCount.load(std::memory_order_relaxed); }
+
+  private:
+    struct PendingJob {
+        Job job;
+        void *context;
+    };
+
+    // A sor csak a Core0-é, a Core1 csak a darabszámot olvassa
+    PendingJob jobs[MAX_JOBS];
+    std::atomic<uint8_t> jobCount{0};
+    uint8_t processTaskId = TaskScheduler::INVALID_TASK;
+
+    // Core1 -> Core0: az utolsó fix epocha ideje, a riasztás állapota, az utolsó UART bájt ideje
+    std::atomic<uint32_t> fixEpochMicros{0};
+    std::atomic<bool> alertActive{false};
+    std::atomic<uint32_t> lastRxMicros{0};
+
+    // Halasztott törlés: a Core1 a csendes szakasz elején ébreszt
+    std::atomic<bool> eraseWaiting{false};
+    bool eraseAllowed = true; // A process() az epocha utáni ablakban false-ra állítja
+    bool jobDeferred = false; // A futó feladat deferToEraseWindow()-t hívott
+
+    // Mérés: az aktuális feladat leállásainak összege, statisztika
+    uint32_t jobStallMicros = 0;
+    std::atomic<uint32_t> lastStallMicros{0};
+    std::atomic<uint32_t> maxStallMicros{0};
+    std::atomic<uint32_t> writeCount{0};
+
+    /**
+     * @brief Az írási ablak
+     */
+    enum class Window : uint8_t {
+        None,      // Nem írhatunk
+        PostEpoch, // Közvetlenül az epocha után: csak lap programozás
+        Erase,     // Csendes szakasz vagy nincs fix: törlés is
+    };
+
+    /**
+     * @brief Milyen írás futhat most
+     */
+    Window currentWindow() const;
+
+    /**
+     * @brief Az epocha sorozata utáni csendes szakaszban vagyunk-e
+     */
+    bool isQuietTail(uint32_t now) const;
+
+    /**
+     * @brief Egy flash művelet leállásának elszámolása
+     */
+    void accountStall(uint32_t micros);
+};
+
+extern FlashWriteService flashWriteService;
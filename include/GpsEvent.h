@@ -0,0 +1,17 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief A GpsManager (Core1) által a UI-nak (Core0) küldött esemény
+ */
+struct GpsEvent {
+    enum Type : uint8_t {
+        FIX_EPOCH, // Egy fix epocha (azonos időbélyegű RMC + GGA mondat) teljesen beérkezett
+        GSV_BLOCK  // Egy teljes GSV blokk (összes műhold üzenet) beérkezett
+    };
+
+    Type type;
+    uint32_t timestamp; // millis() a beérkezés pillanatában
+    uint32_t rxMicros;  // FIX_EPOCH: az epochát nyitó RMC mondat utolsó bájtjának beolvasási ideje (micros), a késleltetés mérés t0-ja
+};
@@ -5,11 +5,19 @@
 
 #include "Config.h"
 #include "DayLightSaving.h"
+#include "GpsEvent.h"
 #include "SatelliteDb.h"
+#include "SpeedFilter.h"
+#include "SpscQueue.h"
 
 class GpsManager {
 
   public:
+    /**
+     * GPS működési mód (a GGA/RMC FixMode alapján)
+     */
+    enum class FixMode : uint8_t { NoFix, Auto, Differential, Estimated, Unknown };
+
     struct Satellites_type {
         int prn;
         int elevation;
@@ -36,9 +44,20 @@ class GpsManager {
     void loop();
 
     /**
-     * @brief Callback függvény, amit a Config hív meg változás esetén
+     * @brief Műhold adatbázis karbantartása: a már nem követett műholdak törlése (Core1, másodpercenként)
+     */
+    void maintainSatelliteDb() { satelliteDb.deleteUntrackedSatellites(); }
+
+    /**
+     * @brief A GPS állapotának (fix mód, adathiány, hibás mondatok) kijelzése a beépített RGB LED-en (Core1, periodikusan)
      */
-    void onConfigChanged();
+    void updateStatusLed();
+
+    /**
+     * @brief Callback függvény, amit a Config hív meg változás esetén (Core1-en fut)
+     * @param changed A megváltozott figyelt mezők (ConfigField bitek)
+     */
+    void onConfigChanged(ConfigFieldMask changed);
 
     /**
      * Thread-safe hozzáférés a műhold adatbázishoz UI számára (Core0)
@@ -86,6 +105,55 @@ class GpsManager {
     String getGpsQualityString();
     String getGpsModeToString();
 
+    /**
+     * GPS működési mód lekérdezése (heap foglalás nélkül)
+     */
+    FixMode getFixMode();
+
+    /**
+     * GPS működési mód szöveges neve
+     */
+    static const char *fixModeToString(FixMode mode);
+
+    /**
+     * @brief A következő GPS esemény kivétele (Core0 hívja, nem blokkol)
+     * @return false, ha nincs függő esemény
+     */
+    bool popEvent(GpsEvent &event) { return eventQueue.pop(event); }
+
+    /**
+     * @brief Van-e a Core0 által még ki nem vett esemény (Core1, a Core0 ütemező felébresztéséhez)
+     */
+    bool hasPendingEvents() const { return !eventQueue.isEmpty(); }
+
+    /**
+     * @brief Van-e még el nem fogyasztott fix epocha (csak Core1, a traffipax kiértékelő ütemezéséhez)
+     */
+    bool isFixEpochPending() const { return fixEpochForCore1; }
+
+    /**
+     * @brief A GPS UART-ról legutóbb beolvasott bájt ideje (csak Core1, a flash törlések ütemezéséhez)
+     */
+    uint32_t getLastRxMicros() const { return lastRxMicros; }
+
+    /**
+     * @brief Volt-e új fix epocha a legutóbbi hívás óta (csak Core1, pl. a traffipax kiértékeléshez)
+     * @param rxMicros Az epocha késleltetés mérési t0-ja
+     */
+    bool consumeFixEpoch(uint32_t &rxMicros) {
+        if (!fixEpochForCore1) {
+            return false;
+        }
+        fixEpochForCore1 = false;
+        rxMicros = epochRxMicros;
+        return true;
+    }
+
+    /**
+     * @brief A Kalman-szűrt sebesség legutóbbi becslése (Core0, nem blokkol)
+     */
+    SpeedFilter::Estimate getSpeedEstimate() const { return speedFilter.getEstimate(); }
+
   private:
     HardwareSerial &gpsSerial;
     TinyGPSPlus gps;
@@ -100,11 +168,32 @@ class GpsManager {
     TinyGPSCustom gsv_azimuth[4];   // gsv_azimuth
     TinyGPSCustom gsv_snr[4];       // gsv_snr
 
+    // Fix epocha detektálása: az RMC és GGA mondatok UTC időbélyege
+    TinyGPSCustom rmc_time;
+    TinyGPSCustom gga_time;
+    char epochTime[11] = {0};   // Az aktuális epocha időbélyege ("hhmmss.ss")
+    uint8_t epochSentences = 0; // Az aktuális epochából már beérkezett mondatok (EPOCH_* bitek)
+    uint32_t epochRxMicros = 0; // Az epocha RMC mondatának utolsó bájtja ekkor lett beolvasva
+    bool fixEpochForCore1 = false; // Új epocha a Core1 fogyasztóinak (consumeFixEpoch())
+
+    // Késleltetés méréshez: a soros port két egymást követő kiolvasása közti idő
+    uint32_t lastPollMicros = 0;
+    uint32_t pollGapMicros = 0;
+    uint32_t lastRxMicros = 0; // A legutóbb beolvasott bájt ideje
+
+    // Szűrt sebesség, fix epochánként frissül
+    SpeedFilter speedFilter;
+
+    // Core1 -> Core0 eseménysor (fix epocha, GSV blokk)
+    SpscQueue<GpsEvent, 8> eventQueue;
+
     // Debugging GPS adatok kiírása
     bool debugGpsSerialData;
 
-    // Debugging a beépített RGB LED-el
+    // A GPS állapot kijelzése a beépített RGB LED-en
     bool debugGpsSerialOnInternalFastLed;
+    uint32_t lastSentenceMillis = 0;  // Az utolsó érvényes NMEA mondat
+    uint32_t lastFailedChecksums = 0; // A hibás mondatok száma a legutóbbi LED frissítéskor
 
     bool debugGpsSatellitesDatabase;
 
@@ -116,4 +205,21 @@ class GpsManager {
     size_t configCallbackId;
 
     void processGSVMessages();
+
+    /**
+     * @brief Fix epocha lezárásának ellenőrzése egy teljes NMEA mondat után
+     * @param rxMicros A mondat utolsó bájtjának beolvasási ideje
+     */
+    void processFixEpoch(uint32_t rxMicros);
+
+    /**
+     * @brief A sebesség szűrő frissítése a lezárt fix epocha adataival
+     */
+    void updateSpeedFilter();
+
+    /**
+     * @brief Esemény küldése a UI-nak
+     * @param rxMicros FIX_EPOCH esetén a késleltetés mérés t0 időbélyege
+     */
+    void publishEvent(GpsEvent::Type type, uint32_t rxMicros = 0);
 };
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "ScreenId.h"
+
 class IScreenManager {
 
   public:
-    virtual bool switchToScreen(const char *screenName, void *params = nullptr) = 0;
+    virtual bool switchToScreen(ScreenId screenId, void *params = nullptr) = 0;
     virtual bool goBack() = 0;
     virtual bool isCurrentScreenDialogActive() = 0;
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Egy hangfájl fejléce (little-endian, 12 bájt), utána az IMA ADPCM adat
+ */
+struct VoiceClipHeader {
+    char magic[4];       // "VPA1"
+    uint16_t sampleRate; // Mintavételi frekvencia (Hz)
+    uint16_t reserved;
+    uint32_t sampleCount; // Minták száma
+};
+
+/**
+ * @brief IMA ADPCM (4 bit / minta) dekóder
+ *
+ * Platformfüggetlen, csak egész aritmetika: a hangfájlokat előállító host oldali kódoló (encode_voice.py)
+ * ugyanezt az algoritmust követi, így a dekódolt minták bitre azonosak a kódoló által rekonstruált mintákkal.
+ * Egy bájt két mintát hordoz, először az alsó nibble-t.
+ */
+namespace ImaAdpcm {
+
+/**
+ * @brief A lépésköz index változása a kódszó (nibble) alsó 3 bitje szerint
+ */
+static constexpr int8_t INDEX_TABLE[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+/**
+ * @brief Lépésköz tábla (89 elem)
+ */
+static constexpr int16_t STEP_TABLE[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,    31,    34,    37,    41,    45,    50,    55,    60,
+    66,    73,    80,    88,    97,    107,   118,   130,   143,   157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,   494,   544,
+    598,   658,   724,   796,   876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,
+    5358,  5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+/**
+ * @brief A dekóder állapota (a fájl elején 0/0)
+ */
+struct State {
+    int16_t predictor = 0;
+    uint8_t index = 0;
+};
+
+/**
+ * @brief Egy 4 bites kódszó dekódolása
+ * @return A következő 16 bites előjeles minta
+ */
+inline int16_t decodeNibble(State &state, uint8_t nibble) {
+    const int32_t step = STEP_TABLE[state.index];
+
+    // diff = (2 * magnitude + 1) * step / 8, eltolásokkal (a kódoló is így számol)
+    int32_t diff = step >> 3;
+    if (nibble & 4) {
+        diff += step;
+    }
+    if (nibble & 2) {
+        diff += step >> 1;
+    }
+    if (nibble & 1) {
+        diff += step >> 2;
+    }
+
+    int32_t predictor = state.predictor + ((nibble & 8) ? -diff : diff);
+    if (predictor > 32767) {
+        predictor = 32767;
+    } else if (predictor < -32768) {
+        predictor = -32768;
+    }
+    state.predictor = (int16_t)predictor;
+
+    int32_t index = state.index + INDEX_TABLE[nibble & 7];
+    state.index = (uint8_t)(index < 0 ? 0 : (index > 88 ? 88 : index));
+
+    return state.predictor;
+}
+
+/**
+ * @brief Egymást követő bájtok dekódolása
+ * @param src ADPCM adat
+ * @param byteCount A bájtok száma (a minták száma ennek kétszerese)
+ * @param dst A kimenet, legalább 2 * byteCount elem
+ */
+inline void decode(State &state, const uint8_t *src, uint32_t byteCount, int16_t *dst) {
+    for (uint32_t i = 0; i < byteCount; i++) {
+        *dst++ = decodeNibble(state, src[i] & 0x0F);
+        *dst++ = decodeNibble(state, src[i] >> 4);
+    }
+}
+
+} // namespace ImaAdpcm
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "defines.h"
+
+/**
+ * @brief Késleltetés hisztogram (mikroszekundum, log2 vödrökkel)
+ *
+ * A k. vödör a [2^(k-1), 2^k) us tartományt számolja (a 0. vödör a 0 us-ot), az utolsó vödör a túlcsordulást.
+ * Egy hisztogramot mindig csak egy mag ír; az olvasó (debug képernyő, soros dump) szakadt értéket is láthat, ami diagnosztikához elfogadható.
+ */
+struct LatencyHistogram {
+    static constexpr uint8_t BUCKET_COUNT = 22; // ~2 mp-ig
+
+    uint32_t buckets[BUCKET_COUNT];
+    uint32_t count;
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    uint64_t sumMicros;
+
+    /**
+     * @brief Egy mérés hozzáadása
+     */
+    void add(uint32_t micros);
+
+    /**
+     * @brief Törlés
+     */
+    void reset();
+
+    /**
+     * @brief Átlag us-ban (0, ha nincs mérés)
+     */
+    uint32_t average() const { return count ? (uint32_t)(sumMicros / count) : 0; }
+
+    /**
+     * @brief Percentilis becslése: annak a vödörnek a felső határa, amelyben a mérések pct százaléka már benne van
+     */
+    uint32_t percentile(uint8_t pct) const;
+};
+
+/**
+ * @brief Traffipax riasztás végponttól végpontig tartó késleltetés mérése (UART bájttól a pixelekig)
+ *
+ * A kiindulópont (t0) az epochát nyitó RMC mondat utolsó bájtjának beolvasása a Core1-en. A fázisok t0-hoz mért késleltetése
+ * külön hisztogramba kerül, így a riasztási késleltetés romlása fázisonként mérhető.
+ * Az érintés fázisainak t0-ja az érintésvezérlő PENIRQ éle, így az érintéstől a visszajelzésig tartó idő is itt látszik.
+ * Megtekinthető a Latency debug képernyőn, és kiírható a soros portra.
+ */
+class LatencyProbe {
+
+  public:
+    /**
+     * @brief A mért fázisok
+     */
+    enum Stage : uint8_t {
+        UART_RECEIVE,       // Core1: az RMC utolsó bájtjának várakozása a soros pufferben (a két GPS loop közti idő, felső becslés)
+        SENTENCE_COMPLETE,  // Core1: az RMC mondat feldolgozva
+        FIX_PUBLISHED,      // Core1: a teljes fix epocha (RMC + GGA) eseményként elküldve a Core0-nak
+        PROXIMITY_COMPUTED, // Core1: a traffipax közelség és riasztási állapot kiértékelve
+        DRAW_STARTED,       // Core0: új riasztás sávjának rajzolása elkezdődött
+        SPI_PUSH_DONE,      // Core0: a riasztás sprite-jai kikerültek a kijelzőre
+        SIREN_STARTED,      // Core0: a sziréna megszólalt (bármelyik képernyőn)
+        TOUCH_DISPATCHED,   // Core0: a lenyomás eljutott a képernyőhöz (t0: PENIRQ él)
+        TOUCH_FEEDBACK,     // Core0: a lenyomást kezelő képernyőkör rajzolása is lefutott (t0: PENIRQ él)
+        STAGE_COUNT
+    };
+
+    /**
+     * @brief Egy fázis késleltetésének rögzítése
+     * @param stage A fázis
+     * @param latencyMicros A t0-tól eltelt idő us-ban
+     */
+    void record(Stage stage, uint32_t latencyMicros) { histograms[stage].add(latencyMicros); }
+
+    /**
+     * @brief Egy fázis rögzítése a t0 időbélyegtől mostanáig
+     */
+    void recordSince(Stage stage, uint32_t t0Micros) { record(stage, micros() - t0Micros); }
+
+    /**
+     * @brief Egy fázis hisztogramja
+     */
+    const LatencyHistogram &getHistogram(Stage stage) const { return histograms[stage]; }
+
+    /**
+     * @brief Egy fázis megjelenítendő neve
+     */
+    static const char *stageName(Stage stage);
+
+    /**
+     * @brief Az összes hisztogram törlése
+     */
+    void reset();
+
+    /**
+     * @brief Az összes hisztogram kiírása a soros portra
+     */
+    void dump() const;
+
+    /**
+     * @brief Késleltetés formázása olvasható alakra ("850us", "12.3ms")
+     */
+    static void formatMicros(uint32_t micros, char *buf, size_t len);
+
+  private:
+    LatencyHistogram histograms[STAGE_COUNT] = {};
+};
+
+extern LatencyProbe latencyProbe;
@@ -1,9 +1,20 @@
 #pragma once
 
 #include <TFT_eSPI.h>
+#include <array>
 
+#include "UIColorPalette.h"
 #include "defines.h"
 
+// A függőleges mérő 4 bpp sprite-jának paletta indexei
+#define LINEAR_METER_PAL_BACKGROUND 0
+#define LINEAR_METER_PAL_TITLE 1
+#define LINEAR_METER_PAL_LABEL 2
+#define LINEAR_METER_PAL_VALUE 3
+#define LINEAR_METER_PAL_SEGMENT_OFF 4
+#define LINEAR_METER_PAL_SEGMENT_FIRST 5                            // Az 1. sáv színe, a többi ezt követi
+#define LINEAR_METER_MAX_SEGMENTS (16 - LINEAR_METER_PAL_SEGMENT_FIRST) // 4 bpp: legfeljebb 11 sáv fér a palettába
+
 /**
  * Szivárvány szín visszaadása 16 bites RGB565 formátumban.
  *
@@ -13,7 +24,7 @@
  * @param spectrum Szín spektrum index (0-191)
  * @return 16 bites RGB565 színkód
  */
-uint16_t rainbowColor(uint8_t spectrum) {
+constexpr uint16_t rainbowColor(uint8_t spectrum) {
     spectrum = spectrum % 192;
     uint8_t red = 0;   // A piros a felső 5 bit
     uint8_t green = 0; // A zöld a középső 6 bit, de csak a felső 5 bitet használjuk
@@ -104,8 +115,151 @@ void linearBar(TFT_eSPI *tft, int val, int x, int y, int w, int h, int g, int n,
 }
 
 /**
- * Függőleges sávos mérő kirajzolása a kijelzőre.
- * @param tft TFT_eSPI kijelző objektum
+ * Arduino map() fordítási időben is kiértékelhető változata (a színtáblákhoz).
+ */
+constexpr long linearMeterMap(long x, long inMin, long inMax, long outMin, long outMax) { return inMax == inMin ? outMin : (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin; }
+
+/**
+ * Függőleges mérő egy kivilágított sávjának színe.
+ * @param b A sáv sorszáma (1-től n-ig)
+ * @param n Sávok száma
+ * @param s Színséma
+ * @return 16 bites RGB565 színkód
+ */
+constexpr uint16_t verticalLinearMeterSegmentColor(int b, int n, byte s) {
+    switch (s) {
+        case RED2RED:
+            return TFT_RED;
+        case GREEN2GREEN:
+            return TFT_GREEN;
+        case BLUE2BLUE:
+            return TFT_BLUE;
+        case BLUE2RED:
+            return rainbowColor(linearMeterMap(b, 1, n, 127, 0));
+        case GREEN2RED:
+            return rainbowColor(linearMeterMap(b, 1, n, 63, 0));
+        case RED2GREEN:
+            return rainbowColor(linearMeterMap(b, 1, n, 0, 63));
+        case RED2VIOLET:
+            return rainbowColor(linearMeterMap(b, 1, n, 0, 159));
+        default:
+            return TFT_BLUE;
+    }
+}
+
+/**
+ * Függőleges mérő sávszín táblája, fordítási időben előállítva.
+ * @tparam N Sávok száma (max LINEAR_METER_MAX_SEGMENTS)
+ * @param s Színséma
+ * @return Az 1..N sávok RGB565 színei
+ */
+template <int N> constexpr std::array<uint16_t, N> verticalLinearMeterColorTable(byte s) {
+    static_assert(N >= 1 && N <= LINEAR_METER_MAX_SEGMENTS, "A sávok színei nem férnek el a 4 bpp palettában");
+    std::array<uint16_t, N> colors{};
+    for (int b = 1; b <= N; b++) {
+        colors[b - 1] = verticalLinearMeterSegmentColor(b, N, s);
+    }
+    return colors;
+}
+
+/**
+ * Függőleges mérő 4 bpp sprite-jának palettája a sávszín tábla és a téma szerint.
+ * A sprite pixelei nem változnak, csak a paletta, így téma váltáskor elég a sprite-ot újra kitolni.
+ * @param sprite A 4 bpp sprite (már létre kell legyen hozva)
+ * @param segmentColors Az 1..n sávok színei (verticalLinearMeterColorTable())
+ * @param n Sávok száma (max LINEAR_METER_MAX_SEGMENTS)
+ * @param night true esetén éjszakai (tompított) téma
+ */
+void verticalLinearMeterPalette(TFT_eSprite *sprite, const uint16_t *segmentColors, int n, bool night) {
+    uint16_t palette[16] = {0};
+    palette[LINEAR_METER_PAL_BACKGROUND] = TFT_BLACK;
+    palette[LINEAR_METER_PAL_TITLE] = TFT_YELLOW;
+    palette[LINEAR_METER_PAL_LABEL] = TFT_WHITE;
+    palette[LINEAR_METER_PAL_VALUE] = TFT_ORANGE;
+    palette[LINEAR_METER_PAL_SEGMENT_OFF] = TFT_DARKGREY;
+    for (int b = 1; b <= n && b <= LINEAR_METER_MAX_SEGMENTS; b++) {
+        palette[LINEAR_METER_PAL_SEGMENT_FIRST + b - 1] = segmentColors[b - 1];
+    }
+    UIColorPalette::applySpritePalette(*sprite, palette, 16, night);
+}
+
+/**
+ * Függőleges mérő legutóbb kirajzolt állapota az inkrementális frissítéshez.
+ */
+struct VerticalLinearMeterState {
+    const char *category = nullptr; // Kirajzolt cím
+    float minVal = 0.0f;            // Kirajzolt minimum
+    float maxVal = 0.0f;            // Kirajzolt maximum
+    int barVal = 0;                 // Kivilágított sávok száma, 0 = még nincs kirajzolva
+    char valueText[12] = {0};       // Kirajzolt érték szöveg
+
+    /**
+     * Következő híváskor teljes újrarajzolás (pl. képernyő törlése után).
+     */
+    void invalidate() { barVal = 0; }
+
+    /**
+     * Ki van-e már rajzolva a mérő?
+     */
+    bool isDrawn() const { return barVal != 0; }
+};
+
+/**
+ * Függőleges mérő egy sávjának és a mellette lévő feliratnak a kirajzolása a sprite-ba.
+ * @return A sor felső Y koordinátája a sprite-on belül (a felirat törlési sávjával együtt)
+ */
+int verticalLinearMeterRow(TFT_eSprite *sprite, int meterWidth, int b, int barVal, const char *valueText, float minVal, float maxVal, int w, int h, int g, int n, boolean mirrored) {
+    char buf[12];
+
+    // Sáv Y koordinátája
+    int barY = 20 + (n - b) * (h + g);
+    // Sáv színe: kivilágított sáv esetén a saját paletta bejegyzése
+    uint8_t barColor = b <= barVal ? LINEAR_METER_PAL_SEGMENT_FIRST + b - 1 : LINEAR_METER_PAL_SEGMENT_OFF;
+
+    // Bar téglalap rajzolása
+    sprite->fillRect(mirrored ? meterWidth - w : 0, barY, w, h, barColor);
+
+    // Korábbi bar szöveg értékek törlése
+    int bgX = mirrored ? meterWidth - w - 50 : w + 5;
+    sprite->fillRect(bgX, barY - 2, 45, h + 4, LINEAR_METER_PAL_BACKGROUND);
+
+    // Bar szöveg meghatározása
+    const char *label = nullptr;
+    if (b == 1) {
+        label = dtostrf(minVal, 0, 1, buf); // Min érték
+    } else if (b == n) {
+        label = dtostrf(maxVal, 0, 1, buf); // Max érték
+    } else if (b == barVal) {
+        label = valueText; // Aktuális érték
+    }
+
+    // Bar szöveg kiírása
+    if (label != nullptr) {
+        sprite->setTextSize(1);
+        sprite->setTextColor(LINEAR_METER_PAL_LABEL, LINEAR_METER_PAL_BACKGROUND);
+        sprite->setTextDatum(mirrored ? TR_DATUM : TL_DATUM);
+
+        // Bar szöveg pozíciója
+        int textX = mirrored ? meterWidth - w - 8 : w + 8;
+        int textY = barY + h / 2 - 4;
+        sprite->drawString(label, textX, textY, 1);
+    }
+
+    return barY - 2;
+}
+
+/**
+ * Függőleges sávos mérő kirajzolása egy 4 bpp palettás sprite-ba, majd a kijelzőre.
+ *
+ * Inkrementális: a state alapján csak a megváltozott sávokat és számjegyeket rajzolja újra,
+ * és csak az érintett sprite sávokat tolja ki a kijelzőre. Ha semmi nem változott, nincs SPI forgalom.
+ * Teljes újrarajzolás az első híváskor, state.invalidate() után, illetve ha a cím vagy a tartomány változik.
+ *
+ * A színek paletta indexek, a palettát a verticalLinearMeterPalette() állítja be.
+ * @param sprite 4 bpp sprite (mérőnként saját, mert a tartalma megmarad a hívások között)
+ * @param state A mérő legutóbb kirajzolt állapota
+ * @param meterHeight A sprite magassága
+ * @param meterWidth A sprite szélessége
  * @param category A mérő címe (pl. "Temp")
  * @param val Az aktuális érték
  * @param minVal Minimum érték
@@ -115,24 +269,14 @@ void linearBar(TFT_eSPI *tft, int val, int x, int y, int w, int h, int g, int n,
  * @param w Egy sáv szélessége
  * @param h Egy sáv magassága
  * @param g Sávok közötti távolság
- * @param n Sávok száma
- * @param s Színséma
+ * @param n Sávok száma (max LINEAR_METER_MAX_SEGMENTS)
  * @param mirrored Szövegek pozíciója (false=jobbra, true=balra)
  */
-void verticalLinearMeter(TFT_eSprite *sprite, int meterHeight, int meterWidth, const char *category, float val, float minVal, float maxVal, int x, int y, int w, int h, int g, int n, byte s, boolean mirrored = false) {
-    char buf[20];
-
-    sprite->fillSprite(TFT_BLACK);
-
-    // 1. Cím kiírása a sprite tetejére
-    int titleY = 0;
-    sprite->setTextSize(1);
-    sprite->setTextColor(TFT_YELLOW, TFT_BLACK);
-    sprite->setTextDatum(mirrored ? TR_DATUM : TL_DATUM);
-    sprite->drawString(category, mirrored ? meterWidth : 0, titleY, 2);
-    sprite->setTextDatum(TL_DATUM);
+void verticalLinearMeter(TFT_eSprite *sprite, VerticalLinearMeterState &state, int meterHeight, int meterWidth, const char *category, float val, float minVal, float maxVal, int x, int y, int w, int h, int g, int n,
+                         boolean mirrored = false) {
+    n = constrain(n, 1, LINEAR_METER_MAX_SEGMENTS);
 
-    // 2. Aktuális érték sávszámra váltása (1-től n-ig)
+    // Aktuális érték sávszámra váltása (1-től n-ig)
     int barVal = map(val, minVal, maxVal, 1, n);
     if (barVal < 1) {
         barVal = 1;
@@ -141,81 +285,69 @@ void verticalLinearMeter(TFT_eSprite *sprite, int meterHeight, int meterWidth, c
         barVal = n;
     }
 
-    // 3. Sávok és feliratok rajzolása
-    for (int b = 1; b <= n; b++) {
-        // Sáv Y koordinátája
-        int barY = 20 + (n - b) * (h + g);
-        // Sáv színének meghatározása
-        uint16_t barColor = TFT_DARKGREY;
-        if (b <= barVal) {
-            switch (s) {
-                case RED2RED:
-                    barColor = TFT_RED;
-                    break;
-                case GREEN2GREEN:
-                    barColor = TFT_GREEN;
-                    break;
-                case BLUE2BLUE:
-                    barColor = TFT_BLUE;
-                    break;
-                case BLUE2RED:
-                    barColor = rainbowColor(map(b, 1, n, 127, 0));
-                    break;
-                case GREEN2RED:
-                    barColor = rainbowColor(map(b, 1, n, 63, 0));
-                    break;
-                case RED2GREEN:
-                    barColor = rainbowColor(map(b, 1, n, 0, 63));
-                    break;
-                case RED2VIOLET:
-                    barColor = rainbowColor(map(b, 1, n, 0, 159));
-                    break;
-                default:
-                    barColor = TFT_BLUE;
-                    break;
-            }
-        }
+    char valueText[sizeof(state.valueText)];
+    dtostrf(val, 0, 2, valueText);
 
-        // Bar téglalap rajzolása
-        sprite->fillRect(mirrored ? meterWidth - w : 0, barY, w, h, barColor);
-
-        // Korábbi bar szöveg értékek törlése
-        int bgX = mirrored ? meterWidth - w - 50 : w + 5;
-        sprite->fillRect(bgX, barY - 2, 45, h + 4, TFT_BLACK);
-
-        // Bar szöveg meghatározása
-        buf[0] = '\0';
-        if (b == 1) {
-            dtostrf(minVal, 0, 1, buf); // Min érték
-        } else if (b == n) {
-            dtostrf(maxVal, 0, 1, buf); // Max érték
-        } else if (b == barVal) {
-            dtostrf(val, 0, 2, buf); // Aktuális érték
-        }
+    // Az érték szöveg a kijelzés felbontásán nem változott és a sáv sem: nincs mit rajzolni
+    bool fullRedraw = !state.isDrawn() || state.category != category || state.minVal != minVal || state.maxVal != maxVal;
+    bool valueTextChanged = strcmp(valueText, state.valueText) != 0;
+    if (!fullRedraw && barVal == state.barVal && !valueTextChanged) {
+        return;
+    }
 
-        // Bar szöveg kiírása
-        if (buf[0] != '\0') {
-            sprite->setTextSize(1);
-            sprite->setTextColor(TFT_WHITE, TFT_BLACK);
-            sprite->setTextDatum(mirrored ? TR_DATUM : TL_DATUM);
+    int drawY = y - meterHeight;
+    int valueTextH = 16; // 1-es font, 2-es méret
+
+    if (fullRedraw) {
+        sprite->fillSprite(LINEAR_METER_PAL_BACKGROUND);
 
-            // Bar szöveg pozíciója
-            int textX = mirrored ? meterWidth - w - 8 : w + 8;
-            int textY = barY + h / 2 - 4;
-            sprite->drawString(buf, textX, textY, 1);
+        // Cím kiírása a sprite tetejére
+        sprite->setTextSize(1);
+        sprite->setTextColor(LINEAR_METER_PAL_TITLE, LINEAR_METER_PAL_BACKGROUND);
+        sprite->setTextDatum(mirrored ? TR_DATUM : TL_DATUM);
+        sprite->drawString(category, mirrored ? meterWidth : 0, 0, 2);
+        sprite->setTextDatum(TL_DATUM);
+
+        // Sávok és feliratok
+        for (int b = 1; b <= n; b++) {
+            verticalLinearMeterRow(sprite, meterWidth, b, barVal, valueText, minVal, maxVal, w, h, g, n, mirrored);
+        }
+    } else {
+        // Csak a két sávszám közötti sorok változnak (szín és az érték felirat helye),
+        // azonos sávszámnál csak az érték feliratot hordozó sor
+        int fromB = std::min(barVal, state.barVal);
+        int toB = std::max(barVal, state.barVal);
+        int rowsTop = meterHeight;
+        int rowsBottom = 0;
+        for (int b = fromB; b <= toB; b++) {
+            int rowY = verticalLinearMeterRow(sprite, meterWidth, b, barVal, valueText, minVal, maxVal, w, h, g, n, mirrored);
+            rowsTop = std::min(rowsTop, rowY);
+            rowsBottom = std::max(rowsBottom, rowY + h + 4);
         }
+        rowsTop = std::max(rowsTop, 0);
+        sprite->pushSprite(x, drawY + rowsTop, 0, rowsTop, meterWidth, rowsBottom - rowsTop);
     }
 
-    // 4. Aktuális érték kiírása a bar aljára
-    dtostrf(val, 0, 2, buf);
-    sprite->setTextSize(2);
-    sprite->setTextDatum(BL_DATUM);
-    sprite->setTextColor(TFT_ORANGE, TFT_BLACK);
-    sprite->drawString(buf, mirrored ? 10 : 0, meterHeight, 1);
+    // Aktuális érték kiírása a bar aljára
+    if (fullRedraw || valueTextChanged) {
+        sprite->fillRect(0, meterHeight - valueTextH, meterWidth, valueTextH, LINEAR_METER_PAL_BACKGROUND);
+        sprite->setTextSize(2);
+        sprite->setTextDatum(BL_DATUM);
+        sprite->setTextColor(LINEAR_METER_PAL_VALUE, LINEAR_METER_PAL_BACKGROUND);
+        sprite->drawString(valueText, mirrored ? 10 : 0, meterHeight, 1);
+        if (!fullRedraw) {
+            sprite->pushSprite(x, drawY + meterHeight - valueTextH, 0, meterHeight - valueTextH, meterWidth, valueTextH);
+        }
+    }
 
-    // Sprite kirajzolása a kijelzőre
-    int drawX = x;
-    int drawY = y - meterHeight;
+    // Teljes újrarajzoláskor a sprite egészét kitoljuk
+    if (fullRedraw) {
+        sprite->pushSprite(x, drawY);
+    }
 
-    sprite->pushSprite(drawX, drawY);
+    state.category = category;
+    state.minVal = minVal;
+    state.maxVal = maxVal;
+    state.barVal = barVal;
+    strcpy(state.valueText, valueText);
 }
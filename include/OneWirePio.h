@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Arduino.h>
+#include <hardware/pio.h>
+
+/**
+ * @brief PIO állapotgéppel megvalósított OneWire busz master
+ *
+ * A bit időzítéseket (reset/presence, írási és olvasási időrések) a PIO állapotgép adja 1µs-os ütemmel, így a CPU-nak nincs
+ * időkritikus feladata és nem kell megszakítást tiltania. Bájtonként egy TX és egy RX FIFO szó megy: az írt bájttal együtt a
+ * busz válasza is visszajön (olvasáshoz 0xFF-et kell írni). Ha a FIFO-k tele vagy üresek, az állapotgép két időrés között vár,
+ * ami a OneWire buszon megengedett, ezért a FIFO-kat ráérős, nem blokkoló lekérdezéssel is lehet kezelni.
+ *
+ * Két használati mód:
+ * - blokkoló hívások (reset(), write(), read(), search()) az inicializáláshoz
+ * - nem blokkoló tranzakció (startTransaction() + poll()) a periodikus méréshez
+ */
+class OneWirePio {
+
+  public:
+    static constexpr uint8_t MAX_TRANSACTION_BYTES = 20; // Egy tranzakció max. hossza (írt + olvasott bájt)
+
+    /**
+     * @brief Egy tranzakció állapota
+     */
+    enum class Status : uint8_t { Idle, Busy, Done, NoPresence };
+
+    /**
+     * @brief PIO program betöltése és az állapotgép indítása
+     * @return false, ha nincs szabad állapotgép / programhely
+     */
+    bool begin(uint8_t pin);
+
+    /**
+     * @brief Busz reset (blokkoló, ~1ms)
+     * @return true, ha legalább egy eszköz jelezte a jelenlétét
+     */
+    bool reset();
+
+    /**
+     * @brief Egy bájt írása (blokkoló, ~0.6ms)
+     */
+    void write(uint8_t value) { exchange(value); }
+
+    /**
+     * @brief Egy bájt olvasása (blokkoló, ~0.6ms)
+     */
+    uint8_t read() { return exchange(0xFF); }
+
+    /**
+     * @brief Az eszközök ROM kódjainak felderítése (blokkoló, Search ROM algoritmus)
+     * @param roms A talált ROM kódok
+     * @param maxCount A tömb mérete
+     * @return A talált (CRC-helyes) eszközök száma
+     */
+    uint8_t search(uint64_t *roms, uint8_t maxCount);
+
+    /**
+     * @brief Nem blokkoló tranzakció indítása: [reset], a tx bájtok írása, majd rxLength bájt olvasása
+     * @return false, ha még fut az előző tranzakció vagy túl hosszú
+     */
+    bool startTransaction(bool withReset, const uint8_t *tx, uint8_t txLength, uint8_t rxLength);
+
+    /**
+     * @brief A tranzakció léptetése: a FIFO-k töltése/ürítése (nem blokkol)
+     */
+    Status poll();
+
+    /**
+     * @brief A befejezett tranzakció olvasott bájtjai (rxLength darab)
+     */
+    const uint8_t *getReceived() const { return buffer + txLength; }
+
+    /**
+     * @brief Dallas CRC8 (ROM kód, scratchpad ellenőrzéshez)
+     */
+    static uint8_t crc8(const uint8_t *data, uint8_t length);
+
+  private:
+    PIO pio = nullptr;
+    uint sm = 0;
+    uint offset = 0;
+    uint8_t pin = 0;
+
+    // A folyamatban lévő tranzakció: a buffer elején az írandó, utána az olvasott bájtok
+    uint8_t buffer[MAX_TRANSACTION_BYTES];
+    uint8_t txLength = 0;
+    uint8_t totalLength = 0;
+    uint8_t sentCount = 0;
+    uint8_t receivedCount = 0;
+    bool waitingPresence = false;
+    Status status = Status::Idle;
+
+    /**
+     * @brief Egy bájt kiküldése és a busz válaszának visszaolvasása (blokkoló)
+     */
+    uint8_t exchange(uint8_t value);
+
+    /**
+     * @brief Search ROM hármas: két bit olvasása (bit, komplemens), majd az irány írása (blokkoló)
+     * @param direction Az ütközésnél választott irány, a függvény felülírja a ténylegesen választottal
+     * @return A két olvasott bit (bit0: bit, bit1: komplemens)
+     */
+    uint8_t triplet(uint8_t &direction);
+
+    /**
+     * @brief Az állapotgép bitszámának átállítása (8: bájt mód, 1: bit mód a kereséshez)
+     */
+    void setBitsPerWord(uint8_t bits);
+};
@@ -7,7 +7,7 @@
  */
 class ScreenDebugSetup : public UIScreen {
   public:
-    ScreenDebugSetup() : UIScreen(SCREEN_NAME_DEBUG_SETUP) { layoutComponents(); }
+    ScreenDebugSetup() : UIScreen(ScreenId::DebugSetup) { layoutComponents(); }
     void layoutComponents() override;
     void drawContent() override;
 };
@@ -17,7 +17,7 @@ class ScreenEmpty : public UIScreen, public ButtonsGroupManager<ScreenEmpty> {
      * @brief ScreenEmpty konstruktor
      * @param tft TFT display referencia
      */
-    ScreenEmpty() : UIScreen(SCREEN_NAME_EMPTY) {
+    ScreenEmpty() : UIScreen(ScreenId::Empty) {
 
         DEBUG("ScreenEmpty: Constructor called\n");
         layoutComponents();
@@ -42,7 +42,7 @@ class ScreenEmpty : public UIScreen, public ButtonsGroupManager<ScreenEmpty> {
         tft.setTextSize(3);
 
         // Képernyő cím kirajzolása
-        tft.drawString(SCREEN_NAME_EMPTY, ::SCREEN_W / 2, ::SCREEN_H / 2 - 20);
+        tft.drawString(getName(), ::SCREEN_W / 2, ::SCREEN_H / 2 - 20);
 
         // Információs szöveg
         tft.setTextSize(1);
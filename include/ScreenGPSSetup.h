@@ -4,7 +4,7 @@
 
 class ScreenGPSSetup : public UIScreen {
   public:
-    ScreenGPSSetup() : UIScreen(SCREEN_NAME_GPS_SETUP) { layoutComponents(); }
+    ScreenGPSSetup() : UIScreen(ScreenId::GpsSetup) { layoutComponents(); }
     void layoutComponents() override;
     void drawContent() override;
 
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Képernyő azonosítók
+ *
+ * Az érték egyben a ScreenManager fordítási idejű regisztrációs táblájának (SCREEN_REGISTRY) indexe,
+ * így a képernyőváltás egy tömbindexelés, nincs szöveges keresés és String másolás.
+ */
+enum class ScreenId : uint8_t {
+    Main,
+    Info,
+    Sats,
+    Setup,
+    TftSetup,
+    SystemSetup,
+    GpsSetup,
+    DebugSetup,
+    Latency,
+    ScreenSaver,
+    Test,
+    Empty,
+    Count,      // A képernyők száma (nem képernyő)
+    None = 0xFF // Nincs képernyő (pl. üres navigációs stack)
+};
+
+/**
+ * @brief A képernyő megjelenítendő / debug neve
+ */
+inline const char *screenName(ScreenId id) {
+    static constexpr const char *NAMES[] = {"Main", "Info", "Satellites", "Setup", "ScreenTFTSetup", "ScreenSystemSetup", "ScreenGPSSetup", "ScreenDebugSetup", "ScreenLatency", "ScreenScreenSaver", "Test", "Empty"};
+    static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == (uint8_t)ScreenId::Count, "screenName: NAMES must match ScreenId");
+    return id < ScreenId::Count ? NAMES[(uint8_t)id] : "None";
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "UIButton.h"
+#include "UIScreen.h"
+
+/**
+ * @brief Riasztási késleltetés debug képernyő
+ *
+ * Fázisonként táblázatosan mutatja a LatencyProbe hisztogramjainak összesítését (darabszám, min, átlag, p50, p95, max).
+ * Mellette az XIP cache találati arányát (CodeProfiler) is mutatja.
+ * A hisztogramok törölhetők, és kiírhatók a soros portra.
+ */
+class ScreenLatency : public UIScreen {
+
+  public:
+    /**
+     * @brief ScreenLatency konstruktor
+     */
+    ScreenLatency();
+
+    virtual ~ScreenLatency() = default;
+
+    /**
+     * @brief Kirajzolja a képernyő saját tartalmát
+     */
+    virtual void drawContent() override;
+
+    /**
+     * @brief Másodpercenként frissíti a táblázat értékeit
+     */
+    virtual void handleOwnLoop() override;
+
+  private:
+    uint16_t textPadding;
+    unsigned long lastUpdated;
+
+    /**
+     * @brief UI komponensek létrehozása és elhelyezése
+     */
+    void layoutComponents();
+
+    /**
+     * @brief A táblázat értékeinek kirajzolása
+     */
+    void drawValues();
+};
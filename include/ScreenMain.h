@@ -5,8 +5,11 @@
 #include "Large_Font.h"
 #include "MessageDialog.h"
 #include "SensorUtils.h"
+#include "TraffipaxAlertEvaluator.h"
 #include "TraffipaxManager.h"
 #include "UIScreen.h"
+#include "UIValueField.h"
+#include "Utils.h"
 #include "ValueChangeDialog.h"
 
 // Globális GPS manager
@@ -22,16 +25,37 @@ class ScreenMain : public UIScreen, public ButtonsGroupManager<ScreenMain> {
   public:
     /**
      * @brief Adatok struktúrája a képernyő megjelenítéséhez
+     *
+     * POD: fix méretű char bufferek és enum, így a képkockánkénti összeállítás, másolás és összehasonlítás heap műveletek nélkül megy.
+     * A changed bitmaszk jelzi, mely mezők változtak az előző képkocka óta.
      */
     struct DisplayData {
+        /**
+         * @brief A changed bitmaszk bitjei
+         */
+        enum ChangedField : uint16_t {
+            SATELLITES = 1 << 0,
+            FIX_MODE = 1 << 1,
+            DATE = 1 << 2,
+            TIME = 1 << 3,
+            POSITION = 1 << 4,
+            ALTITUDE = 1 << 5,
+            HDOP = 1 << 6,
+            SPEED = 1 << 7,
+            MAX_SPEED = 1 << 8,
+            VOLTAGE = 1 << 9,
+            TEMPERATURE = 1 << 10,
+            ALL = 0xFFFF
+        };
+
         // Műhold adatok
         uint8_t satelliteCount = 0;
         bool satelliteValid = false;
-        String gpsMode = "";
+        GpsManager::FixMode fixMode = GpsManager::FixMode::Unknown;
 
         // Dátum és idő
-        String dateString = "";
-        String timeString = "";
+        char dateString[11] = {0}; // "2025-08-23"
+        char timeString[9] = {0};  // "17:42:30"
         bool dateTimeValid = false;
 
         // Pozíció
@@ -55,6 +79,14 @@ class ScreenMain : public UIScreen, public ButtonsGroupManager<ScreenMain> {
         // Szenzorok
         float voltage = 0.0;
         float temperature = 0.0;
+
+        // Az előző képkocka óta megváltozott mezők (ChangedField bitek)
+        uint16_t changed = 0;
+
+        /**
+         * @brief A megváltozott mezők bitmaszkja egy korábbi állapothoz képest
+         */
+        uint16_t changedFrom(const DisplayData &previous) const;
     };
 
     /**
@@ -79,6 +111,11 @@ class ScreenMain : public UIScreen, public ButtonsGroupManager<ScreenMain> {
      */
     virtual void activate() override;
 
+    /**
+     * @brief Dialógus bezárása: az utolsó dialógus után a képernyő törlődött, a widgetek is elölről rajzolnak
+     */
+    virtual void onDialogClosed(UIDialogBase *closedDialog) override;
+
     /**
      * @brief Kirajzolja a képernyő saját tartalmát
      */
@@ -90,37 +127,151 @@ class ScreenMain : public UIScreen, public ButtonsGroupManager<ScreenMain> {
     virtual bool handleTouch(const TouchEvent &event) override;
 
     /**
-     * @brief Callback függvény, amit a Config hív meg változás esetén
+     * @brief GPS esemény kezelése: új fix epochánál frissít
+     */
+    virtual void onGpsEvent(const GpsEvent &event) override;
+
+    /**
+     * @brief Traffipax riasztás esemény kezelése (a Core1 kiértékelőtől)
+     */
+    virtual void onTraffipaxAlert(const TraffipaxAlertEvent &event) override;
+
+    /**
+     * @brief Callback függvény, amit a Config hív meg változás esetén (Core0-n fut)
+     * @param changed A megváltozott figyelt mezők (ConfigField bitek)
      */
-    void onConfigChanged();
+    void onConfigChanged(ConfigFieldMask changed);
+
+    /**
+     * @brief Az utolsó új traffipax riasztás megjelenési ideje: a döntéstől az első kitolt sprite-ig (us)
+     */
+    uint32_t getAlertTimeToFirstPixelMicros() const { return traffipaxAlert.timeToFirstPixelMicros; }
 
   private:
     // Konfigurációs értékek gyorsítótárazása
-    bool _isTraffiAlarmEnabled;
     bool _isExternalVoltageMode;
     bool _isExternalTemperatureMode;
     bool _isBeeperEnabled;
-    uint16_t _gpsTraffiAlarmDistance;
-    bool _isGpsTraffiSirenAlarmEnabled;
 
     // Optimalizált, duplikációmentes állapotváltozók
-    double lastMaxSpeed = -1.0;
-    double lastSpeed = -1.0;
     long lastUpdate = 0;
-    unsigned long lastDemoEndTime = 0;
-    bool wasDemoActive = false;
-    uint8_t lastSatCount = 255;
-    String lastGpsMode = "";
-    String lastDateTime = "?";
-    double lastAltitude = -9999.0;
-    double lastHdop = -1.0;
-    unsigned long lastVerticalLinearSpriteUpdate = 0;
+    double maxSpeedKmph = 0.0; // A valaha kijelzett legnagyobb sebesség (csak beállt szűrőnél)
+    bool _nightTheme = false;     // A képernyő jelenleg az éjszakai témával rajzol-e
+    bool gpsEpochPending = false; // Új GPS fix epocha érkezett, a következő loop rajzol
+    bool alertPending = false;    // Új traffipax riasztás esemény érkezett, a következő loop jeleníti meg
+    TraffipaxAlertEvent pendingAlert;
+
+    // Az előző képkocka adatai a changed bitmaszkhoz
+    DisplayData lastData;
+
+    // A még ki nem rajzolt megváltozott mezők (DisplayData::ChangedField bitek), a widget feladatok törlik
+    uint16_t pendingChanged = 0;
+
+    // A lassú sáv widget frissítő feladatainak azonosítói (UIScreen ütemező)
+    uint8_t headerRefreshTask;
+    uint8_t infoRefreshTask;
+    uint8_t metersRefreshTask;
+
+    // --- Kötött érték mezők formázói (a mezők maguk döntik el, kell-e rajzolni) ---
+
+    // Műholdak száma: fix szélesség (x = 30..63), a padding nem törölhet bele az x = 65-nél kezdődő fixModeField-be
+    struct SatCountFormatter : UIValueFormatterBase {
+        static constexpr const char *SAMPLE = "88";
+        static constexpr uint16_t WIDTH = 34;
+        void begin(TFT_eSPI &tft) const {
+            tft.setTextFont(2);
+            tft.setTextSize(2);
+        }
+        void format(uint8_t value, char *buf, size_t len) const { snprintf(buf, len, "%u", value); }
+    };
+
+    // GPS működési mód: fix nélkül narancs, egyébként zöld
+    struct FixModeFormatter : UIValueFormatterBase {
+        static constexpr const char *SAMPLE = "Differential";
+        static constexpr uint8_t PADDING_EXTRA = 0;
+        void format(GpsManager::FixMode value, char *buf, size_t len) const { strlcpy(buf, GpsManager::fixModeToString(value), len); }
+        uint16_t color(GpsManager::FixMode value) const { return themed(value == GpsManager::FixMode::NoFix ? TFT_ORANGE : TFT_GREEN); }
+    };
+
+    // Dátum
+    struct DateFormatter : UIValueFormatterBase {
+        static constexpr const char *SAMPLE = "8888-88-88";
+        void begin(TFT_eSPI &tft) const {
+            tft.setTextFont(1);
+            tft.setTextSize(2);
+        }
+        void format(const char *value, char *buf, size_t len) const { strlcpy(buf, value, len); }
+    };
+
+    // Magasság méterben, érvénytelen (-9999) esetén "--"
+    struct AltitudeFormatter : UIValueFormatterBase {
+        static constexpr const char *SAMPLE = "8888";
+        void begin(TFT_eSPI &tft) const {
+            tft.setTextFont(2);
+            tft.setTextSize(2);
+        }
+        void format(double value, char *buf, size_t len) const {
+            if (value <= -9999.0) {
+                strlcpy(buf, "--", len);
+            } else {
+                snprintf(buf, len, "%d", (int)value);
+            }
+        }
+    };
+
+    // Maximum sebesség, amíg nincs (0) "--"
+    struct MaxSpeedFormatter : UIValueFormatterBase {
+        static constexpr const char *SAMPLE = "888";
+        void begin(TFT_eSPI &tft) const {
+            tft.setTextFont(2);
+            tft.setTextSize(2);
+        }
+        void format(double value, char *buf, size_t len) const {
+            if (value > 0.0) {
+                snprintf(buf, len, "%d", (int)lround(value)); // a sebesség mezővel azonos kerekítés
+            } else {
+                strlcpy(buf, "--", len);
+            }
+        }
+    };
 
-    // String optimalizálás: egyetlen buffer a szöveges értékekhez
-    char valueBuffer[64]; // Elég nagy az összes értékhez
+    // GPS HDOP, érvénytelen (< 0) esetén "--"
+    struct HdopFormatter : UIValueFormatterBase {
+        static constexpr const char *SAMPLE = "88.88";
+        void begin(TFT_eSPI &tft) const {
+            tft.setTextFont(2);
+            tft.setTextSize(2);
+        }
+        void format(double value, char *buf, size_t len) const {
+            if (value < 0.0) {
+                strlcpy(buf, "--", len);
+            } else {
+                dtostrf(value, 0, 2, buf);
+            }
+        }
+    };
+
+    // Aktuális sebesség nagy smooth fonttal, érvénytelen (< 0) esetén piros 0
+    struct SpeedFormatter : UIValueFormatterBase {
+        static constexpr const char *SAMPLE = "888";
+        void begin(TFT_eSPI &tft) const { tft.loadFont(Utils::xipNoAlloc(Arial_Narrow_Bold120)); } // 160KB glif adat: ne szorítsa ki a kódot a cache-ből
+        void end(TFT_eSPI &tft) const { tft.unloadFont(); }
+        void format(double value, char *buf, size_t len) const { snprintf(buf, len, "%d", value < 0.0 ? 0 : (int)lround(value)); }
+        uint16_t color(double value) const { return themed(value < 0.0 ? TFT_RED : TFT_WHITE); }
+    };
 
-    // Demó logika kiszervezése
-    void handleDemoMode(DisplayData &data);
+    UIValueField<uint8_t, SatCountFormatter> satCountField;
+    UIValueField<GpsManager::FixMode, FixModeFormatter> fixModeField;
+    UIValueField<const char *, DateFormatter> dateField;
+    UIValueField<double, AltitudeFormatter> altitudeField;
+    UIValueField<double, HdopFormatter> hdopField;
+    UIValueField<double, MaxSpeedFormatter> maxSpeedField;
+    UIValueField<double, SpeedFormatter> speedField;
+
+    /**
+     * @brief A kijelzett sebesség a szűrt becslésből (az aktuális időpontra előre jelezve), a maximumot is ebből követi
+     */
+    double displaySpeed(const SpeedFilter::Estimate &estimate);
 
     /**
      * @brief Kényszerített újrarajzolás flag - amikor visszatérünk más képernyőről
@@ -131,18 +282,18 @@ class ScreenMain : public UIScreen, public ButtonsGroupManager<ScreenMain> {
 
     // ...existing code...
 
-    // Intelligens traffipax figyelmeztető rendszer
+    // A Core1 kiértékelő által küldött traffipax riasztás megjelenítési állapota
     struct TraffipaxAlert {
-        enum State { INACTIVE, APPROACHING, NEARBY_STOPPED, DEPARTING };
-
-        State currentState = INACTIVE;
+        TraffipaxAlertEvent::State currentState = TraffipaxAlertEvent::INACTIVE;
         const TraffipaxManager::TraffipaxRecord *activeTraffipax = nullptr;
         double currentDistance = 0.0;
-        double lastDistance = 999999.0;
-        unsigned long lastSirenTime = 0;
-        unsigned long lastStateChange = 0;
+        unsigned long distanceMillis = 0; // A currentDistance mérésének ideje (a fixek közötti predikcióhoz)
 
-        static constexpr unsigned long SIREN_INTERVAL = 10000; // 10 sec szirénázási intervallum
+        // A kijelzőn lévő riasztó sáv állapota (a sprite-ok tartalma ehhez tartozik)
+        const TraffipaxManager::TraffipaxRecord *shownTraffipax = nullptr;
+        TraffipaxAlertEvent::State shownState = TraffipaxAlertEvent::INACTIVE;
+        int shownDistance = -1;
+        uint32_t timeToFirstPixelMicros = 0; // Utolsó új riasztás: a döntéstől az első kitolt sprite-ig eltelt idő (us)
     };
     TraffipaxAlert traffipaxAlert;
 
@@ -154,6 +305,42 @@ class ScreenMain : public UIScreen, public ButtonsGroupManager<ScreenMain> {
      */
     void layoutComponents();
 
+    /**
+     * @brief Widget frissítő feladatok regisztrálása (gyors sáv: sebesség, riasztási távolság; lassú sáv: minden más)
+     */
+    void registerRefreshTasks();
+
+    /**
+     * @brief Widget frissítő feladatok
+     */
+    void refreshSpeed();
+    void refreshAlertDistance();
+    void refreshHeader();
+    void refreshInfo();
+    void refreshMeters();
+
+    /**
+     * @brief A 4 bpp palettás sprite-ok létrehozása (ha még nem léteznek)
+     */
+    void createSprites();
+
+    /**
+     * @brief A sprite-ok palettájának beállítása az aktuális (nappali/éjszakai) témára
+     * @param repush true esetén (téma váltás) a sprite-ok újrarenderelés nélkül, az új palettával újra kikerülnek a kijelzőre,
+     *               a többi szöveg pedig az új színekkel újrarajzolódik
+     */
+    void applySpriteTheme(bool repush);
+
+    /**
+     * @brief Nappali szín az aktuális témára képezve (éjszakai témában tompítva)
+     */
+    uint16_t themeColor(uint16_t dayColor) const { return _nightTheme ? UIColorPalette::toNightColor(dayColor) : dayColor; }
+
+    /**
+     * @brief Az idő kirajzolása a 4 bpp idő sprite-ba és kitolása a kijelzőre
+     */
+    void drawTime(const char *timeString);
+
     /**
      * @brief Műhold ikon rajzolása
      */
@@ -192,14 +379,16 @@ class ScreenMain : public UIScreen, public ButtonsGroupManager<ScreenMain> {
     DisplayData collectDemoData();
 
     /**
-     * @brief Intelligens traffipax figyelmeztetés feldolgozása
+     * @brief A kiértékelő által küldött riasztási állapot megjelenítése
      */
-    void processIntelligentTraffipaxAlert(double currentLat, double currentLon, bool positionValid);
+    void applyTraffipaxAlert(const TraffipaxAlertEvent &event);
 
     /**
      * Trafipax figyelmeztető sáv megjelenítése
+     * A sáv két 4 bpp sprite-ból áll: bal oldalt a város/utca, jobb oldalt a távolság.
+     * @param rxMicros A riasztást kiváltó GPS epocha késleltetés mérési t0-ja (0: nincs mérés)
      */
-    void displayTraffipaxAlert(const TraffipaxManager::TraffipaxRecord *trafipax, double distance);
+    void displayTraffipaxAlert(const TraffipaxManager::TraffipaxRecord *trafipax, double distance, uint32_t rxMicros = 0);
 
     /**
      * Trafipax figyelmeztető sáv törlése
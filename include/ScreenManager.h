@@ -1,64 +1,100 @@
 #pragma once
 
-#include <functional>
-#include <map>
-#include <queue>
-#include <vector> // Navigációs stack-hez
-
 #include "Config.h"
 #include "IScreenManager.h"
+#include "ScreenId.h"
+#include "SpscQueue.h"
 #include "UIScreen.h"
+#include "Utils.h"
 
 // Deferred action struktúra - biztonságos képernyőváltáshoz
 struct DeferredAction {
     enum Type { SwitchScreen, GoBack };
 
     Type type;
-    const char *screenName;
+    ScreenId screenId;
     void *params;
 
-    DeferredAction(Type t, const char *name = nullptr, void *p = nullptr) : type(t), screenName(name), params(p) {}
+    DeferredAction(Type t = SwitchScreen, ScreenId id = ScreenId::None, void *p = nullptr) : type(t), screenId(id), params(p) {}
 };
 
-// Képernyő factory típus
-using ScreenFactory = std::function<std::shared_ptr<UIScreen>()>;
-
-// Képernyőkezelő
+// Képernyő factory típus (a fordítási idejű regisztrációs tábla bejegyzése)
+using ScreenFactory = std::shared_ptr<UIScreen> (*)();
+
+/**
+ * @brief Képernyőkezelő
+ *
+ * A képernyőket a ScreenId azonosítja, a gyárakat egy fordítási idejű tábla (SCREEN_REGISTRY) tartalmazza.
+ * A gyakran használt képernyők (Main, Sats) példánya induláskor egyszer jön létre, és váltáskor csak
+ * deaktiválódik/újraaktiválódik: a váltás költsége egy újrarajzolás, és nem aprózza a heap-et.
+ * A ritkán használt képernyők továbbra is váltáskor jönnek létre és szűnnek meg.
+ */
 class ScreenManager : public IScreenManager {
 
+  public:
+    static constexpr uint8_t MAX_NAVIGATION_DEPTH = 8;     // A back navigáció mélysége (a legrégebbi elem esik ki)
+    static constexpr uint16_t NAVIGATION_SOAK_CYCLES = 50; // A navigációs soak teszt köreinek alapértelmezett száma
+
   private:
-    std::map<String, ScreenFactory> screenFactories;
+    std::shared_ptr<UIScreen> cachedScreens[(uint8_t)ScreenId::Count]; // A gyorsítótárazott képernyők példányai
     std::shared_ptr<UIScreen> currentScreen;
-    const char *previousScreenName;
+    ScreenId previousScreen = ScreenId::None;
     uint32_t lastActivityTime;
     uint32_t screenSaverTimeoutMs; // Kiszámolt képernyővédő időtúllépés ms-ben
 
     // Navigációs stack - többszintű back navigációhoz
-    std::vector<String> navigationStack;
+    ScreenId navigationStack[MAX_NAVIGATION_DEPTH];
+    uint8_t navigationDepth = 0;
 
-    // Screensaver előtti képernyő neve - screensaver visszatéréshez
-    String screenBeforeScreenSaver;
+    // Screensaver előtti képernyő - screensaver visszatéréshez
+    ScreenId screenBeforeScreenSaver = ScreenId::None;
 
     // Deferred action queue - biztonságos képernyőváltáshoz
-    std::queue<DeferredAction> deferredActions;
+    SpscQueue<DeferredAction, 8> deferredActions;
     bool processingEvents = false;
 
     // Config callback token az automatikus leiratkozáshoz
     size_t configCallbackId;
 
-    void registerDefaultScreenFactories();
+    // Navigációs soak teszt állapota (lásd startNavigationSoak())
+    uint16_t soakCycles = 0;
+    uint16_t soakCyclesLeft = 0;
+    uint8_t soakScreenIndex = 0;
+    ScreenId soakReturnScreen = ScreenId::None;
+    ScreenId soakNavigationStack[MAX_NAVIGATION_DEPTH];
+    uint8_t soakNavigationDepth = 0;
+    Utils::HeapStats soakHeapBefore;
+
+    /**
+     * @brief A gyorsítótárazott képernyők létrehozása (egyszer, induláskor)
+     */
+    void createCachedScreens();
+
+    /**
+     * @brief Képernyő felvétele a navigációs stack-re
+     */
+    void pushNavigation(ScreenId screenId);
+
+    /**
+     * @brief A navigációs soak teszt egy lépése: a következő képernyő, rajta egy dialógus megnyitása és bezárása
+     */
+    void stepNavigationSoak();
+
+    /**
+     * @brief A navigációs soak teszt vége: vissza az indító képernyőre, és az eredmény kiírása
+     */
+    void finishNavigationSoak();
 
   public:
     ScreenManager();
     ~ScreenManager();
     std::shared_ptr<UIScreen> getCurrentScreen() const;
-    String getPreviousScreenName() const;
-    void registerScreenFactory(const char *screenName, ScreenFactory factory);
-    void deferSwitchToScreen(const char *screenName, void *params = nullptr);
+    ScreenId getPreviousScreen() const { return previousScreen; }
+    void deferSwitchToScreen(ScreenId screenId, void *params = nullptr);
     void deferGoBack();
     void processDeferredActions();
-    bool switchToScreen(const char *screenName, void *params = nullptr) override;
-    bool immediateSwitch(const char *screenName, void *params = nullptr, bool isBackNavigation = false);
+    bool switchToScreen(ScreenId screenId, void *params = nullptr) override;
+    bool immediateSwitch(ScreenId screenId, void *params = nullptr, bool isBackNavigation = false);
     bool goBack() override;
     bool immediateGoBack();
     bool handleTouch(const TouchEvent &event);
@@ -66,12 +102,28 @@ class ScreenManager : public IScreenManager {
     bool isCurrentScreenDialogActive() override;
 
     /**
-     * @brief Callback függvény, amit a Config hív meg változás esetén
+     * @brief Callback függvény, amit a Config hív meg változás esetén (Core0-n fut)
+     * @param changed A megváltozott figyelt mezők (ConfigField bitek)
      */
-    void onConfigChanged();
+    void onConfigChanged(ConfigFieldMask changed);
 
     /**
      * @brief Megmondja, hogy az aktuális képernyő a screensaver-e
      */
     bool isCurrentScreenScreensaver() const;
+
+    /**
+     * @brief Scriptelt navigációs soak teszt indítása
+     * @param cycles Ennyiszer járja végig az összes regisztrált képernyőt
+     *
+     * A loop() minden körében a következő képernyőre vált, rajta egy dialógust nyit meg és zár be. A végén visszatér
+     * az indító képernyőre, és a soros portra írja a heap állapotát (csúcs, foglalt, szabad, szabad darabok száma)
+     * a teszt előtt és után, valamint a képernyő és dialógus slab-ok kihasználtságát.
+     */
+    void startNavigationSoak(uint16_t cycles = NAVIGATION_SOAK_CYCLES);
+
+    /**
+     * @brief Fut-e a navigációs soak teszt
+     */
+    bool isNavigationSoakRunning() const { return soakCyclesLeft > 0; }
 };
\ No newline at end of file
@@ -24,6 +24,11 @@ class ScreenSats : public UIScreen {
      */
     ~ScreenSats();
 
+    /**
+     * @brief Képernyő aktiválása (a példány gyorsítótárazott: minden visszatéréskor teljes újrarajzolás)
+     */
+    void activate() override;
+
   protected:
     /**
      * @brief Kirajzolja a képernyő saját tartalmát
@@ -35,12 +40,21 @@ class ScreenSats : public UIScreen {
      */
     void handleOwnLoop() override;
 
+    /**
+     * @brief GPS esemény kezelése: teljes GSV blokk után frissít
+     */
+    void onGpsEvent(const GpsEvent &event) override;
+
   private:
     // Korábbi adatok tárolása a változások detektálásához
     std::vector<SatelliteDb::SatelliteData> lastSatellites;
     uint8_t lastSatCount;
     bool firstDraw;
 
+    // Frissítés: teljes GSV blokknál, vagy watchdog időzítővel
+    bool gsvBlockPending = false;
+    long lastUpdate = 0;
+
     // Rendezési beállítások
     SatelliteDb::SortType_t currentSortType;
     bool sortOrderChanged;
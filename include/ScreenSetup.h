@@ -12,7 +12,7 @@ class ScreenSetup : public UIScreen {
     /**
      * @brief ScreenSetup konstruktor
      */
-    ScreenSetup() : UIScreen(SCREEN_NAME_SETUP) { layoutComponents(); }
+    ScreenSetup() : UIScreen(ScreenId::Setup) { layoutComponents(); }
     virtual ~ScreenSetup() = default;
 
     /**
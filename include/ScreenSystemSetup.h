@@ -3,7 +3,7 @@
 #include "UIScreen.h"
 class ScreenSystemSetup : public UIScreen {
   public:
-    ScreenSystemSetup() : UIScreen(SCREEN_NAME_SYSTEM_SETUP) { layoutComponents(); }
+    ScreenSystemSetup() : UIScreen(ScreenId::SystemSetup) { layoutComponents(); }
     void layoutComponents() override;
     void drawContent() override;
 };
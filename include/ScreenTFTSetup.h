@@ -3,7 +3,7 @@
 #include "UIScreen.h"
 class ScreenTFTSetup : public UIScreen {
   public:
-    ScreenTFTSetup() : UIScreen(SCREEN_NAME_TFT_SETUP) { layoutComponents(); }
+    ScreenTFTSetup() : UIScreen(ScreenId::TftSetup) { layoutComponents(); }
     void layoutComponents() override;
     void drawContent() override;
 
@@ -18,7 +18,7 @@ class ScreenTest : public UIScreen, public ButtonsGroupManager<ScreenTest> {
      * Inicializálja a teszt értékeket.
      * @param tft TFT display referencia
      */
-    ScreenTest() : UIScreen(SCREEN_NAME_TEST), _testBool(false), _testInt(50), _testFloat(12.5f) {
+    ScreenTest() : UIScreen(ScreenId::Test), _testBool(false), _testInt(50), _testFloat(12.5f) {
 
         DEBUG("ScreenTest: Constructor called\n");
         layoutComponents();
@@ -43,7 +43,7 @@ class ScreenTest : public UIScreen, public ButtonsGroupManager<ScreenTest> {
         tft.setTextSize(3);
 
         // Képernyő cím kirajzolása
-        tft.drawString(SCREEN_NAME_TEST, ::SCREEN_W / 2, ::SCREEN_H / 2 - 20);
+        tft.drawString(getName(), ::SCREEN_W / 2, ::SCREEN_H / 2 - 20);
 
         // Információs szöveg
         tft.setTextSize(1);
@@ -108,7 +108,7 @@ class ScreenTest : public UIScreen, public ButtonsGroupManager<ScreenTest> {
                              auto showDialog3 = [this]() {
                                  Rect dlg3Bounds(90, 110, 200, 0);
                                  auto dialog3 =
-                                     std::make_shared<MessageDialog>(this, "Dialog 3/3", "Final. Click OK.", MessageDialog::ButtonsType::Ok, dlg3Bounds, ColorScheme::defaultScheme(), true /*okClosesDialog=true*/);
+                                     makeDialog<MessageDialog>(this, "Dialog 3/3", "Final. Click OK.", MessageDialog::ButtonsType::Ok, dlg3Bounds, ColorScheme::defaultScheme(), true /*okClosesDialog=true*/);
                                  dialog3->setDialogCallback([this](UIDialogBase *sender, MessageDialog::DialogResult result) {
                                      if (result == MessageDialog::DialogResult::Accepted) {
                                          DEBUG("Dialog 3 OK. Closing Dialog 3.\n");
@@ -121,7 +121,7 @@ class ScreenTest : public UIScreen, public ButtonsGroupManager<ScreenTest> {
                              auto showDialog2 = [this, showDialog3]() {
                                  Rect dlg2Bounds(60, 70, 200, 0);
                                  auto dialog2 =
-                                     std::make_shared<MessageDialog>(this, "Dialog 2/3", "Next or Cancel.", MessageDialog::ButtonsType::OkCancel, dlg2Bounds, ColorScheme::defaultScheme(), false /*okClosesDialog=false*/);
+                                     makeDialog<MessageDialog>(this, "Dialog 2/3", "Next or Cancel.", MessageDialog::ButtonsType::OkCancel, dlg2Bounds, ColorScheme::defaultScheme(), false /*okClosesDialog=false*/);
                                  dialog2->setDialogCallback([this, showDialog3](UIDialogBase *sender, MessageDialog::DialogResult result) {
                                      if (result == MessageDialog::DialogResult::Accepted) {
                                          DEBUG("Dialog 2 Next. Showing Dialog 3.\n");
@@ -138,7 +138,7 @@ class ScreenTest : public UIScreen, public ButtonsGroupManager<ScreenTest> {
                              // Ennek az "OK" (Next) gombja nem zárja be, csak a callback-et hívja
                              Rect dlg1Bounds(30, 30, 200, 0);
                              auto dialog1 =
-                                 std::make_shared<MessageDialog>(this, "Dialog 1/3", "Next or Cancel.", MessageDialog::ButtonsType::OkCancel, dlg1Bounds, ColorScheme::defaultScheme(), false /*okClosesDialog=false*/);
+                                 makeDialog<MessageDialog>(this, "Dialog 1/3", "Next or Cancel.", MessageDialog::ButtonsType::OkCancel, dlg1Bounds, ColorScheme::defaultScheme(), false /*okClosesDialog=false*/);
                              dialog1->setDialogCallback([this, showDialog2](UIDialogBase *sender, MessageDialog::DialogResult result) {
                                  if (result == MessageDialog::DialogResult::Accepted) {
                                      DEBUG("Dialog 1 Next. Showing Dialog 2.\n");
@@ -152,7 +152,7 @@ class ScreenTest : public UIScreen, public ButtonsGroupManager<ScreenTest> {
 
                          } else if (STREQ(event.label, "Bool Dlg")) {
                              Rect dlgBounds(-1, -1, 280, 0); // Auto-magasság
-                             auto boolDialog = std::make_shared<ValueChangeDialog>(
+                             auto boolDialog = makeDialog<ValueChangeDialog>(
                                  this, "Boolean Test", "Change boolean value:", &_testBool,
                                  [this](const std::variant<int, float, bool> &newValue) {
                                      if (std::holds_alternative<bool>(newValue)) {
@@ -166,7 +166,7 @@ class ScreenTest : public UIScreen, public ButtonsGroupManager<ScreenTest> {
 
                          } else if (STREQ(event.label, "Int Dlg")) {
                              Rect dlgBounds(-1, -1, 280, 0); // Auto-magasság
-                             auto intDialog = std::make_shared<ValueChangeDialog>(
+                             auto intDialog = makeDialog<ValueChangeDialog>(
                                  this, "Integer Test", "Change integer value:", &_testInt, 0, 100, 5,
                                  [this](const std::variant<int, float, bool> &newValue) {
                                      if (std::holds_alternative<int>(newValue)) {
@@ -180,7 +180,7 @@ class ScreenTest : public UIScreen, public ButtonsGroupManager<ScreenTest> {
 
                          } else if (STREQ(event.label, "Float Dlg")) {
                              Rect dlgBounds(-1, -1, 280, 0); // Auto-magasság
-                             auto floatDialog = std::make_shared<ValueChangeDialog>(
+                             auto floatDialog = makeDialog<ValueChangeDialog>(
                                  this, "Float Test", "Change float value:", &_testFloat, 0.0f, 50.0f, 0.5f,
                                  [this](const std::variant<int, float, bool> &newValue) {
                                      if (std::holds_alternative<float>(newValue)) {
@@ -200,7 +200,7 @@ class ScreenTest : public UIScreen, public ButtonsGroupManager<ScreenTest> {
 
                          if (showSpecificDialog) {
                              Rect dialogBounds(-1, -1, 300, 0); // Centered X, auto Y, width 180, auto-height
-                             auto dialog = std::make_shared<MessageDialog>(this, "Test Dialog", dialogMessage, dialogType, dialogBounds, ColorScheme::defaultScheme(), true /*okClosesDialog=true alapértelmezetten*/);
+                             auto dialog = makeDialog<MessageDialog>(this, "Test Dialog", dialogMessage, dialogType, dialogBounds, ColorScheme::defaultScheme(), true /*okClosesDialog=true alapértelmezetten*/);
                              dialog->setDialogCallback([this, label = event.label](UIDialogBase *sender, MessageDialog::DialogResult result) {
                                  const char *resultStr = "Unknown";
                                  if (result == MessageDialog::DialogResult::Accepted)
@@ -1,51 +1,33 @@
 #pragma once
 
 #include <Arduino.h>
-#include <DallasTemperature.h>
-#include <NonBlockingDallas.h>
-#include <OneWire.h>
 
+#include "Ds18b20.h"
 #include "defines.h"
 #include "pins.h"
 
-// Cache konstans
-#define SENSORS_CACHE_TIMEOUT_MS (5 * 1000) // 5 másodperc a cache idő
+#define SENSORS_LOOP_INTERVAL_MS 20 // A loop() hívási periódusa (a DS18B20 tranzakciók ennyi időnként lépnek tovább)
 
-// Cache struktúra
+// Szenzorok kezelése
 class SensorUtils {
   private:
-    float vBusExtValue;            // VBUS KÜLSŐ feszültség utolsó mért értéke (Volt)
-    unsigned long vBusExtLastRead; // VBUS utolsó mérésének időpontja (ms)
-    bool vBusExtValid;             // VBUS cache érvényessége
-
-    float vSysExtValue;            // VSYS KÜLSŐ feszültség utolsó mért értéke (Volt)
-    unsigned long vSysExtLastRead; // VSYS utolsó mérésének időpontja (ms)
-    bool vSysExtValid;             // VSYS cache érvényessége
-
-    float coreTemperatureValue;            // Hőmérséklet utolsó mért értéke (Celsius)
-    unsigned long coreTemperatureLastRead; // Hőmérséklet utolsó mérésének időpontja (ms)
-    bool coreTemperatureValid;             // Hőmérséklet cache érvényessége
-
-    // DS18B20
-    static volatile float externalTemperatureValue; // Külső hőmérséklet utolsó mért értéke (Celsius)
-    static void handleTemperatureChange(int deviceIndex, int32_t temperatureRAW);
+    // DS18B20 szenzorok (PIO OneWire busz)
+    Ds18b20 externalSensors;
 
   public:
-    SensorUtils();
-
     /**
      * Inicializálja az osztályt
      */
     void init();
 
     /**
-     * ADC olvasás és VBUS feszültség kiszámítása KÜLSŐ osztóval
+     * VBUS feszültség kiszámítása KÜLSŐ osztóval (az AdcSampler szűrt értékéből, nem blokkol)
      * @return A VBUS mért feszültsége Voltban.
      */
     float readVBusExternal();
 
     /**
-     * ADC olvasás és VSYS feszültség kiszámítása KÜLSŐ osztóval
+     * VSYS feszültség kiszámítása KÜLSŐ osztóval (az AdcSampler szűrt értékéből, nem blokkol)
      * @return A VSYS mért feszültsége Voltban.
      */
     float readVSysExternal();
@@ -58,12 +40,18 @@ class SensorUtils {
 
     /**
      * Kiolvassa a külső hőmérsékletét
+     * @param index A DS18B20 szenzor indexe (a ROM kódok keresési sorrendjében)
      * @return külső hőmérséklete Celsius fokban
      */
-    float readExternalTemperature();
+    float readExternalTemperature(uint8_t index = 0);
+
+    /**
+     * A talált külső (DS18B20) hőmérők száma
+     */
+    uint8_t getExternalSensorCount() const { return externalSensors.getSensorCount(); }
 
     /**
-     * Loop
+     * Loop (SENSORS_LOOP_INTERVAL_MS-enként hívandó)
      */
     void loop();
 };
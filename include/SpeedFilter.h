@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * @brief Állandó gyorsulás modellű Kalman-szűrő a GPS sebességre
+ *
+ * Állapot: [sebesség, gyorsulás]. Epochánként két mérést dolgoz fel:
+ * - a GPS (Doppler) sebességet,
+ * - a két fix közötti elmozdulás haladási irányra (course) vetített sebességét.
+ * A méréseket a HDOP alapján súlyozza, és eldobja a kiugró értékeket (HDOP határ, fizikai gyorsulás határ, innováció kapu).
+ *
+ * A Core1 (GpsManager) frissíti fix epochánként, a Core0 a publikált becslésből a fixek között előre jelzett sebességet rajzol.
+ * A publikálás seqlock-kal védett, így a Core0 sosem lát félig írt becslést és egyik mag sem blokkol.
+ */
+class SpeedFilter {
+
+  public:
+    /**
+     * @brief A UI számára publikált becslés
+     */
+    struct Estimate {
+        float speedKmph = 0.0f;       // Szűrt sebesség az epocha időpontjában
+        float accelKmphPerSec = 0.0f; // Szűrt gyorsulás
+        uint32_t epochMillis = 0;     // Az epocha beérkezésének ideje (millis)
+        bool valid = false;           // Van friss, elfogadott becslés
+        bool settled = false;         // A szűrő beállt (elég elfogadott mérés az utolsó újraindítás óta)
+
+        /**
+         * @brief Előre jelzett sebesség egy adott időpontra (a gyorsulással, korlátozott ideig extrapolálva)
+         * @param nowMillis Az aktuális idő (millis)
+         */
+        float predictKmph(uint32_t nowMillis) const;
+    };
+
+    /**
+     * @brief Egy GPS epocha mérései
+     */
+    struct Measurement {
+        uint32_t gpsTimeMillis; // Az epocha GPS ideje a nap kezdetétől (ms)
+        bool speedValid;
+        float speedMps;
+        bool courseValid;
+        float courseDeg;
+        bool positionValid;
+        double lat;
+        double lng;
+        bool hdopValid;
+        float hdop;
+    };
+
+    /**
+     * @brief Szűrő frissítése egy új fix epochával (Core1)
+     * @param m Az epocha mérései
+     * @param epochMillis Az epocha beérkezésének helyi ideje (millis)
+     */
+    void update(const Measurement &m, uint32_t epochMillis);
+
+    /**
+     * @brief A legutóbb publikált becslés (Core0, nem blokkol)
+     */
+    Estimate getEstimate() const;
+
+  private:
+    // Szűrő állapot (csak a Core1 használja)
+    float v = 0.0f; // m/s
+    float a = 0.0f; // m/s^2
+    float p00 = 0.0f, p01 = 0.0f, p11 = 0.0f;
+    bool initialized = false;
+    uint8_t acceptedCount = 0;
+    uint8_t rejectedInRow = 0;
+
+    // Az előző epocha (dt és elmozdulás számításához)
+    uint32_t lastGpsTimeMillis = 0;
+    uint32_t lastEpochMillis = 0;
+    bool lastPositionValid = false;
+    double lastLat = 0.0;
+    double lastLng = 0.0;
+
+    // Publikált becslés (seqlock: páratlan sorszám = írás folyamatban)
+    Estimate published;
+    std::atomic<uint32_t> sequence{0};
+
+    /**
+     * @brief Szűrő újraindítása egy elfogadott sebesség méréssel
+     */
+    void reset(float speedMps, float variance);
+
+    /**
+     * @brief Predikció dt másodperccel előre
+     */
+    void predict(float dt);
+
+    /**
+     * @brief Sebesség mérés beépítése
+     * @return false, ha a mérést kiugró értékként eldobtuk
+     */
+    bool correct(float z, float variance, float speedBefore, float dt);
+
+    /**
+     * @brief Becslés publikálása a Core0-nak
+     */
+    void publish(uint32_t epochMillis, bool valid);
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * @brief Zármentes, egy termelős / egy fogyasztós (SPSC) gyűrűpuffer a két mag közötti üzenetküldéshez
+ *
+ * A termelő (pl. Core1) csak a head, a fogyasztó (pl. Core0) csak a tail indexet írja,
+ * így nincs szükség mutexre és a push()/pop() sosem blokkol. Az acquire/release sorrendezés
+ * garantálja, hogy a fogyasztó a beírt elemet már teljes egészében látja.
+ *
+ * @tparam T Az elem típusa (triviálisan másolható, kis méretű struktúra)
+ * @tparam N A puffer mérete, 2 hatványa (a hasznos kapacitás N - 1)
+ */
+template <typename T, uint8_t N> class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue: N must be a power of two");
+
+  public:
+    /**
+     * @brief Elem beírása (csak a termelő hívhatja)
+     * @return false, ha a puffer tele van (az elem eldobásra kerül)
+     */
+    bool push(const T &item) {
+        uint8_t head = this->head.load(std::memory_order_relaxed);
+        uint8_t next = (head + 1) & (N - 1);
+        if (next == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        buffer[head] = item;
+        this->head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Elem kivétele (csak a fogyasztó hívhatja)
+     * @return false, ha a puffer üres
+     */
+    bool pop(T &item) {
+        uint8_t tail = this->tail.load(std::memory_order_relaxed);
+        if (tail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = buffer[tail];
+        this->tail.store((tail + 1) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Üres-e a puffer (a fogyasztó oldaláról nézve)
+     */
+    bool isEmpty() const { return tail.load(std::memory_order_relaxed) == head.load(std::memory_order_acquire); }
+
+  private:
+    T buffer[N];
+    std::atomic<uint8_t> head{0};
+    std::atomic<uint8_t> tail{0};
+};
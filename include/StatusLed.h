@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <hardware/pio.h>
+#include <pico/time.h>
+
+/**
+ * @brief PIO vezérelt WS2812 státusz LED (Pico Zero belső RGB LED) önállóan futó mintákkal
+ *
+ * A bitfolyamot egy PIO állapotgép adja ki (800kHz, a CPU-tól független időzítéssel), a mintákat (szín + időtartam lépések)
+ * egy hardveres alarm lépteti a Core0-n. Egy lépés csak egy szót ír a PIO FIFO-ba: nincs megszakítás tiltás,
+ * így a GPS UART vétel sem sérülhet, és a minta kiválasztása (setPattern) a hívó magnak csak egy atomi írás.
+ * Az új minta a futó lépés végén lép életbe.
+ */
+class StatusLed {
+
+  public:
+    /**
+     * @brief A megjeleníthető minták
+     */
+    enum class Pattern : uint8_t {
+        Off,             // Kikapcsolva
+        NoFix,           // Van NMEA adat, de nincs fix: rövid piros villanás 2 mp-enként
+        FixAuto,         // 2D/3D fix: rövid zöld villanás másodpercenként
+        FixDifferential, // Differenciális fix: rövid cián villanás másodpercenként
+        FixEstimated,    // Becsült (dead reckoning) fix: rövid sárga villanás másodpercenként
+        ErrorCode,       // Hibakód: N piros villanás, utána szünet
+    };
+
+    /**
+     * @brief Egy minta lépés
+     */
+    struct Step {
+        uint32_t rgb; // 0xRRGGBB
+        uint16_t durationMs;
+    };
+
+    static constexpr uint8_t BRIGHTNESS = 10;    // Fényerő (0-255)
+    static constexpr uint8_t MAX_ERROR_CODE = 9; // Legfeljebb ennyi villanás még megszámolható
+
+    /**
+     * Konstruktor
+     * @param pin A WS2812 adatláb
+     */
+    explicit StatusLed(uint8_t pin) : pin(pin) {}
+
+    /**
+     * @brief PIO program betöltése, állapotgép és alarm indítása (Core0, a lépések megszakítása ezen a magon fut)
+     */
+    void begin();
+
+    /**
+     * @brief Minta kiválasztása (bármelyik magról hívható, a futó lépés végén lép életbe)
+     */
+    void setPattern(Pattern pattern) { request.store(encode(pattern, 0), std::memory_order_relaxed); }
+
+    /**
+     * @brief Hibakód villogtatása (1..MAX_ERROR_CODE piros villanás, majd szünet, ismétlődve)
+     */
+    void showErrorCode(uint8_t code) { request.store(encode(Pattern::ErrorCode, constrain(code, 1, MAX_ERROR_CODE)), std::memory_order_relaxed); }
+
+  private:
+    uint8_t pin;
+    PIO pio = nullptr;
+    uint sm = 0;
+
+    std::atomic<uint16_t> request{0}; // A kért minta (alsó bájt) és hibakód (felső bájt)
+    uint16_t current = 0;             // Az éppen játszott minta
+    uint8_t stepIndex = 0;
+    uint32_t shownRgb = UINT32_MAX; // Az utoljára kiküldött szín (csak változáskor írunk a FIFO-ba)
+
+    static constexpr uint16_t encode(Pattern pattern, uint8_t errorCode) { return static_cast<uint8_t>(pattern) | (errorCode << 8); }
+
+    /**
+     * @brief Az alarm megszakítás: a következő lépés kiírása
+     * @return A következő lépésig hátralévő idő µs-ban (az alarm újraütemezése)
+     */
+    static int64_t onAlarm(alarm_id_t id, void *userData);
+
+    /**
+     * @brief A minta következő lépése (a minta váltását is itt vesszük át)
+     */
+    Step nextStep();
+
+    /**
+     * @brief Egy szín kiküldése a LED-re (fényerő skálázással, GRB sorrendben)
+     */
+    void show(uint32_t rgb);
+};
+
+extern StatusLed statusLed;
@@ -3,15 +3,15 @@
 
 #include <Arduino.h>
 
-#include "StoreEepromBase.h"
+#include "StoreJournalBase.h"
 #include "defines.h"
-#include "utils.h"
+#include "Utils.h"
 
 /**
- * @brief Generikus wrapper alaposztály EEPROM kezeléshez
+ * @brief Generikus wrapper alaposztály a perzisztens tároláshoz (flash napló)
  *
  * Automatikus CRC ellenőrzéssel és mentéssel rendelkezik.
- * A leszármazott osztályok egyszerűen implementálhatják az EEPROM
+ * A leszármazott osztályok egyszerűen implementálhatják a tárolási
  * funkcionalitást.
  *
  * @tparam T A tárolandó struktúra típusa
@@ -48,26 +48,31 @@ template <typename T> class StoreBase {
     virtual const char *getClassName() const = 0;
 
     /**
-     * @brief EEPROM mentés végrehajtása
+     * @brief Mentés végrehajtása (csak a változások kerülnek a naplóba)
      *
-     * A leszármazott felülírhatja a megfelelő cím megadásához.
+     * A leszármazott felülírhatja (pl. debug kiíratáshoz).
      *
      * @return uint16_t Mentett adatok CRC-je (0 ha sikertelen)
      */
-    virtual uint16_t performSave() { return StoreEepromBase<T>::save(getData(), 0, getClassName()); }
+    virtual uint16_t performSave() { return StoreJournalBase<T>::save(getData(), getClassName()); }
 
     /**
-     * @brief EEPROM betöltés végrehajtása
+     * @brief Betöltés végrehajtása
      *
-     * A leszármazott felülírhatja a megfelelő cím megadásához.
+     * A leszármazott felülírhatja (pl. debug kiíratáshoz).
      *
      * @return uint16_t Betöltött adatok CRC-je
      */
-    virtual uint16_t performLoad() { return StoreEepromBase<T>::load(getData(), 0, getClassName()); }
+    virtual uint16_t performLoad() { return StoreJournalBase<T>::load(getData(), getClassName()); }
+
+    /**
+     * @brief FlashWriteService feladat: a függő mentés végrehajtása
+     */
+    static void flushJob(void *context) { static_cast<StoreBase<T> *>(context)->flushSave(); }
 
   public:
     /**
-     * @brief Kényszerített mentés EEPROM-ba
+     * @brief Kényszerített mentés
      *
      * Feltétel nélkül elmenti az adatokat és frissíti a CRC-t.
      */
@@ -80,7 +85,7 @@ template <typename T> class StoreBase {
     }
 
     /**
-     * @brief Adatok betöltése EEPROM-ból
+     * @brief Adatok betöltése
      *
      * Ha az adatok érvénytelenek, alapértékek mentése történik.
      */
@@ -99,15 +104,26 @@ template <typename T> class StoreBase {
      * @brief Automatikus mentés CRC ellenőrzés alapján
      *
      * Összehasonlítja a jelenlegi adatok CRC-jét az utoljára mentett értékkel.
-     * Ha különböznek, automatikusan menti az adatokat.
+     * Ha különböznek, a mentést a FlashWriteService-nél kéri: az a következő biztonságos ponton fut (flushSave()).
      */
     virtual void checkSave() {
+        if (needsSave()) {
+            flashWriteService.request(flushJob, this);
+        }
+    }
+
+    /**
+     * @brief A függő mentés végrehajtása (a FlashWriteService hívja a biztonságos ponton)
+     *
+     * Ha az adatok CRC-je eltér az utoljára mentettől, elmenti az adatokat.
+     */
+    virtual void flushSave() {
         DEBUG("[%s] CRC ellenőrzés a mentéshez\n", getClassName());
 
         uint16_t currentCrc = Utils::calcCRC16(reinterpret_cast<const uint8_t *>(&getData()), sizeof(T));
 
         if (lastCRC != currentCrc) {
-            DEBUG("[%s] CRC eltérés (RAM: %d != EEPROM: %d). Mentés...\n", getClassName(), currentCrc, lastCRC);
+            DEBUG("[%s] CRC eltérés (RAM: %d != Flash: %d). Mentés...\n", getClassName(), currentCrc, lastCRC);
 
             uint16_t savedCrc = performSave();
             DEBUG("[%s] Mentés OK\n", getClassName());
@@ -4,7 +4,7 @@
 #include <EEPROM.h>
 
 #include "defines.h"
-#include "utils.h"
+#include "Utils.h"
 
 #ifndef EEPROM_SIZE
 #define EEPROM_SIZE 4096 // 4K méret a Pico-n (LittleFS után a flash végén)
@@ -100,7 +100,7 @@ template <typename T> class StoreEepromBase {
      */
     static uint16_t getIfValid(T &data, bool &valid, uint16_t address = 0, const char *className = "Ismeretlen") {
         T tempData;
-        uint16_t storedCrc;
+        uint16_t storedCrc = 0;
 
         // Adatok és CRC beolvasása
         EEPROM.get(address, tempData);
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <Arduino.h>
+#include <algorithm>
+#include <hardware/flash.h>
+#include <stddef.h>
+
+#include "FlashWriteService.h"
+#include "StoreEepromBase.h"
+#include "Utils.h"
+#include "defines.h"
+
+// Raspberry Pi Pico flash memória térképe a naplóval:
+// 0x10000000 - 0x100fb000: Sketch terület (~1MB - 16KB)
+// 0x100fb000 - 0x100ff000: Konfig napló (4 x 4KB szektor, közvetlenül a LittleFS előtt; a journal_guard.py linkeléskor ellenőrzi)
+// 0x100ff000 - 0x101ff000: LittleFS terület (1MB)
+// 0x101ff000 - 0x10200000: Régi EEPROM terület (csak az egyszeri átköltöztetéshez olvassuk)
+#define JOURNAL_SECTOR_COUNT 4
+
+extern "C" uint8_t _FS_start;          // arduino-pico linker szimbólum: a LittleFS terület kezdete
+extern "C" uint8_t __flash_binary_end; // pico-sdk linker szimbólum: a program vége a flash-ben
+
+/**
+ * @brief Kopáskiegyenlítő, naplózó flash tár struktúrák tárolásához
+ *
+ * Az EEPROM emuláció minden commit-nál a teljes 4KB-os szektort törli és újraírja. Itt a mentés csak a legutóbb mentett
+ * képhez képest megváltozott bájt szakaszokat fűzi a napló végére kis, CRC16-tal keretezett rekordokként
+ * ([offset][hossz][adat...][CRC16]), ami egy (ritkán két) lap programozása, törlés nélkül.
+ * Ha a szektor megtelt, a tömörítés a következő szektorba egy teljes pillanatképet ír (nagyobb sorszámú fejléccel),
+ * így a törlések körben járják a JOURNAL_SECTOR_COUNT szektort.
+ *
+ * Betöltéskor a legnagyobb sorszámú érvényes szektor rekordjait játsszuk vissza; a megszakadt (áramkimaradás) írás
+ * CRC hibás rekordja lezárja a naplót, és a következő mentés tömörít. A régi EEPROM tartalmat az első indításkor átvesszük.
+ *
+ * @tparam T A tárolandó struktúra típusa
+ */
+template <typename T> class StoreJournalBase {
+  public:
+    /**
+     * @brief A napló terület ellenőrzése
+     *
+     * Ezt egyszer kell meghívni a setup() függvényben.
+     */
+    static void init() {
+        usable = reinterpret_cast<uintptr_t>(&__flash_binary_end) <= XIP_BASE + regionOffset();
+        DEBUG("Konfig napló: %d x %d bájt (offset: 0x%X)%s\n", JOURNAL_SECTOR_COUNT, FLASH_SECTOR_SIZE, regionOffset(), usable ? "" : " - A PROGRAM BELELÓG, NEM HASZNÁLHATÓ!");
+    }
+
+    /**
+     * @brief Adatok betöltése a naplóból
+     *
+     * Ha nincs érvényes napló, a régi EEPROM tartalmat, annak hiányában az alapértelmezett értékeket menti.
+     *
+     * @param data Cél struktúra referencia
+     * @param className Osztálynév a debug üzenetekhez
+     * @return CRC16 ellenőrző összeg
+     */
+    static uint16_t load(T &data, const char *className = "Ismeretlen") {
+        if (usable) {
+            // A legnagyobb sorszámú szektortól visszafelé, amíg egy vissza nem játszható
+            uint32_t sequenceLimit = UINT32_MAX;
+            for (uint8_t attempt = 0; attempt < JOURNAL_SECTOR_COUNT; attempt++) {
+                int8_t sector = findNewestSector(sequenceLimit);
+                if (sector < 0) {
+                    break;
+                }
+                if (replay(sector, data)) {
+                    DEBUG("[%s] Napló betöltés sikeres (szektor: %d, sorszám: %u, foglalt: %d bájt)\n", className, sector, (unsigned)activeSequence, writeOffset);
+                    return Utils::calcCRC16(reinterpret_cast<const uint8_t *>(&data), sizeof(T));
+                }
+                sequenceLimit = readHeader(sector).sequence;
+            }
+        }
+
+        // Nincs érvényes napló: a régi EEPROM tartalom átvétele (az EEPROM puffert csak erre az időre foglaljuk)
+        bool valid = false;
+        EEPROM.begin(EEPROM_SIZE);
+        StoreEepromBase<T>::getIfValid(data, valid, 0, className);
+        EEPROM.end();
+        DEBUG("[%s] Nincs érvényes napló, %s mentése!\n", className, valid ? "az EEPROM tartalom" : "az alapértékek");
+
+        savedValid = false;
+        return save(data, className);
+    }
+
+    /**
+     * @brief A változások hozzáfűzése a naplóhoz
+     *
+     * @param data Mentendő struktúra referencia
+     * @param className Osztálynév a debug üzenetekhez
+     * @return CRC16 ellenőrző összeg (0 ha sikertelen)
+     */
+    static uint16_t save(const T &data, const char *className = "Ismeretlen") {
+        uint16_t crc = Utils::calcCRC16(reinterpret_cast<const uint8_t *>(&data), sizeof(T));
+        if (!usable) {
+            DEBUG("[%s] A konfig napló nem használható, mentés SIKERTELEN!\n", className);
+            return 0;
+        }
+
+        if (!savedValid || needsCompaction) {
+            return compactOrDefer(data, crc, className);
+        }
+
+        // A megváltozott bájt szakaszok rekordjai; a RECORD_OVERHEAD-nél kisebb hézaggal elválasztott szakaszok összevonva
+        uint8_t records[FLASH_PAGE_SIZE];
+        uint16_t length = 0;
+        const uint8_t *current = reinterpret_cast<const uint8_t *>(&data);
+        const uint8_t *previous = reinterpret_cast<const uint8_t *>(&saved);
+        for (uint16_t i = 0; i < sizeof(T);) {
+            if (current[i] == previous[i]) {
+                i++;
+                continue;
+            }
+            uint16_t end = i + 1;
+            for (uint16_t j = end; j < sizeof(T) && j - end < RECORD_OVERHEAD; j++) {
+                if (current[j] != previous[j]) {
+                    end = j + 1;
+                }
+            }
+            uint32_t needed = length + RECORD_OVERHEAD + (end - i);
+            if (needed > sizeof(records)) {
+                return compactOrDefer(data, crc, className); // Szétszórt, sok változás: egy pillanatkép olcsóbb
+            }
+            length += buildRecord(&records[length], i, end - i, current + i);
+            i = end;
+        }
+
+        if (length == 0) {
+            return crc;
+        }
+
+        // Nem fér el az aktív szektorban: tömörítés a következőbe
+        if (writeOffset + length > FLASH_SECTOR_SIZE) {
+            return compactOrDefer(data, crc, className);
+        }
+
+        uint32_t offset = sectorOffset(activeSector) + writeOffset;
+        programBytes(offset, records, length);
+        if (memcmp(flashPointer(offset), records, length) != 0) {
+            DEBUG("[%s] Napló írás hiba, a következő mentés tömörít!\n", className);
+            needsCompaction = true;
+            return 0;
+        }
+
+        DEBUG("[%s] Napló: %d bájt hozzáfűzve (szektor: %d, foglalt: %d bájt, CRC: %d)\n", className, length, activeSector, writeOffset + length, crc);
+        writeOffset += length;
+        saved = data;
+        return crc;
+    }
+
+  private:
+    /**
+     * @brief Szektor fejléc (a szektor elején, HEADER_SIZE-ra kitöltve)
+     */
+    struct SectorHeader {
+        uint32_t magic;
+        uint32_t sequence; // Tömörítésenként nő: a legnagyobb az aktív szektor
+        uint16_t dataSize; // sizeof(T): a struktúra méretének változása érvényteleníti a naplót
+        uint16_t crc;      // A fejléc előző mezőinek CRC16-ja
+    };
+
+    static constexpr uint32_t MAGIC = 0x4A474643;                          // "CFGJ"
+    static constexpr uint16_t HEADER_SIZE = 16;                            // A fejléc helye a szektor elején
+    static constexpr uint8_t RECORD_OVERHEAD = 4;                          // offset + hossz + CRC16
+    static constexpr uint8_t END_MARKER = 0xFF;                            // Törölt flash: a napló vége
+    static constexpr uint16_t SNAPSHOT_SIZE = RECORD_OVERHEAD + sizeof(T); // A teljes pillanatkép rekord
+
+    static_assert(sizeof(SectorHeader) <= HEADER_SIZE, "SectorHeader does not fit");
+    static_assert(sizeof(T) < END_MARKER, "The record offset must not reach the end marker");
+    static_assert(HEADER_SIZE + SNAPSHOT_SIZE <= FLASH_PAGE_SIZE, "The snapshot must fit into the first page");
+
+    static inline bool usable = false;          // A napló terület a program fölött van
+    static inline T saved;                      // Az utoljára mentett kép (ehhez képest keressük a változást)
+    static inline bool savedValid = false;      // A saved tartalma egyezik a flash-sel
+    static inline bool needsCompaction = false; // Sérült rekord / írás hiba: a következő mentés tömörít
+    static inline uint8_t activeSector = 0;
+    static inline uint32_t activeSequence = 0;
+    static inline uint16_t writeOffset = 0; // Az első szabad bájt az aktív szektorban
+
+    /**
+     * @brief A napló terület kezdete (flash offset): a LittleFS előtti JOURNAL_SECTOR_COUNT szektor
+     */
+    static uint32_t regionOffset() { return reinterpret_cast<uintptr_t>(&_FS_start) - XIP_BASE - JOURNAL_SECTOR_COUNT * FLASH_SECTOR_SIZE; }
+
+    static uint32_t sectorOffset(uint8_t sector) { return regionOffset() + sector * FLASH_SECTOR_SIZE; }
+
+    static const uint8_t *flashPointer(uint32_t offset) { return reinterpret_cast<const uint8_t *>(XIP_BASE + offset); }
+
+    static SectorHeader readHeader(uint8_t sector) {
+        SectorHeader header;
+        memcpy(&header, flashPointer(sectorOffset(sector)), sizeof(header));
+        return header;
+    }
+
+    /**
+     * @brief A legnagyobb, sequenceLimit alatti sorszámú érvényes fejlécű szektor (-1 ha nincs)
+     */
+    static int8_t findNewestSector(uint32_t sequenceLimit) {
+        int8_t newest = -1;
+        uint32_t newestSequence = 0;
+        for (uint8_t sector = 0; sector < JOURNAL_SECTOR_COUNT; sector++) {
+            SectorHeader header = readHeader(sector);
+            if (header.magic != MAGIC || header.dataSize != sizeof(T) || header.sequence >= sequenceLimit ||
+                header.crc != Utils::calcCRC16(reinterpret_cast<const uint8_t *>(&header), offsetof(SectorHeader, crc))) {
+                continue;
+            }
+            if (newest < 0 || header.sequence > newestSequence) {
+                newest = sector;
+                newestSequence = header.sequence;
+            }
+        }
+        return newest;
+    }
+
+    /**
+     * @brief A szektor rekordjainak visszajátszása (az első rekordnak teljes pillanatképnek kell lennie)
+     */
+    static bool replay(uint8_t sector, T &data) {
+        const uint8_t *base = flashPointer(sectorOffset(sector));
+        T replayed;
+        bool haveSnapshot = false;
+        bool damaged = false;
+
+        uint32_t position = HEADER_SIZE;
+        while (position + RECORD_OVERHEAD <= FLASH_SECTOR_SIZE && base[position] != END_MARKER) {
+            uint32_t offset = base[position];
+            uint32_t length = base[position + 1];
+            if (length == 0 || offset + length > sizeof(T) || position + RECORD_OVERHEAD + length > FLASH_SECTOR_SIZE) {
+                damaged = true;
+                break;
+            }
+            uint16_t storedCrc = base[position + 2 + length] | (base[position + 3 + length] << 8);
+            if (storedCrc != Utils::calcCRC16(base + position, 2 + length)) {
+                damaged = true; // Megszakadt írás: a napló itt véget ér
+                break;
+            }
+            if (!haveSnapshot && (offset != 0 || length != sizeof(T))) {
+                return false;
+            }
+            memcpy(reinterpret_cast<uint8_t *>(&replayed) + offset, base + position + 2, length);
+            haveSnapshot = true;
+            position += RECORD_OVERHEAD + length;
+        }
+        if (!haveSnapshot) {
+            return false;
+        }
+
+        data = replayed;
+        saved = replayed;
+        savedValid = true;
+        needsCompaction = damaged;
+        activeSector = sector;
+        activeSequence = readHeader(sector).sequence;
+        writeOffset = position;
+        return true;
+    }
+
+    /**
+     * @brief Egy rekord összeállítása
+     * @return A rekord hossza
+     */
+    static uint16_t buildRecord(uint8_t *record, uint8_t offset, uint8_t length, const uint8_t *bytes) {
+        record[0] = offset;
+        record[1] = length;
+        memcpy(&record[2], bytes, length);
+        uint16_t crc = Utils::calcCRC16(record, 2 + length);
+        record[2 + length] = crc & 0xFF;
+        record[3 + length] = crc >> 8;
+        return RECORD_OVERHEAD + length;
+    }
+
+    /**
+     * @brief Tömörítés, ha most törölhetünk; különben a FlashWriteService a feladatot a GPS csendes szakaszára halasztja
+     * @return A mentett adat CRC-je (0: sikertelen vagy halasztva)
+     */
+    static uint16_t compactOrDefer(const T &data, uint16_t crc, const char *className) {
+        if (!flashWriteService.mayErase()) {
+            DEBUG("[%s] Napló tömörítés a GPS csendes szakaszára halasztva\n", className);
+            flashWriteService.deferToEraseWindow();
+            return 0;
+        }
+        return compact(data, className) ? crc : 0;
+    }
+
+    /**
+     * @brief Tömörítés: a következő szektor törlése, majd fejléc + teljes pillanatkép egy lap programozással
+     */
+    static bool compact(const T &data, const char *className) {
+        // A következő szektor; ha nincs visszajátszott napló, a legújabb (akár sérült) szektor utáni
+        if (!savedValid) {
+            int8_t newest = findNewestSector(UINT32_MAX);
+            activeSector = newest < 0 ? JOURNAL_SECTOR_COUNT - 1 : newest;
+            activeSequence = newest < 0 ? 0 : readHeader(newest).sequence;
+        }
+        uint8_t sector = (activeSector + 1) % JOURNAL_SECTOR_COUNT;
+        uint32_t sequence = activeSequence + 1;
+
+        uint8_t page[HEADER_SIZE + SNAPSHOT_SIZE];
+        memset(page, 0xFF, sizeof(page));
+        SectorHeader header = {MAGIC, sequence, sizeof(T), 0};
+        header.crc = Utils::calcCRC16(reinterpret_cast<const uint8_t *>(&header), offsetof(SectorHeader, crc));
+        memcpy(page, &header, sizeof(header));
+        buildRecord(&page[HEADER_SIZE], 0, sizeof(T), reinterpret_cast<const uint8_t *>(&data));
+
+        uint32_t offset = sectorOffset(sector);
+        eraseSector(offset);
+        programBytes(offset, page, sizeof(page));
+        if (memcmp(flashPointer(offset), page, sizeof(page)) != 0) {
+            DEBUG("[%s] Napló tömörítés SIKERTELEN (szektor: %d)!\n", className, sector);
+            needsCompaction = true;
+            return false;
+        }
+
+        DEBUG("[%s] Napló tömörítve -> szektor: %d, sorszám: %u\n", className, sector, (unsigned)sequence);
+        activeSector = sector;
+        activeSequence = sequence;
+        writeOffset = sizeof(page);
+        saved = data;
+        savedValid = true;
+        needsCompaction = false;
+        return true;
+    }
+
+    /**
+     * @brief Egy szektor törlése (a FlashWriteService végzi: a másik mag áll, a leállás mérve)
+     */
+    static void eraseSector(uint32_t offset) { flashWriteService.eraseSector(offset); }
+
+    /**
+     * @brief Bájtok programozása tetszőleges címre: az érintett lapokat a meglévő tartalommal együtt programozzuk
+     * (a még törölt 0xFF bájtok a lapon változatlanok maradnak)
+     */
+    static void programBytes(uint32_t offset, const uint8_t *bytes, uint16_t length) {
+        uint8_t page[FLASH_PAGE_SIZE];
+        while (length > 0) {
+            uint32_t pageOffset = offset & ~(FLASH_PAGE_SIZE - 1);
+            uint16_t inPage = offset - pageOffset;
+            uint16_t chunk = std::min<uint16_t>(length, FLASH_PAGE_SIZE - inPage);
+
+            memcpy(page, flashPointer(pageOffset), FLASH_PAGE_SIZE);
+            memcpy(&page[inPage], bytes, chunk);
+
+            flashWriteService.programPage(pageOffset, page);
+
+            offset += chunk;
+            bytes += chunk;
+            length -= chunk;
+        }
+    }
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include <pico/time.h>
+
+/**
+ * @brief Kooperatív, határidő alapú feladatütemező egy maghoz
+ *
+ * Magonként egy példány van (core0Scheduler, core1Scheduler), a mag loop()-ja csak a run()-t hívja.
+ * - periodikus feladat: a saját periódusával fut, a határidők a 64 bites µs időalaphoz rögzítettek (nincs elcsúszás)
+ * - esemény feladat: csak signal() után fut; bármelyik magról jelezhető
+ * - a periodikus feladat is jelezhető, ilyenkor a periódus lejárta előtt, a következő körben fut
+ *
+ * Ha nincs esedékes feladat, a mag __wfe-vel alszik a legközelebbi határidőig, vagy amíg egy megszakítás
+ * (pl. UART adat) vagy a másik mag __sev()-je fel nem ébreszti. Méri a feladatok futásidejét és a mag üresjárati arányát.
+ */
+class TaskScheduler {
+
+  public:
+    using TaskFunction = std::function<void()>;
+
+    static constexpr uint8_t MAX_TASKS = 10;
+    static constexpr uint8_t INVALID_TASK = 0xFF;
+    static constexpr uint32_t IDLE_WINDOW_MICROS = 1000000; // Az üresjárati arány mérési ablaka
+
+    /**
+     * @brief Egy feladat futási statisztikája
+     */
+    struct TaskStats {
+        const char *name = nullptr;
+        uint32_t periodMs = 0;    // 0: esemény feladat
+        uint32_t runCount = 0;    // Futások száma
+        uint64_t totalMicros = 0; // Összes futásidő
+        uint32_t maxMicros = 0;   // Leghosszabb futás
+    };
+
+    /**
+     * Konstruktor
+     * @param name Az ütemező neve (debug kiíratáshoz)
+     */
+    explicit TaskScheduler(const char *name) : name(name) {}
+
+    /**
+     * @brief Monoton 64 bites időalap µs-ban (nem csordul túl, mindkét magon azonos)
+     */
+    static uint64_t nowMicros() { return time_us_64(); }
+
+    /**
+     * @brief Periodikus feladat regisztrálása (a setup-ban, a saját magon)
+     * @param name A feladat neve (statikus szöveg)
+     * @param periodMs A futás periódusa
+     * @param function A futtatandó függvény
+     * @return A feladat azonosítója (INVALID_TASK, ha betelt a tábla)
+     */
+    uint8_t addPeriodicTask(const char *name, uint32_t periodMs, TaskFunction function);
+
+    /**
+     * @brief Esemény feladat regisztrálása: csak signal() után fut
+     * @return A feladat azonosítója (INVALID_TASK, ha betelt a tábla)
+     */
+    uint8_t addEventTask(const char *name, TaskFunction function);
+
+    /**
+     * @brief A feladat futtatásának kérése a következő körben (bármelyik magról hívható)
+     */
+    void signal(uint8_t taskId);
+
+    /**
+     * @brief Az esedékes feladatok futtatása, majd alvás a következő határidőig (a mag loop()-ja hívja)
+     */
+    void run();
+
+    /**
+     * @brief A regisztrált feladatok száma
+     */
+    uint8_t getTaskCount() const { return taskCount; }
+
+    /**
+     * @brief Egy feladat statisztikája (a másik magról olvasva csak tájékoztató jellegű)
+     */
+    const TaskStats &getTaskStats(uint8_t taskId) const { return tasks[taskId].stats; }
+
+    /**
+     * @brief Az utolsó mérési ablak üresjárati aránya százalékban
+     */
+    uint8_t getIdlePercent() const { return idlePercent; }
+
+    /**
+     * @brief Statisztikák nullázása (a következő run() hajtja végre a saját magján)
+     */
+    void resetStats() { resetRequested = true; }
+
+    /**
+     * @brief Statisztikák kiírása a debug soros portra
+     */
+    void dump() const;
+
+  private:
+    /**
+     * @brief Egy regisztrált feladat
+     */
+    struct Task {
+        TaskFunction function;
+        uint64_t nextRunMicros = 0; // Periodikus feladat következő határideje
+        std::atomic<bool> signalled{false};
+        TaskStats stats;
+    };
+
+    const char *name;
+    Task tasks[MAX_TASKS];
+    uint8_t taskCount = 0;
+
+    // Üresjárat mérés (csak a saját mag írja)
+    uint64_t windowStartMicros = 0;
+    uint64_t windowIdleMicros = 0;
+    volatile uint8_t idlePercent = 0;
+    volatile bool resetRequested = false;
+
+    /**
+     * @brief Feladat felvétele a táblába
+     */
+    uint8_t addTask(const char *name, uint32_t periodMs, TaskFunction function);
+
+    /**
+     * @brief Egy feladat futtatása és mérése
+     * @return A futás utáni időpont
+     */
+    uint64_t runTask(Task &task, uint64_t now);
+
+    /**
+     * @brief A mérési ablak lezárása, az üresjárati arány frissítése
+     */
+    void updateIdleWindow(uint64_t now);
+};
+
+// Magonkénti ütemezők (main.cpp)
+extern TaskScheduler core0Scheduler;
+extern TaskScheduler core1Scheduler;
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <Arduino.h>
+#include <atomic>
+#include <pico/time.h>
 
+#include "AdcSampler.h"
+#include "Config.h"
 #include "defines.h"
 #include "pins.h"
 
@@ -12,31 +16,73 @@
 #define SENSOR_VALUE_NIGHT 350  // Éjszakai fény érzékelő érték
 #define SENSOR_VALUE_DAILY 1000 // Nappali fény érzékelő érték
 
-#define LED_ADJUST_MSEC 20    // LED fényerő állítási idő
-#define SENSOR_CHECK_MSEC 200 // Fényérzékelő ellenőrzési idő
+#define SENSOR_VALUE_NIGHT_THEME_HYSTERESIS 50 // Ennyivel SENSOR_VALUE_NIGHT fölé kell menni a nappali témához való visszaváltáshoz
+#define SENSOR_VALUE_TARGET_HYSTERESIS 24      // Ennyit kell változnia a szűrt érzékelő értéknek az új cél fényerőhöz
+#define SENSOR_FILTER_SHIFT 2                  // Az érzékelő IIR szűrő együtthatója (1/4)
+
+#define SENSOR_CHECK_MSEC 200      // Fényérzékelő ellenőrzési idő (az updateTarget() hívási periódusa)
+#define BACKLIGHT_FADE_STEP_MSEC 4 // Az átmenet egy lépésének ideje (hardver alarm)
+#define BACKLIGHT_FADE_MSEC 1000   // A teljes (min -> max) átmenet ideje
+#define BACKLIGHT_PWM_FREQ 25000   // PWM frekvencia (hallható tartomány fölött)
+#define BACKLIGHT_PWM_WRAP 4095    // PWM felbontás: 12 bit
+#define BACKLIGHT_GAMMA 2.2f       // A fényerő skála gamma korrekciója
 
 /**
  * TFT háttérvilágítás állító osztály.
+ *
+ * A fényerő (NIGHTLY_BRIGHTNESS..255) észlelt (perceptuális) skálán értendő: a két végpont kitöltése a korábbi lineáris
+ * skáláé maradt, közöttük a 12 bites PWM kitöltés gamma görbén halad.
+ * Az átmeneteket egy hardver alarm lépteti (BACKLIGHT_FADE_STEP_MSEC-enként, a Core0 alarm pool-jában), az 1/256 fényerő
+ * lépések között a gamma táblából interpolálva, így az átmenet sima és független a Core1 ütemezésétől.
+ * A cél fényerőt és az azonnali ugrást egy-egy atomi írás kéri, bármelyik magról.
  */
 class TftBackLightAdjuster {
 
   private:
-    uint8_t _backlightLevel;
-    uint32_t lastSensorCheckMsec;
-    uint32_t lastAdjustMsec;
-    byte brightness;
-    byte new_brightness;
     bool _tftAutoBrightnessActive;
     uint8_t _manualBrightnessValue;
+    volatile bool _nightTheme; // Core1 írja, Core0 olvassa
+
+    // Az érzékelő szűrése (Core1)
+    int32_t _filteredSensorValue = -1; // IIR szűrt érzékelő érték (-1: még nincs)
+    int32_t _targetSensorValue = -1;   // Az érzékelő érték, amiből az aktuális cél fényerő számolódott
+
+    // Átmenet: a kért cél (alsó 16 bit: fényerő * 256) és az azonnali ugrás sorszáma (felső 16 bit)
+    std::atomic<uint32_t> _request{(uint32_t)DEFAULT_BRIGHTNESS << 8};
+    uint16_t _currentLevel = DEFAULT_BRIGHTNESS << 8; // Az alarm által kiadott fényerő (fényerő * 256)
+    uint16_t _jumpSequence = 0;                       // Az alarm által utoljára látott ugrás sorszám
+
+    uint16_t _gammaTable[256]; // Fényerő -> PWM kitöltés
+    uint _slice = 0;
+    uint _channel = 0;
+    bool _started = false;
 
     // Config callback id a leiratkozáshoz
-    size_t configCallbackId;
+    size_t configCallbackId = Config::INVALID_CALLBACK_ID;
+
+    /**
+     * @brief Cél fényerő kérése (az alarm BACKLIGHT_FADE_MSEC alatti teljes skálájú sebességgel közelít)
+     */
+    void fadeTo(uint8_t level) {
+        uint32_t request = _request.load(std::memory_order_relaxed);
+        _request.store((request & 0xFFFF0000) | ((uint32_t)level << 8), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Az átmenet alarm megszakítása
+     */
+    static int64_t onFadeAlarm(alarm_id_t id, void *userData);
+
+    /**
+     * @brief A (fényerő * 256) szint kiírása a PWM-re gamma korrekcióval
+     */
+    void writeLevel(uint16_t level);
 
   public:
     /**
      * Konstruktor.
      */
-    TftBackLightAdjuster() : lastSensorCheckMsec(0), lastAdjustMsec(0), brightness(DEFAULT_BRIGHTNESS), new_brightness(0) {}
+    TftBackLightAdjuster() : _nightTheme(false) {}
 
     /**
      * Destruktor.
@@ -44,36 +90,45 @@ class TftBackLightAdjuster {
     ~TftBackLightAdjuster();
 
     /**
-     * Inicializálja a háttérvilágítást.
+     * Inicializálja a háttérvilágítást (Core0, az átmenet alarm ezen a magon fut).
      */
     void begin();
 
     /**
-     * @brief Callback függvény, amit a Config hív meg változás esetén
+     * @brief Callback függvény, amit a Config hív meg változás esetén (Core1-en fut, a háttérvilágítást a Core1 loop kezeli)
+     * @param changed A megváltozott figyelt mezők (ConfigField bitek)
      */
-    void onConfigChanged();
+    void onConfigChanged(ConfigFieldMask changed);
 
     /**
-     * Beállítja a háttérvilágítás szintjét.
+     * Beállítja a háttérvilágítás szintjét (azonnal, átmenet nélkül; bármelyik magról hívható).
      */
     void setBacklightLevel(uint8_t level) {
-        _backlightLevel = constrain(level, NIGHTLY_BRIGHTNESS, TFT_BACKGROUND_LED_MAX_BRIGHTNESS);
-        analogWrite(PIN_TFT_BACKGROUND_LED, _backlightLevel);
-        brightness = _backlightLevel; // Az aktuális fényerő is erre álljon
+        level = constrain(level, NIGHTLY_BRIGHTNESS, TFT_BACKGROUND_LED_MAX_BRIGHTNESS);
+        uint32_t request = _request.load(std::memory_order_relaxed);
+        _request.store(((request + 0x10000) & 0xFFFF0000) | ((uint32_t)level << 8), std::memory_order_relaxed);
     }
 
     /**
-     * Visszaadja a háttérvilágítás szintjét.
+     * Visszaadja a háttérvilágítás (cél) szintjét.
+     */
+    uint8_t getBacklightLevel() const { return (_request.load(std::memory_order_relaxed) & 0xFFFF) >> 8; }
+
+    /**
+     * Fényérzékelő értékének lekérdezése (az AdcSampler szűrt értéke 12 bites skálán, a SENSOR_VALUE_* küszöbökhöz).
      */
-    uint8_t getBacklightLevel() const { return _backlightLevel; }
+    uint16_t getSensorValue() const { return adcSampler.getRaw(AdcSampler::Channel::LightSensor) >> 4; }
 
     /**
-     * Fényérzékelő értékének lekérdezése.
+     * Éjszakai téma aktív-e?
+     * Automata fényerő módban igaz, ha a fényérzékelő SENSOR_VALUE_NIGHT alá esett (hiszterézissel).
+     * Manuális módban mindig a nappali téma az aktív.
      */
-    uint16_t getSensorValue() const { return analogRead(PIN_LIGHT_SENSOR); }
+    bool isNightTheme() const { return _nightTheme; }
 
     /**
-     * Állítgatja a háttérvilágítást a környezeti fényviszonyoknak megfelelően.
+     * A cél fényerő frissítése a környezeti fényviszonyok (vagy a kézi beállítás) alapján, az átmenetet az alarm végzi.
+     * SENSOR_CHECK_MSEC-enként hívandó.
      */
-    void loop(void);
-};
\ No newline at end of file
+    void updateTarget();
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+#include "SpscQueue.h"
+#include "UIComponent.h"
+
+/**
+ * @brief Megszakítás vezérelt érintés mintavételező az XPT2046-hoz
+ *
+ * Az érintésvezérlő a közös SPI buszon van a kijelzővel, ezért csak akkor olvassuk, ha a panel tényleg le van nyomva:
+ * - a PENIRQ (T_IRQ) lefutó éle megszakítást kér, ami rögzíti az érintés időpontját és azonnal felébreszti a "touch" feladatot
+ * - elengedett állapotban a periodikus futás csak a PENIRQ lábat nézi, SPI forgalom nincs
+ * - lenyomva: MEDIAN_SAMPLES nyers mintából medián (a tüskék ellen), utána IIR szűrés (a remegés ellen)
+ * - lenyomás / felengedés pergésmentesítve: PRESS_DEBOUNCE_SAMPLES ill. RELEASE_DEBOUNCE_SAMPLES egymást követő mintára dönt
+ *
+ * A TouchEvent-ek egy sorba kerülnek, amit a ScreenManager loop()-ja ürít ki. A lenyomás eseménye hordozza a PENIRQ él
+ * időpontját, így az érintéstől a visszajelzésig tartó késleltetés a LatencyProbe-bal mérhető.
+ */
+class TouchSampler {
+
+  public:
+    static constexpr uint8_t MEDIAN_SAMPLES = 5;           // Nyers minták egy méréshez (páratlan)
+    static constexpr uint16_t Z_THRESHOLD = 600;           // Min. nyomás (a TFT_eSPI getTouch() alapértéke)
+    static constexpr uint8_t IIR_SHIFT = 2;                // IIR súly: 1/4 az új mintának
+    static constexpr uint8_t PRESS_DEBOUNCE_SAMPLES = 2;   // Ennyi érvényes minta után lenyomás
+    static constexpr uint8_t RELEASE_DEBOUNCE_SAMPLES = 2; // Ennyi érvénytelen minta után felengedés
+
+    /**
+     * Konstruktor
+     * @param tft A kijelző (az érintésvezérlő is rajta keresztül érhető el)
+     */
+    explicit TouchSampler(TFT_eSPI &tft) : tft(tft) {}
+
+    /**
+     * @brief PENIRQ láb és megszakítás beállítása (Core0)
+     * @param sampleTaskId A mintavételező Core0 feladat (a megszakítás ezt ébreszti)
+     */
+    void begin(uint8_t sampleTaskId);
+
+    /**
+     * @brief Egy mintavételi lépés (a Core0 "touch" feladata: periodikusan és a PENIRQ élére)
+     */
+    void sample();
+
+    /**
+     * @brief A következő érintés esemény kivétele (a ScreenManager hívja)
+     * @return false, ha nincs függő esemény
+     */
+    bool popEvent(TouchEvent &event) { return eventQueue.pop(event); }
+
+  private:
+    static TouchSampler *instance; // A megszakítás kezelőnek
+
+    TFT_eSPI &tft;
+    uint8_t sampleTaskId = 0xFF;
+
+    volatile uint32_t penIrqMicros = 0; // Az utolsó PENIRQ él (0: nincs)
+
+    // A megszakítás is olvassa
+    volatile bool pressed = false;   // A pergésmentesített állapot
+    volatile uint8_t validCount = 0; // Egymást követő érvényes minták (lenyomás előtt)
+
+    uint8_t invalidCount = 0; // Egymást követő érvénytelen minták (lenyomva)
+    int32_t filteredX = 0;    // IIR kimenet, 4 bit törtrésszel
+    int32_t filteredY = 0;
+
+    SpscQueue<TouchEvent, 8> eventQueue;
+
+    /**
+     * @brief A PENIRQ megszakítás kezelője
+     */
+    static void onPenIrq();
+
+    /**
+     * @brief Le van-e nyomva a panel (a PENIRQ alacsony)
+     */
+    static bool isPenDown();
+
+    /**
+     * @brief Szűrt, kalibrált koordináta olvasása (SPI)
+     * @return false, ha a nyomás kicsi vagy a koordináta a képernyőn kívül esik
+     */
+    bool readFiltered(uint16_t &x, uint16_t &y);
+
+    /**
+     * @brief Az esemény beírása a sorba és a képernyőkezelő felébresztése
+     */
+    void publish(const TouchEvent &event);
+};
+
+extern TouchSampler touchSampler;
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "ConfigData.h"
+#include "SpscQueue.h"
+#include "TraffipaxManager.h"
+
+/**
+ * @brief A traffipax riasztás kiértékelésének eredménye (Core1 -> Core0)
+ */
+struct TraffipaxAlertEvent {
+    /**
+     * @brief Riasztási állapot
+     * - INACTIVE: Nincs közeli traffipax
+     * - APPROACHING: Közeledik (piros sáv + szirénázás)
+     * - NEARBY_STOPPED: Megállt közel (piros sáv, nincs szirénázás)
+     * - DEPARTING: Távolodik (narancssárga sáv, nincs szirénázás)
+     */
+    enum State : uint8_t { INACTIVE, APPROACHING, NEARBY_STOPPED, DEPARTING };
+
+    /**
+     * @brief Sziréna kérés a Core0 felé
+     */
+    enum Siren : uint8_t { SIREN_NONE, SIREN_START, SIREN_STOP };
+
+    const TraffipaxManager::TraffipaxRecord *traffipax = nullptr; // A legközelebbi traffipax (INACTIVE esetén nullptr)
+    float distance = 0.0f;                                        // Távolság méterben
+    State state = INACTIVE;
+    Siren siren = SIREN_NONE;
+    uint32_t timestamp = 0; // millis() a kiértékeléskor (a távolság fixek közötti predikciójához)
+    uint32_t rxMicros = 0;  // A kiértékelt GPS epocha késleltetés mérési t0-ja (0: nem epochához kötött)
+};
+
+/**
+ * @brief Intelligens traffipax figyelmeztető rendszer a Core1-en
+ *
+ * Minden publikált GPS fix epocha után (demó módban másodpercenként) megkeresi a legközelebbi traffipaxot, lépteti a riasztás
+ * állapotgépét, és az eredményt eseményként elküldi a Core0-nak. Így a kamera keresés nem versenyez a rajzolással, és a riasztás
+ * (hanggal együtt) akkor is működik, ha nem a fő képernyő látszik.
+ *
+ * - a riasztási távolságon belül: piros sáv + város/utca + távolság
+ * - közeledés esetén: 10mp-enként szirénázás
+ * - megállás esetén: nincs szirénázás, csak a piros sáv
+ * - távolodás esetén: narancssárga sáv, nincs szirénázás
+ */
+class TraffipaxAlertEvaluator {
+
+  public:
+    /**
+     * Konstruktor
+     */
+    TraffipaxAlertEvaluator();
+
+    /**
+     * Destruktor
+     */
+    ~TraffipaxAlertEvaluator();
+
+    /**
+     * @brief Core1 loop: új fix epocha (vagy watchdog / demó időzítő) esetén kiértékel
+     */
+    void loop();
+
+    /**
+     * @brief A következő riasztás esemény kivétele (Core0 hívja, nem blokkol)
+     * @return false, ha nincs függő esemény
+     */
+    bool popEvent(TraffipaxAlertEvent &event);
+
+    /**
+     * @brief Van-e a Core0 által még ki nem vett esemény (Core1, a Core0 ütemező felébresztéséhez)
+     */
+    bool hasPendingEvents() const { return !eventQueue.isEmpty(); }
+
+    /**
+     * @brief Van-e folyamatban lévő riasztás (csak Core1, pl. a flash írások visszatartásához)
+     */
+    bool isAlertActive() const { return state != TraffipaxAlertEvent::INACTIVE; }
+
+    /**
+     * @brief A Core0 által legutóbb kivett esemény, azaz a riasztás aktuális állapota (csak Core0)
+     */
+    const TraffipaxAlertEvent &getCurrentAlert() const { return currentAlert; }
+
+    /**
+     * @brief Callback függvény, amit a Config hív meg változás esetén (Core1-en fut)
+     * @param changed A megváltozott figyelt mezők (ConfigField bitek)
+     */
+    void onConfigChanged(ConfigFieldMask changed);
+
+  private:
+    static constexpr unsigned long SIREN_INTERVAL = 10000;     // 10 sec szirénázási intervallum
+    static constexpr unsigned long OUT_OF_RANGE_HOLD_MS = 3000; // Ennyi ideig marad a riasztás a távolságon kívül
+
+    // Konfigurációs értékek gyorsítótárazása
+    bool alarmEnabled;
+    bool sirenAlarmEnabled;
+    uint16_t alarmDistance;
+
+    // Állapotgép (csak Core1)
+    TraffipaxAlertEvent::State state = TraffipaxAlertEvent::INACTIVE;
+    const TraffipaxManager::TraffipaxRecord *activeTraffipax = nullptr;
+    double lastDistance = 999999.0;
+    unsigned long lastSirenTime = 0;
+    unsigned long outOfRangeStart = 0;
+    unsigned long lastEvaluation = 0;
+    bool resendPending = false; // Az utolsó esemény nem fért a sorba, a következő kiértékelés újraküldi
+
+    // Demó (csak Core1)
+    unsigned long lastDemoEndTime = 0;
+    bool wasDemoActive = false;
+
+    // Core1 -> Core0 eseménysor
+    SpscQueue<TraffipaxAlertEvent, 8> eventQueue;
+
+    // A Core0 által legutóbb kivett esemény
+    TraffipaxAlertEvent currentAlert;
+
+    // Config callback id a leiratkozáshoz
+    size_t configCallbackId;
+
+    /**
+     * @brief Kiértékelés egy pozícióra
+     * @param rxMicros A GPS epocha késleltetés mérési t0-ja (0: nem epochához kötött)
+     */
+    void evaluate(double lat, double lon, bool positionValid, uint32_t rxMicros);
+
+    /**
+     * @brief A riasztás kikapcsolása (ha aktív volt)
+     */
+    void deactivate(uint32_t rxMicros);
+
+    /**
+     * @brief Eredmény küldése a Core0-nak
+     */
+    void publish(const TraffipaxManager::TraffipaxRecord *traffipax, double distance, TraffipaxAlertEvent::Siren siren, uint32_t rxMicros);
+
+    /**
+     * @brief Demó pozíció léptetése
+     * @return true, ha a demó aktív és a koordináták érvényesek
+     */
+    bool processDemo(double &lat, double &lon);
+};
+
+extern TraffipaxAlertEvaluator *traffipaxAlertEvaluator;
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+#include <new>
+
+#include "defines.h"
+
+/**
+ * @brief Bump allokátor a UI komponensekhez (képernyőnként / dialógusonként egy slab)
+ *
+ * A képernyő (vagy dialógus) objektuma és az összes gyerek komponense, a shared_ptr vezérlő blokkjával együtt,
+ * egy rögzített méretű statikus slab-ből foglalódik: a foglalás egy mutató léptetése. A felszabadítás csak az élő
+ * objektumokat számolja; amikor az utolsó is megszűnik (a képernyő a komponenseivel együtt), a slab egyben kiürül és
+ * újra kiosztható. Így a képernyőváltások és a dialógusok nem aprózzák fel a heap-et.
+ *
+ * Ha a slab betelt, a foglalás a heap-re esik vissza: ezt számoljuk, a méretezéshez a navigációs soak teszt
+ * (ScreenManager::startNavigationSoak()) kiírja a slab-ok csúcs kihasználtságát. Csak a Core0 (UI) használja.
+ */
+class UIArena {
+
+  public:
+    /**
+     * @brief A slab memóriájának beállítása (a pool konstruktora hívja)
+     */
+    void init(uint8_t *slab, uint16_t slabSize) {
+        buffer = slab;
+        capacity = slabSize;
+    }
+
+    /**
+     * @brief Foglalás a slab-ből (ha nem fér bele, a heap-ről)
+     */
+    void *allocate(size_t size, size_t alignment);
+
+    /**
+     * @brief Felszabadítás: a slab-beli objektumot csak leszámolja, a heap-ről foglaltat felszabadítja
+     */
+    void deallocate(void *p);
+
+    /**
+     * @brief Lefoglalás új tulajdonosnak (a pool hívja az objektum létrehozása előtt)
+     */
+    void reserve() { reserved = true; }
+
+    /**
+     * @brief A lefoglalás feloldása: innentől az élő objektumok tartják meg a slab-ot
+     */
+    void release();
+
+    /**
+     * @brief Kiosztható-e (nincs lefoglalva, és nincs benne élő objektum)
+     */
+    bool isIdle() const { return !reserved && liveObjects == 0; }
+
+    uint16_t getCapacity() const { return capacity; }
+    uint16_t getUsed() const { return used; }
+    uint16_t getHighWater() const { return highWater; }
+    uint16_t getLiveObjects() const { return liveObjects; }
+    uint16_t getHeapFallbacks() const { return heapFallbacks; }
+
+    /**
+     * @brief Az éppen létrehozás alatt álló képernyő/dialógus arénája (nullptr: heap)
+     *
+     * A UIContainerComponent konstruktora innen veszi át az arénáját, így a konstruktorban létrehozott gyerek
+     * komponensek is ugyanabba a slab-be kerülnek, a leszármazottak konstruktorainak módosítása nélkül.
+     */
+    static UIArena *getConstructionArena() { return constructionArena; }
+
+    /**
+     * @brief A létrehozás alatti aréna beállítása a scope végéig (egymásba ágyazható)
+     */
+    class Scope {
+      public:
+        Scope(UIArena *arena) : previous(constructionArena) { constructionArena = arena; }
+        ~Scope() { constructionArena = previous; }
+
+      private:
+        UIArena *previous;
+    };
+
+  private:
+    uint8_t *buffer = nullptr;
+    uint16_t capacity = 0;
+    uint16_t used = 0;          // A bump mutató
+    uint16_t highWater = 0;     // A legnagyobb kihasználtság (a slab méretezéséhez)
+    uint16_t liveObjects = 0;   // A slab-ben élő foglalások
+    uint16_t heapFallbacks = 0; // A slab-be nem férő, a heap-re került foglalások
+    bool reserved = false;
+
+    static UIArena *constructionArena;
+};
+
+/**
+ * @brief STL allokátor az arénához (std::allocate_shared-hez), nullptr aréna esetén a heap-ről foglal
+ */
+template <typename T> struct UIArenaAllocator {
+    using value_type = T;
+
+    UIArena *arena;
+
+    UIArenaAllocator(UIArena *arena) : arena(arena) {}
+    template <typename U> UIArenaAllocator(const UIArenaAllocator<U> &other) : arena(other.arena) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(arena ? arena->allocate(n * sizeof(T), alignof(T)) : ::operator new(n * sizeof(T))); }
+
+    void deallocate(T *p, size_t n) {
+        if (arena) {
+            arena->deallocate(p);
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    template <typename U> bool operator==(const UIArenaAllocator<U> &other) const { return arena == other.arena; }
+    template <typename U> bool operator!=(const UIArenaAllocator<U> &other) const { return arena != other.arena; }
+};
+
+/**
+ * @brief Objektum létrehozása az arénában (a vezérlő blokkal együtt egy foglalás)
+ *
+ * A konstruktor futása alatt az aréna a létrehozás alatti aréna, így a konténerek gyerekei is ide kerülnek.
+ */
+template <typename T, typename... Args> std::shared_ptr<T> makeArenaShared(UIArena *arena, Args &&...args) {
+    UIArena::Scope scope(arena);
+    return std::allocate_shared<T>(UIArenaAllocator<T>(arena), std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Rögzített számú, azonos méretű slab (képernyőkhöz, dialógusokhoz)
+ */
+template <uint16_t SLAB_SIZE, uint8_t SLAB_COUNT> class UIArenaPool {
+
+  public:
+    UIArenaPool() {
+        for (uint8_t i = 0; i < SLAB_COUNT; i++) {
+            arenas[i].init(storage[i], SLAB_SIZE);
+        }
+    }
+
+    /**
+     * @brief Objektum (képernyő, dialógus) létrehozása egy szabad slab-ben
+     *
+     * A slab addig marad foglalt, amíg az objektum vagy bármelyik komponense él. Ha nincs szabad slab, a heap-re kerül.
+     */
+    template <typename T, typename... Args> std::shared_ptr<T> make(Args &&...args) {
+        UIArena *arena = acquire();
+        std::shared_ptr<T> object = makeArenaShared<T>(arena, std::forward<Args>(args)...);
+        if (arena) {
+            arena->release();
+        }
+        return object;
+    }
+
+    /**
+     * @brief A slab-ok kihasználtságának kiírása a soros portra
+     */
+    void dump(const char *name) const {
+        for (uint8_t i = 0; i < SLAB_COUNT; i++) {
+            const UIArena &arena = arenas[i];
+            DEBUG("%s[%d]: used %u/%u, high-water %u, live %u, heap fallbacks %u\n", name, i, arena.getUsed(), arena.getCapacity(), arena.getHighWater(), arena.getLiveObjects(), arena.getHeapFallbacks());
+        }
+        DEBUG("%s: no free slab %u times\n", name, exhausted);
+    }
+
+  private:
+    alignas(8) uint8_t storage[SLAB_COUNT][SLAB_SIZE];
+    UIArena arenas[SLAB_COUNT];
+    uint16_t exhausted = 0; // Ennyiszer nem volt szabad slab
+
+    UIArena *acquire() {
+        for (UIArena &arena : arenas) {
+            if (arena.isIdle()) {
+                arena.reserve();
+                return &arena;
+            }
+        }
+        exhausted++;
+        DEBUG("UIArenaPool: no free slab, falling back to heap\n");
+        return nullptr;
+    }
+};
+
+// A képernyők slab-jai: a két gyorsítótárazott (Main, Sats), az aktuális és egy tartalék (a váltás alatt még élő példánynak)
+constexpr uint16_t SCREEN_ARENA_SIZE = 2048;
+constexpr uint8_t SCREEN_ARENA_COUNT = 4;
+
+// A dialógusok slab-jai: ennyi dialógus lehet egymásra nyitva (UIScreen::MAX_DIALOG_DEPTH)
+constexpr uint16_t DIALOG_ARENA_SIZE = 1536;
+constexpr uint8_t DIALOG_ARENA_COUNT = 4;
+
+using ScreenArenaPool = UIArenaPool<SCREEN_ARENA_SIZE, SCREEN_ARENA_COUNT>;
+using DialogArenaPool = UIArenaPool<DIALOG_ARENA_SIZE, DIALOG_ARENA_COUNT>;
+
+extern ScreenArenaPool screenArenaPool;
+extern DialogArenaPool dialogArenaPool;
@@ -125,7 +125,49 @@ class UIColorPalette {
     // ScreenSaver mód színei (kék színséma)
     static constexpr uint16_t FREQ_SCREENSAVER_ACTIVE = TFT_CYAN;                    // Aktív számjegyek színe képernyővédő módban
     static constexpr uint16_t FREQ_SCREENSAVER_INACTIVE = TFT_COLOR(0, 0, 80);       // Inaktív számjegyek színe (sötét kék)
-    static constexpr uint16_t FREQ_SCREENSAVER_INDICATOR = TFT_COLOR(173, 216, 230); // Indikátor elemek színe (világos kék)    // === SEGÉD METÓDUSOK ===
+    static constexpr uint16_t FREQ_SCREENSAVER_INDICATOR = TFT_COLOR(173, 216, 230); // Indikátor elemek színe (világos kék)
+
+    // === 4 BPP PALETTÁS SPRITE-OK (nappali / éjszakai téma) ===
+
+    // Idő sprite paletta indexei és nappali színei
+    static constexpr uint8_t TIME_SPRITE_PAL_BACKGROUND = 0;
+    static constexpr uint8_t TIME_SPRITE_PAL_TEXT = 1;
+    static constexpr uint16_t TIME_SPRITE_PALETTE[] = {TFT_BLACK, TFT_WHITE};
+
+    // Traffipax riasztó sáv sprite-jainak paletta indexei és színei állapotonként (közeledés/megállás: piros, távolodás: narancs)
+    static constexpr uint8_t TRAFFIPAX_ALERT_PAL_BACKGROUND = 0;
+    static constexpr uint8_t TRAFFIPAX_ALERT_PAL_TEXT = 1;
+    static constexpr uint16_t TRAFFIPAX_ALERT_NEAR_PALETTE[] = {TFT_RED, TFT_WHITE};
+    static constexpr uint16_t TRAFFIPAX_ALERT_DEPARTING_PALETTE[] = {TFT_ORANGE, TFT_BLACK};
+
+    /**
+     * @brief Nappali színből éjszakai (tompított, meleg tónusú) szín képzése
+     * @details A piros csatorna felére, a zöld és kék negyedére csökken, így éjjel nem vakít és nem rontja a sötéthez szokott látást.
+     * @param color Nappali RGB565 szín
+     * @return Éjszakai RGB565 szín
+     */
+    static constexpr uint16_t toNightColor(uint16_t color) {
+        return ((((color >> 11) & 0x1F) >> 1) << 11) | ((((color >> 5) & 0x3F) >> 2) << 5) | ((color & 0x1F) >> 2);
+    }
+
+    /**
+     * @brief 4 bpp sprite palettájának beállítása a nappali színekből az aktuális témának megfelelően
+     * @details Csak a paletta cserélődik, a sprite pixelei (indexei) nem, így a téma váltáshoz elég a sprite-ot újra kitolni a kijelzőre.
+     * @param sprite A 4 bpp sprite (már létre kell legyen hozva)
+     * @param dayPalette Nappali színek
+     * @param count Színek száma (max 16)
+     * @param night true esetén éjszakai téma
+     */
+    static void applySpritePalette(TFT_eSprite &sprite, const uint16_t *dayPalette, uint8_t count, bool night) {
+        uint16_t palette[16] = {0};
+        count = std::min<uint8_t>(count, 16);
+        for (uint8_t i = 0; i < count; i++) {
+            palette[i] = night ? toNightColor(dayPalette[i]) : dayPalette[i];
+        }
+        sprite.createPalette(palette, count);
+    }
+
+    // === SEGÉD METÓDUSOK ===
 
     /**
      * Alapértelmezett gomb ColorScheme létrehozása
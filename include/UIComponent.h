@@ -16,8 +16,10 @@ extern uint16_t SCREEN_H;
 struct TouchEvent {
     uint16_t x, y;
     bool pressed;
+    uint32_t t0Micros; // A lenyomás (PENIRQ él) időpontja a késleltetés méréshez, 0: nincs
 
-    TouchEvent(uint16_t x, uint16_t y, bool pressed) : x(x), y(y), pressed(pressed) {}
+    TouchEvent() : x(0), y(0), pressed(false), t0Micros(0) {}
+    TouchEvent(uint16_t x, uint16_t y, bool pressed, uint32_t t0Micros = 0) : x(x), y(y), pressed(pressed), t0Micros(t0Micros) {}
 };
 
 // Téglalap struktúra
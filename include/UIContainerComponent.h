@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 
+#include "UIArena.h"
 #include "UIComponent.h"
 
 class UIContainerComponent : public UIComponent {
@@ -11,13 +12,20 @@ class UIContainerComponent : public UIComponent {
   protected:
     std::vector<std::shared_ptr<UIComponent>> children;
 
+    /**
+     * @brief A gyerek komponensek arénája (a képernyő/dialógus slab-je, nullptr: heap)
+     */
+    UIArena *arena;
+
   public:
     /**
      * @brief UIContainerComponent konstruktor
      * @param bounds A konténer határai (alapértelmezett: {0, 0, 0, 0})
      * @param colors A konténer színpalettája (alapértelmezett: ColorScheme::defaultScheme())
+     *
+     * Az aréna a létrehozás alatti aréna (lásd UIArenaPool::make()), heap-en létrehozott konténernél nullptr.
      */
-    UIContainerComponent(const Rect &bounds = {0, 0, 0, 0}, const ColorScheme &colors = ColorScheme::defaultScheme()) : UIComponent(bounds, colors) {}
+    UIContainerComponent(const Rect &bounds = {0, 0, 0, 0}, const ColorScheme &colors = ColorScheme::defaultScheme()) : UIComponent(bounds, colors), arena(UIArena::getConstructionArena()) {}
 
     /**
      *  @brief UIContainerComponent destruktor
@@ -29,6 +37,12 @@ class UIContainerComponent : public UIComponent {
         children.clear(); // Eltávolítja az összes gyerek komponenst
     };
 
+    /**
+     * @brief Komponens létrehozása a konténer arénájában (a std::make_shared helyett)
+     * @return A létrehozott komponens, a konténer élettartamáig a slab-ben
+     */
+    template <typename T, typename... Args> std::shared_ptr<T> makeComponent(Args &&...args) { return makeArenaShared<T>(arena, std::forward<Args>(args)...); }
+
     /**
      * @brief Gyerek komponens hozzáadása a konténerhez.
      * @param child A hozzáadandó gyerek komponens.
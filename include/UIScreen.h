@@ -1,16 +1,24 @@
 #pragma once
 
+#include <functional>
+
+#include "GpsEvent.h"
+
+struct TraffipaxAlertEvent;
 #include "IScreenManager.h"
 #include "UIContainerComponent.h"
 #include "UIDialogBase.h"
 
 class UIScreen : public UIContainerComponent {
 
+  public:
+    static constexpr uint8_t MAX_DIALOG_DEPTH = DIALOG_ARENA_COUNT; // Ennyi dialógus nyitható egymásra
+
   private:
     /**
-     * @brief A képernyő egyedi neve
+     * @brief A képernyő egyedi azonosítója
      */
-    const char *name;
+    ScreenId id;
 
     /**
      * @brief ScreenManager referencia a képernyő váltásokhoz
@@ -18,18 +26,15 @@ class UIScreen : public UIContainerComponent {
     IScreenManager *screenManager = nullptr;
 
     /**
-     * @brief Dialógus stack gyors eléréshez (weak_ptr)
+     * @brief A megnyitott dialógusok alulról felfelé (a legfelső az aktív), a tömb tartja életben őket
      */
-    std::vector<std::weak_ptr<UIDialogBase>> dialogStack;
-    /**
-     * @brief Dialógus stack memória védelemhez (shared_ptr) - Dual stack rendszer
-     */
-    std::vector<std::shared_ptr<UIDialogBase>> dialogSharedStack;
+    std::shared_ptr<UIDialogBase> dialogStack[MAX_DIALOG_DEPTH];
+    uint8_t dialogDepth = 0;
 
     /**
-     * @brief Jelenleg aktív dialógus referencia
+     * @brief A bezárt dialógus eltávolítása a stack-ből (bárhol is van)
      */
-    std::shared_ptr<UIDialogBase> currentDialog;
+    void removeDialog(UIDialogBase *closedDialog);
 
     // ===================================================================
     // UI komponensek factory metódusok
@@ -64,12 +69,12 @@ class UIScreen : public UIContainerComponent {
 
   public:
     /**
-     * @brief Konstruktor képernyő névvel
-     * @param name A képernyő egyedi neve
+     * @brief Konstruktor képernyő azonosítóval
+     * @param id A képernyő egyedi azonosítója
      *
      * A képernyő teljes display méretet használja automatikusan.
      */
-    UIScreen(const char *name);
+    UIScreen(ScreenId id);
 
     /**
      * @brief Virtuális destruktor
@@ -79,10 +84,15 @@ class UIScreen : public UIContainerComponent {
     virtual ~UIScreen() = default;
 
     /**
-     * @brief Képernyő egyedi nevének elkérése
+     * @brief Képernyő egyedi azonosítójának elkérése
+     */
+    ScreenId getId() const { return id; }
+
+    /**
+     * @brief Képernyő nevének elkérése (debug kiíratáshoz)
      * @return A képernyő neve
      */
-    const char *getName() const { return name; }
+    const char *getName() const { return screenName(id); }
 
     /**
      * @brief ScreenManager beállítása
@@ -124,6 +134,24 @@ class UIScreen : public UIContainerComponent {
      */
     virtual void deactivate() {}
 
+    /**
+     * @brief GPS esemény (új fix epocha, teljes GSV blokk) kezelése
+     * @param event A Core1-ről érkezett esemény
+     *
+     * A ScreenManager hívja az aktív képernyőn, a Core0 loop-jában.
+     * Felülírható, ha a képernyő a GPS adatok beérkezéséhez igazítva frissít.
+     */
+    virtual void onGpsEvent(const GpsEvent &event) {}
+
+    /**
+     * @brief Traffipax riasztás állapotváltozás kezelése
+     * @param event A Core1 kiértékelő eseménye
+     *
+     * A ScreenManager hívja az aktív képernyőn, a sziréna kezelése után.
+     * Felülírható, ha a képernyő megjeleníti a riasztást.
+     */
+    virtual void onTraffipaxAlert(const TraffipaxAlertEvent &event) {}
+
     // ================================
     // UIComponent Override Methods - Event Handling és Rendering
     // ================================
@@ -178,14 +206,17 @@ class UIScreen : public UIContainerComponent {
     // Layered Dialog System
     // ================================
 
+    /**
+     * @brief Dialógus létrehozása a dialógus slab-ek egyikében (a std::make_shared helyett)
+     * @return A létrehozott dialógus; a slab a dialógussal és a gombjaival együtt szabadul fel
+     */
+    template <typename T, typename... Args> std::shared_ptr<T> makeDialog(Args &&...args) { return dialogArenaPool.make<T>(std::forward<Args>(args)...); }
+
     /**
      * @brief Dialógus megjelenítése a layered dialog rendszerben
      * @param dialog Megjelenítendő dialógus (shared_ptr)
      *
-     * A dialógus hozzáadódik a dual stack rendszerhez:
-     * - _dialogStack: gyors elérés (weak_ptr)
-     * - _dialogSharedStack: memória védelem (shared_ptr)
-     *
+     * A dialógus a stack tetejére kerül (tele stack esetén nem nyílik meg).
      * A dialógus automatikusan megjelenik és aktívvá válik.
      * Az előző dialógus (ha van) inaktívvá válik, de látható marad.
      *
@@ -201,7 +232,7 @@ class UIScreen : public UIContainerComponent {
      * Kezeli a stack cleanup-ot és az előző dialógus visszaállítását.
      *
      * Funkciók:
-     * - Dialógus eltávolítása mindkét stack-ből
+     * - Dialógus eltávolítása a stack-ből
      * - Előző dialógus aktiválása (ha van)
      * - Képernyő újrarajzolás (ha szükséges)
      * - Memória cleanup
@@ -221,40 +252,50 @@ class UIScreen : public UIContainerComponent {
      *     showDialog(newDialog);
      * }
      */
-    inline bool isDialogActive() const { return !dialogStack.empty(); }
+    inline bool isDialogActive() const { return dialogDepth > 0; }
 
   protected:
+    // ===================================================================
+    // Multi-rate Refresh Scheduler
+    // ===================================================================
+
     /**
-     * @brief Segédfüggvény egy UI érték frissítésére, csak ha az megváltozott.
-     *
-     * Ez a sablonfüggvény összehasonlít egy új értéket egy utoljára ismert értékkel.
-     * Ha az érték megváltozott (vagy ha a forceRedraw igaz), végrehajtja a megadott
-     * rajzoló lambda függvényt, és frissíti az utoljára ismert értéket.
-     *
-     * Speciális kezelést alkalmaz a következőkre:
-     * - String: Pontos egyenlőtlenséget vizsgál.
-     * - Numerikus típusok: Azt vizsgálja, hogy az abszolút különbség meghalad-e egy küszöbértéket.
+     * @brief Frissítési sáv
      *
-     * @tparam T Az összehasonlítandó érték típusa.
-     * @param lastValue Referencia a legutóbbi értéket tároló változóra.
-     * @param newValue Az új, összehasonlítandó érték.
-     * @param drawFunc Egy lambda függvény, amely a változáskor végrehajtandó rajzolási kódot tartalmazza.
-     * @param threshold A numerikus összehasonlítások küszöbértéke.
-     * @param forceRedraw Ha igaz, a változástól függetlenül kényszeríti a frissítést.
-     */
-    template <typename T> static void updateUIValue(T &lastValue, T newValue, std::function<void()> drawFunc, double threshold = 0.1, bool forceRedraw = false) {
-        if constexpr (std::is_same_v<T, String>) {
-            if (forceRedraw || newValue != lastValue) {
-                drawFunc();
-                lastValue = newValue;
-            }
-        } else {
-            if (forceRedraw || std::abs(static_cast<double>(newValue) - static_cast<double>(lastValue)) > threshold) {
-                drawFunc();
-                lastValue = newValue;
-            }
-        }
-    }
+     * - Fast: minden esedékes feladat lefut a keretben, a költségvetéstől függetlenül (pl. sebesség)
+     * - Slow: a legrégebben esedékes feladatok futnak, amíg a keret idő költségvetése engedi
+     */
+    enum class RefreshLane : uint8_t { Fast, Slow };
+
+    /**
+     * @brief A lassú sáv alapértelmezett idő költségvetése keretenként (rajzolás + SPI), us
+     */
+    static constexpr uint16_t DEFAULT_REFRESH_BUDGET_MICROS = 10000;
+
+    /**
+     * @brief Periodikus widget frissítő feladat regisztrálása
+     * @param lane A frissítési sáv
+     * @param periodMs A legkisebb frissítési periódus (a legnagyobb frissítési ráta)
+     * @param refresh A widget frissítése (rajzolás csak változáskor)
+     * @param periodic true esetén minden periódusban lefut, false esetén csak markRefreshDirty() után
+     * @return A feladat azonosítója
+     */
+    uint8_t addRefreshTask(RefreshLane lane, uint16_t periodMs, std::function<void()> refresh, bool periodic = false);
+
+    /**
+     * @brief Feladat megjelölése: a következő esedékességkor lefut
+     */
+    void markRefreshDirty(uint8_t taskId);
+
+    /**
+     * @brief Az összes feladat megjelölése azonnali futásra (pl. teljes újrarajzolás után)
+     */
+    void markAllRefreshDirty();
+
+    /**
+     * @brief A lassú sáv keretenkénti idő költségvetésének beállítása
+     */
+    void setRefreshBudgetMicros(uint16_t budgetMicros) { refreshBudgetMicros = budgetMicros; }
 
     // ===================================================================
     // Dialog cleanup helper methods
@@ -267,4 +308,38 @@ class UIScreen : public UIContainerComponent {
      * Hasznos olyan esetekben, amikor a leszármazott osztály egyedi rajzolási logikát szeretne.
      */
     void performDialogCleanupWithoutDraw(UIDialogBase *closedDialog);
+
+  private:
+    /**
+     * @brief Periodikus widget frissítő feladat (lásd addRefreshTask())
+     */
+    struct RefreshTask {
+        std::function<void()> refresh;
+        uint16_t periodMs;
+        RefreshLane lane;
+        bool periodic;
+        bool dirty;
+        uint32_t lastRunMillis;
+        uint32_t avgCostMicros; // Mért futási idő mozgó átlaga, ebből becsüljük, belefér-e a keretbe
+    };
+
+    /**
+     * @brief A regisztrált frissítő feladatok
+     */
+    std::vector<RefreshTask> refreshTasks;
+
+    /**
+     * @brief A lassú sáv keretenkénti idő költségvetése (us)
+     */
+    uint16_t refreshBudgetMicros;
+
+    /**
+     * @brief Az esedékes frissítő feladatok futtatása (a loop() hívja, ha nincs aktív dialógus)
+     */
+    void runRefreshTasks();
+
+    /**
+     * @brief Egy feladat futtatása és költségének mérése
+     */
+    void runRefreshTask(RefreshTask &task, uint32_t now);
 };
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <type_traits>
+
+#include "UIColorPalette.h"
+#include "UIComponent.h"
+
+/**
+ * @brief UIValueField formázóinak alaposztálya az alapértelmezett viselkedésekkel
+ *
+ * Egy formázó (Formatter) a következőket adja meg a UIValueField számára:
+ * - SAMPLE / PADDING_EXTRA: a legszélesebb kiírható szöveg és a ráhagyás, ebből adódik a mező szélessége
+ * - WIDTH: ha nem 0, fix mezőszélesség a SAMPLE mérése helyett (pl. ha a mező mellett szorosan másik mező kezdődik)
+ * - begin(): font, méret beállítása (szín nélkül)
+ * - format(): az érték szöveggé alakítása a megadott fix bufferbe
+ * - color(): az érték előtér színe (pl. érvénytelen érték pirossal), a themed()-en át a témát követve
+ * - end(): a begin() visszaállítása (pl. betöltött smooth font felszabadítása)
+ *
+ * A formázók sima (nem virtuális) struktúrák, a UIValueField sablonparaméterként kapja őket,
+ * így a hívások fordítási időben feloldódnak, nincs std::function és nincs heap foglalás.
+ */
+struct UIValueFormatterBase {
+    static constexpr uint8_t PADDING_EXTRA = 10;
+    static constexpr uint16_t WIDTH = 0;
+
+    // Az éjszakai téma jelzője (a képernyő tagja), nullptr esetén mindig nappali színek
+    const bool *nightTheme = nullptr;
+
+    void begin(TFT_eSPI &tft) const {
+        tft.setFreeFont();
+        tft.setTextSize(1);
+    }
+    void end(TFT_eSPI &tft) const {}
+    template <typename T> uint16_t color(const T &value) const { return themed(TFT_WHITE); }
+    uint16_t themed(uint16_t dayColor) const { return nightTheme && *nightTheme ? UIColorPalette::toNightColor(dayColor) : dayColor; }
+    uint16_t background() const { return TFT_BLACK; }
+};
+
+/**
+ * @brief Kötött érték mező: saját maga tárolja az utolsó kirajzolt értéket, és csak változáskor rajzol
+ *
+ * A mező egy rögzített horgonypontra és igazításra (datum) rajzol. A szöveget fix méretű bufferbe formázza,
+ * és csak akkor rajzol újra, ha a látható szöveg vagy a színe megváltozott. A törlést a TFT_eSPI padding végzi,
+ * így a mező téglalapja (getBounds()) az első rajzoláskor, a formázó mintaszövegéből adódik.
+ *
+ * @tparam T Az érték típusa (számok, enum-ok, vagy const char* szöveg)
+ * @tparam Formatter A formázó (lásd UIValueFormatterBase)
+ * @tparam BufferSize A formázott szöveg buffer mérete
+ */
+template <typename T, typename Formatter, uint8_t BufferSize = 16> class UIValueField {
+
+  public:
+    /**
+     * @brief Konstruktor
+     * @param x Horgonypont X koordináta
+     * @param y Horgonypont Y koordináta
+     * @param datum TFT_eSPI szöveg igazítás (pl. ML_DATUM), a horgonypont ehhez viszonyul
+     * @param formatter A formázó példány (állapotot is hordozhat, pl. téma)
+     */
+    UIValueField(int16_t x, int16_t y, uint8_t datum, Formatter formatter = Formatter()) : x(x), y(y), datum(datum), formatter(formatter) {}
+
+    /**
+     * @brief Érték frissítése, rajzolás csak ha a kijelzett szöveg vagy szín változott
+     * @param value Az új érték
+     * @param force Ha true, a változástól függetlenül újrarajzol
+     * @return true, ha rajzolás történt
+     */
+    bool update(const T &value, bool force = false) {
+        force = force || !drawn;
+
+        // Skalár típusoknál az azonos érték formázás nélkül kiszűrhető
+        if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            if (!force && value == lastValue) {
+                return false;
+            }
+        }
+        lastValue = value;
+
+        char text[BufferSize];
+        formatter.format(value, text, sizeof(text));
+        uint16_t color = formatter.color(value);
+        if (!force && color == lastColor && strcmp(text, lastText) == 0) {
+            return false;
+        }
+
+        draw(text, color);
+        strcpy(lastText, text);
+        lastColor = color;
+        drawn = true;
+        return true;
+    }
+
+    /**
+     * @brief A következő update() mindenképpen rajzoljon (pl. a képernyő törlése után)
+     */
+    void invalidate() { drawn = false; }
+
+    /**
+     * @brief Ki van-e már rajzolva a mező?
+     */
+    bool isDrawn() const { return drawn; }
+
+    /**
+     * @brief A mező képernyő téglalapja (az első rajzolás után érvényes)
+     */
+    const Rect &getBounds() const { return bounds; }
+
+    /**
+     * @brief A formázó elérése (pl. állapotának módosításához)
+     */
+    Formatter &getFormatter() { return formatter; }
+
+  private:
+    int16_t x;
+    int16_t y;
+    uint8_t datum;
+    Formatter formatter;
+
+    Rect bounds;
+    bool drawn = false;
+    T lastValue{};
+    uint16_t lastColor = 0;
+    char lastText[BufferSize] = {0};
+
+    /**
+     * @brief Szöveg kirajzolása a horgonypontra, a mező szélességére paddingolva
+     */
+    void draw(const char *text, uint16_t color) {
+        formatter.begin(tft);
+
+        // A mező mérete a formázó mintaszövegéből (egyszer számoljuk)
+        if (bounds.width == 0) {
+            uint16_t width = Formatter::WIDTH ? Formatter::WIDTH : tft.textWidth(Formatter::SAMPLE) + Formatter::PADDING_EXTRA;
+            uint16_t height = tft.fontHeight();
+            // A datum vízszintes (bal/közép/jobb) és függőleges (fent/közép/lent) része
+            int16_t left = x - (datum % 3) * width / 2;
+            int16_t top = y - (datum / 3) * height / 2;
+            bounds = Rect(left, top, width, height);
+        }
+
+        tft.setTextDatum(datum);
+        tft.setTextColor(color, formatter.background());
+        tft.setTextPadding(bounds.width);
+        tft.drawString(text, x, y);
+        tft.setTextPadding(0);
+
+        formatter.end(tft);
+    }
+};
@@ -1,6 +1,9 @@
 #pragma once
 
-#include <TFT_eSPI.h> // Hardware-specific library
+#include <Arduino.h>
+#include <hardware/regs/addressmap.h>
+
+class TFT_eSPI; // A TFT-s segédfüggvények az UtilsHardware.cpp-ben: a hoszt (native) build TFT nélkül is fordítja
 
 //--- Utils ---
 namespace Utils {
@@ -38,45 +41,22 @@ void tftTouchCalibrate(TFT_eSPI &tft, uint16_t (&calData)[5]);
 void removeAccents(char *text);
 
 //--- Beep ----
+// A hangok az AudioEngine prioritási sorába kerülnek, a hívás nem blokkol
+
 /**
  *  Pitty hangjelzés
  */
 void beepTick();
-void beepError();
-
-/**
- * Trafipax riasztó hangjelzés
- */
-void beepAlert();
 
 /**
- * Sziréna hangjelzés (felfutó-lefutó)
- * @param cycles hány sziréna ciklus
- * @param minFreq kezdő frekvencia (Hz)
- * @param maxFreq vég frekvencia (Hz)
- * @param step lépésköz (Hz)
- * @param toneMs egy lépés hossza (ms)
- * @param pauseMs ciklusok közti szünet (ms)
+ * Hiba hangjelzés
  */
-void beepSiren(int cycles, int minFreq, int maxFreq, int step, int toneMs, int pauseMs);
+void beepError();
 
 /**
- * @brief Nem-blokkoló sziréna vezérlése
- *
- * @param maxFreq vég frekvencia (Hz)
- * @param step lépésköz (Hz)
- * @param toneMs egy lépés hossza (ms)
- * @param pauseMs ciklusok közti szünet (ms)
- */
-void startNonBlockingSiren(int cycles, int minFreq, int maxFreq, int step, int toneMs, int pauseMs);
-/**
- * Nem-blokkoló sziréna kezelése
- */
-void handleNonBlockingSiren();
-/**
- * Nem-blokkoló sziréna leállítása
+ * Trafipax riasztó hangjelzés
  */
-void stopNonBlockingSiren();
+void beepAlert();
 
 /**
  * @brief CRC16 számítás (CCITT algoritmus)
@@ -100,6 +80,36 @@ template <typename T, size_t N> bool isZeroArray(T (&arr)[N]) {
     return true; // Ha minden elem nulla, akkor true-t adunk vissza
 }
 
+/**
+ * @brief Flash-beli konstans adat címe az XIP cache-t nem foglaló (NOALLOC) aliason
+ *
+ * A nagy, rajzoláskor végigolvasott adat (pl. a sebesség smooth font glifjei) így nem szorítja ki a hot kódot a 16KB-os
+ * XIP cache-ből: találatkor a cache-ből, tévesztéskor közvetlenül a flash-ből olvasódik, új cache sor foglalása nélkül.
+ * A nem flash-beli (pl. az sram_hotlist.txt alapján SRAM-ba tett) adat címét változatlanul adja vissza.
+ */
+template <typename T> inline const T *xipNoAlloc(const T *data) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(data);
+    if (address >= XIP_BASE && address < XIP_NOALLOC_BASE) {
+        address += XIP_NOALLOC_BASE - XIP_BASE;
+    }
+    return reinterpret_cast<const T *>(address);
+}
+
+/**
+ * @brief A heap állapota (newlib mallinfo)
+ */
+struct HeapStats {
+    uint32_t top;        // A heap teteje (a valaha használt legnagyobb méret: csúcs kihasználtság)
+    uint32_t used;       // Foglalt bájtok
+    uint32_t free;       // Szabad bájtok a heap tetejéig
+    uint32_t freeChunks; // Szabad darabok száma (a töredezettség mértéke)
+};
+
+/**
+ * @brief A heap pillanatnyi állapota
+ */
+HeapStats getHeapStats();
+
 /**
  * Eltelt már annyi idő?
  */
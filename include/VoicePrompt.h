@@ -0,0 +1,194 @@
+#pragma once
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include "ImaAdpcm.h"
+
+/**
+ * @brief LittleFS-en tárolt, tömörített beszédhang bejelentések (pl. "traffipax 500 méter")
+ *
+ * A klipek IMA ADPCM tömörítésű fájlok a /voice könyvtárban, a host oldali encode_voice.py készíti őket WAV-ból.
+ * A lejátszás a buzzer PWM szeletén megy (az AudioEngine-től kölcsönkérve): a vivő ~130kHz, a kitöltés a minta.
+ * A mintákat egy DMA csatorna írja a PWM CC regiszterébe, a mintavételi ütemet egy DMA időzítő adja, így a CPU-t
+ * csak a pufferváltás megszakítása és a dekódolás terheli.
+ *
+ * Dekódolás előre: BUFFER_COUNT darab puffer körben, a DMA az egyiket játssza, a többit a Core0 "voice" feladata
+ * tölti fel (a puffer végén a megszakítás jelzi). Így a fájl olvasás és a dekódolás a rajzolási körök közé esik,
+ * és egy hosszabb rajzolást is kibír a lejátszás (BUFFER_COUNT-1 puffernyi előny).
+ *
+ * Kattanásmentes ki/be kapcsolás: a csend a PCM középszint (PCM_MIDPOINT), nem a 0 kitöltés. A bejelentés elején a
+ * kimenet FADE_SAMPLES minta alatt úszik fel a 0-ról (amit az AudioEngine hagyott) a középszintre, a végén (és stop()
+ * után) ugyanígy vissza, és csak ezután kapja vissza az AudioEngine a PWM-et. Alulcsorduláskor a kimenet a középszinten áll.
+ *
+ * Feltöltés a LittleFS-re a CSV-vel együtt: a klipeket a data/voice könyvtárba kell tenni, majd: pio run --target uploadfs
+ * Ha a klipek hiányoznak, isAvailable() false, és a riasztás a szirénára marad.
+ */
+class VoicePrompt {
+
+  public:
+    /**
+     * @brief A klipek (fájlnevek a CLIP_FILES táblában)
+     */
+    enum class Clip : uint8_t {
+        Traffipax, // "traffipax"
+        N100,      // "száz"
+        N200,
+        N300,
+        N400,
+        N500,
+        N600,
+        N700,
+        N800,
+        N900,
+        N1000,  // "ezer"
+        Meters, // "méter"
+        COUNT
+    };
+
+    static constexpr uint8_t MAX_PHRASE_CLIPS = 6;  // Egy bejelentés max. ennyi klipből áll
+    static constexpr uint8_t BUFFER_COUNT = 4;      // Körpufferek száma
+    static constexpr uint16_t BUFFER_SAMPLES = 256; // Minták pufferenként (8kHz-en 32ms)
+    static constexpr uint8_t PCM_BITS = 10;         // A PWM kitöltés felbontása
+    static constexpr uint16_t PCM_TOP = (1 << PCM_BITS) - 1;
+    static constexpr uint16_t PCM_MIDPOINT = (PCM_TOP + 1) / 2; // A 0 minta (csend) kitöltése
+    static constexpr uint16_t FADE_SAMPLES = 64;                // A ki/be úsztatás hossza (8kHz-en 8ms)
+    static_assert(FADE_SAMPLES <= BUFFER_SAMPLES, "A leúsztatás egy pufferbe kell férjen");
+
+    /**
+     * @brief DMA csatorna, DMA időzítő és megszakítás lefoglalása, a klipek meglétének ellenőrzése (Core0, LittleFS.begin() után)
+     * @param refillTaskId A puffereket töltő Core0 feladat (a megszakítás ezt jelzi)
+     */
+    void begin(uint8_t refillTaskId);
+
+    /**
+     * @brief Megvannak-e a klipek a LittleFS-en
+     */
+    bool isAvailable() const { return available; }
+
+    /**
+     * @brief Traffipax bejelentés a távolsággal ("traffipax 500 méter"), a futó bejelentést lecseréli
+     * @param distanceMeters Távolság, 100 méterre kerekítve kerül kimondásra (100..1900)
+     * @return false, ha nincs hang (hiányzó klipek)
+     */
+    bool announceCamera(float distanceMeters);
+
+    /**
+     * @brief Tetszőleges klip sorozat lejátszása (a futó bejelentést lecseréli)
+     */
+    bool play(const Clip *clips, uint8_t count);
+
+    /**
+     * @brief A bejelentés leállítása: a kimenet leúszik a 0 kitöltésre, utána a PWM visszakerül az AudioEngine-hez
+     */
+    void stop();
+
+    /**
+     * @brief Szól-e éppen bejelentés
+     */
+    bool isPlaying() const { return playing; }
+
+    /**
+     * @brief A szabad pufferek feltöltése (a Core0 "voice" feladata, a megszakítás jelzésére)
+     */
+    void refill();
+
+  private:
+    static const char *const CLIP_FILES[static_cast<uint8_t>(Clip::COUNT)];
+    static VoicePrompt *instance; // A DMA megszakítás kezelőnek
+
+    bool available = false;
+    int dmaChannel = -1;
+    int dmaTimer = -1;
+    uint8_t refillTaskId = 0xFF;
+    volatile uint32_t *pwmCc = nullptr; // A DMA cél: a buzzer PWM szeletének CC regisztere
+    uint8_t ccShift = 0;                // A buzzer csatornájának helye a CC regiszterben (A: 0, B: 16)
+    uint16_t sampleRate = 0;
+
+    // A kimondandó klipek
+    Clip phrase[MAX_PHRASE_CLIPS];
+    uint8_t phraseLength = 0;
+    uint8_t phrasePos = 0;
+
+    // Az éppen olvasott klip
+    File clipFile;
+    uint32_t samplesLeft = 0; // A klipből még dekódolandó minták
+    ImaAdpcm::State decoderState;
+
+    // Körpufferek: a DMA a playIndex-ediket játssza, a refill() a fillIndex-ediktől tölt
+    uint32_t buffers[BUFFER_COUNT][BUFFER_SAMPLES]; // A PWM CC regiszterbe írandó értékek
+    uint16_t bufferLength[BUFFER_COUNT];
+    volatile uint8_t readyCount = 0; // Feltöltött, még le nem játszott pufferek (a DMA-ban lévővel együtt)
+    volatile uint8_t playIndex = 0;
+    uint8_t fillIndex = 0;
+    volatile bool dmaRunning = false;
+    volatile bool playing = false;
+    bool endOfPhrase = false;
+    uint16_t fadeInLeft = 0; // A bejelentés elején még hátralévő felúsztató minták
+    bool fadingOut = false;  // A leúsztató puffer már sorban van
+
+    /**
+     * @brief A DMA megszakítás kezelője (megosztott DMA_IRQ_1)
+     */
+    static void onDmaIrq();
+
+    /**
+     * @brief A puffer végén: a következő feltöltött puffer indítása, a töltő feladat jelzése (megszakításból)
+     */
+    void onBufferDone();
+
+    /**
+     * @brief A DMA leállítása, a klip bezárása (a PWM és a kimenet szintje nálunk marad)
+     */
+    void halt();
+
+    /**
+     * @brief A leúsztatás után: a bejelentés vége, a PWM visszaadása az AudioEngine-nek
+     */
+    void finish();
+
+    /**
+     * @brief A kimenet a csend szintjére (PCM_MIDPOINT), csak a buzzer csatornáját írva
+     */
+    void parkOutput();
+
+    /**
+     * @brief A fillIndex-edik puffer sorba állítása, a DMA indítása, ha áll
+     */
+    void queueBuffer(uint16_t length);
+
+    /**
+     * @brief A következő feltöltött puffer DMA átvitelének indítása
+     */
+    void startDma();
+
+    /**
+     * @brief Egy puffer feltöltése a klipekből
+     * @return A pufferbe került minták száma (0: a bejelentés végére értünk)
+     */
+    uint16_t fillBuffer(uint32_t *dst);
+
+    /**
+     * @brief A leúsztató minták (PCM_MIDPOINT -> 0) a pufferbe
+     * @return A minták száma (FADE_SAMPLES)
+     */
+    uint16_t fillFadeOut(uint32_t *dst);
+
+    /**
+     * @brief PWM kitöltés (0..PCM_TOP) -> a CC regiszterbe írandó érték (a buzzer csatornájának helyére tolva)
+     */
+    uint32_t ccValue(uint32_t level) const { return level << ccShift; }
+
+    /**
+     * @brief A bejelentés következő klipjének megnyitása
+     * @return false, ha nincs több klip
+     */
+    bool openNextClip();
+
+    /**
+     * @brief A klip fájl neve
+     */
+    static void clipPath(Clip clip, char *path, size_t size);
+};
+
+extern VoicePrompt voicePrompt;
@@ -7,26 +7,12 @@
 #define PROGRAM_VERSION "V0.0.4"
 #define PROGRAM_AUTHOR "BT-Soft"
 
-//--- ScreenNames ----
-#define SCREEN_NAME_MAIN "Main"
-#define SCREEN_NAME_INFO "Info"
-#define SCREEN_NAME_SETUP "Setup"
-#define SCREEN_NAME_SATS "Satellites"
-#define SCREEN_NAME_TFT_SETUP "ScreenTFTSetup"
-#define SCREEN_NAME_SYSTEM_SETUP "ScreenSystemSetup"
-#define SCREEN_NAME_GPS_SETUP "ScreenGPSSetup"
-#define SCREEN_NAME_DEBUG_SETUP "ScreenDebugSetup"
-#define SCREEN_NAME_SCREENSAVER "ScreenScreenSaver"
-
-//---
-#define SCREEN_NAME_EMPTY "Empty"
-#define SCREEN_NAME_TEST "Test"
-
 // Képernyővédő deaktiválásához szükséges sebesség km/h-ban
 #define SCREEN_HIDE_SCREENSAVER_SPEED_KMPH 3.0f
 
 #define __DEBUG
 //  #define __DEBUG_WAIT_FOR_SERIAL
+//  #define __CODE_PROFILE // PC mintavételező profilozó az sram_hotlist.txt frissítéséhez (Latency képernyő -> Dump)
 
 // Színsémák
 #define RED2RED 0
@@ -68,6 +54,9 @@
 // GPS adatok maximális életkora ms-ban
 #define GPS_DATA_MAX_AGE 5000
 
+// A képernyők a GPS epochák beérkezésekor frissülnek; ha ennyi ideig nem jön epocha (nincs fix, kiesett modul), az időzítő frissít
+#define GPS_EPOCH_WATCHDOG_MS 1500
+
 // Minimum ennyi ideig látszik a traffipax alarm
 #define ALARM_TIME_MS 10000
 
@@ -15,3 +15,9 @@
 #define PIN_VBUS_EXTERNAL_MEASURE_INPUT A0
 #define PIN_VSYS_EXTERNAL_MEASURE_INPUT A2
 #define PIN_BUZZER 9
+
+// Pico Zero belső WS2812 RGB LED
+#define PIN_INTERNAL_RGB_LED 16
+
+// Érintésvezérlő (XPT2046) PENIRQ kimenete (T_IRQ), lenyomáskor alacsony
+#define PIN_TOUCH_IRQ 10
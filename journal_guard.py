@@ -0,0 +1,41 @@
+"""
+A konfig napló flash területének védelme linkeléskor (PlatformIO extra_script)
+
+A napló (StoreJournalBase.h) a LittleFS előtti JOURNAL_SECTOR_COUNT szektort használja, de az arduino-pico linker
+szkriptje ezt a sketch területéhez számolja. A szkript egy implicit linker szkriptet ír a build könyvtárba, amelynek
+ASSERT-je a linkelést hibával leállítja, ha a program vége (__flash_binary_end) belelóg a napló területébe.
+A szektorok számát a StoreJournalBase.h-ból olvassa, így csak ott kell módosítani.
+"""
+
+import os
+import re
+
+Import("env")
+
+JOURNAL_HEADER = os.path.join(env.subst("$PROJECT_INCLUDE_DIR"), "StoreJournalBase.h")
+FLASH_SECTOR_SIZE = 4096
+
+
+def journal_sector_count(path):
+    with open(path, encoding="utf-8") as f:
+        match = re.search(r"^#define\s+JOURNAL_SECTOR_COUNT\s+(\d+)", f.read(), re.MULTILINE)
+    if not match:
+        raise ValueError(f"{path}: a JOURNAL_SECTOR_COUNT nem található")
+    return int(match.group(1))
+
+
+def write_guard_script(path, sectors):
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("/* A journal_guard.py generálja: a program nem lóghat bele a konfig napló területébe */\n")
+        f.write(f"ASSERT(__flash_binary_end <= _FS_start - {sectors} * {FLASH_SECTOR_SIZE}, "
+                f"\"A program belelog a konfig naplo teruletebe ({sectors} x {FLASH_SECTOR_SIZE} bajt a LittleFS elott)\")\n")
+
+
+build_dir = env.subst("$BUILD_DIR")
+os.makedirs(build_dir, exist_ok=True)
+guard_script = os.path.join(build_dir, "journal_guard.ld")
+write_guard_script(guard_script, journal_sector_count(JOURNAL_HEADER))
+
+# A linker a nem objektum bemenetet implicit linker szkriptként kezeli: az ASSERT a végső elrendezés után értékelődik ki
+env.Append(LINKFLAGS=[guard_script])
+env.Depends("$BUILD_DIR/${PROGNAME}.elf", guard_script)
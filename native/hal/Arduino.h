@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+
+#include <hardware/regs/addressmap.h>
+#include <pico/time.h>
+
+/**
+ * @brief Az arduino-pico core hoszt (native) helyettesítője
+ *
+ * Csak annyit ad, amennyit a mag logika (GPS, műhold adatbázis, traffipax, konfig napló, ütemező) használ, a Pico
+ * API-val azonos nevekkel és viselkedéssel. Az idő virtuális: csak a NativeHal::advanceMicros() (és a delay()) lépteti,
+ * így a futás determinisztikus, és a hoszt teljes sebességével halad. A két mag egy szálon fut; hogy éppen melyik
+ * "fut", azt a NativeHal::setCore() választja (pl. a Config magonkénti kézbesítéséhez).
+ */
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+
+#define PROGMEM
+#define __not_in_flash_func(f) f
+#define __not_in_flash(group)
+#define __time_critical_func(f) f
+#define __scratch_x(name)
+#define __scratch_y(name)
+
+//--- Idő (virtuális óra; mint a Pico-n, 32 bites és körbefordul) ---
+uint32_t millis();
+uint32_t micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+//--- Megszakítások: egy szálon nincs mit tiltani ---
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+//--- Segédfüggvények ---
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+template <class T, class L, class H> auto constrain(T amt, L low, H high) -> decltype(amt) { return amt < low ? low : (amt > high ? high : amt); }
+char *dtostrf(double value, signed char width, unsigned char precision, char *buffer);
+#if !defined(__APPLE__) && !(defined(__GLIBC__) && __GLIBC_PREREQ(2, 38)) // Ott már a C könyvtár része
+size_t strlcpy(char *dst, const char *src, size_t size);
+#endif
+
+/**
+ * @brief Vékony String (a GpsManager szöveges lekérdezéseihez)
+ */
+class String {
+  public:
+    String(const char *text = "") : text(text ? text : "") {}
+    String(const std::string &text) : text(text) {}
+    String(int value) : text(std::to_string(value)) {}
+    String(unsigned int value) : text(std::to_string(value)) {}
+    String(long value) : text(std::to_string(value)) {}
+    String(unsigned long value) : text(std::to_string(value)) {}
+    String(double value, unsigned char decimalPlaces = 2);
+
+    const char *c_str() const { return text.c_str(); }
+    unsigned int length() const { return text.length(); }
+    bool isEmpty() const { return text.empty(); }
+
+    String &operator+=(const String &other) {
+        text += other.text;
+        return *this;
+    }
+    String operator+(const String &other) const { return String(text + other.text); }
+    bool operator==(const String &other) const { return text == other.text; }
+    bool operator!=(const String &other) const { return text != other.text; }
+    bool operator<(const String &other) const { return text < other.text; }
+
+  private:
+    std::string text;
+};
+
+/**
+ * @brief Kimenet (a write() a leszármazottban)
+ */
+class Print {
+  public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *text) { return write(reinterpret_cast<const uint8_t *>(text), strlen(text)); }
+
+    size_t print(const char *text) { return write(text); }
+    size_t print(const String &text) { return write(text.c_str()); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(double value, int decimalPlaces = 2) { return printf("%.*f", decimalPlaces, value); }
+    size_t println(const char *text = "") { return print(text) + write("\r\n"); }
+    size_t println(const String &text) { return println(text.c_str()); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+/**
+ * @brief Bemeneti adatfolyam (a read()/available() a leszármazottban)
+ */
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytesUntil(char terminator, char *buffer, size_t length);
+};
+
+/**
+ * @brief Bájtfolyam soros port
+ *
+ * A vett bájtok a feed()-del kerülnek a sorba, és a beállított baud rátának megfelelő virtuális időpontban válnak
+ * olvashatóvá (10 bit/bájt), mintha a GPS modul küldené őket. Ha a ki nem olvasott bájtok túllépik a FIFO méretét
+ * (az arduino-pico alapértéke 32), az újonnan érkezők elvesznek: ezt a getOverruns() számolja.
+ * Az adás a setOutput() fájlba megy (nullptr: eldobja).
+ */
+class HardwareSerial : public Stream {
+  public:
+    explicit HardwareSerial(FILE *output = nullptr) : output(output) {}
+
+    void begin(unsigned long baud) { this->baud = baud; }
+    void end() {}
+    void setRX(int pin) {}
+    void setTX(int pin) {}
+    void setFIFOSize(size_t size) { fifoSize = size; }
+    operator bool() const { return true; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    /**
+     * @brief Vett bájtok sorba állítása (a baud rátával ütemezve, az utolsó már sorban álló bájt után)
+     */
+    void feed(const uint8_t *data, size_t length);
+
+    /**
+     * @brief A még be nem érkezett vagy ki nem olvasott bájtok száma
+     */
+    size_t pending() const { return rx.size(); }
+
+    /**
+     * @brief A FIFO túlcsordulás miatt elveszett bájtok száma
+     */
+    uint32_t getOverruns() const { return overruns; }
+
+    /**
+     * @brief Az adás célja (nullptr: eldobja)
+     */
+    void setOutput(FILE *output) { this->output = output; }
+
+  private:
+    struct RxByte {
+        uint64_t arrivalMicros;
+        uint8_t value;
+    };
+
+    std::deque<RxByte> rx;
+    uint64_t lastArrivalMicros = 0;
+    unsigned long baud = 115200;
+    size_t fifoSize = 32;
+    uint32_t overruns = 0;
+    FILE *output;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+/**
+ * @brief Az rp2040 objektum (mag azonosító, a másik mag parkolása, heap adatok)
+ */
+class RP2040 {
+  public:
+    int cpuid();
+    void idleOtherCore() {}
+    void resumeOtherCore() {}
+    uint32_t f_cpu() { return 133000000; }
+
+    // A hoszton nincs Pico heap: rögzített értékek, hogy a kijelzett adatok futásról futásra azonosak legyenek
+    int getTotalHeap() { return 240 * 1024; }
+    int getUsedHeap() { return 80 * 1024; }
+    int getFreeHeap() { return getTotalHeap() - getUsedHeap(); }
+};
+
+extern RP2040 rp2040;
+
+inline uint get_core_num() { return rp2040.cpuid(); }
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Az arduino-pico EEPROM emuláció hoszt helyettesítője
+ *
+ * Mint a Pico-n: a begin() a flash kép utolsó szektorából RAM pufferbe olvas, a commit() oda visszaírja
+ * (így a NativeHal flash képfájljával együtt megmarad).
+ */
+class EEPROMClass {
+  public:
+    void begin(size_t size);
+    bool commit();
+    bool end();
+
+    uint8_t read(int address) const { return address >= 0 && (size_t)address < size ? data[address] : 0; }
+    void write(int address, uint8_t value);
+    uint8_t *getDataPtr() { return data; }
+    size_t length() const { return size; }
+
+    template <typename T> T &get(int address, T &t) {
+        if (address >= 0 && address + sizeof(T) <= size) {
+            memcpy(&t, data + address, sizeof(T));
+        }
+        return t;
+    }
+
+    template <typename T> const T &put(int address, const T &t) {
+        if (address >= 0 && address + sizeof(T) <= size) {
+            memcpy(data + address, &t, sizeof(T));
+            dirty = true;
+        }
+        return t;
+    }
+
+  private:
+    uint8_t *data = nullptr;
+    size_t size = 0;
+    bool dirty = false;
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+
+/**
+ * @brief Az arduino-pico LittleFS hoszt helyettesítője: egy hoszt könyvtár (NativeHal::setFsRoot(), alapból "data")
+ *
+ * A "/trafipaxes.csv" a <gyökér>/trafipaxes.csv fájl, így ugyanaz a data/ könyvtár használható, amit a pio
+ * uploadfs a Pico-ra tölt.
+ */
+namespace fs {
+
+class File : public Stream {
+  public:
+    File() = default;
+    File(FILE *handle, const char *path);
+
+    operator bool() const { return handle != nullptr; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t read(uint8_t *buffer, size_t size);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    bool seek(uint32_t position);
+    size_t position() const;
+    size_t size() const;
+    const char *name() const { return path.c_str(); }
+    void close() { handle.reset(); }
+
+  private:
+    std::shared_ptr<FILE> handle; // Az Arduino File másolható, a másolatok ugyanazt a megnyitott fájlt érik el
+    std::string path;
+};
+
+class FS {
+  public:
+    bool begin() { return true; }
+    void end() {}
+    bool exists(const char *path);
+    File open(const char *path, const char *mode);
+    bool remove(const char *path);
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+extern FS LittleFS;
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief A hoszt (native) HAL vezérlése: virtuális óra, az éppen futó mag, a flash képfájl és a LittleFS gyökér
+ *
+ * Csak a hoszt vezérlő (native/src/main.cpp) használja; a mag logika a megszokott Arduino / pico-sdk API-t látja.
+ */
+namespace NativeHal {
+
+/**
+ * @brief A virtuális óra állása (µs a "boot" óta)
+ */
+uint64_t nowMicros();
+
+/**
+ * @brief A virtuális óra léptetése
+ */
+void advanceMicros(uint64_t us);
+
+/**
+ * @brief Melyik mag "fut" (a rp2040.cpuid() ezt adja vissza)
+ */
+void setCore(uint8_t core);
+
+/**
+ * @brief A flash kép betöltése a fájlból, és a további írások visszamentése oda (nullptr: csak a memóriában)
+ *
+ * A nem létező fájl törölt (0xFF) flash-ként indul. A konfig napló és az EEPROM terület így a futások között megmarad.
+ * @return false, ha a fájl nem nyitható meg
+ */
+bool openFlashImage(const char *path);
+
+/**
+ * @brief A LittleFS helyettesítő gyökérkönyvtára
+ */
+void setFsRoot(const char *path);
+
+/**
+ * @brief A LittleFS útvonal -> hoszt útvonal
+ */
+const char *fsPath(const char *path, char *buffer, size_t bufferSize);
+
+/**
+ * @brief A flash törlések / lap programozások száma (a konfig napló kopásának méréséhez)
+ */
+uint32_t getFlashEraseCount();
+uint32_t getFlashProgramCount();
+
+} // namespace NativeHal
@@ -0,0 +1,375 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+/**
+ * @brief A TFT_eSPI hoszt (native) helyettesítője: fej nélküli kijelző memóriabeli keretpufferrel
+ *
+ * A kirajzolás egy RGB565 keretpufferbe megy (setRotation(1) után 480x320, mint az ILI9488 a készüléken), a primitívek
+ * pedig ugyanazokra a cím ablak + pixel folyam lépésekre bomlanak, mint a valódi könyvtárban. Ebből számolja a
+ * képkockánkénti költséget: a kiadott primitíveket, a cím ablakokat, a kiírt (és visszaolvasott) pixeleket és a SPI
+ * buszon átmenő bájtokat (ILI9488: 18 bites szín = 3 bájt/pixel; setWindow = CASET + PASET + RAMWR parancs és adat,
+ * a drawPixel a valódihoz hasonlóan kihagyja a nem változott oszlop/sor címet).
+ *
+ * A betűk:
+ *  - a GLCD (1-es) font a valódi 5x7-es tábla,
+ *  - a betöltött smooth (VLW) font pontos (a Large_Font.h adatával),
+ *  - a free fontok (FreeSans9pt7b, ...) és a 2/4/6/7/8-as beépített fontok adata a TFT_eSPI könyvtárban van, ami a hoszton
+ *    nincs meg: helyettük azonos sormagasságú és közelítő betűszélességű, az 5x7-es glifekből nagyított fontok állnak.
+ *    A szövegek helye, a mezők mérete és a költség így közelítő, de determinisztikus (a referencia képekhez ez kell).
+ *
+ * A sprite-ok (TFT_eSprite, 1/4/8/16 bit) a memóriában rajzolnak, SPI forgalmat csak a pushSprite() okoz.
+ * Az érintés mindig "nincs érintés".
+ */
+
+//--- Színek (RGB565) ---
+#define TFT_BLACK 0x0000
+#define TFT_NAVY 0x000F
+#define TFT_DARKGREEN 0x03E0
+#define TFT_DARKCYAN 0x03EF
+#define TFT_MAROON 0x7800
+#define TFT_PURPLE 0x780F
+#define TFT_OLIVE 0x7BE0
+#define TFT_LIGHTGREY 0xD69A
+#define TFT_DARKGREY 0x7BEF
+#define TFT_BLUE 0x001F
+#define TFT_GREEN 0x07E0
+#define TFT_CYAN 0x07FF
+#define TFT_RED 0xF800
+#define TFT_MAGENTA 0xF81F
+#define TFT_YELLOW 0xFFE0
+#define TFT_WHITE 0xFFFF
+#define TFT_ORANGE 0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK 0xFE19
+#define TFT_BROWN 0x9A60
+#define TFT_GOLD 0xFEA0
+#define TFT_SILVER 0xC618
+#define TFT_SKYBLUE 0x867D
+#define TFT_VIOLET 0x915C
+#define TFT_TRANSPARENT 0x0120
+
+//--- Szöveg horgonypontok ---
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define CL_DATUM 3
+#define MC_DATUM 4
+#define CC_DATUM 4
+#define MR_DATUM 5
+#define CR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+#define L_BASELINE 9
+#define C_BASELINE 10
+#define R_BASELINE 11
+
+#define TFT_WIDTH 320
+#define TFT_HEIGHT 480
+
+/**
+ * @brief Adafruit GFX font glif (a TFT_eSPI elrendezésével, így a valódi font fejlécek is használhatók)
+ */
+typedef struct {
+    uint32_t bitmapOffset;
+    uint8_t width, height;
+    uint8_t xAdvance;
+    int8_t xOffset, yOffset;
+} GFXglyph;
+
+/**
+ * @brief Adafruit GFX font
+ */
+typedef struct {
+    uint8_t *bitmap;
+    GFXglyph *glyph;
+    uint16_t first, last;
+    uint8_t yAdvance;
+} GFXfont;
+
+// A projektben használt free fontok (közelítő, szintetizált glifekkel)
+extern const GFXfont FreeMono9pt7b;
+extern const GFXfont FreeSans9pt7b;
+extern const GFXfont FreeSansBold9pt7b;
+extern const GFXfont FreeSansBold18pt7b;
+extern const GFXfont FreeSansBold24pt7b;
+extern const GFXfont FreeSerifBold24pt7b;
+
+class TFT_eSprite;
+
+/**
+ * @brief Fej nélküli TFT_eSPI
+ */
+class TFT_eSPI : public Print {
+    friend class TFT_eSprite;
+
+  public:
+    /**
+     * @brief A primitív fajták (a költség bontásához)
+     */
+    enum PrimitiveKind : uint8_t { FILL_SCREEN, FILL_RECT, FAST_LINE, LINE, PIXEL, RECT, ROUND_RECT, CIRCLE, TRIANGLE, TEXT, SPRITE, PRIMITIVE_KIND_COUNT };
+
+    /**
+     * @brief A kirajzolás költség számlálói (hoszt kiterjesztés)
+     *
+     * Egy primitív a legkülső API hívás (pl. egy drawString a benne kirajzolt betűkkel és paddinggel együtt egy);
+     * a bontásban a belső lépések költsége is a legkülső hívás fajtájához számít.
+     */
+    struct RenderStats {
+        uint32_t primitives = 0;                         // Kiadott primitívek
+        uint32_t windows = 0;                            // Cím ablak beállítások (setWindow / CASET+PASET+RAMWR)
+        uint32_t pixels = 0;                             // Kiírt pixelek
+        uint32_t pixelReads = 0;                         // Visszaolvasott pixelek (smooth font átlátszó háttérrel)
+        uint32_t spiBytes = 0;                           // A SPI buszon átmenő bájtok (parancs + adat, mindkét irány)
+        uint32_t kindCount[PRIMITIVE_KIND_COUNT] = {};   // Primitívek fajtánként
+        uint32_t kindSpiBytes[PRIMITIVE_KIND_COUNT] = {}; // SPI bájtok fajtánként
+    };
+
+    TFT_eSPI(int16_t width = TFT_WIDTH, int16_t height = TFT_HEIGHT);
+    virtual ~TFT_eSPI() = default;
+
+    void init(uint8_t tc = 0) { begin(tc); }
+    void begin(uint8_t tc = 0);
+    void setRotation(uint8_t rotation);
+    uint8_t getRotation() const { return rotation; }
+    void startWrite() {}
+    void endWrite() {}
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+    //--- Grafikus primitívek ---
+    void fillScreen(uint32_t color);
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+    void drawPixel(int32_t x, int32_t y, uint32_t color);
+    void drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+    void fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+    void drawTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color);
+    void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color);
+    uint16_t readPixel(int32_t x, int32_t y);
+
+    uint16_t color565(uint8_t r, uint8_t g, uint8_t b) const { return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3); }
+    static uint16_t alphaBlend(uint8_t alpha, uint16_t fgc, uint16_t bgc);
+
+    //--- Szöveg ---
+    void setCursor(int16_t x, int16_t y);
+    void setCursor(int16_t x, int16_t y, uint8_t font);
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+    void setTextColor(uint16_t color);
+    void setTextColor(uint16_t fgcolor, uint16_t bgcolor, bool bgfill = false);
+    void setTextSize(uint8_t size) { textsize = size < 1 ? 1 : size; }
+    void setTextDatum(uint8_t datum) { textdatum = datum; }
+    uint8_t getTextDatum() const { return textdatum; }
+    void setTextPadding(uint16_t xWidth) { padX = xWidth; }
+    void setTextWrap(bool wrapX, bool wrapY = false) {}
+    void setTextFont(uint8_t font);
+    void setFreeFont(const GFXfont *font = nullptr);
+
+    int16_t textWidth(const char *string, uint8_t font);
+    int16_t textWidth(const char *string) { return textWidth(string, textfont); }
+    int16_t textWidth(const String &string) { return textWidth(string.c_str(), textfont); }
+    int16_t fontHeight(int16_t font);
+    int16_t fontHeight() { return fontHeight(textfont); }
+
+    int16_t drawString(const char *string, int32_t x, int32_t y, uint8_t font);
+    int16_t drawString(const char *string, int32_t x, int32_t y) { return drawString(string, x, y, textfont); }
+    int16_t drawString(const String &string, int32_t x, int32_t y, uint8_t font) { return drawString(string.c_str(), x, y, font); }
+    int16_t drawString(const String &string, int32_t x, int32_t y) { return drawString(string.c_str(), x, y, textfont); }
+    int16_t drawCentreString(const char *string, int32_t x, int32_t y, uint8_t font);
+    int16_t drawRightString(const char *string, int32_t x, int32_t y, uint8_t font);
+    int16_t drawNumber(long value, int32_t x, int32_t y);
+    int16_t drawFloat(float value, uint8_t decimals, int32_t x, int32_t y);
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    //--- Smooth (VLW) font ---
+    void loadFont(const uint8_t array[]);
+    void unloadFont() { fontLoaded = false; }
+
+    //--- Érintés: fej nélkül nincs ---
+    bool getTouch(uint16_t *x, uint16_t *y, uint16_t threshold = 600) { return false; }
+    uint8_t getTouchRaw(uint16_t *x, uint16_t *y) {
+        *x = *y = 0;
+        return 0;
+    }
+    uint16_t getTouchRawZ() { return 0; }
+    void convertRawXY(uint16_t *x, uint16_t *y) {}
+    void setTouch(uint16_t *data) {}
+    void calibrateTouch(uint16_t *data, uint32_t colorFg, uint32_t colorBg, uint8_t size) {}
+
+    //--- Hoszt kiterjesztések (a valódi TFT_eSPI-ben nincsenek) ---
+
+    /**
+     * @brief A keretpuffer (width() x height() RGB565 pixel, soronként)
+     */
+    const uint16_t *getFramebuffer() const { return framebuffer.data(); }
+
+    /**
+     * @brief A költség számlálók az utolsó resetStats() óta
+     */
+    const RenderStats &getStats() const { return stats; }
+
+    /**
+     * @brief A költség számlálók nullázása (pl. képkocka elején)
+     */
+    void resetStats() { stats = RenderStats(); }
+
+    uint8_t textfont = 1;
+    uint8_t textsize = 1;
+    uint8_t textdatum = TL_DATUM;
+    uint8_t rotation = 0;
+
+  protected:
+    /**
+     * @brief Egy betöltött VLW glif
+     */
+    struct SmoothGlyph {
+        uint32_t unicode;
+        uint16_t height, width;
+        int16_t xAdvance, dY, dX;
+        const uint8_t *bitmap;
+    };
+
+    /**
+     * @brief A legkülső primitív hívás jelölése (a számlálóknak)
+     */
+    class PrimitiveScope {
+      public:
+        PrimitiveScope(TFT_eSPI *tft, PrimitiveKind kind);
+        ~PrimitiveScope() { tft->primitiveDepth--; }
+
+      private:
+        TFT_eSPI *tft;
+    };
+
+    //--- A rajzolási felület (TFT: keretpuffer + SPI költség, sprite: memória) ---
+
+    /**
+     * @brief Egyszínű téglalap kiírása (levágva); TFT-n egy cím ablak + w*h pixel
+     */
+    virtual void writeBlock(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+
+    /**
+     * @brief Egy pixel kiírása; TFT-n a nem változott oszlop/sor cím kimarad
+     */
+    virtual void writePixel(int32_t x, int32_t y, uint32_t color);
+
+    /**
+     * @brief Egy cím ablak kitöltése pixelenként megadott színekkel (levágva); TFT-n egy cím ablak + w*h pixel
+     */
+    virtual void writeWindow(int32_t x, int32_t y, int32_t w, int32_t h, const uint32_t *colors);
+
+    /**
+     * @brief Pixel visszaolvasása RGB565-ben; TFT-n SPI olvasás
+     */
+    virtual uint16_t readRgb(int32_t x, int32_t y);
+
+    /**
+     * @brief RGB565 képtartalom kiírása (a sprite-ok pushSprite()-ja); transparent: ez a szín kimarad
+     */
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data, int32_t stride, int32_t transparent = -1);
+
+    void countWindow(uint32_t commandBytes);
+    void countPixels(uint32_t count);
+
+    // Szöveg belső lépései
+    const uint8_t *glcdGlyph(uint32_t c) const;
+    const GFXfont *builtinFont(uint8_t font) const;
+    int16_t drawGlcdChar(uint32_t c, int32_t x, int32_t y);
+    int16_t drawGfxChar(const GFXfont *font, uint32_t c, int32_t x, int32_t y);
+    int16_t drawBuiltinChar(uint8_t font, uint32_t c, int32_t x, int32_t y);
+    void drawGlyph(uint32_t code);
+    const SmoothGlyph *findGlyph(uint32_t code) const;
+    static uint32_t decodeUTF8(const char *&string);
+
+    // Alakzat segédek (a valódi TFT_eSPI algoritmusai)
+    void drawCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t cornername, uint32_t color);
+    void fillCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t cornername, int32_t delta, uint32_t color);
+
+    int32_t initWidth, initHeight;
+    int32_t _width, _height;
+    std::vector<uint16_t> framebuffer;
+
+    uint32_t textcolor = TFT_WHITE;
+    uint32_t textbgcolor = TFT_BLACK;
+    bool fillbg = false;
+    int32_t cursor_x = 0, cursor_y = 0, bg_cursor_x = 0;
+    uint16_t padX = 0;
+    const GFXfont *gfxFont = nullptr;
+    uint8_t glyph_ab = 0, glyph_bb = 0; // A free font alapvonal feletti / alatti legnagyobb kiterjedése
+
+    // Betöltött smooth font
+    bool fontLoaded = false;
+    struct {
+        uint16_t yAdvance, spaceWidth, ascent, descent, maxAscent, maxDescent;
+    } gFont = {};
+    std::vector<SmoothGlyph> smoothGlyphs;
+
+    // Költség
+    RenderStats stats;
+    uint8_t primitiveDepth = 0;
+    PrimitiveKind currentKind = FILL_RECT;
+    uint32_t addrCol = 0xFFFFFFFF, addrRow = 0xFFFFFFFF; // A drawPixel cím gyorsítótára (setWindow érvényteleníti)
+};
+
+/**
+ * @brief Memóriabeli sprite
+ *
+ * A színmélység 16 (RGB565), 8 (RGB332), 4 (16 elemű paletta index) vagy 1 bit; 4 bitnél a rajzoló függvények
+ * színe a paletta index, mint a valódi könyvtárban.
+ */
+class TFT_eSprite : public TFT_eSPI {
+  public:
+    explicit TFT_eSprite(TFT_eSPI *tft);
+
+    void *setColorDepth(int8_t depth);
+    int8_t getColorDepth() const { return colorDepth; }
+    void *createSprite(int16_t width, int16_t height, uint8_t frames = 1);
+    void deleteSprite();
+    bool created() const { return isCreated; }
+    void *getPointer() { return isCreated ? pixels.data() : nullptr; }
+
+    void createPalette(uint16_t *colorMap, uint8_t colors = 16) { createPalette(static_cast<const uint16_t *>(colorMap), colors); }
+    void createPalette(const uint16_t *colorMap, uint8_t colors = 16);
+    void setPaletteColor(uint8_t index, uint16_t color) { palette[index & 0x0F] = color; }
+    uint16_t getPaletteColor(uint8_t index) const { return palette[index & 0x0F]; }
+    void setBitmapColor(uint16_t foreground, uint16_t background) {
+        bitmapFg = foreground;
+        bitmapBg = background;
+    }
+
+    void fillSprite(uint32_t color);
+    void pushSprite(int32_t x, int32_t y);
+    void pushSprite(int32_t x, int32_t y, uint16_t transparent);
+    bool pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
+
+  protected:
+    void writeBlock(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override;
+    void writePixel(int32_t x, int32_t y, uint32_t color) override { writeBlock(x, y, 1, 1, color); }
+    void writeWindow(int32_t x, int32_t y, int32_t w, int32_t h, const uint32_t *colors) override;
+    uint16_t readRgb(int32_t x, int32_t y) override;
+
+  private:
+    /**
+     * @brief Egy tárolt pixel RGB565-ben
+     */
+    uint16_t toRgb(uint16_t stored) const;
+
+    TFT_eSPI *tft;
+    int8_t colorDepth = 16;
+    bool isCreated = false;
+    std::vector<uint16_t> pixels; // A tárolt érték (RGB565 / RGB332 / index / bit)
+    uint16_t palette[16];
+    uint16_t bitmapFg = TFT_WHITE, bitmapBg = TFT_BLACK;
+};
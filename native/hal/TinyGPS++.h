@@ -0,0 +1,211 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief A TinyGPSPlus könyvtár hoszt (native) helyettesítője
+ *
+ * A native envek nem húzzák be a könyvtárat (a képernyő referencia képek és a visszajátszás is ezzel a változattal
+ * készülnek, így nem függenek a könyvtár verziójától). Csak a projektben használt felület: a GPRMC/GNRMC és a
+ * GPGGA/GNGGA mondatok mezői a könyvtár szerinti egységekben (a tizedes mezők századokban), a TinyGPSCustom mezők
+ * (GSV, időbélyegek), a checksum számlálók és a távolság/irány számítás. A mezők a könyvtárhoz hasonlóan csak helyes
+ * checksum esetén, a mondat végén kerülnek át (commit); a pozíció, a sebesség és az irány csak érvényes fix-szel.
+ */
+
+/**
+ * @brief Közös mező állapot: érvényesség, frissülés, utolsó commit ideje
+ */
+struct TinyGPSField {
+    bool isValid() const { return valid; }
+    bool isUpdated() const { return updated; }
+    uint32_t age() const { return valid ? millis() - lastCommitTime : UINT32_MAX; }
+
+    void commit() {
+        valid = updated = true;
+        lastCommitTime = millis();
+    }
+
+  protected:
+    bool valid = false;
+    bool updated = false;
+    uint32_t lastCommitTime = 0;
+};
+
+struct TinyGPSLocation : TinyGPSField {
+    enum Quality { Invalid = '0', GPS = '1', DGPS = '2', PPS = '3', RTK = '4', FloatRTK = '5', Estimated = '6', Manual = '7', Simulated = '8' };
+    enum Mode { N = 'N', A = 'A', D = 'D', E = 'E' };
+
+    double lat() {
+        updated = false;
+        return latitude;
+    }
+    double lng() {
+        updated = false;
+        return longitude;
+    }
+    Quality FixQuality() { return fixQuality; }
+    Mode FixMode() { return fixMode; }
+
+    double latitude = 0.0;
+    double longitude = 0.0;
+    Quality fixQuality = Invalid;
+    Mode fixMode = N;
+};
+
+struct TinyGPSDate : TinyGPSField {
+    uint32_t value() {
+        updated = false;
+        return date; // ddmmyy
+    }
+    uint16_t year() {
+        updated = false;
+        return date % 100 + 2000;
+    }
+    uint8_t month() {
+        updated = false;
+        return (date / 100) % 100;
+    }
+    uint8_t day() {
+        updated = false;
+        return date / 10000;
+    }
+
+    uint32_t date = 0;
+};
+
+struct TinyGPSTime : TinyGPSField {
+    uint32_t value() {
+        updated = false;
+        return time; // hhmmsscc
+    }
+    uint8_t hour() {
+        updated = false;
+        return time / 1000000;
+    }
+    uint8_t minute() {
+        updated = false;
+        return (time / 10000) % 100;
+    }
+    uint8_t second() {
+        updated = false;
+        return (time / 100) % 100;
+    }
+    uint8_t centisecond() {
+        updated = false;
+        return time % 100;
+    }
+
+    uint32_t time = 0;
+};
+
+struct TinyGPSDecimal : TinyGPSField {
+    int32_t value() {
+        updated = false;
+        return val; // századokban
+    }
+
+    int32_t val = 0;
+};
+
+struct TinyGPSInteger : TinyGPSField {
+    uint32_t value() {
+        updated = false;
+        return val;
+    }
+
+    uint32_t val = 0;
+};
+
+struct TinyGPSSpeed : TinyGPSDecimal {
+    double knots() { return value() / 100.0; }
+    double mph() { return 1.15077945 * value() / 100.0; }
+    double mps() { return 0.51444444 * value() / 100.0; }
+    double kmph() { return 1.852 * value() / 100.0; }
+};
+
+struct TinyGPSCourse : TinyGPSDecimal {
+    double deg() { return value() / 100.0; }
+};
+
+struct TinyGPSAltitude : TinyGPSDecimal {
+    double meters() { return value() / 100.0; }
+};
+
+struct TinyGPSHDOP : TinyGPSDecimal {
+    double hdop() { return value() / 100.0; }
+};
+
+class TinyGPSPlus;
+
+/**
+ * @brief Tetszőleges mondat egy mezője szövegként (a mező indexe a mondat neve után 1-től)
+ */
+class TinyGPSCustom {
+  public:
+    TinyGPSCustom() = default;
+    TinyGPSCustom(TinyGPSPlus &gps, const char *sentenceName, int termNumber) { begin(gps, sentenceName, termNumber); }
+    void begin(TinyGPSPlus &gps, const char *sentenceName, int termNumber);
+
+    bool isUpdated() const { return updated; }
+    bool isValid() const { return valid; }
+    uint32_t age() const { return valid ? millis() - lastCommitTime : UINT32_MAX; }
+    const char *value() {
+        updated = false;
+        return buffer;
+    }
+
+  private:
+    friend class TinyGPSPlus;
+    static constexpr size_t MAX_FIELD_SIZE = 15;
+
+    char sentenceName[8] = {};
+    int termNumber = 0;
+    char buffer[MAX_FIELD_SIZE + 1] = {};
+    bool valid = false;
+    bool updated = false;
+    uint32_t lastCommitTime = 0;
+    TinyGPSCustom *next = nullptr;
+};
+
+class TinyGPSPlus {
+  public:
+    /**
+     * @brief Egy bájt feldolgozása
+     * @return true, ha a bájt egy helyes checksum-ú mondatot zárt le
+     */
+    bool encode(char c);
+
+    TinyGPSLocation location;
+    TinyGPSDate date;
+    TinyGPSTime time;
+    TinyGPSSpeed speed;
+    TinyGPSCourse course;
+    TinyGPSAltitude altitude;
+    TinyGPSInteger satellites;
+    TinyGPSHDOP hdop;
+
+    static double distanceBetween(double lat1, double long1, double lat2, double long2);
+    static double courseTo(double lat1, double long1, double lat2, double long2);
+
+    uint32_t charsProcessed() const { return encodedCharCount; }
+    uint32_t sentencesWithFix() const { return sentencesWithFixCount; }
+    uint32_t failedChecksum() const { return failedChecksumCount; }
+    uint32_t passedChecksum() const { return passedChecksumCount; }
+
+  private:
+    friend class TinyGPSCustom;
+    static constexpr size_t MAX_SENTENCE_SIZE = 120;
+    static constexpr uint8_t MAX_TERMS = 24;
+
+    bool endOfSentence();
+
+    char sentence[MAX_SENTENCE_SIZE + 1] = {};
+    size_t sentenceLength = 0;
+    bool inSentence = false;
+    TinyGPSCustom *customs = nullptr;
+
+    uint32_t encodedCharCount = 0;
+    uint32_t sentencesWithFixCount = 0;
+    uint32_t failedChecksumCount = 0;
+    uint32_t passedChecksumCount = 0;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <hardware/regs/addressmap.h>
+
+/**
+ * @brief A pico-sdk flash API hoszt helyettesítője: a NativeHal flash képét írja (és a képfájlba menti)
+ */
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+void flash_range_erase(uint32_t flashOffset, size_t count);
+void flash_range_program(uint32_t flashOffset, const uint8_t *data, size_t count);
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <pico/types.h>
+
+/**
+ * @brief A PIO típusai (a StatusLed fejlécéhez; a hoszton nincs PIO, a StatusLed helyettesítője nem használja)
+ */
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
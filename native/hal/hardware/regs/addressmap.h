@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief A flash XIP ablak a hoszton: a NativeHal flash képének címe
+ *
+ * A NOALLOC alias a hoszton nem létezik (az XIP_BASE-zel egyezik), így az Utils::xipNoAlloc() a címet nem módosítja.
+ */
+#define NATIVE_FLASH_SIZE (2 * 1024 * 1024) // A Pico Zero 2MB-os flash-e
+
+extern "C" uint8_t nativeFlashImage[NATIVE_FLASH_SIZE];
+
+#define XIP_BASE (reinterpret_cast<uintptr_t>(nativeFlashImage))
+#define XIP_NOALLOC_BASE XIP_BASE
@@ -0,0 +1,12 @@
+#pragma once
+
+/**
+ * @brief A pico-sdk critical section hoszt helyettesítője: a két mag egy szálon fut, nincs mit kizárni
+ */
+typedef struct {
+    bool locked;
+} critical_section_t;
+
+inline void critical_section_init(critical_section_t *cs) { cs->locked = false; }
+inline void critical_section_enter_blocking(critical_section_t *cs) { cs->locked = true; }
+inline void critical_section_exit(critical_section_t *cs) { cs->locked = false; }
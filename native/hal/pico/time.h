@@ -0,0 +1,23 @@
+#pragma once
+
+#include <pico/types.h>
+
+/**
+ * @brief A pico-sdk időkezelés hoszt helyettesítője: a NativeHal virtuális órájára épül
+ */
+
+uint64_t time_us_64();
+
+inline absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+
+/**
+ * @brief Az ütemező alvása: az időt a hoszt vezérlő lépteti, így azonnal visszatér (a határidő "lejárt")
+ */
+inline bool best_effort_wfe_or_timeout(absolute_time_t timeout) { return true; }
+
+inline void __sev() {}
+inline void __wfe() {}
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *userData);
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
@@ -0,0 +1,40 @@
+/**
+ * A képernyők által használt hardveres osztályok hoszt helyettesítői
+ *
+ * A SensorUtils, a TftBackLightAdjuster és a hangjelzés valódi megvalósítása ADC-t, PIO-t, PWM-et és alarmot használ, ezek
+ * helyett itt a NativeRender forgatókönyv értékei állnak. Csak azokat a tagfüggvényeket definiálja, amiket a fejlécek
+ * nem adnak meg inline-ként.
+ */
+#include "Config.h"
+#include "NativeRender.h"
+#include "SensorUtils.h"
+#include "TftBackLightAdjuster.h"
+#include "Utils.h"
+
+namespace NativeRender {
+
+Sensors &sensors() {
+    static Sensors values;
+    return values;
+}
+
+} // namespace NativeRender
+
+//--- SensorUtils ---
+void SensorUtils::init() {}
+void SensorUtils::loop() {}
+float SensorUtils::readVBusExternal() { return NativeRender::sensors().vbus; }
+float SensorUtils::readVSysExternal() { return NativeRender::sensors().vsys; }
+float SensorUtils::readCoreTemperature() { return NativeRender::sensors().coreTemperature; }
+float SensorUtils::readExternalTemperature(uint8_t index) { return NativeRender::sensors().externalTemperature; }
+
+//--- TftBackLightAdjuster: nincs PWM, csak a téma váltás ---
+TftBackLightAdjuster::~TftBackLightAdjuster() { config.unregisterCallback(configCallbackId); }
+void TftBackLightAdjuster::begin() {}
+void TftBackLightAdjuster::onConfigChanged(ConfigFieldMask changed) {}
+void TftBackLightAdjuster::updateTarget() { _nightTheme = NativeRender::sensors().nightTheme; }
+
+//--- Hangjelzés: néma ---
+namespace Utils {
+void beepTick() {}
+} // namespace Utils
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief A hardveres osztályok (szenzorok, háttérvilágítás, hang) hoszt helyettesítőinek forgatókönyv értékei
+ *
+ * A renderelő futtató (native/render/main.cpp) lépésenként állítja őket, a képernyők a valódi API-n keresztül olvassák.
+ * Alapból a futásról futásra azonos, "átlagos" értékek: így a referencia képeken csak a szándékolt változás látszik.
+ */
+namespace NativeRender {
+
+struct Sensors {
+    float vbus = 5.02f;                // SensorUtils::readVBusExternal() [V]
+    float vsys = 4.71f;                // SensorUtils::readVSysExternal() [V]
+    float externalTemperature = 21.5f; // SensorUtils::readExternalTemperature() [°C]
+    float coreTemperature = 34.25f;    // SensorUtils::readCoreTemperature() [°C]
+    bool nightTheme = false;           // TftBackLightAdjuster::isNightTheme() a következő updateTarget() után
+};
+
+/**
+ * @brief A jelenlegi forgatókönyv értékek (írható)
+ */
+Sensors &sensors();
+
+/**
+ * @brief A renderelő futtatás beállításai (a parancssori kapcsolók, ld. main.cpp)
+ */
+struct RunOptions {
+    bool quiet = false;               // -q: a DEBUG kimenet elnémítása
+    bool verbose = false;             // -v: költség primitív fajtánként
+    bool update = false;              // -u: a referencia képek és a keret fájl felülírása
+    const char *outDir = nullptr;     // -o: a renderelt és a diff képek könyvtára
+    const char *goldenDir = nullptr;  // -g: a referencia képek könyvtára
+    const char *budgetFile = nullptr; // -b: a SPI bájt keret fájl
+};
+
+/**
+ * @brief A forgatókönyv lefuttatása, a lépések táblázata a kimenetre (folyamatonként egyszer hívható)
+ * @return A hibás ellenőrzések száma (eltérő vagy hiányzó kép, túllépett vagy hiányzó keret), -1 ha a kimenet nem írható
+ */
+int run(const RunOptions &options);
+
+} // namespace NativeRender
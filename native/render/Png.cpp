@@ -0,0 +1,549 @@
+#include "Png.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+// Deflate hossz és távolság kódok (RFC 1951 3.2.5)
+const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+const uint8_t CODE_LENGTH_ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+constexpr uint16_t WINDOW_SIZE = 32768;
+constexpr uint16_t MAX_MATCH = 258;
+constexpr uint8_t MIN_MATCH = 3;
+constexpr uint8_t HASH_BITS = 15;
+constexpr uint16_t MAX_CHAIN = 64; // Ennyi korábbi előfordulást néz meg pozíciónként (sebesség / tömörítés)
+
+uint32_t crc32(const uint8_t *data, size_t length, uint32_t crc = 0) {
+    static uint32_t table[256];
+    if (table[1] == 0) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (uint8_t k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t adler32(const uint8_t *data, size_t length) {
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < length; i++) {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+void putBigEndian(std::vector<uint8_t> &out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(value >> shift);
+    }
+}
+
+uint32_t getBigEndian(const uint8_t *data) { return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3]; }
+
+/**
+ * @brief Bitfolyam író (deflate: LSB először)
+ */
+class BitWriter {
+  public:
+    explicit BitWriter(std::vector<uint8_t> &out) : out(out) {}
+
+    void bits(uint32_t value, uint8_t count) {
+        buffer |= value << used;
+        used += count;
+        while (used >= 8) {
+            out.push_back(buffer & 0xFF);
+            buffer >>= 8;
+            used -= 8;
+        }
+    }
+
+    // A Huffman kódok MSB először kerülnek a folyamba
+    void code(uint32_t code, uint8_t length) {
+        uint32_t reversed = 0;
+        for (uint8_t i = 0; i < length; i++) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        bits(reversed, length);
+    }
+
+    void flush() {
+        if (used > 0) {
+            out.push_back(buffer & 0xFF);
+        }
+        buffer = 0;
+        used = 0;
+    }
+
+  private:
+    std::vector<uint8_t> &out;
+    uint32_t buffer = 0;
+    uint8_t used = 0;
+};
+
+/**
+ * @brief Literál/hossz szimbólum a fix Huffman táblával (RFC 1951 3.2.6)
+ */
+void fixedLiteral(BitWriter &writer, uint16_t symbol) {
+    if (symbol < 144) {
+        writer.code(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        writer.code(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        writer.code(symbol - 256, 7);
+    } else {
+        writer.code(0xC0 + symbol - 280, 8);
+    }
+}
+
+void fixedMatch(BitWriter &writer, uint16_t length, uint16_t distance) {
+    uint8_t l = 28;
+    while (LENGTH_BASE[l] > length) {
+        l--;
+    }
+    fixedLiteral(writer, 257 + l);
+    writer.bits(length - LENGTH_BASE[l], LENGTH_EXTRA[l]);
+
+    uint8_t d = 29;
+    while (DIST_BASE[d] > distance) {
+        d--;
+    }
+    writer.code(d, 5);
+    writer.bits(distance - DIST_BASE[d], DIST_EXTRA[d]);
+}
+
+/**
+ * @brief zlib folyam: egyetlen fix Huffman blokk, mohó LZ77 illesztés hash láncokkal
+ */
+std::vector<uint8_t> deflate(const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> out = {0x78, 0x01};
+    BitWriter writer(out);
+    writer.bits(1, 1); // BFINAL
+    writer.bits(1, 2); // BTYPE = fix Huffman
+
+    std::vector<int32_t> head(1 << HASH_BITS, -1);
+    std::vector<int32_t> previous(WINDOW_SIZE, -1);
+    auto hash = [&](size_t i) { return ((data[i] << 10) ^ (data[i + 1] << 5) ^ data[i + 2]) & ((1 << HASH_BITS) - 1); };
+    auto insert = [&](size_t i) {
+        if (i + MIN_MATCH <= data.size()) {
+            uint32_t h = hash(i);
+            previous[i % WINDOW_SIZE] = head[h];
+            head[h] = i;
+        }
+    };
+
+    size_t i = 0;
+    while (i < data.size()) {
+        uint16_t bestLength = 0;
+        uint16_t bestDistance = 0;
+        if (i + MIN_MATCH <= data.size()) {
+            size_t maxLength = std::min<size_t>(MAX_MATCH, data.size() - i);
+            int32_t candidate = head[hash(i)];
+            for (uint16_t chain = 0; candidate >= 0 && i - candidate <= WINDOW_SIZE - 1 && chain < MAX_CHAIN; chain++) {
+                uint16_t length = 0;
+                while (length < maxLength && data[candidate + length] == data[i + length]) {
+                    length++;
+                }
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDistance = i - candidate;
+                    if (length == maxLength) {
+                        break;
+                    }
+                }
+                int32_t next = previous[candidate % WINDOW_SIZE];
+                if (next >= candidate) {
+                    break; // A körpuffer már felülírta
+                }
+                candidate = next;
+            }
+        }
+
+        if (bestLength >= MIN_MATCH) {
+            fixedMatch(writer, bestLength, bestDistance);
+            for (uint16_t k = 0; k < bestLength; k++) {
+                insert(i + k);
+            }
+            i += bestLength;
+        } else {
+            fixedLiteral(writer, data[i]);
+            insert(i);
+            i++;
+        }
+    }
+    fixedLiteral(writer, 256); // Blokk vége
+    writer.flush();
+    putBigEndian(out, adler32(data.data(), data.size()));
+    return out;
+}
+
+void writeChunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &data) {
+    putBigEndian(png, data.size());
+    size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    putBigEndian(png, crc32(&png[start], png.size() - start));
+}
+
+/**
+ * @brief Bitfolyam olvasó
+ */
+class BitReader {
+  public:
+    BitReader(const uint8_t *data, size_t length) : data(data), length(length) {}
+
+    bool bits(uint8_t count, uint32_t &value) {
+        value = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            if (position >= length * 8) {
+                return false;
+            }
+            value |= ((data[position >> 3] >> (position & 7)) & 1) << i;
+            position++;
+        }
+        return true;
+    }
+
+    void alignToByte() { position = (position + 7) & ~(size_t)7; }
+    size_t bytePosition() const { return position >> 3; }
+    void skipBytes(size_t count) { position += count * 8; }
+    const uint8_t *bytes() const { return data; }
+    size_t size() const { return length; }
+
+  private:
+    const uint8_t *data;
+    size_t length;
+    size_t position = 0;
+};
+
+/**
+ * @brief Kanonikus Huffman dekódoló (kódhosszanként számolt, RFC 1951 3.2.2)
+ */
+class Huffman {
+  public:
+    bool build(const uint8_t *lengths, uint16_t count) {
+        memset(counts, 0, sizeof(counts));
+        for (uint16_t i = 0; i < count; i++) {
+            counts[lengths[i]]++;
+        }
+        counts[0] = 0;
+        uint16_t offsets[16] = {};
+        for (uint8_t bits = 1; bits < 15; bits++) {
+            offsets[bits + 1] = offsets[bits] + counts[bits];
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            if (lengths[i]) {
+                symbols[offsets[lengths[i]]++] = i;
+            }
+        }
+        return true;
+    }
+
+    bool decode(BitReader &reader, uint16_t &symbol) const {
+        int32_t code = 0, first = 0, index = 0;
+        for (uint8_t bits = 1; bits <= 15; bits++) {
+            uint32_t bit;
+            if (!reader.bits(1, bit)) {
+                return false;
+            }
+            code |= bit;
+            int32_t count = counts[bits];
+            if (code - count < first) {
+                symbol = symbols[index + (code - first)];
+                return true;
+            }
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        return false;
+    }
+
+  private:
+    uint16_t counts[16];
+    uint16_t symbols[288];
+};
+
+bool inflateBlock(BitReader &reader, const Huffman &literals, const Huffman &distances, std::vector<uint8_t> &out) {
+    for (;;) {
+        uint16_t symbol;
+        if (!literals.decode(reader, symbol)) {
+            return false;
+        }
+        if (symbol < 256) {
+            out.push_back(symbol);
+        } else if (symbol == 256) {
+            return true;
+        } else {
+            symbol -= 257;
+            if (symbol >= 29) {
+                return false;
+            }
+            uint32_t extra;
+            if (!reader.bits(LENGTH_EXTRA[symbol], extra)) {
+                return false;
+            }
+            uint16_t length = LENGTH_BASE[symbol] + extra;
+            uint16_t distanceSymbol;
+            if (!distances.decode(reader, distanceSymbol) || distanceSymbol >= 30 || !reader.bits(DIST_EXTRA[distanceSymbol], extra)) {
+                return false;
+            }
+            size_t distance = DIST_BASE[distanceSymbol] + extra;
+            if (distance > out.size()) {
+                return false;
+            }
+            for (uint16_t k = 0; k < length; k++) {
+                out.push_back(out[out.size() - distance]);
+            }
+        }
+    }
+}
+
+bool inflate(const std::vector<uint8_t> &zlib, std::vector<uint8_t> &out) {
+    if (zlib.size() < 6 || (zlib[0] & 0x0F) != 8 || ((zlib[0] << 8) | zlib[1]) % 31 != 0) {
+        return false;
+    }
+    BitReader reader(zlib.data() + 2, zlib.size() - 2);
+    uint32_t final, type;
+    do {
+        if (!reader.bits(1, final) || !reader.bits(2, type)) {
+            return false;
+        }
+        if (type == 0) {
+            // Tárolt blokk
+            reader.alignToByte();
+            size_t at = reader.bytePosition();
+            if (at + 4 > reader.size()) {
+                return false;
+            }
+            uint16_t length = reader.bytes()[at] | (reader.bytes()[at + 1] << 8);
+            if (at + 4 + length > reader.size()) {
+                return false;
+            }
+            out.insert(out.end(), reader.bytes() + at + 4, reader.bytes() + at + 4 + length);
+            reader.skipBytes(4 + length);
+        } else if (type == 1) {
+            uint8_t lengths[288 + 30];
+            memset(lengths, 8, 144);
+            memset(lengths + 144, 9, 112);
+            memset(lengths + 256, 7, 24);
+            memset(lengths + 280, 8, 8);
+            memset(lengths + 288, 5, 30);
+            Huffman literals, distances;
+            literals.build(lengths, 288);
+            distances.build(lengths + 288, 30);
+            if (!inflateBlock(reader, literals, distances, out)) {
+                return false;
+            }
+        } else if (type == 2) {
+            uint32_t hlit, hdist, hclen;
+            if (!reader.bits(5, hlit) || !reader.bits(5, hdist) || !reader.bits(4, hclen)) {
+                return false;
+            }
+            hlit += 257;
+            hdist += 1;
+            hclen += 4;
+            uint8_t codeLengths[19] = {};
+            for (uint8_t i = 0; i < hclen; i++) {
+                uint32_t value;
+                if (!reader.bits(3, value)) {
+                    return false;
+                }
+                codeLengths[CODE_LENGTH_ORDER[i]] = value;
+            }
+            Huffman lengthCodes;
+            lengthCodes.build(codeLengths, 19);
+
+            uint8_t lengths[288 + 32] = {};
+            uint16_t count = 0;
+            while (count < hlit + hdist) {
+                uint16_t symbol;
+                if (!lengthCodes.decode(reader, symbol)) {
+                    return false;
+                }
+                uint32_t repeat;
+                uint8_t value = 0;
+                if (symbol < 16) {
+                    lengths[count++] = symbol;
+                    continue;
+                } else if (symbol == 16) {
+                    if (count == 0 || !reader.bits(2, repeat)) {
+                        return false;
+                    }
+                    value = lengths[count - 1];
+                    repeat += 3;
+                } else if (symbol == 17) {
+                    if (!reader.bits(3, repeat)) {
+                        return false;
+                    }
+                    repeat += 3;
+                } else {
+                    if (!reader.bits(7, repeat)) {
+                        return false;
+                    }
+                    repeat += 11;
+                }
+                if (count + repeat > hlit + hdist) {
+                    return false;
+                }
+                while (repeat--) {
+                    lengths[count++] = value;
+                }
+            }
+            Huffman literals, distances;
+            literals.build(lengths, hlit);
+            distances.build(lengths + hlit, hdist);
+            if (!inflateBlock(reader, literals, distances, out)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    } while (!final);
+    return true;
+}
+
+uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    int p = a + b - c;
+    int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    return (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+}
+
+} // namespace
+
+namespace Png {
+
+bool write(const char *path, const uint8_t *rgb, uint16_t width, uint16_t height) {
+    // Szűrő nélküli sorok (minden sor elején 0 szűrő bájt)
+    std::vector<uint8_t> raw;
+    raw.reserve((size_t)height * (width * 3 + 1));
+    for (uint16_t y = 0; y < height; y++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb + (size_t)y * width * 3, rgb + (size_t)(y + 1) * width * 3);
+    }
+
+    std::vector<uint8_t> png(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+    std::vector<uint8_t> header;
+    putBigEndian(header, width);
+    putBigEndian(header, height);
+    header.insert(header.end(), {8, 2, 0, 0, 0}); // 8 bit, RGB, deflate, szűrő 0, nincs interlace
+    writeChunk(png, "IHDR", header);
+    writeChunk(png, "IDAT", deflate(raw));
+    writeChunk(png, "IEND", {});
+
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(png.data(), 1, png.size(), file) == png.size();
+    return fclose(file) == 0 && ok;
+}
+
+bool read(const char *path, std::vector<uint8_t> &rgb, uint16_t &width, uint16_t &height) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::vector<uint8_t> png;
+    uint8_t buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        png.insert(png.end(), buffer, buffer + length);
+    }
+    fclose(file);
+
+    if (png.size() < sizeof(SIGNATURE) || memcmp(png.data(), SIGNATURE, sizeof(SIGNATURE)) != 0) {
+        return false;
+    }
+
+    // Darabok: IHDR, IDAT (több is lehet), a többi kihagyva
+    uint8_t channels = 0;
+    uint32_t imageWidth = 0, imageHeight = 0;
+    std::vector<uint8_t> zlib;
+    for (size_t at = sizeof(SIGNATURE); at + 12 <= png.size();) {
+        uint32_t chunkLength = getBigEndian(&png[at]);
+        if (at + 12 + chunkLength > png.size()) {
+            return false;
+        }
+        const uint8_t *type = &png[at + 4];
+        const uint8_t *data = &png[at + 8];
+        if (memcmp(type, "IHDR", 4) == 0 && chunkLength >= 13) {
+            imageWidth = getBigEndian(data);
+            imageHeight = getBigEndian(data + 4);
+            uint8_t bitDepth = data[8], colorType = data[9], interlace = data[12];
+            if (bitDepth != 8 || interlace != 0 || (colorType != 2 && colorType != 6) || imageWidth > 0xFFFF || imageHeight > 0xFFFF) {
+                return false;
+            }
+            channels = colorType == 6 ? 4 : 3;
+        } else if (memcmp(type, "IDAT", 4) == 0) {
+            zlib.insert(zlib.end(), data, data + chunkLength);
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        at += 12 + chunkLength;
+    }
+
+    std::vector<uint8_t> raw;
+    size_t stride = (size_t)imageWidth * channels;
+    if (channels == 0 || !inflate(zlib, raw) || raw.size() < (stride + 1) * imageHeight) {
+        return false;
+    }
+
+    // Sorszűrők visszafejtése helyben
+    for (uint32_t y = 0; y < imageHeight; y++) {
+        uint8_t filter = raw[y * (stride + 1)];
+        uint8_t *row = &raw[y * (stride + 1) + 1];
+        const uint8_t *above = y > 0 ? row - (stride + 1) : nullptr;
+        for (size_t x = 0; x < stride; x++) {
+            uint8_t a = x >= channels ? row[x - channels] : 0;
+            uint8_t b = above ? above[x] : 0;
+            uint8_t c = (above && x >= channels) ? above[x - channels] : 0;
+            switch (filter) {
+                case 0:
+                    break;
+                case 1:
+                    row[x] += a;
+                    break;
+                case 2:
+                    row[x] += b;
+                    break;
+                case 3:
+                    row[x] += (a + b) / 2;
+                    break;
+                case 4:
+                    row[x] += paeth(a, b, c);
+                    break;
+                default:
+                    return false;
+            }
+        }
+    }
+
+    width = imageWidth;
+    height = imageHeight;
+    rgb.resize((size_t)width * height * 3);
+    for (uint32_t y = 0; y < imageHeight; y++) {
+        const uint8_t *row = &raw[y * (stride + 1) + 1];
+        for (uint32_t x = 0; x < imageWidth; x++) {
+            memcpy(&rgb[((size_t)y * width + x) * 3], row + x * channels, 3);
+        }
+    }
+    return true;
+}
+
+} // namespace Png
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Minimális PNG író/olvasó a renderelt képekhez (külső könyvtár nélkül)
+ *
+ * Írás: 8 bites RGB, szűrő nélkül, fix Huffman kódos deflate LZ77 hash láncokkal (a UI képek nagy egyszínű felületei
+ * jól tömörödnek). Olvasás: 8 bites RGB és RGBA (az alfa eldobva), mind az öt sorszűrő, tárolt, fix és dinamikus
+ * Huffman blokkok, így a más eszközzel újramentett referencia képek is beolvashatók. Interlace és paletta nincs.
+ */
+namespace Png {
+
+/**
+ * @brief RGB888 kép mentése
+ * @param rgb width * height * 3 bájt, soronként balról jobbra
+ * @return false, ha a fájl nem írható
+ */
+bool write(const char *path, const uint8_t *rgb, uint16_t width, uint16_t height);
+
+/**
+ * @brief Kép beolvasása RGB888-ként
+ * @return false, ha a fájl nem létezik, sérült vagy nem támogatott formátumú
+ */
+bool read(const char *path, std::vector<uint8_t> &rgb, uint16_t &width, uint16_t &height);
+
+} // namespace Png
@@ -0,0 +1,732 @@
+/**
+ * Hoszt (native) renderelő: a képernyők fej nélküli kirajzolása forgatókönyv szerinti adatokkal
+ *
+ * A ScreenMain, a ScreenSats, a ScreenInfo és a dialógusok a valódi kódjukkal rajzolnak a TFT_eSPI hoszt helyettesítőjébe
+ * (native/hal/TFT_eSPI.h), az adatokat pedig a valódi út adja: a forgatókönyv NMEA mondatai a GPS soros portra mennek,
+ * a GpsManager dolgozza fel őket a Core1 ütemezőn, a képernyők a Core0 "ui" feladatában kapják az eseményeket (mint a
+ * ScreenManager-ben). A szenzorok és a téma a NativeRender értékekből jönnek, a traffipax riasztás esemény a
+ * forgatókönyvből.
+ *
+ * Minden lépés után a keretpuffer egy PNG kép, a lépés költsége pedig a UI körök (képkockák) SPI forgalma: a lépés összesen
+ * és a legdrágább képkocka. Referencia könyvtárral a képek pixelre egyeznek-e (eltérés esetén a kimeneti könyvtárba egy
+ * diff kép is kerül), keret fájllal a legdrágább képkocka belefér-e a lépés SPI bájt keretébe. Bármelyik hiba: kilépési kód 1.
+ *
+ * Használat:
+ *   pio run -e native_render
+ *   .pio/build/native_render/program [-q] [-v] [-o out] [-g golden] [-b budgets.txt] [-u]
+ *
+ *   -q  a DEBUG kimenet elnémítása
+ *   -v  a lépések költsége primitív fajtánként is
+ *   -o  a renderelt (és eltérés esetén a diff) képek könyvtára
+ *   -g  a referencia képek könyvtára
+ *   -b  a SPI bájt keret fájl (soronként: "<lépés> <max bájt/képkocka>", # megjegyzés)
+ *   -u  összehasonlítás helyett a referencia képek és a keret fájl felülírása a mostani eredménnyel
+ *
+ * A repóban tárolt referencia képekkel és kerettel a test/test_render teszt futtatja: pio test -e native_render
+ */
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <functional>
+#include <getopt.h>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include "Config.h"
+#include "FlashWriteService.h"
+#include "GpsManager.h"
+#include "IScreenManager.h"
+#include "LatencyProbe.h"
+#include "MessageDialog.h"
+#include "NativeHal.h"
+#include "NativeRender.h"
+#include "Png.h"
+#include "ScreenInfo.h"
+#include "ScreenMain.h"
+#include "ScreenSats.h"
+#include "SensorUtils.h"
+#include "StatusLed.h"
+#include "TaskScheduler.h"
+#include "TftBackLightAdjuster.h"
+#include "TraffipaxAlertEvaluator.h"
+#include "TraffipaxManager.h"
+#include "UIArena.h"
+#include "ValueChangeDialog.h"
+#include "pins.h"
+
+//------------------ A main.cpp globálisai (a képernyők és a mag logika használja őket)
+TFT_eSPI tft;
+uint16_t SCREEN_W;
+uint16_t SCREEN_H;
+SensorUtils sensorUtils;
+TftBackLightAdjuster tftBackLightAdjuster;
+TraffipaxManager traffipaxManager;
+LatencyProbe latencyProbe;
+StatusLed statusLed(PIN_INTERNAL_RGB_LED);
+GpsManager *gpsManager = nullptr;
+TraffipaxAlertEvaluator *traffipaxAlertEvaluator = nullptr;
+FlashWriteService flashWriteService;
+TaskScheduler core0Scheduler("core0");
+TaskScheduler core1Scheduler("core1");
+ScreenArenaPool screenArenaPool;
+DialogArenaPool dialogArenaPool;
+bool demoMode = false;
+
+// A main.cpp feladat periódusai
+#define UI_TASK_INTERVAL_MS 10
+#define CONFIG_DISPATCH_INTERVAL_MS 50
+#define GPS_TASK_INTERVAL_MS 2
+#define ALERT_TASK_INTERVAL_MS 100
+#define SATELLITE_DB_MAINTENANCE_INTERVAL_MS 1000
+
+#define GPS_BAUD 9600
+#define TICK_MICROS 1000      // A virtuális óra lépése a két ütemező futtatása között
+#define NMEA_EPOCH_MS 1000    // A forgatókönyv GPS-e ennyi időnként küld egy epochát (RMC + GGA + GSV blokk)
+#define STEP_DURATION_MS 6000 // Egy lépés hossza: a leglassabb frissítési sáv (mérők, 5mp) is lefut
+#define RENDER_BUDGET_MARGIN_PERCENT 10 // -u: a keret a mért csúcs + ennyi %, felfelé kerekítve
+#define RENDER_BUDGET_ROUNDING 1024     // A keret kerekítése (bájt)
+#define RENDER_BUDGET_FILE_HEADER "# <step> <max SPI bytes per frame>"
+
+namespace {
+
+/**
+ * @brief Képernyőkezelő a renderelőhöz: a ScreenManager körének eseménykezelése és rajzolása, érintés és screensaver nélkül
+ */
+class RenderScreenManager : public IScreenManager {
+  public:
+    void begin() {
+        // A Main és a Sats a valódi registry-ben is gyorsítótárazott, az Info váltáskor jön létre
+        mainScreen = screenArenaPool.make<ScreenMain>();
+        mainScreen->setScreenManager(this);
+        satsScreen = screenArenaPool.make<ScreenSats>();
+        satsScreen->setScreenManager(this);
+    }
+
+    bool switchToScreen(ScreenId screenId, void *params = nullptr) override {
+        if (current && current->getId() == screenId) {
+            return true;
+        }
+        std::shared_ptr<UIScreen> next;
+        if (screenId == ScreenId::Main) {
+            next = mainScreen;
+        } else if (screenId == ScreenId::Sats) {
+            next = satsScreen;
+        } else if (screenId == ScreenId::Info) {
+            next = screenArenaPool.make<ScreenInfo>();
+            next->setScreenManager(this);
+        } else {
+            return false;
+        }
+
+        if (current) {
+            previous = current->getId();
+            current->deactivate();
+        }
+        ::tft.fillScreen(TFT_BLACK);
+        current = next;
+        if (params) {
+            current->setParameters(params);
+        }
+        current->activate();
+        return true;
+    }
+
+    bool goBack() override { return previous != ScreenId::None && switchToScreen(previous); }
+
+    bool isCurrentScreenDialogActive() override { return current && current->isDialogActive(); }
+
+    UIScreen *getCurrentScreen() const { return current.get(); }
+
+    /**
+     * @brief A forgatókönyv következő UI körben végrehajtandó lépése (képernyőváltás, dialógus, riasztás)
+     */
+    void post(std::function<void()> action) { pendingAction = std::move(action); }
+
+    /**
+     * @brief Egy UI kör, mint a ScreenManager::loop()
+     */
+    void loop() {
+        if (pendingAction) {
+            std::function<void()> action = std::move(pendingAction);
+            pendingAction = nullptr;
+            action();
+        }
+
+        GpsEvent gpsEvent;
+        while (gpsManager->popEvent(gpsEvent)) {
+            if (current) {
+                current->onGpsEvent(gpsEvent);
+            }
+        }
+
+        TraffipaxAlertEvent alertEvent;
+        while (traffipaxAlertEvaluator->popEvent(alertEvent)) {
+            if (current) {
+                current->onTraffipaxAlert(alertEvent);
+            }
+        }
+
+        if (current) {
+            if (current->isRedrawNeeded()) {
+                current->draw();
+            }
+            current->loop();
+        }
+    }
+
+  private:
+    std::shared_ptr<UIScreen> mainScreen;
+    std::shared_ptr<UIScreen> satsScreen;
+    std::shared_ptr<UIScreen> current;
+    ScreenId previous = ScreenId::None;
+    std::function<void()> pendingAction;
+};
+
+RenderScreenManager renderScreenManager;
+IScreenManager *screenManagerInterface = &renderScreenManager;
+
+} // namespace
+
+IScreenManager **iScreenManager = &screenManagerInterface; // A UIComponent használja
+
+namespace {
+
+//--- A forgatókönyv GPS-e ---
+
+struct Satellite {
+    uint8_t prn;
+    uint8_t elevation;
+    uint16_t azimuth;
+    uint8_t snr; // 0: látható, de nem követett
+};
+
+/**
+ * @brief A szimulált GPS modul állapota, ebből készülnek az NMEA mondatok
+ */
+struct GpsScript {
+    bool fix = false;
+    uint32_t utcSeconds = 9 * 3600 + 41 * 60 + 7; // A nap másodperce (UTC)
+    uint8_t day = 14, month = 6;
+    uint16_t year = 2025;
+    double lat = 47.497913, lon = 19.040236;
+    float speedKmph = 0.0f;
+    float course = 0.0f;
+    float altitude = 118.4f;
+    float hdop = 0.9f;
+    uint8_t satellitesUsed = 0;
+    std::vector<Satellite> satellites;
+};
+
+GpsScript gpsScript;
+
+void sendSentence(const char *body) {
+    uint8_t checksum = 0;
+    for (const char *c = body; *c; c++) {
+        checksum ^= *c;
+    }
+    char sentence[128];
+    int length = snprintf(sentence, sizeof(sentence), "$%s*%02X\r\n", body, checksum);
+    Serial1.feed(reinterpret_cast<const uint8_t *>(sentence), length);
+}
+
+/**
+ * @brief Fok -> NMEA "(d)ddmm.mmmm" és félteke
+ */
+void formatCoordinate(char *buffer, size_t size, double degrees, uint8_t degreeDigits, char positive, char negative) {
+    double absolute = fabs(degrees);
+    int whole = (int)absolute;
+    snprintf(buffer, size, "%0*d%07.4f,%c", degreeDigits, whole, (absolute - whole) * 60.0, degrees < 0 ? negative : positive);
+}
+
+/**
+ * @brief Egy GPS epocha: RMC, GGA és a GSV blokk (mint egy u-blox modul 1Hz-en)
+ */
+void sendGpsEpoch() {
+    const GpsScript &g = gpsScript;
+    char time[16], date[8], lat[24], lon[24], body[120];
+    snprintf(time, sizeof(time), "%02lu%02lu%02lu.00", (unsigned long)(g.utcSeconds / 3600 % 24), (unsigned long)(g.utcSeconds / 60 % 60), (unsigned long)(g.utcSeconds % 60));
+    snprintf(date, sizeof(date), "%02u%02u%02u", g.day, g.month, g.year % 100);
+    formatCoordinate(lat, sizeof(lat), g.lat, 2, 'N', 'S');
+    formatCoordinate(lon, sizeof(lon), g.lon, 3, 'E', 'W');
+
+    if (g.fix) {
+        snprintf(body, sizeof(body), "GPRMC,%s,A,%s,%s,%.3f,%.2f,%s,,,A", time, lat, lon, g.speedKmph / 1.852, g.course, date);
+        sendSentence(body);
+        snprintf(body, sizeof(body), "GPGGA,%s,%s,%s,1,%02u,%.2f,%.1f,M,40.3,M,,", time, lat, lon, g.satellitesUsed, g.hdop, g.altitude);
+        sendSentence(body);
+    } else {
+        snprintf(body, sizeof(body), "GPRMC,%s,V,,,,,,,%s,,,N", time, date);
+        sendSentence(body);
+        snprintf(body, sizeof(body), "GPGGA,%s,,,,,0,%02u,99.99,,,,,,", time, g.satellitesUsed);
+        sendSentence(body);
+    }
+
+    uint8_t total = (g.satellites.size() + 3) / 4;
+    for (uint8_t message = 0; message < total; message++) {
+        int length = snprintf(body, sizeof(body), "GPGSV,%u,%u,%02u", total, message + 1, (unsigned)g.satellites.size());
+        for (size_t i = message * 4; i < g.satellites.size() && i < message * 4 + 4u; i++) {
+            const Satellite &s = g.satellites[i];
+            if (s.snr) {
+                length += snprintf(body + length, sizeof(body) - length, ",%02u,%02u,%03u,%02u", s.prn, s.elevation, s.azimuth, s.snr);
+            } else {
+                length += snprintf(body + length, sizeof(body) - length, ",%02u,%02u,%03u,", s.prn, s.elevation, s.azimuth);
+            }
+        }
+        sendSentence(body);
+    }
+}
+
+//--- Forgatókönyv lépések ---
+
+const TraffipaxManager::TraffipaxRecord SCRIPT_TRAFFIPAX = {"Budapest", "Váci út 112", 47.5402, 19.0689};
+std::shared_ptr<UIDialogBase> openDialog;
+int valueDialogValue = 7;
+
+TraffipaxAlertEvent scriptAlert(TraffipaxAlertEvent::State state, float distance, TraffipaxAlertEvent::Siren siren) {
+    TraffipaxAlertEvent event;
+    event.traffipax = state == TraffipaxAlertEvent::INACTIVE ? nullptr : &SCRIPT_TRAFFIPAX;
+    event.distance = distance;
+    event.state = state;
+    event.siren = siren;
+    event.timestamp = millis();
+    return event;
+}
+
+void closeOpenDialog() {
+    if (openDialog) {
+        openDialog->close(UIDialogBase::DialogResult::Dismissed);
+        openDialog.reset();
+    }
+}
+
+const std::vector<Satellite> SKY_FIRST = {{2, 63, 286, 44}, {5, 12, 41, 0}, {11, 48, 114, 38}, {12, 27, 198, 31}, {18, 71, 52, 45},
+                                          {20, 8, 323, 0},  {23, 35, 252, 29}, {25, 19, 156, 24}, {29, 54, 97, 41}};
+const std::vector<Satellite> SKY_LATER = {{2, 64, 285, 46}, {5, 14, 42, 22}, {11, 47, 116, 37}, {12, 26, 199, 0}, {18, 72, 50, 44},
+                                          {23, 36, 251, 33}, {25, 20, 155, 27}, {29, 55, 96, 42}, {31, 6, 12, 0}, {32, 16, 230, 19}};
+
+/**
+ * @brief Egy lépés: a kezdő művelet (a UI feladatban fut), utána STEP_DURATION_MS szimulált idő, a végén a kép
+ */
+struct Step {
+    const char *name;
+    std::function<void()> setup;         // A GPS forgatókönyv / szenzorok módosítása (a lépés elején, a UI-n kívül)
+    std::function<void()> action;        // A UI kör elején futó művelet (képernyőváltás, dialógus, riasztás)
+    std::function<const char *()> check; // A lépés végi kép saját ellenőrzése: nullptr ha rendben, különben a hiba
+};
+
+/**
+ * @brief Az adott színű pixelek száma a keretpuffer egy téglalapjában
+ */
+uint32_t countPixels(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    const uint16_t *pixels = tft.getFramebuffer();
+    uint32_t count = 0;
+    for (int32_t row = y; row < y + h; row++) {
+        for (int32_t column = x; column < x + w; column++) {
+            count += pixels[row * tft.width() + column] == color;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief A műholdszám változása után mindkét fejléc mező látszik: a műholdszám mezője (x = 30..63) nem törölhet bele
+ * a mellette, x = 65-nél kezdődő fix mód mezőbe (az a változatlan értéke miatt nem rajzolódik újra)
+ */
+const char *checkSatCountAndFixMode() {
+    if (countPixels(30, 0, 35, 30, TFT_WHITE) == 0) {
+        return "no sat count";
+    }
+    // A fix mód szövegének (ML_DATUM) első pixel oszlopa a mező bal szélén: a túlnyúló törlés ezt viszi el először
+    if (countPixels(65, 0, 1, 30, TFT_GREEN) == 0) {
+        return "fix mode erased";
+    }
+    return nullptr;
+}
+
+std::vector<Step> buildScript() {
+    return {
+        {"main_nofix", [] { gpsScript.satellites = {{2, 63, 286, 0}, {11, 48, 114, 0}, {18, 71, 52, 0}}; }, [] { renderScreenManager.switchToScreen(ScreenId::Main); }},
+        {"main_fix",
+         [] {
+             gpsScript.fix = true;
+             gpsScript.satellitesUsed = 7;
+             gpsScript.satellites = SKY_FIRST;
+         },
+         nullptr},
+        {"main_moving",
+         [] {
+             gpsScript.speedKmph = 87.0f;
+             gpsScript.course = 34.0f;
+             gpsScript.altitude = 121.8f;
+             gpsScript.hdop = 0.8f;
+             gpsScript.satellitesUsed = 8;
+         },
+         nullptr},
+        {"main_sat_count", [] { gpsScript.satellitesUsed = 11; }, nullptr, checkSatCountAndFixMode},
+        {"main_alert", nullptr, [] { renderScreenManager.getCurrentScreen()->onTraffipaxAlert(scriptAlert(TraffipaxAlertEvent::APPROACHING, 420.0f, TraffipaxAlertEvent::SIREN_START)); }},
+        {"main_alert_end", nullptr, [] { renderScreenManager.getCurrentScreen()->onTraffipaxAlert(scriptAlert(TraffipaxAlertEvent::INACTIVE, 0.0f, TraffipaxAlertEvent::SIREN_STOP)); }},
+        {"main_message_dialog", nullptr,
+         [] {
+             UIScreen *screen = renderScreenManager.getCurrentScreen();
+             openDialog = dialogArenaPool.make<MessageDialog>(screen, "Traffipax", "Delete the selected camera?", MessageDialog::ButtonsType::OkCancel);
+             screen->showDialog(openDialog);
+         }},
+        {"main_message_closed", nullptr, closeOpenDialog},
+        {"main_value_dialog", nullptr,
+         [] {
+             UIScreen *screen = renderScreenManager.getCurrentScreen();
+             openDialog = dialogArenaPool.make<ValueChangeDialog>(screen, "Brightness", "Manual backlight level", &valueDialogValue, 1, 15, 1);
+             screen->showDialog(openDialog);
+         }},
+        {"main_value_closed", nullptr, closeOpenDialog},
+        {"main_night", [] { NativeRender::sensors().nightTheme = true; }, nullptr},
+        {"sats",
+         [] {
+             NativeRender::sensors().nightTheme = false;
+             gpsScript.speedKmph = 0.0f;
+         },
+         [] { renderScreenManager.switchToScreen(ScreenId::Sats); }},
+        {"sats_update",
+         [] {
+             gpsScript.satellites = SKY_LATER;
+             gpsScript.satellitesUsed = 9;
+         },
+         nullptr},
+        {"info", nullptr, [] { renderScreenManager.switchToScreen(ScreenId::Info); }},
+    };
+}
+
+//--- Futtatás és mérés ---
+
+uint8_t uiTaskId = TaskScheduler::INVALID_TASK;
+uint8_t alertTaskId = TaskScheduler::INVALID_TASK;
+
+/**
+ * @brief Egy lépés mért eredménye
+ */
+struct StepResult {
+    TFT_eSPI::RenderStats total;    // A lépés összes kirajzolása
+    uint32_t frames = 0;            // A rajzoló UI körök száma
+    uint32_t peakFrameSpiBytes = 0; // A legdrágább UI kör SPI forgalma
+};
+
+StepResult stepResult;
+
+/**
+ * @brief A Core0 "ui" feladata: a képernyőkezelő köre, a kör SPI forgalmának mérésével
+ */
+void uiTask() {
+    uint32_t spiBefore = tft.getStats().spiBytes;
+    renderScreenManager.loop();
+    uint32_t frameSpiBytes = tft.getStats().spiBytes - spiBefore;
+    if (frameSpiBytes > 0) {
+        stepResult.frames++;
+        stepResult.peakFrameSpiBytes = std::max(stepResult.peakFrameSpiBytes, frameSpiBytes);
+    }
+}
+
+/**
+ * @brief A main.cpp feladatai, amik a képernyők adatait adják
+ */
+void registerTasks() {
+    uiTaskId = core0Scheduler.addPeriodicTask("ui", UI_TASK_INTERVAL_MS, uiTask);
+    core0Scheduler.addPeriodicTask("config", CONFIG_DISPATCH_INTERVAL_MS, []() { config.dispatchPending(); });
+
+    core1Scheduler.addPeriodicTask("config", CONFIG_DISPATCH_INTERVAL_MS, []() { config.dispatchPending(); });
+    core1Scheduler.addPeriodicTask("gps", GPS_TASK_INTERVAL_MS, []() {
+        gpsManager->loop();
+        if (gpsManager->isFixEpochPending()) {
+            core1Scheduler.signal(alertTaskId);
+        }
+        if (gpsManager->hasPendingEvents()) {
+            core0Scheduler.signal(uiTaskId);
+        }
+    });
+    alertTaskId = core1Scheduler.addPeriodicTask("alert", ALERT_TASK_INTERVAL_MS, []() {
+        traffipaxAlertEvaluator->loop();
+        if (traffipaxAlertEvaluator->hasPendingEvents()) {
+            core0Scheduler.signal(uiTaskId);
+        }
+    });
+    core1Scheduler.addPeriodicTask("satdb", SATELLITE_DB_MAINTENANCE_INTERVAL_MS, []() { gpsManager->maintainSatelliteDb(); });
+    core1Scheduler.addPeriodicTask("light", SENSOR_CHECK_MSEC, []() { tftBackLightAdjuster.updateTarget(); });
+}
+
+/**
+ * @brief Egy lépés lefuttatása: a GPS epochák a szimulált idő szerint, a két ütemező 1ms-onként
+ */
+void runStep(const Step &step) {
+    stepResult = StepResult();
+    tft.resetStats();
+    if (step.setup) {
+        step.setup();
+    }
+    if (step.action) {
+        renderScreenManager.post(step.action);
+    }
+
+    for (uint32_t ms = 0; ms < STEP_DURATION_MS; ms++) {
+        if (NativeHal::nowMicros() / 1000 % NMEA_EPOCH_MS == 0) {
+            sendGpsEpoch();
+            gpsScript.utcSeconds++;
+        }
+        NativeHal::setCore(1);
+        core1Scheduler.run();
+        NativeHal::setCore(0);
+        core0Scheduler.run();
+        NativeHal::advanceMicros(TICK_MICROS);
+    }
+    stepResult.total = tft.getStats();
+}
+
+//--- Képek és keretek ---
+
+void framebufferToRgb(std::vector<uint8_t> &rgb) {
+    const uint16_t *pixels = tft.getFramebuffer();
+    size_t count = (size_t)tft.width() * tft.height();
+    rgb.resize(count * 3);
+    for (size_t i = 0; i < count; i++) {
+        uint16_t c = pixels[i];
+        uint8_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+        rgb[i * 3] = (r << 3) | (r >> 2);
+        rgb[i * 3 + 1] = (g << 2) | (g >> 4);
+        rgb[i * 3 + 2] = (b << 3) | (b >> 2);
+    }
+}
+
+/**
+ * @brief Eltérő pixelek száma; a diff kép: az eltérések pirossal a halványított renderelt képen
+ */
+uint32_t compareImages(const std::vector<uint8_t> &actual, const std::vector<uint8_t> &expected, std::vector<uint8_t> &diff) {
+    uint32_t mismatches = 0;
+    diff.resize(actual.size());
+    for (size_t i = 0; i < actual.size(); i += 3) {
+        bool differs = memcmp(&actual[i], &expected[i], 3) != 0;
+        mismatches += differs;
+        uint8_t gray = (actual[i] + actual[i + 1] + actual[i + 2]) / 12;
+        diff[i] = differs ? 255 : gray;
+        diff[i + 1] = differs ? 0 : gray;
+        diff[i + 2] = differs ? 0 : gray;
+    }
+    return mismatches;
+}
+
+std::map<std::string, uint32_t> readBudgets(const char *path) {
+    std::map<std::string, uint32_t> budgets;
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        return budgets;
+    }
+    char line[128], name[64];
+    unsigned long bytes;
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] != '#' && sscanf(line, "%63s %lu", name, &bytes) == 2) {
+            budgets[name] = bytes;
+        }
+    }
+    fclose(file);
+    return budgets;
+}
+
+/**
+ * @brief Könyvtár létrehozása a hiányzó szülőkkel együtt (mkdir -p)
+ */
+void makeDirs(const char *path) {
+    std::string dir = path;
+    for (size_t slash = dir.find('/', 1); slash != std::string::npos; slash = dir.find('/', slash + 1)) {
+        mkdir(dir.substr(0, slash).c_str(), 0755);
+    }
+    mkdir(dir.c_str(), 0755);
+}
+
+std::string joinPath(const char *dir, const char *name, const char *suffix) { return std::string(dir) + "/" + name + suffix; }
+
+const char *KIND_NAMES[TFT_eSPI::PRIMITIVE_KIND_COUNT] = {"fillScreen", "fillRect", "fastLine", "line", "pixel", "rect", "roundRect", "circle", "triangle", "text", "sprite"};
+
+void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-q] [-v] [-o out_dir] [-g golden_dir] [-b budget_file] [-u]\n", program);
+    exit(2);
+}
+} // namespace
+
+/**
+ * A forgatókönyv lefuttatása
+ */
+int NativeRender::run(const RunOptions &options) {
+    const bool quiet = options.quiet;
+    const bool verbose = options.verbose;
+    const bool update = options.update;
+    const char *outDir = options.outDir;
+    const char *goldenDir = options.goldenDir;
+    const char *budgetFile = options.budgetFile;
+
+    // A kimeneti könyvtárak (ha még nincsenek)
+    if (outDir) {
+        makeDirs(outDir);
+    }
+    if (goldenDir && update) {
+        makeDirs(goldenDir);
+    }
+
+    NativeHal::openFlashImage(nullptr);
+    if (quiet) {
+        Serial.setOutput(nullptr);
+    }
+
+    // Core0 setup (mint a main.cpp; traffipax adatbázis nélkül, a riasztást a forgatókönyv adja)
+    NativeHal::setCore(0);
+    tft.begin();
+    tft.setRotation(1);
+    tft.fillScreen(TFT_BLACK);
+    SCREEN_W = tft.width();
+    SCREEN_H = tft.height();
+    StoreJournalBase<Config_t>::init();
+    config.load();
+    tftBackLightAdjuster.begin();
+
+    // Core1 setup
+    NativeHal::setCore(1);
+    Serial1.begin(GPS_BAUD);
+    gpsManager = new GpsManager(Serial1);
+    traffipaxAlertEvaluator = new TraffipaxAlertEvaluator();
+
+    NativeHal::setCore(0);
+    renderScreenManager.begin();
+    registerTasks();
+
+    std::map<std::string, uint32_t> budgets = (budgetFile && !update) ? readBudgets(budgetFile) : std::map<std::string, uint32_t>();
+    std::vector<std::pair<std::string, uint32_t>> measuredBudgets;
+    uint32_t failures = 0;
+
+    printf("%-20s %6s %7s %7s %9s %10s %10s %10s  %s\n", "step", "frames", "prims", "windows", "pixels", "spi bytes", "peak frame", "budget", "image");
+    for (const Step &step : buildScript()) {
+        runStep(step);
+        const StepResult &r = stepResult;
+        measuredBudgets.push_back({step.name, r.peakFrameSpiBytes});
+
+        // Kép: mentés, összehasonlítás vagy a referencia felülírása
+        std::vector<uint8_t> rgb;
+        framebufferToRgb(rgb);
+        std::string imageStatus = "-";
+        if (outDir && !Png::write(joinPath(outDir, step.name, ".png").c_str(), rgb.data(), tft.width(), tft.height())) {
+            perror(outDir);
+            return -1;
+        }
+        if (goldenDir && update) {
+            imageStatus = Png::write(joinPath(goldenDir, step.name, ".png").c_str(), rgb.data(), tft.width(), tft.height()) ? "updated" : "WRITE FAILED";
+        } else if (goldenDir) {
+            std::vector<uint8_t> expected, diff;
+            uint16_t width, height;
+            if (!Png::read(joinPath(goldenDir, step.name, ".png").c_str(), expected, width, height)) {
+                imageStatus = "NO GOLDEN";
+                failures++;
+            } else if (width != tft.width() || height != tft.height()) {
+                imageStatus = "SIZE MISMATCH";
+                failures++;
+            } else if (uint32_t mismatches = compareImages(rgb, expected, diff)) {
+                imageStatus = "DIFF " + std::to_string(mismatches) + " px";
+                failures++;
+                if (outDir) {
+                    Png::write(joinPath(outDir, step.name, ".diff.png").c_str(), diff.data(), width, height);
+                }
+            } else {
+                imageStatus = "ok";
+            }
+        }
+        if (step.check) {
+            if (const char *problem = step.check()) {
+                imageStatus += std::string(" CHECK: ") + problem;
+                failures++;
+            }
+        }
+
+        // SPI keret: a legdrágább képkocka
+        std::string budgetText = "-";
+        auto budget = budgets.find(step.name);
+        if (budget != budgets.end()) {
+            budgetText = std::to_string(budget->second);
+            if (r.peakFrameSpiBytes > budget->second) {
+                budgetText += " OVER";
+                failures++;
+            }
+        } else if (budgetFile && !update) {
+            budgetText = "NONE";
+            failures++;
+        }
+
+        printf("%-20s %6u %7u %7u %9u %10u %10u %10s  %s\n", step.name, r.frames, r.total.primitives, r.total.windows, r.total.pixels, r.total.spiBytes, r.peakFrameSpiBytes, budgetText.c_str(),
+               imageStatus.c_str());
+        if (verbose) {
+            for (uint8_t kind = 0; kind < TFT_eSPI::PRIMITIVE_KIND_COUNT; kind++) {
+                if (r.total.kindCount[kind]) {
+                    printf("    %-12s %7u prims %10u spi bytes\n", KIND_NAMES[kind], r.total.kindCount[kind], r.total.kindSpiBytes[kind]);
+                }
+            }
+        }
+    }
+
+    if (budgetFile && update) {
+        FILE *file = fopen(budgetFile, "w");
+        if (file == nullptr) {
+            perror(budgetFile);
+            return -1;
+        }
+        fprintf(file, "%s\n", RENDER_BUDGET_FILE_HEADER);
+        fprintf(file, "# A -u írja: a lépés legdrágább képkockája + %d%% tartalék, felfelé kerekítve %d bájtra.\n", RENDER_BUDGET_MARGIN_PERCENT, RENDER_BUDGET_ROUNDING);
+        fprintf(file, "# A tartalék a szándékolt apró változásoknak ad helyet; a csak egy mezőt frissítő lépéseknél (pl. main_sat_count) egy teljes képernyős újrarajzolás így is túllépi.\n");
+        for (const auto &entry : measuredBudgets) {
+            uint32_t budget = entry.second + entry.second * RENDER_BUDGET_MARGIN_PERCENT / 100;
+            budget = (budget + RENDER_BUDGET_ROUNDING - 1) / RENDER_BUDGET_ROUNDING * RENDER_BUDGET_ROUNDING;
+            fprintf(file, "%s %u\n", entry.first.c_str(), budget);
+        }
+        fclose(file);
+        printf("budgets written to %s\n", budgetFile);
+    }
+
+    delete traffipaxAlertEvaluator;
+    delete gpsManager;
+
+    if (failures) {
+        printf("%u check(s) FAILED\n", failures);
+    }
+    return failures;
+}
+
+// A test/test_render Unity tesztje a saját main()-jéből hívja a run()-t
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char *argv[]) {
+    NativeRender::RunOptions options;
+
+    int option;
+    while ((option = getopt(argc, argv, "qvo:g:b:u")) != -1) {
+        switch (option) {
+            case 'q':
+                options.quiet = true;
+                break;
+            case 'v':
+                options.verbose = true;
+                break;
+            case 'o':
+                options.outDir = optarg;
+                break;
+            case 'g':
+                options.goldenDir = optarg;
+                break;
+            case 'b':
+                options.budgetFile = optarg;
+                break;
+            case 'u':
+                options.update = true;
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if (optind != argc || (options.update && options.goldenDir == nullptr && options.budgetFile == nullptr)) {
+        usage(argv[0]);
+    }
+
+    return NativeRender::run(options) == 0 ? 0 : 1;
+}
+#endif
@@ -0,0 +1,175 @@
+#include <Arduino.h>
+#include <algorithm>
+#include <random>
+
+#include "NativeHal.h"
+
+namespace {
+uint64_t clockMicros = 0; // A virtuális óra
+uint8_t currentCore = 0;  // Az éppen "futó" mag
+std::mt19937 randomGenerator;
+} // namespace
+
+HardwareSerial Serial(stdout); // DEBUG kimenet
+HardwareSerial Serial1;        // GPS
+HardwareSerial Serial2;
+RP2040 rp2040;
+
+namespace NativeHal {
+
+/**
+ * @brief A virtuális óra állása
+ */
+uint64_t nowMicros() { return clockMicros; }
+
+/**
+ * @brief A virtuális óra léptetése
+ */
+void advanceMicros(uint64_t us) { clockMicros += us; }
+
+/**
+ * @brief Melyik mag "fut"
+ */
+void setCore(uint8_t core) { currentCore = core; }
+
+} // namespace NativeHal
+
+//--- Idő ---
+uint64_t time_us_64() { return clockMicros; }
+uint32_t millis() { return clockMicros / 1000; }
+uint32_t micros() { return clockMicros; }
+void delay(unsigned long ms) { clockMicros += (uint64_t)ms * 1000; }
+void delayMicroseconds(unsigned int us) { clockMicros += us; }
+
+int RP2040::cpuid() { return currentCore; }
+
+//--- Segédfüggvények ---
+long random(long howBig) { return howBig > 0 ? random(0, howBig) : 0; }
+
+long random(long howSmall, long howBig) {
+    if (howSmall >= howBig) {
+        return howSmall;
+    }
+    return std::uniform_int_distribution<long>(howSmall, howBig - 1)(randomGenerator);
+}
+
+void randomSeed(unsigned long seed) { randomGenerator.seed(seed); }
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) { return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin; }
+
+char *dtostrf(double value, signed char width, unsigned char precision, char *buffer) {
+    sprintf(buffer, "%*.*f", width, precision, value);
+    return buffer;
+}
+
+#if !defined(__APPLE__) && !(defined(__GLIBC__) && __GLIBC_PREREQ(2, 38))
+size_t strlcpy(char *dst, const char *src, size_t size) {
+    size_t length = strlen(src);
+    if (size > 0) {
+        size_t n = std::min(length, size - 1);
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return length;
+}
+#endif
+
+String::String(double value, unsigned char decimalPlaces) {
+    char buffer[32];
+    text = dtostrf(value, 0, decimalPlaces, buffer);
+}
+
+//--- Print / Stream ---
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t written = 0;
+    while (size--) {
+        written += write(*buffer++);
+    }
+    return written;
+}
+
+size_t Print::printf(const char *format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length < 0) {
+        return 0;
+    }
+    if ((size_t)length < sizeof(buffer)) {
+        return write(reinterpret_cast<const uint8_t *>(buffer), length);
+    }
+
+    // Nem fért el: a pontos méretű pufferbe újra
+    std::string text(length + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&text[0], text.size(), format, args);
+    va_end(args);
+    return write(reinterpret_cast<const uint8_t *>(text.data()), length);
+}
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length && available() > 0) {
+        buffer[count++] = (char)read();
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length && available() > 0) {
+        int c = read();
+        if (c == terminator) {
+            break;
+        }
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+//--- HardwareSerial ---
+int HardwareSerial::available() {
+    // Az érkezési idők növekvők: a már beérkezett bájtok a sor elején vannak
+    auto arrived = std::upper_bound(rx.begin(), rx.end(), clockMicros, [](uint64_t now, const RxByte &b) { return now < b.arrivalMicros; });
+    size_t count = arrived - rx.begin();
+
+    // A FIFO-ba nem fért bájtok elvesztek (a régebbiek maradnak, mint a UART-nál)
+    if (count > fifoSize) {
+        rx.erase(rx.begin() + fifoSize, arrived);
+        overruns += count - fifoSize;
+        count = fifoSize;
+    }
+    return count;
+}
+
+int HardwareSerial::read() {
+    if (rx.empty() || rx.front().arrivalMicros > clockMicros) {
+        return -1;
+    }
+    uint8_t value = rx.front().value;
+    rx.pop_front();
+    return value;
+}
+
+int HardwareSerial::peek() { return rx.empty() || rx.front().arrivalMicros > clockMicros ? -1 : rx.front().value; }
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    if (output) {
+        fwrite(buffer, 1, size, output);
+    }
+    return size;
+}
+
+void HardwareSerial::feed(const uint8_t *data, size_t length) {
+    const uint64_t byteMicros = 10 * 1000000ULL / baud; // Start + 8 adat + stop bit
+    uint64_t arrival = std::max(lastArrivalMicros, clockMicros);
+    for (size_t i = 0; i < length; i++) {
+        arrival += byteMicros;
+        rx.push_back({arrival, data[i]});
+    }
+    lastArrivalMicros = arrival;
+}
@@ -0,0 +1,146 @@
+#include <EEPROM.h>
+#include <algorithm>
+#include <hardware/flash.h>
+
+#include "NativeHal.h"
+
+// A Pico flash térképe a hoszt képben is (ld. StoreJournalBase.h, StoreEepromBase.h): a program a kép elején,
+// a LittleFS előtt a konfig napló, a legvégén az EEPROM szektor
+#define NATIVE_FS_START_OFFSET 0xff000
+#define NATIVE_EEPROM_OFFSET (NATIVE_FLASH_SIZE - FLASH_SECTOR_SIZE)
+
+// A flash műveletek ideje (W25Q16JV tipikus értékek): ennyivel lép a virtuális óra, így a FlashWriteService a valós
+// leállást méri, és a GPS UART FIFO túlcsordulása is látszik, ha rossz pillanatban írunk
+#define NATIVE_FLASH_ERASE_MICROS 45000
+#define NATIVE_FLASH_PROGRAM_MICROS 400
+
+extern "C" {
+alignas(FLASH_SECTOR_SIZE) uint8_t nativeFlashImage[NATIVE_FLASH_SIZE];
+}
+
+// A linker szimbólumok (_FS_start, __flash_binary_end) a kép megfelelő bájtjaira mutatnak
+#define NATIVE_STRINGIFY(x) #x
+#define NATIVE_EQUATE(symbol, offset) ".globl " #symbol "\n.set " #symbol ", nativeFlashImage + " NATIVE_STRINGIFY(offset) "\n"
+asm(NATIVE_EQUATE(_FS_start, NATIVE_FS_START_OFFSET) NATIVE_EQUATE(__flash_binary_end, 0));
+
+EEPROMClass EEPROM;
+
+namespace {
+FILE *imageFile = nullptr;
+uint32_t eraseCount = 0;
+uint32_t programCount = 0;
+
+/**
+ * @brief A kép egy szakaszának visszamentése a fájlba
+ */
+void persist(uint32_t offset, size_t count) {
+    if (imageFile == nullptr) {
+        return;
+    }
+    fseek(imageFile, offset, SEEK_SET);
+    fwrite(&nativeFlashImage[offset], 1, count, imageFile);
+    fflush(imageFile);
+}
+} // namespace
+
+namespace NativeHal {
+
+/**
+ * @brief A flash kép betöltése a fájlból
+ */
+bool openFlashImage(const char *path) {
+    memset(nativeFlashImage, 0xFF, sizeof(nativeFlashImage));
+    if (path == nullptr) {
+        return true;
+    }
+
+    imageFile = fopen(path, "r+b");
+    if (imageFile) {
+        fread(nativeFlashImage, 1, sizeof(nativeFlashImage), imageFile);
+        return true;
+    }
+
+    // Új kép: törölt flash
+    imageFile = fopen(path, "w+b");
+    if (imageFile == nullptr) {
+        return false;
+    }
+    persist(0, sizeof(nativeFlashImage));
+    return true;
+}
+
+uint32_t getFlashEraseCount() { return eraseCount; }
+uint32_t getFlashProgramCount() { return programCount; }
+
+} // namespace NativeHal
+
+//--- pico-sdk flash API ---
+void flash_range_erase(uint32_t flashOffset, size_t count) {
+    if (flashOffset % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flashOffset + count > NATIVE_FLASH_SIZE) {
+        fprintf(stderr, "flash_range_erase: invalid range 0x%X + %u\n", (unsigned)flashOffset, (unsigned)count);
+        abort();
+    }
+    memset(&nativeFlashImage[flashOffset], 0xFF, count);
+    persist(flashOffset, count);
+    eraseCount++;
+    NativeHal::advanceMicros(NATIVE_FLASH_ERASE_MICROS * (count / FLASH_SECTOR_SIZE));
+}
+
+void flash_range_program(uint32_t flashOffset, const uint8_t *data, size_t count) {
+    if (flashOffset % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flashOffset + count > NATIVE_FLASH_SIZE) {
+        fprintf(stderr, "flash_range_program: invalid range 0x%X + %u\n", (unsigned)flashOffset, (unsigned)count);
+        abort();
+    }
+    // A NOR flash programozás csak 1 -> 0 bitet tud: a nem törölt bájt felülírása ÉS-elődik, mint a valóságban
+    for (size_t i = 0; i < count; i++) {
+        nativeFlashImage[flashOffset + i] &= data[i];
+    }
+    persist(flashOffset, count);
+    programCount++;
+    NativeHal::advanceMicros(NATIVE_FLASH_PROGRAM_MICROS * (count / FLASH_PAGE_SIZE));
+}
+
+//--- EEPROM ---
+void EEPROMClass::begin(size_t size) {
+    size = std::min<size_t>(size, FLASH_SECTOR_SIZE);
+    if (data) {
+        delete[] data;
+    }
+    data = new uint8_t[size];
+    this->size = size;
+    memcpy(data, &nativeFlashImage[NATIVE_EEPROM_OFFSET], size);
+    dirty = false;
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    if (address >= 0 && (size_t)address < size && data[address] != value) {
+        data[address] = value;
+        dirty = true;
+    }
+}
+
+bool EEPROMClass::commit() {
+    if (data == nullptr) {
+        return false;
+    }
+    if (!dirty) {
+        return true;
+    }
+
+    // Mint az arduino-pico: a teljes szektor törlése és újraírása
+    uint8_t sector[FLASH_SECTOR_SIZE];
+    memcpy(sector, &nativeFlashImage[NATIVE_EEPROM_OFFSET], sizeof(sector));
+    memcpy(sector, data, size);
+    flash_range_erase(NATIVE_EEPROM_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(NATIVE_EEPROM_OFFSET, sector, FLASH_SECTOR_SIZE);
+    dirty = false;
+    return true;
+}
+
+bool EEPROMClass::end() {
+    bool committed = commit();
+    delete[] data;
+    data = nullptr;
+    size = 0;
+    return committed;
+}
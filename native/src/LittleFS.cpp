@@ -0,0 +1,94 @@
+#include <LittleFS.h>
+#include <sys/stat.h>
+
+#include "NativeHal.h"
+
+FS LittleFS;
+
+namespace {
+std::string fsRoot = "data";
+} // namespace
+
+namespace NativeHal {
+
+/**
+ * @brief A LittleFS helyettesítő gyökérkönyvtára
+ */
+void setFsRoot(const char *path) { fsRoot = path; }
+
+/**
+ * @brief A LittleFS útvonal -> hoszt útvonal
+ */
+const char *fsPath(const char *path, char *buffer, size_t bufferSize) {
+    snprintf(buffer, bufferSize, "%s%s%s", fsRoot.c_str(), path[0] == '/' ? "" : "/", path);
+    return buffer;
+}
+
+} // namespace NativeHal
+
+namespace fs {
+
+//--- File ---
+File::File(FILE *handle, const char *path) : handle(handle, fclose), path(path) {}
+
+int File::available() {
+    if (!handle) {
+        return 0;
+    }
+    return size() - position();
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t *buffer, size_t size) { return handle ? fread(buffer, 1, size, handle.get()) : 0; }
+
+int File::peek() {
+    if (!handle) {
+        return -1;
+    }
+    int c = fgetc(handle.get());
+    if (c != EOF) {
+        ungetc(c, handle.get());
+    }
+    return c == EOF ? -1 : c;
+}
+
+size_t File::write(uint8_t c) { return write(&c, 1); }
+
+size_t File::write(const uint8_t *buffer, size_t size) { return handle ? fwrite(buffer, 1, size, handle.get()) : 0; }
+
+bool File::seek(uint32_t position) { return handle && fseek(handle.get(), position, SEEK_SET) == 0; }
+
+size_t File::position() const { return handle ? ftell(handle.get()) : 0; }
+
+size_t File::size() const {
+    struct stat info;
+    if (!handle || fstat(fileno(handle.get()), &info) != 0) {
+        return 0;
+    }
+    return info.st_size;
+}
+
+//--- FS ---
+bool FS::exists(const char *path) {
+    char hostPath[256];
+    struct stat info;
+    return stat(NativeHal::fsPath(path, hostPath, sizeof(hostPath)), &info) == 0;
+}
+
+File FS::open(const char *path, const char *mode) {
+    char hostPath[256];
+    std::string hostMode = std::string(mode) + "b"; // Bináris mód (Windows hoszton sincs sorvég konverzió)
+    FILE *handle = fopen(NativeHal::fsPath(path, hostPath, sizeof(hostPath)), hostMode.c_str());
+    return handle ? File(handle, path) : File();
+}
+
+bool FS::remove(const char *path) {
+    char hostPath[256];
+    return ::remove(NativeHal::fsPath(path, hostPath, sizeof(hostPath))) == 0;
+}
+
+} // namespace fs
@@ -0,0 +1,6 @@
+#include "StatusLed.h"
+
+/**
+ * @brief A hoszton nincs LED: a minta kérése (setPattern) a request-ben marad, a PIO/alarm indítás elmarad
+ */
+void StatusLed::begin() {}
@@ -0,0 +1,1294 @@
+#include <TFT_eSPI.h>
+#include <algorithm>
+#include <deque>
+
+namespace {
+
+// A klasszikus 5x7-es GLCD font (0x20..0x7E), oszloponként, a legalsó bit a felső sor
+const uint8_t GLCD_FONT[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x14, 0x7F, 0x14, 0x7F, 0x14, // ' ' ! " #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x23, 0x13, 0x08, 0x64, 0x62, 0x36, 0x49, 0x56, 0x20, 0x50, 0x00, 0x08, 0x07, 0x03, 0x00, // $ % & '
+    0x00, 0x1C, 0x22, 0x41, 0x00, 0x00, 0x41, 0x22, 0x1C, 0x00, 0x2A, 0x1C, 0x7F, 0x1C, 0x2A, 0x08, 0x08, 0x3E, 0x08, 0x08, // ( ) * +
+    0x00, 0x80, 0x70, 0x30, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x60, 0x60, 0x00, 0x20, 0x10, 0x08, 0x04, 0x02, // , - . /
+    0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00, 0x42, 0x7F, 0x40, 0x00, 0x72, 0x49, 0x49, 0x49, 0x46, 0x21, 0x41, 0x49, 0x4D, 0x33, // 0 1 2 3
+    0x18, 0x14, 0x12, 0x7F, 0x10, 0x27, 0x45, 0x45, 0x45, 0x39, 0x3C, 0x4A, 0x49, 0x49, 0x31, 0x41, 0x21, 0x11, 0x09, 0x07, // 4 5 6 7
+    0x36, 0x49, 0x49, 0x49, 0x36, 0x46, 0x49, 0x49, 0x29, 0x1E, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x40, 0x34, 0x00, 0x00, // 8 9 : ;
+    0x00, 0x08, 0x14, 0x22, 0x41, 0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x41, 0x22, 0x14, 0x08, 0x02, 0x01, 0x59, 0x09, 0x06, // < = > ?
+    0x3E, 0x41, 0x5D, 0x59, 0x4E, 0x7C, 0x12, 0x11, 0x12, 0x7C, 0x7F, 0x49, 0x49, 0x49, 0x36, 0x3E, 0x41, 0x41, 0x41, 0x22, // @ A B C
+    0x7F, 0x41, 0x41, 0x41, 0x3E, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x7F, 0x09, 0x09, 0x09, 0x01, 0x3E, 0x41, 0x41, 0x51, 0x73, // D E F G
+    0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00, 0x41, 0x7F, 0x41, 0x00, 0x20, 0x40, 0x41, 0x3F, 0x01, 0x7F, 0x08, 0x14, 0x22, 0x41, // H I J K
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x02, 0x1C, 0x02, 0x7F, 0x7F, 0x04, 0x08, 0x10, 0x7F, 0x3E, 0x41, 0x41, 0x41, 0x3E, // L M N O
+    0x7F, 0x09, 0x09, 0x09, 0x06, 0x3E, 0x41, 0x51, 0x21, 0x5E, 0x7F, 0x09, 0x19, 0x29, 0x46, 0x26, 0x49, 0x49, 0x49, 0x32, // P Q R S
+    0x03, 0x01, 0x7F, 0x01, 0x03, 0x3F, 0x40, 0x40, 0x40, 0x3F, 0x1F, 0x20, 0x40, 0x20, 0x1F, 0x3F, 0x40, 0x38, 0x40, 0x3F, // T U V W
+    0x63, 0x14, 0x08, 0x14, 0x63, 0x03, 0x04, 0x78, 0x04, 0x03, 0x61, 0x59, 0x49, 0x4D, 0x43, 0x00, 0x7F, 0x41, 0x41, 0x41, // X Y Z [
+    0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x41, 0x41, 0x41, 0x7F, 0x04, 0x02, 0x01, 0x02, 0x04, 0x40, 0x40, 0x40, 0x40, 0x40, // \ ] ^ _
+    0x00, 0x03, 0x07, 0x08, 0x00, 0x20, 0x54, 0x54, 0x78, 0x40, 0x7F, 0x28, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x28, // ` a b c
+    0x38, 0x44, 0x44, 0x28, 0x7F, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x08, 0x7E, 0x09, 0x02, 0x18, 0xA4, 0xA4, 0x9C, 0x78, // d e f g
+    0x7F, 0x08, 0x04, 0x04, 0x78, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x20, 0x40, 0x40, 0x3D, 0x00, 0x7F, 0x10, 0x28, 0x44, 0x00, // h i j k
+    0x00, 0x41, 0x7F, 0x40, 0x00, 0x7C, 0x04, 0x78, 0x04, 0x78, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x38, 0x44, 0x44, 0x44, 0x38, // l m n o
+    0xFC, 0x18, 0x24, 0x24, 0x18, 0x18, 0x24, 0x24, 0x18, 0xFC, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x48, 0x54, 0x54, 0x54, 0x24, // p q r s
+    0x04, 0x04, 0x3F, 0x44, 0x24, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x1C, 0x20, 0x40, 0x20, 0x1C, 0x3C, 0x40, 0x30, 0x40, 0x3C, // t u v w
+    0x44, 0x28, 0x10, 0x28, 0x44, 0x4C, 0x90, 0x90, 0x90, 0x7C, 0x44, 0x64, 0x54, 0x4C, 0x44, 0x00, 0x08, 0x36, 0x41, 0x00, // x y z {
+    0x00, 0x00, 0x77, 0x00, 0x00, 0x00, 0x41, 0x36, 0x08, 0x00, 0x02, 0x01, 0x02, 0x04, 0x02,                               // | } ~
+};
+constexpr uint32_t GLCD_FIRST = 0x20;
+constexpr uint32_t GLCD_LAST = 0x7E;
+
+// ILI9488 SPI: CASET/PASET = 1 parancs + 4 adat bájt, RAMWR/RAMRD = 1 parancs bájt, 18 bites pixel = 3 bájt
+constexpr uint32_t SPI_ADDRESS_BYTES = 5;
+constexpr uint32_t SPI_COMMAND_BYTES = 1;
+constexpr uint32_t SPI_WINDOW_BYTES = 2 * SPI_ADDRESS_BYTES + SPI_COMMAND_BYTES;
+constexpr uint32_t SPI_PIXEL_BYTES = 3;
+constexpr uint32_t SPI_READ_DUMMY_BYTES = 1;
+
+// A 4 bites sprite-ok alap palettája (mint a TFT_eSPI-ben)
+const uint16_t DEFAULT_4BIT_PALETTE[16] = {TFT_BLACK, TFT_BROWN, TFT_RED,   TFT_ORANGE,  TFT_YELLOW, TFT_GREEN,     TFT_BLUE, TFT_PURPLE,
+                                           TFT_DARKGREY, TFT_WHITE, TFT_CYAN, TFT_MAGENTA, TFT_MAROON, TFT_DARKGREEN, TFT_NAVY, TFT_PINK};
+
+/**
+ * @brief Egy GLCD glif pixele (col 0..4, row 0..7)
+ */
+bool glcdBit(uint32_t c, int col, int row) { return (GLCD_FONT[(c - GLCD_FIRST) * 5 + col] >> row) & 1; }
+
+/**
+ * @brief Közelítő GFX font az 5x7-es glifek nagyításával
+ *
+ * A sormagasság (yAdvance) és a nagybetű magasság a valódi fontéval egyezik, a betűszélesség az átlagos; a glif a
+ * GLCD glif legközelebbi szomszéd nagyítása (félkövérnél vízszintesen vastagítva).
+ */
+GFXfont synthesizeFont(uint8_t advance, uint8_t ascent, uint8_t descent, uint8_t yAdvance, bool bold) {
+    struct Store {
+        std::vector<uint8_t> bitmap;
+        std::vector<GFXglyph> glyphs;
+    };
+    static std::deque<Store> stores; // A fontok élettartama a programé
+    stores.emplace_back();
+    Store &store = stores.back();
+
+    const uint8_t width = std::max(1, advance * 4 / 5);
+    const uint8_t height = ascent + descent;
+    const int boldShift = bold ? std::max(1, width / 8) : 0;
+
+    for (uint32_t c = GLCD_FIRST; c <= GLCD_LAST; c++) {
+        GFXglyph glyph = {(uint32_t)store.bitmap.size(), width, height, advance, (int8_t)((advance - width) / 2), (int8_t)-ascent};
+        if (c == ' ') {
+            glyph = {(uint32_t)store.bitmap.size(), 0, 0, (uint8_t)std::max(1, advance / 2), 0, 0};
+            store.glyphs.push_back(glyph);
+            continue;
+        }
+
+        // Bitfolyam soronként, MSB először, a glif eleje bájthatáron (Adafruit formátum)
+        uint8_t bits = 0;
+        uint8_t count = 0;
+        for (int y = 0; y < height; y++) {
+            int row = y < ascent ? y * 7 / ascent : 7;
+            for (int x = 0; x < width; x++) {
+                bool set = glcdBit(c, x * 5 / width, row);
+                if (!set && boldShift && x >= boldShift) {
+                    set = glcdBit(c, (x - boldShift) * 5 / width, row);
+                }
+                bits = (bits << 1) | set;
+                if (++count == 8) {
+                    store.bitmap.push_back(bits);
+                    bits = count = 0;
+                }
+            }
+        }
+        if (count) {
+            store.bitmap.push_back(bits << (8 - count));
+        }
+        store.glyphs.push_back(glyph);
+    }
+    return {store.bitmap.data(), store.glyphs.data(), (uint16_t)GLCD_FIRST, (uint16_t)GLCD_LAST, yAdvance};
+}
+
+/**
+ * @brief A beépített (2/4/6/7/8) fontok adatai: sormagasság és alapvonal a TFT_eSPI-ből, a glifek szintetizáltak
+ */
+struct BuiltinFont {
+    uint8_t height;
+    uint8_t baseline;
+    GFXfont font;
+};
+
+const BuiltinFont *builtinFontData(uint8_t font) {
+    static const BuiltinFont fonts[] = {
+        {16, 13, synthesizeFont(8, 10, 2, 16, false)},  // 2
+        {26, 19, synthesizeFont(14, 17, 5, 26, false)}, // 4
+        {48, 38, synthesizeFont(27, 34, 0, 48, false)}, // 6
+        {48, 47, synthesizeFont(32, 46, 0, 48, false)}, // 7
+        {75, 73, synthesizeFont(55, 71, 0, 75, false)}, // 8
+    };
+    switch (font) {
+        case 2:
+            return &fonts[0];
+        case 4:
+            return &fonts[1];
+        case 6:
+            return &fonts[2];
+        case 7:
+            return &fonts[3];
+        case 8:
+            return &fonts[4];
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * @brief Egy GFX glif pixele
+ */
+bool gfxBit(const GFXfont *font, const GFXglyph *glyph, int x, int y) {
+    uint32_t bit = y * glyph->width + x;
+    return (font->bitmap[glyph->bitmapOffset + bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+/**
+ * @brief Big endian 32 bites érték a VLW fájlból
+ */
+int32_t readInt32(const uint8_t *data) { return (int32_t)((uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 | (uint32_t)data[2] << 8 | data[3]); }
+
+} // namespace
+
+//--- A projekt free fontjai (sormagasság, nagybetű magasság, átlagos betűszélesség a valódiból) ---
+const GFXfont FreeMono9pt7b = synthesizeFont(11, 11, 4, 18, false);
+const GFXfont FreeSans9pt7b = synthesizeFont(10, 13, 4, 22, false);
+const GFXfont FreeSansBold9pt7b = synthesizeFont(10, 13, 4, 22, true);
+const GFXfont FreeSansBold18pt7b = synthesizeFont(19, 25, 7, 42, true);
+const GFXfont FreeSansBold24pt7b = synthesizeFont(27, 34, 10, 56, true);
+const GFXfont FreeSerifBold24pt7b = synthesizeFont(24, 33, 10, 56, true);
+
+//--- TFT_eSPI ---
+TFT_eSPI::PrimitiveScope::PrimitiveScope(TFT_eSPI *tft, PrimitiveKind kind) : tft(tft) {
+    if (tft->primitiveDepth++ == 0) {
+        tft->currentKind = kind;
+        tft->stats.primitives++;
+        tft->stats.kindCount[kind]++;
+    }
+}
+
+TFT_eSPI::TFT_eSPI(int16_t width, int16_t height) : initWidth(width), initHeight(height), _width(width), _height(height) { framebuffer.assign((size_t)width * height, TFT_BLACK); }
+
+void TFT_eSPI::begin(uint8_t tc) {
+    setRotation(0);
+    addrCol = addrRow = 0xFFFFFFFF;
+}
+
+void TFT_eSPI::setRotation(uint8_t rotation) {
+    this->rotation = rotation & 3;
+    _width = this->rotation & 1 ? initHeight : initWidth;
+    _height = this->rotation & 1 ? initWidth : initHeight;
+    framebuffer.assign((size_t)_width * _height, TFT_BLACK);
+    addrCol = addrRow = 0xFFFFFFFF;
+}
+
+void TFT_eSPI::countWindow(uint32_t commandBytes) {
+    stats.windows++;
+    stats.spiBytes += commandBytes;
+    stats.kindSpiBytes[currentKind] += commandBytes;
+}
+
+void TFT_eSPI::countPixels(uint32_t count) {
+    stats.pixels += count;
+    stats.spiBytes += count * SPI_PIXEL_BYTES;
+    stats.kindSpiBytes[currentKind] += count * SPI_PIXEL_BYTES;
+}
+
+void TFT_eSPI::writeBlock(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        h += y;
+        y = 0;
+    }
+    w = std::min(w, _width - x);
+    h = std::min(h, _height - y);
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    // setWindow(): a teljes cím, és a drawPixel cím gyorsítótára érvénytelen
+    countWindow(SPI_WINDOW_BYTES);
+    addrCol = addrRow = 0xFFFFFFFF;
+    countPixels(w * h);
+    for (int32_t row = y; row < y + h; row++) {
+        std::fill_n(&framebuffer[(size_t)row * _width + x], w, (uint16_t)color);
+    }
+}
+
+void TFT_eSPI::writePixel(int32_t x, int32_t y, uint32_t color) {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) {
+        return;
+    }
+
+    // Mint a valódi drawPixel(): a nem változott oszlop/sor cím nem megy ki újra
+    uint32_t bytes = SPI_COMMAND_BYTES;
+    if (addrCol != (uint32_t)x) {
+        addrCol = x;
+        bytes += SPI_ADDRESS_BYTES;
+    }
+    if (addrRow != (uint32_t)y) {
+        addrRow = y;
+        bytes += SPI_ADDRESS_BYTES;
+    }
+    countWindow(bytes);
+    countPixels(1);
+    framebuffer[(size_t)y * _width + x] = color;
+}
+
+uint16_t TFT_eSPI::readRgb(int32_t x, int32_t y) {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) {
+        return 0;
+    }
+    countWindow(SPI_WINDOW_BYTES);
+    addrCol = addrRow = 0xFFFFFFFF;
+    stats.pixelReads++;
+    stats.spiBytes += SPI_READ_DUMMY_BYTES + SPI_PIXEL_BYTES;
+    stats.kindSpiBytes[currentKind] += SPI_READ_DUMMY_BYTES + SPI_PIXEL_BYTES;
+    return framebuffer[(size_t)y * _width + x];
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data, int32_t stride, int32_t transparent) {
+    // Levágás a képernyőre
+    int32_t dx = 0, dy = 0;
+    if (x < 0) {
+        dx = -x;
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        dy = -y;
+        h += y;
+        y = 0;
+    }
+    w = std::min(w, _width - x);
+    h = std::min(h, _height - y);
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    if (transparent < 0) {
+        // Egy cím ablak, a teljes tartalom
+        countWindow(SPI_WINDOW_BYTES);
+        addrCol = addrRow = 0xFFFFFFFF;
+        countPixels(w * h);
+        for (int32_t row = 0; row < h; row++) {
+            std::copy_n(&data[(size_t)(dy + row) * stride + dx], w, &framebuffer[(size_t)(y + row) * _width + x]);
+        }
+        return;
+    }
+
+    // Átlátszó szín: soronként a nem átlátszó szakaszok, mindegyik saját cím ablakkal
+    for (int32_t row = 0; row < h; row++) {
+        const uint16_t *line = &data[(size_t)(dy + row) * stride + dx];
+        int32_t col = 0;
+        while (col < w) {
+            if (line[col] == transparent) {
+                col++;
+                continue;
+            }
+            int32_t start = col;
+            while (col < w && line[col] != transparent) {
+                col++;
+            }
+            countWindow(SPI_WINDOW_BYTES);
+            countPixels(col - start);
+            std::copy_n(&line[start], col - start, &framebuffer[(size_t)(y + row) * _width + x + start]);
+        }
+    }
+    addrCol = addrRow = 0xFFFFFFFF;
+}
+
+uint16_t TFT_eSPI::alphaBlend(uint8_t alpha, uint16_t fgc, uint16_t bgc) {
+    // A TFT_eSPI képlete (6 bites csatornákon)
+    uint16_t fgR = ((fgc >> 10) & 0x3E) + 1;
+    uint16_t fgG = ((fgc >> 4) & 0x7E) + 1;
+    uint16_t fgB = ((fgc << 1) & 0x3E) + 1;
+    uint16_t bgR = ((bgc >> 10) & 0x3E) + 1;
+    uint16_t bgG = ((bgc >> 4) & 0x7E) + 1;
+    uint16_t bgB = ((bgc << 1) & 0x3E) + 1;
+    uint16_t r = ((fgR * alpha) + (bgR * (255 - alpha))) >> 9;
+    uint16_t g = ((fgG * alpha) + (bgG * (255 - alpha))) >> 9;
+    uint16_t b = ((fgB * alpha) + (bgB * (255 - alpha))) >> 9;
+    return (r << 11) | (g << 5) | b;
+}
+
+//--- Grafikus primitívek (a TFT_eSPI algoritmusaival, így a felbontásuk és a költségük is azonos) ---
+void TFT_eSPI::fillScreen(uint32_t color) {
+    PrimitiveScope scope(this, FILL_SCREEN);
+    writeBlock(0, 0, _width, _height, color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    PrimitiveScope scope(this, FILL_RECT);
+    writeBlock(x, y, w, h, color);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+    PrimitiveScope scope(this, FAST_LINE);
+    writeBlock(x, y, w, 1, color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+    PrimitiveScope scope(this, FAST_LINE);
+    writeBlock(x, y, 1, h, color);
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+    PrimitiveScope scope(this, PIXEL);
+    writePixel(x, y, color);
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) { return readRgb(x, y); }
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    PrimitiveScope scope(this, RECT);
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y + 1, h - 2, color);
+    drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+    PrimitiveScope scope(this, LINE);
+
+    // Bresenham, a vízszintes/függőleges szakaszok egy-egy gyors vonalként
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    int32_t dx = x1 - x0, dy = abs(y1 - y0);
+    int32_t err = dx >> 1, ystep = y0 < y1 ? 1 : -1, xs = x0, dlen = 0;
+    for (; x0 <= x1; x0++) {
+        dlen++;
+        err -= dy;
+        if (err < 0) {
+            if (dlen == 1) {
+                steep ? drawPixel(y0, xs, color) : drawPixel(xs, y0, color);
+            } else {
+                steep ? drawFastVLine(y0, xs, dlen, color) : drawFastHLine(xs, y0, dlen, color);
+            }
+            dlen = 0;
+            y0 += ystep;
+            xs = x0 + 1;
+            err += dx;
+        }
+    }
+    if (dlen) {
+        steep ? drawFastVLine(y0, xs, dlen, color) : drawFastHLine(xs, y0, dlen, color);
+    }
+}
+
+void TFT_eSPI::drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+    PrimitiveScope scope(this, CIRCLE);
+    if (r <= 0) {
+        return;
+    }
+
+    int32_t f = 1 - r, ddF_y = -2 * r, ddF_x = 1, xs = -1, xe = 0, len = 0;
+    bool first = true;
+    do {
+        while (f < 0) {
+            ++xe;
+            f += (ddF_x += 2);
+        }
+        f += (ddF_y += 2);
+
+        if (xe - xs > 1) {
+            if (first) {
+                len = 2 * (xe - xs) - 1;
+                drawFastHLine(x0 - xe, y0 + r, len, color);
+                drawFastHLine(x0 - xe, y0 - r, len, color);
+                drawFastVLine(x0 + r, y0 - xe, len, color);
+                drawFastVLine(x0 - r, y0 - xe, len, color);
+                first = false;
+            } else {
+                len = xe - xs++;
+                drawFastHLine(x0 - xe, y0 + r, len, color);
+                drawFastHLine(x0 - xe, y0 - r, len, color);
+                drawFastHLine(x0 + xs, y0 - r, len, color);
+                drawFastHLine(x0 + xs, y0 + r, len, color);
+                drawFastVLine(x0 + r, y0 + xs, len, color);
+                drawFastVLine(x0 + r, y0 - xe, len, color);
+                drawFastVLine(x0 - r, y0 - xe, len, color);
+                drawFastVLine(x0 - r, y0 + xs, len, color);
+            }
+        } else {
+            ++xs;
+            drawPixel(x0 - xe, y0 + r, color);
+            drawPixel(x0 - xe, y0 - r, color);
+            drawPixel(x0 + xs, y0 - r, color);
+            drawPixel(x0 + xs, y0 + r, color);
+            drawPixel(x0 + r, y0 + xs, color);
+            drawPixel(x0 + r, y0 - xe, color);
+            drawPixel(x0 - r, y0 - xe, color);
+            drawPixel(x0 - r, y0 + xs, color);
+        }
+        xs = xe;
+    } while (xe < --r);
+}
+
+void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+    PrimitiveScope scope(this, CIRCLE);
+    int32_t x = 0, dx = 1, dy = r + r, p = -(r >> 1);
+
+    drawFastHLine(x0 - r, y0, dy + 1, color);
+    while (x < r) {
+        if (p >= 0) {
+            drawFastHLine(x0 - x, y0 + r, dx, color);
+            drawFastHLine(x0 - x, y0 - r, dx, color);
+            dy -= 2;
+            p -= dy;
+            r--;
+        }
+        dx += 2;
+        p += dx;
+        x++;
+        drawFastHLine(x0 - r, y0 + x, dy + 1, color);
+        drawFastHLine(x0 - r, y0 - x, dy + 1, color);
+    }
+}
+
+void TFT_eSPI::drawCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t cornername, uint32_t color) {
+    if (r <= 0) {
+        return;
+    }
+    int32_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0;
+    while (x < r) {
+        if (f >= 0) {
+            r--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (cornername & 0x4) {
+            drawPixel(x0 + x, y0 + r, color);
+            drawPixel(x0 + r, y0 + x, color);
+        }
+        if (cornername & 0x2) {
+            drawPixel(x0 + x, y0 - r, color);
+            drawPixel(x0 + r, y0 - x, color);
+        }
+        if (cornername & 0x8) {
+            drawPixel(x0 - r, y0 + x, color);
+            drawPixel(x0 - x, y0 + r, color);
+        }
+        if (cornername & 0x1) {
+            drawPixel(x0 - r, y0 - x, color);
+            drawPixel(x0 - x, y0 - r, color);
+        }
+    }
+}
+
+void TFT_eSPI::fillCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t cornername, int32_t delta, uint32_t color) {
+    int32_t f = 1 - r, ddF_x = 1, ddF_y = -r - r, y = 0;
+    delta++;
+    while (y < r) {
+        if (f >= 0) {
+            if (cornername & 0x1) {
+                drawFastHLine(x0 - y, y0 + r, y + y + delta, color);
+            }
+            if (cornername & 0x2) {
+                drawFastHLine(x0 - y, y0 - r, y + y + delta, color);
+            }
+            r--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        y++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (cornername & 0x1) {
+            drawFastHLine(x0 - r, y0 + y, r + r + delta, color);
+        }
+        if (cornername & 0x2) {
+            drawFastHLine(x0 - r, y0 - y, r + r + delta, color);
+        }
+    }
+}
+
+void TFT_eSPI::drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
+    PrimitiveScope scope(this, ROUND_RECT);
+    drawFastHLine(x + r, y, w - r - r, color);
+    drawFastHLine(x + r, y + h - 1, w - r - r, color);
+    drawFastVLine(x, y + r, h - r - r, color);
+    drawFastVLine(x + w - 1, y + r, h - r - r, color);
+    drawCircleHelper(x + r, y + r, r, 1, color);
+    drawCircleHelper(x + w - r - 1, y + r, r, 2, color);
+    drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
+    drawCircleHelper(x + r, y + h - r - 1, r, 8, color);
+}
+
+void TFT_eSPI::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
+    PrimitiveScope scope(this, ROUND_RECT);
+    fillRect(x, y + r, w, h - r - r, color);
+    fillCircleHelper(x + r, y + h - r - 1, r, 1, w - r - r - 1, color);
+    fillCircleHelper(x + r, y + r, r, 2, w - r - r - 1, color);
+}
+
+void TFT_eSPI::drawTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color) {
+    PrimitiveScope scope(this, TRIANGLE);
+    drawLine(x0, y0, x1, y1, color);
+    drawLine(x1, y1, x2, y2, color);
+    drawLine(x2, y2, x0, y0, color);
+}
+
+void TFT_eSPI::fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color) {
+    PrimitiveScope scope(this, TRIANGLE);
+
+    // Y szerint rendezve (y2 >= y1 >= y0), soronként egy vízszintes vonal
+    if (y0 > y1) {
+        std::swap(y0, y1);
+        std::swap(x0, x1);
+    }
+    if (y1 > y2) {
+        std::swap(y2, y1);
+        std::swap(x2, x1);
+    }
+    if (y0 > y1) {
+        std::swap(y0, y1);
+        std::swap(x0, x1);
+    }
+
+    if (y0 == y2) {
+        int32_t a = std::min({x0, x1, x2});
+        int32_t b = std::max({x0, x1, x2});
+        drawFastHLine(a, y0, b - a + 1, color);
+        return;
+    }
+
+    int32_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+    int32_t last = y1 == y2 ? y1 : y1 - 1;
+    int32_t y;
+    for (y = y0; y <= last; y++) {
+        int32_t a = x0 + sa / dy01;
+        int32_t b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        if (a > b) {
+            std::swap(a, b);
+        }
+        drawFastHLine(a, y, b - a + 1, color);
+    }
+
+    sa = dx12 * (y - y1);
+    sb = dx02 * (y - y0);
+    for (; y <= y2; y++) {
+        int32_t a = x1 + sa / dy12;
+        int32_t b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        if (a > b) {
+            std::swap(a, b);
+        }
+        drawFastHLine(a, y, b - a + 1, color);
+    }
+}
+
+//--- Szöveg ---
+void TFT_eSPI::setCursor(int16_t x, int16_t y) {
+    cursor_x = bg_cursor_x = x;
+    cursor_y = y;
+}
+
+void TFT_eSPI::setCursor(int16_t x, int16_t y, uint8_t font) {
+    setTextFont(font);
+    setCursor(x, y);
+}
+
+void TFT_eSPI::setTextColor(uint16_t color) { textcolor = textbgcolor = color; }
+
+void TFT_eSPI::setTextColor(uint16_t fgcolor, uint16_t bgcolor, bool bgfill) {
+    textcolor = fgcolor;
+    textbgcolor = bgcolor;
+    fillbg = bgfill;
+}
+
+void TFT_eSPI::setTextFont(uint8_t font) {
+    textfont = font < 1 || font > 8 ? 1 : font;
+    gfxFont = nullptr;
+}
+
+void TFT_eSPI::setFreeFont(const GFXfont *font) {
+    textfont = 1;
+    gfxFont = font;
+    glyph_ab = glyph_bb = 0;
+    if (font == nullptr) {
+        return;
+    }
+
+    // A legnagyobb alapvonal feletti és alatti kiterjedés (a horgonypontokhoz)
+    for (uint16_t c = 0; c <= font->last - font->first; c++) {
+        const GFXglyph &glyph = font->glyph[c];
+        int8_t ab = -glyph.yOffset;
+        int8_t bb = glyph.height - ab;
+        glyph_ab = std::max<int>(glyph_ab, ab);
+        glyph_bb = std::max<int>(glyph_bb, bb);
+    }
+}
+
+const GFXfont *TFT_eSPI::builtinFont(uint8_t font) const {
+    const BuiltinFont *data = builtinFontData(font);
+    return data ? &data->font : nullptr;
+}
+
+uint32_t TFT_eSPI::decodeUTF8(const char *&string) {
+    uint8_t c = *string++;
+    if (c < 0x80) {
+        return c;
+    }
+    if ((c & 0xE0) == 0xC0 && (string[0] & 0xC0) == 0x80) {
+        return ((c & 0x1F) << 6) | (*string++ & 0x3F);
+    }
+    if ((c & 0xF0) == 0xE0 && (string[0] & 0xC0) == 0x80 && (string[1] & 0xC0) == 0x80) {
+        uint32_t code = ((c & 0x0F) << 12) | ((string[0] & 0x3F) << 6) | (string[1] & 0x3F);
+        string += 2;
+        return code;
+    }
+    return c;
+}
+
+int16_t TFT_eSPI::textWidth(const char *string, uint8_t font) {
+    int32_t width = 0;
+
+    if (fontLoaded) {
+        while (*string) {
+            uint32_t code = decodeUTF8(string);
+            const SmoothGlyph *glyph = findGlyph(code);
+            if (glyph) {
+                if (width == 0 && glyph->dX < 0) {
+                    width -= glyph->dX;
+                }
+                width += *string ? glyph->xAdvance : glyph->dX + glyph->width;
+            } else {
+                width += gFont.spaceWidth + 1;
+            }
+        }
+        return width;
+    }
+
+    const GFXfont *gfx = font == 1 ? gfxFont : builtinFont(font);
+    while (*string) {
+        uint32_t code = decodeUTF8(string);
+        if (gfx == nullptr) {
+            width += 6; // GLCD
+        } else if (code >= gfx->first && code <= gfx->last) {
+            const GFXglyph &glyph = gfx->glyph[code - gfx->first];
+            // Free fontnál az utolsó betű a tényleges szélességével számít (az nagyobb lehet az előtolásnál)
+            width += (*string || gfx != gfxFont) ? glyph.xAdvance : glyph.xOffset + glyph.width;
+        }
+    }
+    return width * textsize;
+}
+
+int16_t TFT_eSPI::fontHeight(int16_t font) {
+    if (fontLoaded) {
+        return gFont.yAdvance;
+    }
+    if (font == 1) {
+        return (gfxFont ? gfxFont->yAdvance : 8) * textsize;
+    }
+    const BuiltinFont *data = builtinFontData(font);
+    return (data ? data->height : 8) * textsize;
+}
+
+const uint8_t *TFT_eSPI::glcdGlyph(uint32_t c) const { return c >= GLCD_FIRST && c <= GLCD_LAST ? &GLCD_FONT[(c - GLCD_FIRST) * 5] : nullptr; }
+
+void TFT_eSPI::writeWindow(int32_t x, int32_t y, int32_t w, int32_t h, const uint32_t *colors) {
+    int32_t x0 = std::max<int32_t>(x, 0), y0 = std::max<int32_t>(y, 0);
+    int32_t x1 = std::min<int32_t>(x + w, _width), y1 = std::min<int32_t>(y + h, _height);
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    countWindow(SPI_WINDOW_BYTES);
+    addrCol = addrRow = 0xFFFFFFFF;
+    countPixels((x1 - x0) * (y1 - y0));
+    for (int32_t row = y0; row < y1; row++) {
+        for (int32_t col = x0; col < x1; col++) {
+            framebuffer[(size_t)row * _width + col] = colors[(row - y) * w + (col - x)];
+        }
+    }
+}
+
+int16_t TFT_eSPI::drawGlcdChar(uint32_t c, int32_t x, int32_t y) {
+    const uint8_t *glyph = glcdGlyph(c);
+    const bool background = textcolor != textbgcolor;
+    const uint8_t size = textsize;
+
+    if (size == 1 && background) {
+        // Egy ablakban a 6x8-as cella a háttérrel együtt
+        uint32_t cell[6 * 8];
+        for (int32_t row = 0; row < 8; row++) {
+            for (int32_t col = 0; col < 6; col++) {
+                bool set = glyph && col < 5 && ((glyph[col] >> row) & 1);
+                cell[row * 6 + col] = set ? textcolor : textbgcolor;
+            }
+        }
+        writeWindow(x, y, 6, 8, cell);
+        return 6;
+    }
+
+    for (int32_t col = 0; col < 6; col++) {
+        uint8_t line = (glyph && col < 5) ? glyph[col] : 0;
+        for (int32_t row = 0; row < 8; row++, line >>= 1) {
+            if (size == 1) {
+                if (line & 1) {
+                    writePixel(x + col, y + row, textcolor);
+                }
+            } else if (line & 1) {
+                writeBlock(x + col * size, y + row * size, size, size, textcolor);
+            } else if (background) {
+                writeBlock(x + col * size, y + row * size, size, size, textbgcolor);
+            }
+        }
+    }
+    return 6 * size;
+}
+
+int16_t TFT_eSPI::drawGfxChar(const GFXfont *font, uint32_t c, int32_t x, int32_t y) {
+    if (c < font->first || c > font->last) {
+        return 0;
+    }
+    const GFXglyph *glyph = &font->glyph[c - font->first];
+    const uint8_t size = textsize;
+    const int32_t xo = glyph->xOffset, yo = glyph->yOffset;
+
+    // Átlátszó háttér: soronként a kitöltött szakaszok (y az alapvonal)
+    for (int32_t yy = 0; yy < glyph->height; yy++) {
+        int32_t run = 0;
+        for (int32_t xx = 0; xx <= glyph->width; xx++) {
+            if (xx < glyph->width && gfxBit(font, glyph, xx, yy)) {
+                run++;
+                continue;
+            }
+            if (run) {
+                if (size == 1) {
+                    writeBlock(x + xo + xx - run, y + yo + yy, run, 1, textcolor);
+                } else {
+                    writeBlock(x + (xo + xx - run) * size, y + (yo + yy) * size, size * run, size, textcolor);
+                }
+                run = 0;
+            }
+        }
+    }
+    return glyph->xAdvance * size;
+}
+
+int16_t TFT_eSPI::drawBuiltinChar(uint8_t font, uint32_t c, int32_t x, int32_t y) {
+    const BuiltinFont *data = builtinFontData(font);
+    if (c < data->font.first || c > data->font.last) {
+        return 0;
+    }
+    const GFXglyph *glyph = &data->font.glyph[c - data->font.first];
+    const int32_t width = glyph->xAdvance, height = data->height;
+    const int32_t top = data->baseline + glyph->yOffset; // A glif első sora a cellában
+    const bool background = textcolor != textbgcolor;
+    const uint8_t size = textsize;
+
+    auto cellBit = [&](int32_t col, int32_t row) {
+        int32_t gx = col - glyph->xOffset, gy = row - top;
+        return gx >= 0 && gy >= 0 && gx < glyph->width && gy < glyph->height && gfxBit(&data->font, glyph, gx, gy);
+    };
+
+    if (background && size == 1) {
+        // Gyors út: a cella egy ablakban, a háttérrel együtt
+        std::vector<uint32_t> cell(width * height);
+        for (int32_t row = 0; row < height; row++) {
+            for (int32_t col = 0; col < width; col++) {
+                cell[row * width + col] = cellBit(col, row) ? textcolor : textbgcolor;
+            }
+        }
+        writeWindow(x, y, width, height, cell.data());
+        return width;
+    }
+
+    // Nagyított vagy átlátszó: a 2-es font soronként tölti a hátteret, az RLE fontok egyben; a pixelek egyenként
+    if (background && font != 2) {
+        writeBlock(x, y, width * size, height * size, textbgcolor);
+    }
+    for (int32_t row = 0; row < height; row++) {
+        if (background && font == 2) {
+            writeBlock(x, y + row * size, width * size, size, textbgcolor);
+        }
+        for (int32_t col = 0; col < width; col++) {
+            if (cellBit(col, row)) {
+                if (size == 1) {
+                    writePixel(x + col, y + row, textcolor);
+                } else {
+                    writeBlock(x + col * size, y + row * size, size, size, textcolor);
+                }
+            }
+        }
+    }
+    return width * size;
+}
+
+int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8_t font) {
+    PrimitiveScope scope(this, TEXT);
+
+    const bool freeFont = font == 1 && gfxFont && !fontLoaded;
+    const bool builtin = !fontLoaded && !freeFont && builtinFontData(font) != nullptr;
+    const int32_t cwidth = textWidth(string, font);
+    int32_t cheight = 8 * textsize;
+    int32_t baseline = 0;
+    uint8_t padding = 1; // 1: balra, 2: középre, 3: jobbra igazított
+
+    if (fontLoaded) {
+        baseline = gFont.maxAscent;
+        cheight = fontHeight();
+    } else if (freeFont) {
+        // A free font y koordinátája az alapvonal
+        cheight = glyph_ab * textsize;
+        poY += cheight;
+        baseline = cheight;
+        if (textdatum == BL_DATUM || textdatum == BC_DATUM || textdatum == BR_DATUM) {
+            cheight += glyph_bb * textsize;
+        }
+    } else if (builtin) {
+        baseline = builtinFontData(font)->baseline * textsize;
+        cheight = fontHeight(font);
+    }
+
+    switch (textdatum) {
+        case TC_DATUM:
+            poX -= cwidth / 2;
+            padding += 1;
+            break;
+        case TR_DATUM:
+            poX -= cwidth;
+            padding += 2;
+            break;
+        case ML_DATUM:
+            poY -= cheight / 2;
+            break;
+        case MC_DATUM:
+            poX -= cwidth / 2;
+            poY -= cheight / 2;
+            padding += 1;
+            break;
+        case MR_DATUM:
+            poX -= cwidth;
+            poY -= cheight / 2;
+            padding += 2;
+            break;
+        case BL_DATUM:
+            poY -= cheight;
+            break;
+        case BC_DATUM:
+            poX -= cwidth / 2;
+            poY -= cheight;
+            padding += 1;
+            break;
+        case BR_DATUM:
+            poX -= cwidth;
+            poY -= cheight;
+            padding += 2;
+            break;
+        case L_BASELINE:
+            poY -= baseline;
+            break;
+        case C_BASELINE:
+            poX -= cwidth / 2;
+            poY -= baseline;
+            padding += 1;
+            break;
+        case R_BASELINE:
+            poX -= cwidth;
+            poY -= baseline;
+            padding += 2;
+            break;
+    }
+
+    const bool background = textcolor != textbgcolor;
+    int32_t top = poY;
+    if (freeFont) {
+        // A free font nem rajzol hátteret: a szöveg dobozát előre kitölti
+        top = poY - glyph_ab * textsize;
+        cheight = (glyph_ab + glyph_bb) * textsize;
+        if (background) {
+            writeBlock(poX, top, cwidth, cheight, textbgcolor);
+        }
+    }
+
+    int32_t sumX = 0;
+    if (fontLoaded) {
+        setCursor(poX, poY);
+        bool savedFillbg = fillbg;
+        if (padX && !fillbg) {
+            fillbg = true; // Paddinggel a glifek a hátteret is kitöltik
+        }
+        while (*string) {
+            drawGlyph(decodeUTF8(string));
+        }
+        fillbg = savedFillbg;
+        sumX = cwidth;
+    } else {
+        while (*string) {
+            uint32_t c = decodeUTF8(string);
+            if (freeFont) {
+                sumX += drawGfxChar(gfxFont, c, poX + sumX, poY);
+            } else if (builtin) {
+                sumX += drawBuiltinChar(font, c, poX + sumX, poY);
+            } else {
+                sumX += drawGlcdChar(c, poX + sumX, poY);
+            }
+        }
+    }
+
+    // A padding a szöveg mellett a háttér színével töröl (a régi, hosszabb szöveg maradékát)
+    if (padX > cwidth && background) {
+        int32_t extra = padX - cwidth;
+        switch (padding) {
+            case 1:
+                writeBlock(poX + cwidth, top, extra, cheight, textbgcolor);
+                break;
+            case 2:
+                writeBlock(poX - (extra >> 1), top, extra >> 1, cheight, textbgcolor);
+                writeBlock(poX + cwidth, top, (extra + 1) >> 1, cheight, textbgcolor);
+                break;
+            case 3:
+                writeBlock(poX - extra, top, extra, cheight, textbgcolor);
+                break;
+        }
+    }
+    return sumX;
+}
+
+int16_t TFT_eSPI::drawCentreString(const char *string, int32_t x, int32_t y, uint8_t font) {
+    uint8_t savedDatum = textdatum;
+    textdatum = TC_DATUM;
+    int16_t width = drawString(string, x, y, font);
+    textdatum = savedDatum;
+    return width;
+}
+
+int16_t TFT_eSPI::drawRightString(const char *string, int32_t x, int32_t y, uint8_t font) {
+    uint8_t savedDatum = textdatum;
+    textdatum = TR_DATUM;
+    int16_t width = drawString(string, x, y, font);
+    textdatum = savedDatum;
+    return width;
+}
+
+int16_t TFT_eSPI::drawNumber(long value, int32_t x, int32_t y) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%ld", value);
+    return drawString(buffer, x, y, textfont);
+}
+
+int16_t TFT_eSPI::drawFloat(float value, uint8_t decimals, int32_t x, int32_t y) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    return drawString(buffer, x, y, textfont);
+}
+
+size_t TFT_eSPI::write(uint8_t c) {
+    PrimitiveScope scope(this, TEXT);
+    if (c == '\r') {
+        return 1;
+    }
+    if (c == '\n') {
+        cursor_x = bg_cursor_x = 0;
+        cursor_y += fontHeight();
+        return 1;
+    }
+    if (fontLoaded) {
+        drawGlyph(c);
+    } else if (textfont == 1 && gfxFont) {
+        cursor_x += drawGfxChar(gfxFont, c, cursor_x, cursor_y); // A print() kurzora free fontnál az alapvonal
+    } else if (builtinFontData(textfont)) {
+        cursor_x += drawBuiltinChar(textfont, c, cursor_x, cursor_y);
+    } else {
+        cursor_x += drawGlcdChar(c, cursor_x, cursor_y);
+    }
+    return 1;
+}
+
+//--- Smooth (VLW) font ---
+void TFT_eSPI::loadFont(const uint8_t array[]) {
+    // Fejléc: glifek száma, verzió, méret, (nem használt), ascent, descent; majd glifenként 7 érték és a bitképek
+    const uint32_t count = readInt32(&array[0]);
+    gFont.ascent = readInt32(&array[16]);
+    gFont.descent = readInt32(&array[20]);
+    gFont.maxAscent = gFont.ascent;
+    gFont.maxDescent = gFont.descent;
+    gFont.spaceWidth = (gFont.ascent + gFont.descent) * 2 / 7;
+
+    smoothGlyphs.clear();
+    const uint8_t *bitmap = &array[24 + count * 28];
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *record = &array[24 + i * 28];
+        SmoothGlyph glyph;
+        glyph.unicode = readInt32(&record[0]);
+        glyph.height = readInt32(&record[4]);
+        glyph.width = readInt32(&record[8]);
+        glyph.xAdvance = readInt32(&record[12]);
+        glyph.dY = readInt32(&record[16]);
+        glyph.dX = readInt32(&record[20]);
+        glyph.bitmap = bitmap;
+        bitmap += glyph.width * glyph.height;
+
+        // A legnagyobb kiterjedés a látható glifekből
+        if (glyph.unicode > 0x20 && glyph.unicode != 0xA0 && glyph.unicode != 0x3000) {
+            gFont.maxAscent = std::max<int>(gFont.maxAscent, glyph.dY);
+            gFont.maxDescent = std::max<int>(gFont.maxDescent, glyph.height - glyph.dY);
+        }
+        smoothGlyphs.push_back(glyph);
+    }
+    gFont.yAdvance = gFont.maxAscent + gFont.maxDescent;
+    fontLoaded = true;
+}
+
+const TFT_eSPI::SmoothGlyph *TFT_eSPI::findGlyph(uint32_t code) const {
+    for (const SmoothGlyph &glyph : smoothGlyphs) {
+        if (glyph.unicode == code) {
+            return &glyph;
+        }
+    }
+    return nullptr;
+}
+
+void TFT_eSPI::drawGlyph(uint32_t code) {
+    const SmoothGlyph *glyph = code > 0x20 ? findGlyph(code) : nullptr;
+
+    if (glyph == nullptr) {
+        if (code == ' ' && fillbg) {
+            writeBlock(bg_cursor_x, cursor_y, cursor_x + gFont.spaceWidth - bg_cursor_x, gFont.yAdvance, textbgcolor);
+        } else if (code != ' ') {
+            // Hiányzó glif: keret, mint a valódi könyvtárban
+            drawRect(cursor_x, cursor_y + gFont.maxAscent - gFont.ascent, gFont.spaceWidth, gFont.ascent, textcolor);
+        }
+        cursor_x += gFont.spaceWidth + (code == ' ' ? 0 : 1);
+        bg_cursor_x = cursor_x;
+        return;
+    }
+
+    const int32_t cy = cursor_y + gFont.maxAscent - glyph->dY;
+    const int32_t cx = cursor_x + glyph->dX;
+    const int32_t right = cursor_x + glyph->xAdvance;
+
+    // Háttér: a glif feletti, bal és jobb oldali sáv
+    int32_t fillWidth = 0;
+    int32_t bx = 0;
+    if (fillbg) {
+        fillWidth = std::max<int32_t>(0, right - bg_cursor_x);
+        if (fillWidth > 0 && gFont.maxAscent - glyph->dY > 0) {
+            writeBlock(bg_cursor_x, cursor_y, fillWidth, gFont.maxAscent - glyph->dY, textbgcolor);
+        }
+        if (bg_cursor_x < cx) {
+            writeBlock(bg_cursor_x, cy, cx - bg_cursor_x, glyph->height, textbgcolor);
+        }
+        if (bg_cursor_x > cx) {
+            bx = bg_cursor_x - cx;
+        }
+        if (cx + glyph->width < right) {
+            writeBlock(cx + glyph->width, cy, right - (cx + glyph->width), glyph->height, textbgcolor);
+        }
+    }
+
+    // Soronként: a teljes fedésű szakaszok vonalként, a részlegesek keverve pixelenként
+    const bool readBackground = textcolor == textbgcolor;
+    for (int32_t y = 0; y < glyph->height; y++) {
+        const uint8_t *row = &glyph->bitmap[y * glyph->width];
+        int32_t fgStart = 0, fgLength = 0, bgStart = 0, bgLength = 0;
+        for (int32_t x = 0; x <= glyph->width; x++) {
+            uint8_t alpha = x < glyph->width ? row[x] : 0;
+            bool end = x == glyph->width;
+            if ((alpha || end) && bgLength) {
+                writeBlock(bgStart, cy + y, bgLength, 1, textbgcolor);
+                bgLength = 0;
+            }
+            if ((alpha != 0xFF || end) && fgLength) {
+                writeBlock(fgStart, cy + y, fgLength, 1, textcolor);
+                fgLength = 0;
+            }
+            if (end) {
+                break;
+            }
+            if (alpha == 0xFF) {
+                if (fgLength++ == 0) {
+                    fgStart = cx + x;
+                }
+            } else if (alpha) {
+                uint16_t background = readBackground ? readRgb(cx + x, cy + y) : textbgcolor;
+                writePixel(cx + x, cy + y, alphaBlend(alpha, textcolor, background));
+            } else if (fillbg && x >= bx) {
+                if (bgLength++ == 0) {
+                    bgStart = cx + x;
+                }
+            }
+        }
+    }
+
+    // Háttér: a glif alatti sáv
+    if (fillWidth > 0) {
+        int32_t fillHeight = cursor_y + gFont.yAdvance - (cy + glyph->height);
+        if (fillHeight > 0) {
+            writeBlock(bg_cursor_x, cy + glyph->height, fillWidth, fillHeight, textbgcolor);
+        }
+    }
+    cursor_x += glyph->xAdvance;
+    bg_cursor_x = cursor_x;
+}
+
+//--- TFT_eSprite ---
+TFT_eSprite::TFT_eSprite(TFT_eSPI *tft) : TFT_eSPI(0, 0), tft(tft) { std::copy_n(DEFAULT_4BIT_PALETTE, 16, palette); }
+
+void *TFT_eSprite::setColorDepth(int8_t depth) {
+    colorDepth = (depth == 1 || depth == 4 || depth == 8) ? depth : 16;
+    if (isCreated) {
+        int16_t width = _width, height = _height;
+        deleteSprite();
+        return createSprite(width, height);
+    }
+    return nullptr;
+}
+
+void *TFT_eSprite::createSprite(int16_t width, int16_t height, uint8_t frames) {
+    if (isCreated) {
+        return pixels.data();
+    }
+    if (width < 1 || height < 1) {
+        return nullptr;
+    }
+    _width = initWidth = width;
+    _height = initHeight = height;
+    pixels.assign((size_t)width * height, 0);
+    isCreated = true;
+    return pixels.data();
+}
+
+void TFT_eSprite::deleteSprite() {
+    pixels.clear();
+    pixels.shrink_to_fit();
+    isCreated = false;
+}
+
+void TFT_eSprite::createPalette(const uint16_t *colorMap, uint8_t colors) {
+    std::copy_n(DEFAULT_4BIT_PALETTE, 16, palette);
+    if (colorMap) {
+        std::copy_n(colorMap, std::min<uint8_t>(colors, 16), palette);
+    }
+}
+
+uint16_t TFT_eSprite::toRgb(uint16_t stored) const {
+    switch (colorDepth) {
+        case 1:
+            return stored ? bitmapFg : bitmapBg;
+        case 4:
+            return palette[stored & 0x0F];
+        case 8: {
+            // RGB332 -> RGB565
+            uint16_t r = (stored >> 5) & 0x07, g = (stored >> 2) & 0x07, b = stored & 0x03;
+            return ((r * 31 / 7) << 11) | ((g * 63 / 7) << 5) | (b * 31 / 3);
+        }
+        default:
+            return stored;
+    }
+}
+
+void TFT_eSprite::writeBlock(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    if (!isCreated) {
+        return;
+    }
+    int32_t x0 = std::max<int32_t>(x, 0), y0 = std::max<int32_t>(y, 0);
+    int32_t x1 = std::min<int32_t>(x + w, _width), y1 = std::min<int32_t>(y + h, _height);
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+
+    // A tárolt érték: 16 bitnél a szín, 8 bitnél RGB332, 4 bitnél a paletta index, 1 bitnél 0/1
+    uint16_t stored;
+    switch (colorDepth) {
+        case 1:
+            stored = color ? 1 : 0;
+            break;
+        case 4:
+            stored = color & 0x0F;
+            break;
+        case 8:
+            stored = ((color >> 8) & 0xE0) | ((color >> 6) & 0x1C) | ((color >> 3) & 0x03);
+            break;
+        default:
+            stored = color;
+            break;
+    }
+    for (int32_t row = y0; row < y1; row++) {
+        std::fill_n(&pixels[(size_t)row * _width + x0], x1 - x0, stored);
+    }
+}
+
+void TFT_eSprite::writeWindow(int32_t x, int32_t y, int32_t w, int32_t h, const uint32_t *colors) {
+    for (int32_t row = 0; row < h; row++) {
+        for (int32_t col = 0; col < w; col++) {
+            writeBlock(x + col, y + row, 1, 1, colors[row * w + col]);
+        }
+    }
+}
+
+uint16_t TFT_eSprite::readRgb(int32_t x, int32_t y) {
+    if (!isCreated || x < 0 || y < 0 || x >= _width || y >= _height) {
+        return 0;
+    }
+    return toRgb(pixels[(size_t)y * _width + x]);
+}
+
+void TFT_eSprite::fillSprite(uint32_t color) { writeBlock(0, 0, _width, _height, color); }
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) { pushSprite(x, y, 0, 0, _width, _height); }
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transparent) {
+    if (!isCreated) {
+        return;
+    }
+    // Az átlátszó szín a sprite színmélységén értendő (4 bitnél paletta index)
+    int32_t transparentRgb = colorDepth == 16 ? transparent : colorDepth == 4 ? palette[transparent & 0x0F] : toRgb(transparent);
+
+    std::vector<uint16_t> rgb(pixels.size());
+    std::transform(pixels.begin(), pixels.end(), rgb.begin(), [this](uint16_t stored) { return toRgb(stored); });
+    PrimitiveScope scope(tft, SPRITE);
+    tft->pushImage(x, y, _width, _height, rgb.data(), _width, transparentRgb);
+}
+
+bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh) {
+    if (!isCreated) {
+        return false;
+    }
+
+    // A forrás téglalap levágása a sprite-ra
+    if (sx < 0) {
+        tx -= sx;
+        sw += sx;
+        sx = 0;
+    }
+    if (sy < 0) {
+        ty -= sy;
+        sh += sy;
+        sy = 0;
+    }
+    sw = std::min<int32_t>(sw, _width - sx);
+    sh = std::min<int32_t>(sh, _height - sy);
+    if (sw <= 0 || sh <= 0) {
+        return false;
+    }
+
+    std::vector<uint16_t> rgb((size_t)sw * sh);
+    for (int32_t row = 0; row < sh; row++) {
+        for (int32_t col = 0; col < sw; col++) {
+            rgb[(size_t)row * sw + col] = toRgb(pixels[(size_t)(sy + row) * _width + sx + col]);
+        }
+    }
+    PrimitiveScope scope(tft, SPRITE);
+    tft->pushImage(tx, ty, sw, sh, rgb.data(), sw);
+    return true;
+}
@@ -0,0 +1,194 @@
+#include <TinyGPS++.h>
+
+namespace {
+
+/**
+ * @brief Tizedes mező századokban (mint a TinyGPSPlus::parseDecimal: "123.45" -> 12345, a 3. tizedestől csonkol)
+ */
+int32_t parseDecimal(const char *term) {
+    bool negative = *term == '-';
+    if (negative) {
+        term++;
+    }
+    int32_t value = 100 * (int32_t)atol(term);
+    while (isdigit((unsigned char)*term)) {
+        term++;
+    }
+    if (*term == '.' && isdigit((unsigned char)term[1])) {
+        value += 10 * (term[1] - '0');
+        if (isdigit((unsigned char)term[2])) {
+            value += term[2] - '0';
+        }
+    }
+    return negative ? -value : value;
+}
+
+/**
+ * @brief ddmm.mmmm (vagy dddmm.mmmm) koordináta és félteke -> előjeles fok
+ */
+double parseDegrees(const char *term, const char *hemisphere) {
+    double raw = atof(term);
+    int degrees = (int)(raw / 100);
+    double value = degrees + (raw - degrees * 100) / 60.0;
+    return (*hemisphere == 'S' || *hemisphere == 'W') ? -value : value;
+}
+
+/**
+ * @brief Mondat típus a GP/GN előtag nélkül ("RMC", "GGA"), ha a két előtag egyike
+ */
+const char *sentenceType(const char *name) { return (strncmp(name, "GP", 2) == 0 || strncmp(name, "GN", 2) == 0) ? name + 2 : ""; }
+
+} // namespace
+
+void TinyGPSCustom::begin(TinyGPSPlus &gps, const char *sentenceName, int termNumber) {
+    strncpy(this->sentenceName, sentenceName, sizeof(this->sentenceName) - 1);
+    this->termNumber = termNumber;
+    next = gps.customs;
+    gps.customs = this;
+}
+
+bool TinyGPSPlus::encode(char c) {
+    encodedCharCount++;
+
+    if (c == '$') {
+        inSentence = true;
+        sentenceLength = 0;
+        return false;
+    }
+    if (!inSentence || c == '\r') {
+        return false;
+    }
+    if (c == '\n') {
+        inSentence = false;
+        sentence[sentenceLength] = '\0';
+        return endOfSentence();
+    }
+    if (sentenceLength < MAX_SENTENCE_SIZE) {
+        sentence[sentenceLength++] = c;
+    } else {
+        inSentence = false; // túl hosszú: eldobjuk
+    }
+    return false;
+}
+
+/**
+ * @brief A lezárt mondat ellenőrzése és a mezők commit-ja
+ */
+bool TinyGPSPlus::endOfSentence() {
+    char *star = strchr(sentence, '*');
+    if (star == nullptr || strlen(star) < 3) {
+        failedChecksumCount++;
+        return false;
+    }
+    uint8_t checksum = 0;
+    for (char *p = sentence; p < star; p++) {
+        checksum ^= (uint8_t)*p;
+    }
+    if (checksum != (uint8_t)strtoul(star + 1, nullptr, 16)) {
+        failedChecksumCount++;
+        return false;
+    }
+    passedChecksumCount++;
+
+    // Mezőkre bontás helyben (üres mezők is)
+    *star = '\0';
+    const char *terms[MAX_TERMS];
+    uint8_t termCount = 0;
+    char *term = sentence;
+    while (termCount < MAX_TERMS) {
+        terms[termCount++] = term;
+        char *comma = strchr(term, ',');
+        if (comma == nullptr) {
+            break;
+        }
+        *comma = '\0';
+        term = comma + 1;
+    }
+    auto field = [&](uint8_t index) { return index < termCount ? terms[index] : ""; };
+
+    const char *type = sentenceType(terms[0]);
+    if (strcmp(type, "RMC") == 0) {
+        const bool hasFix = *field(2) == 'A';
+        time.time = (uint32_t)parseDecimal(field(1));
+        time.commit();
+        date.date = (uint32_t)atol(field(9));
+        date.commit();
+        location.fixMode = *field(12) ? (TinyGPSLocation::Mode)*field(12) : TinyGPSLocation::N;
+        if (hasFix) {
+            sentencesWithFixCount++;
+            location.latitude = parseDegrees(field(3), field(4));
+            location.longitude = parseDegrees(field(5), field(6));
+            location.commit();
+            speed.val = parseDecimal(field(7));
+            speed.commit();
+            course.val = parseDecimal(field(8));
+            course.commit();
+        }
+    } else if (strcmp(type, "GGA") == 0) {
+        const bool hasFix = *field(6) > '0';
+        time.time = (uint32_t)parseDecimal(field(1));
+        time.commit();
+        location.fixQuality = *field(6) ? (TinyGPSLocation::Quality)*field(6) : TinyGPSLocation::Invalid;
+        if (hasFix) {
+            sentencesWithFixCount++;
+            location.latitude = parseDegrees(field(2), field(3));
+            location.longitude = parseDegrees(field(4), field(5));
+            location.commit();
+            altitude.val = parseDecimal(field(9));
+            altitude.commit();
+        }
+        satellites.val = (uint32_t)atol(field(7));
+        satellites.commit();
+        hdop.val = parseDecimal(field(8));
+        hdop.commit();
+    }
+
+    for (TinyGPSCustom *custom = customs; custom != nullptr; custom = custom->next) {
+        if (strcmp(custom->sentenceName, terms[0]) == 0 && custom->termNumber < termCount) {
+            strncpy(custom->buffer, terms[custom->termNumber], TinyGPSCustom::MAX_FIELD_SIZE);
+            custom->buffer[TinyGPSCustom::MAX_FIELD_SIZE] = '\0';
+            custom->valid = custom->updated = true;
+            custom->lastCommitTime = millis();
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Főkör távolság méterben (a könyvtár képlete)
+ */
+double TinyGPSPlus::distanceBetween(double lat1, double long1, double lat2, double long2) {
+    double delta = radians(long1 - long2);
+    double sdlong = sin(delta);
+    double cdlong = cos(delta);
+    lat1 = radians(lat1);
+    lat2 = radians(lat2);
+    double slat1 = sin(lat1);
+    double clat1 = cos(lat1);
+    double slat2 = sin(lat2);
+    double clat2 = cos(lat2);
+    delta = (clat1 * slat2) - (slat1 * clat2 * cdlong);
+    delta = sq(delta);
+    delta += sq(clat2 * sdlong);
+    delta = sqrt(delta);
+    double denom = (slat1 * slat2) + (clat1 * clat2 * cdlong);
+    delta = atan2(delta, denom);
+    return delta * 6372795;
+}
+
+/**
+ * @brief Irányszög fokban (0 = észak, a könyvtár képlete)
+ */
+double TinyGPSPlus::courseTo(double lat1, double long1, double lat2, double long2) {
+    double dlon = radians(long2 - long1);
+    lat1 = radians(lat1);
+    lat2 = radians(lat2);
+    double a1 = sin(dlon) * cos(lat2);
+    double a2 = sin(lat1) * cos(lat2) * cos(dlon);
+    a2 = cos(lat1) * sin(lat2) - a2;
+    a2 = atan2(a1, a2);
+    if (a2 < 0.0) {
+        a2 += TWO_PI;
+    }
+    return degrees(a2);
+}
@@ -0,0 +1,279 @@
+/**
+ * Hoszt (native) futtató: NMEA napló visszajátszása a GPS / traffipax / konfig logikán, a Pico nélkül
+ *
+ * A Core0/Core1 ütemezőket ugyanazokkal a feladatokkal tölti fel, mint a main.cpp (a kijelző, érintés, hang és szenzorok
+ * nélkül), a naplót a megadott baud rátával a GPS soros portra adagolja, és a virtuális órát 1ms-onként léptetve
+ * futtatja a két ütemezőt. A futás végén összesít: epochák, riasztások, elveszett GPS bájtok, flash írások, a feladatok
+ * hoszt ideje magonként és a hoszt sebessége (a virtuális idő hányszorosa). A virtuális óra a feladatok alatt áll
+ * (csak a flash műveletek léptetik), így az ütemezők futásidő statisztikája itt nem a költséget, hanem a futások számát mutatja.
+ *
+ * Használat:
+ *   pio run -e native
+ *   .pio/build/native/program [-q] [-b 9600] [-d data] [-f native_flash.bin] [-r 1] drive.nmea
+ *
+ *   -q  a DEBUG kimenet elnémítása (benchmark)
+ *   -b  a GPS baud ráta
+ *   -d  a LittleFS gyökér (a trafipaxes.csv helye)
+ *   -f  a flash képfájl (a konfig napló a futások között megmarad; alapból csak memóriában)
+ *   -r  a napló ismétlésének száma
+ */
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <chrono>
+#include <getopt.h>
+#include <vector>
+
+#include "Config.h"
+#include "FlashWriteService.h"
+#include "GpsManager.h"
+#include "LatencyProbe.h"
+#include "NativeHal.h"
+#include "StatusLed.h"
+#include "TaskScheduler.h"
+#include "TraffipaxAlertEvaluator.h"
+#include "TraffipaxManager.h"
+#include "pins.h"
+
+//------------------ A main.cpp globálisai (a mag logika használja őket)
+TraffipaxManager traffipaxManager;
+LatencyProbe latencyProbe;
+StatusLed statusLed(PIN_INTERNAL_RGB_LED);
+GpsManager *gpsManager = nullptr;
+TraffipaxAlertEvaluator *traffipaxAlertEvaluator = nullptr;
+FlashWriteService flashWriteService;
+TaskScheduler core0Scheduler("core0");
+TaskScheduler core1Scheduler("core1");
+bool demoMode = false;
+
+// A main.cpp feladat periódusai
+#define CONFIG_DISPATCH_INTERVAL_MS 50
+#define CONFIG_SAVE_CHECK_INTERVAL (1000 * 60 * 5)
+#define GPS_TASK_INTERVAL_MS 2
+#define ALERT_TASK_INTERVAL_MS 100
+#define SATELLITE_DB_MAINTENANCE_INTERVAL_MS 1000
+#define STATUS_LED_UPDATE_INTERVAL_MS 500
+
+#define TICK_MICROS 1000       // A virtuális óra lépése a két ütemező futtatása között
+#define FEED_CHUNK_SIZE 1024   // Ennyi bájt kerül egyszerre a GPS soros port sorába
+#define DRAIN_TIMEOUT_MS 10000 // A napló vége után ennyi ideig fut még (riasztás lecsengése, függő flash írások)
+
+namespace {
+uint8_t uiTaskId = TaskScheduler::INVALID_TASK;
+uint8_t alertTaskId = TaskScheduler::INVALID_TASK;
+
+// A képernyőkezelő helyett: az események számolása, a riasztások kiírása
+uint32_t fixEpochs = 0;
+uint32_t gsvBlocks = 0;
+uint32_t alertEvents = 0;
+uint32_t sirenStarts = 0;
+
+// A hoszt ideje magonként (a feladatok virtuális futásideje 0, a valós költségük ez)
+std::chrono::steady_clock::duration hostCoreTime[2] = {};
+
+const char *alertStateName(TraffipaxAlertEvent::State state) {
+    switch (state) {
+        case TraffipaxAlertEvent::APPROACHING:
+            return "APPROACHING";
+        case TraffipaxAlertEvent::NEARBY_STOPPED:
+            return "NEARBY_STOPPED";
+        case TraffipaxAlertEvent::DEPARTING:
+            return "DEPARTING";
+        default:
+            return "INACTIVE";
+    }
+}
+
+/**
+ * @brief A Core0 "ui" feladata: a GPS és a riasztás események kivétele
+ */
+void drainEvents() {
+    GpsEvent gpsEvent;
+    while (gpsManager->popEvent(gpsEvent)) {
+        if (gpsEvent.type == GpsEvent::FIX_EPOCH) {
+            fixEpochs++;
+        } else {
+            gsvBlocks++;
+        }
+    }
+
+    TraffipaxAlertEvent alert;
+    static TraffipaxAlertEvent::State lastState = TraffipaxAlertEvent::INACTIVE;
+    while (traffipaxAlertEvaluator->popEvent(alert)) {
+        alertEvents++;
+        if (alert.siren == TraffipaxAlertEvent::SIREN_START) {
+            sirenStarts++;
+        }
+        if (alert.state != lastState) {
+            lastState = alert.state;
+            printf("%10.3f s  %-14s %6.0f m  %s, %s\n", NativeHal::nowMicros() / 1e6, alertStateName(alert.state), alert.distance, alert.traffipax ? alert.traffipax->city : "-",
+                   alert.traffipax ? alert.traffipax->street_or_km : "-");
+        }
+    }
+}
+
+/**
+ * @brief A main.cpp feladatai, a hardver nélküliek
+ */
+void registerTasks() {
+    uiTaskId = core0Scheduler.addPeriodicTask("ui", 10, drainEvents);
+    core0Scheduler.addPeriodicTask("config", CONFIG_DISPATCH_INTERVAL_MS, []() { config.dispatchPending(); });
+    core0Scheduler.addPeriodicTask("cfgsave", CONFIG_SAVE_CHECK_INTERVAL, []() { config.checkSave(); });
+    uint8_t flashTaskId = core0Scheduler.addPeriodicTask("flash", FlashWriteService::PROCESS_INTERVAL_MS, []() { flashWriteService.process(); });
+    flashWriteService.begin(flashTaskId);
+
+    core1Scheduler.addPeriodicTask("config", CONFIG_DISPATCH_INTERVAL_MS, []() { config.dispatchPending(); });
+    core1Scheduler.addPeriodicTask("gps", GPS_TASK_INTERVAL_MS, []() {
+        gpsManager->loop();
+        if (gpsManager->isFixEpochPending()) {
+            core1Scheduler.signal(alertTaskId);
+            flashWriteService.onFixEpoch(traffipaxAlertEvaluator->isAlertActive());
+        }
+        flashWriteService.onGpsPoll(gpsManager->getLastRxMicros());
+        if (gpsManager->hasPendingEvents()) {
+            core0Scheduler.signal(uiTaskId);
+        }
+    });
+    alertTaskId = core1Scheduler.addPeriodicTask("alert", ALERT_TASK_INTERVAL_MS, []() {
+        traffipaxAlertEvaluator->loop();
+        if (traffipaxAlertEvaluator->hasPendingEvents()) {
+            core0Scheduler.signal(uiTaskId);
+        }
+    });
+    core1Scheduler.addPeriodicTask("satdb", SATELLITE_DB_MAINTENANCE_INTERVAL_MS, []() { gpsManager->maintainSatelliteDb(); });
+    core1Scheduler.addPeriodicTask("gpsled", STATUS_LED_UPDATE_INTERVAL_MS, []() { gpsManager->updateStatusLed(); });
+}
+
+/**
+ * @brief Egy virtuális óra lépés: mindkét mag ütemezőjének egy köre
+ */
+void tick() {
+    auto start = std::chrono::steady_clock::now();
+    NativeHal::setCore(1);
+    core1Scheduler.run();
+    auto core1Done = std::chrono::steady_clock::now();
+    NativeHal::setCore(0);
+    core0Scheduler.run();
+    auto core0Done = std::chrono::steady_clock::now();
+    hostCoreTime[1] += core1Done - start;
+    hostCoreTime[0] += core0Done - core1Done;
+    NativeHal::advanceMicros(TICK_MICROS);
+}
+
+void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-q] [-b baud] [-d fs_root] [-f flash_image] [-r repeat] <nmea_log>\n", program);
+    exit(2);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    bool quiet = false;
+    unsigned long baud = 9600;
+    const char *fsRoot = "data";
+    const char *flashImage = nullptr;
+    int repeat = 1;
+
+    int option;
+    while ((option = getopt(argc, argv, "qb:d:f:r:")) != -1) {
+        switch (option) {
+            case 'q':
+                quiet = true;
+                break;
+            case 'b':
+                baud = strtoul(optarg, nullptr, 10);
+                break;
+            case 'd':
+                fsRoot = optarg;
+                break;
+            case 'f':
+                flashImage = optarg;
+                break;
+            case 'r':
+                repeat = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if (optind != argc - 1 || baud == 0 || repeat < 1) {
+        usage(argv[0]);
+    }
+
+    // A napló beolvasása
+    FILE *logFile = fopen(argv[optind], "rb");
+    if (logFile == nullptr) {
+        perror(argv[optind]);
+        return 1;
+    }
+    std::vector<uint8_t> nmea;
+    uint8_t buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), logFile)) > 0) {
+        nmea.insert(nmea.end(), buffer, buffer + length);
+    }
+    fclose(logFile);
+
+    if (!NativeHal::openFlashImage(flashImage)) {
+        perror(flashImage);
+        return 1;
+    }
+    NativeHal::setFsRoot(fsRoot);
+    if (quiet) {
+        Serial.setOutput(nullptr);
+    }
+
+    // Core0 setup (mint a main.cpp)
+    NativeHal::setCore(0);
+    LittleFS.begin();
+    if (traffipaxManager.checkFile(TraffipaxManager::CSV_FILE_NAME)) {
+        traffipaxManager.loadFromCSV(TraffipaxManager::CSV_FILE_NAME);
+    }
+    StoreJournalBase<Config_t>::init();
+    config.load();
+
+    // Core1 setup
+    NativeHal::setCore(1);
+    Serial1.begin(baud);
+    gpsManager = new GpsManager(Serial1);
+    traffipaxAlertEvaluator = new TraffipaxAlertEvaluator();
+
+    registerTasks();
+    printf("%d traffipax, %u NMEA bytes x %d @ %lu baud\n", traffipaxManager.count(), (unsigned)nmea.size(), repeat, baud);
+
+    // Visszajátszás: a soros port sorát darabonként töltjük, hogy a teljes napló ne kerüljön egyszerre a sorba
+    auto hostStart = std::chrono::steady_clock::now();
+    uint64_t virtualStart = NativeHal::nowMicros();
+    size_t fed = 0;
+    size_t total = nmea.size() * repeat;
+    while (fed < total || Serial1.pending() > 0) {
+        if (fed < total && Serial1.pending() < FEED_CHUNK_SIZE) {
+            size_t offset = fed % nmea.size();
+            size_t chunk = std::min<size_t>(FEED_CHUNK_SIZE, nmea.size() - offset);
+            Serial1.feed(&nmea[offset], chunk);
+            fed += chunk;
+        }
+        tick();
+    }
+    for (uint32_t i = 0; i < DRAIN_TIMEOUT_MS * 1000 / TICK_MICROS; i++) {
+        tick();
+    }
+    double hostSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - hostStart).count();
+    double virtualSeconds = (NativeHal::nowMicros() - virtualStart) / 1e6;
+
+    // Összesítés (a dump-ok a DEBUG kimenetre mennek)
+    Serial.setOutput(stdout);
+    printf("\n%.1f s replayed in %.3f s host time (x%.0f)\n", virtualSeconds, hostSeconds, hostSeconds > 0 ? virtualSeconds / hostSeconds : 0.0);
+    for (uint8_t core = 0; core < 2; core++) {
+        printf("core%u host time %.3f ms\n", core, std::chrono::duration<double, std::milli>(hostCoreTime[core]).count());
+    }
+    printf("fix epochs %u, GSV blocks %u, alert events %u, siren starts %u\n", fixEpochs, gsvBlocks, alertEvents, sirenStarts);
+    printf("GPS UART overruns %u bytes\n", Serial1.getOverruns());
+    printf("flash: %u erases, %u page programs, %u writes (max stall %u us)\n", NativeHal::getFlashEraseCount(), NativeHal::getFlashProgramCount(), flashWriteService.getWriteCount(),
+           flashWriteService.getMaxStallMicros());
+    core0Scheduler.dump();
+    core1Scheduler.dump();
+    latencyProbe.dump();
+
+    delete traffipaxAlertEvaluator;
+    delete gpsManager;
+    return 0;
+}
@@ -0,0 +1,121 @@
+"""
+Hot kód és adat SRAM-ba helyezése az sram_hotlist.txt alapján (PlatformIO extra_script, linkelés előtt fut)
+
+A -ffunction-sections / -fdata-sections miatt minden függvény és konstans saját szekcióban van (.text.<név>, .rodata.<név>).
+A listában szereplő (demangle-olt névre illeszkedő) szekciókat az objcopy átnevezi a build könyvtár összes objektumában
+és könyvtár archívumában (saját kód, TinyGPSPlus, TFT_eSPI, arduino-pico core):
+    .text.<név>   -> .time_critical.<név>   (a pico-sdk linker szkript a .data kimeneti szekcióba, SRAM-ba teszi)
+    .rodata.<név> -> .data.<név>            (SRAM, a startup kód másolja a flash-ből)
+A flash-be visszahívó kódhoz a linker maga tesz hosszú ugrás veneer-t. A már átnevezett szekciókat nem nevezi át újra,
+így a lépés többször is lefuthat. Kiírja az áthelyezett szekciókat, figyelmeztet a semmire sem illeszkedő mintákra,
+és hibával leáll, ha az összméret túllépi a budget értéket.
+"""
+
+import fnmatch
+import os
+import subprocess
+
+Import("env")
+
+HOTLIST_FILE = os.path.join(env.subst("$PROJECT_DIR"), "sram_hotlist.txt")
+SECTION_KINDS = {
+    "code": (".text.", ".time_critical."),
+    "data": (".rodata.", ".data."),
+}
+
+
+def load_hotlist(path):
+    """A lista beolvasása: (budget, [(fajta, minta), ...])"""
+    budget = None
+    entries = []
+    with open(path, encoding="utf-8") as f:
+        for line_no, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            kind, _, value = line.partition(" ")
+            value = value.strip()
+            if kind == "budget":
+                budget = int(value, 0)
+            elif kind in SECTION_KINDS and value:
+                entries.append((kind, value))
+            else:
+                raise ValueError(f"{path}:{line_no}: ismeretlen bejegyzés: {line}")
+    return budget, entries
+
+
+def list_sections(objdump, path):
+    """Egy objektum/archívum szekciói: [(név, méret), ...]"""
+    output = subprocess.run([objdump, "-h", path], capture_output=True, text=True, check=True).stdout
+    sections = []
+    for line in output.splitlines():
+        fields = line.split()
+        # "  3 .text._ZN11TinyGPSPlus6encodeEc 000001a4  00000000 ..."
+        if len(fields) >= 3 and fields[0].isdigit() and fields[1].startswith("."):
+            sections.append((fields[1], int(fields[2], 16)))
+    return sections
+
+
+def demangle(cppfilt, names):
+    """Nevek demangle-olása egy c++filt hívással"""
+    if not names:
+        return []
+    output = subprocess.run([cppfilt], input="\n".join(names), capture_output=True, text=True, check=True).stdout
+    return output.splitlines()
+
+
+def place_hot_sections(target, source, env):
+    if not os.path.isfile(HOTLIST_FILE):
+        return
+
+    budget, entries = load_hotlist(HOTLIST_FILE)
+    objcopy = env.subst("$OBJCOPY")
+    objdump = objcopy.replace("objcopy", "objdump")
+    cppfilt = objcopy.replace("objcopy", "c++filt")
+    build_dir = env.subst("$BUILD_DIR")
+
+    matched_patterns = set()
+    placed = {}  # szekció név -> (demangle-olt név, méret): a több fordítási egységben előforduló szekció egyszer számít
+    for root, _, files in os.walk(build_dir):
+        for file_name in files:
+            if not file_name.endswith((".o", ".a")):
+                continue
+            path = os.path.join(root, file_name)
+
+            # A korábbi futásban már áthelyezett szekciók is számítanak (a méret és a minták ellenőrzéséhez)
+            candidates = []
+            for name, size in list_sections(objdump, path):
+                for kind, prefixes in SECTION_KINDS.items():
+                    for prefix in prefixes:
+                        if name.startswith(prefix):
+                            candidates.append((kind, name, name[len(prefix):], size))
+            symbols = demangle(cppfilt, [suffix for _, _, suffix, _ in candidates])
+
+            renames = []
+            for (kind, name, suffix, size), symbol in zip(candidates, symbols):
+                for entry_kind, pattern in entries:
+                    if entry_kind == kind and fnmatch.fnmatchcase(symbol, pattern):
+                        new_name = SECTION_KINDS[kind][1] + suffix
+                        if name != new_name:
+                            flags = "" if kind == "code" else ",alloc,load,contents,data"
+                            renames += ["--rename-section", f"{name}={new_name}{flags}"]
+                        matched_patterns.add((entry_kind, pattern))
+                        placed[new_name] = (symbol, size)
+                        break
+            if renames:
+                subprocess.run([objcopy] + renames + [path], check=True)
+
+    # A nem használt szekciókat a --gc-sections még eldobhatja: ez felső becslés
+    total = sum(size for _, size in placed.values())
+    print(f"sram_placement: {len(placed)} szekció, {total} bájt SRAM-ba (felső becslés, a --gc-sections előtt)")
+    for symbol, size in sorted(placed.values(), key=lambda item: -item[1]):
+        print(f"  {size:6d}  {symbol}")
+    for kind, pattern in entries:
+        if (kind, pattern) not in matched_patterns:
+            print(f"sram_placement: FIGYELEM: a '{kind} {pattern}' bejegyzés semmire sem illeszkedik (elavult profil?)")
+    if budget is not None and total > budget:
+        print(f"sram_placement: HIBA: {total} bájt, több mint a {HOTLIST_FILE} budget értéke ({budget} bájt)")
+        env.Exit(1)
+
+
+env.AddPreAction("$BUILD_DIR/${PROGNAME}.elf", place_hot_sections)
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+PC minta profil kiértékelése az sram_hotlist.txt összeállításához
+
+Bemenet: a CodeProfiler::dump() soros kimenete (__CODE_PROFILE build, Latency képernyő -> Dump) és ugyanannak a buildnek
+a firmware.elf fájlja. A "PCPROF <mag> <cím> <darab>" sorok 32 bájtos címvödrei a szimbólumtábla alapján függvényekhez
+rendelődnek; a kimenet a flash-ből futó függvények rangsora a minták száma szerint, méretükkel és a halmozott SRAM
+igénnyel. A --budget keretbe férő függvényekre "code" sorokat javasol (a --write fájlba is írhatja).
+
+Használat:
+    pio device monitor > profile.log   (Dump gomb, majd kilépés)
+    python sram_profile.py profile.log .pio/build/pico/firmware.elf --budget 16384
+    python sram_profile.py profile.log .pio/build/pico/firmware.elf --budget 16384 --write hot_code.txt
+
+Csak a flash-ben futó kód látszik: ami már SRAM-ban van (vagy a bootrom float rutinjai), az a PCPROF_TOTAL sorban
+ram/rom mintaként jelenik meg.
+"""
+
+import argparse
+import bisect
+import os
+import re
+import subprocess
+import sys
+
+DEFAULT_NM = os.path.expanduser("~/.platformio/packages/toolchain-rp2040-earlephilhower/bin/arm-none-eabi-nm")
+SRAM_BASE = 0x20000000
+
+PROFILE_LINE = re.compile(r"PCPROF (\d) 0x([0-9a-fA-F]+) (\d+)")
+TOTAL_LINE = re.compile(r"PCPROF_TOTAL (\d) flash=(\d+) ram=(\d+) rom=(\d+) dropped=(\d+)")
+GLOB_SPECIAL = re.compile(r"([\[\]*?])")
+
+
+def load_symbols(nm, elf):
+    """A flash-beli függvények címsorrendben: [(cím, méret, név), ...]"""
+    output = subprocess.run([nm, "-C", "-S", "-n", "--defined-only", elf], capture_output=True, text=True, check=True).stdout
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split(" ", 3)
+        if len(fields) < 4 or fields[2] not in "tTwW":
+            continue
+        address = int(fields[0], 16) & ~1  # Thumb bit
+        if address < SRAM_BASE:
+            symbols.append((address, int(fields[1], 16), fields[3]))
+    return symbols
+
+
+def find_symbol(symbols, addresses, address):
+    """A címet tartalmazó függvény (vagy None)"""
+    i = bisect.bisect_right(addresses, address) - 1
+    if i >= 0:
+        start, size, name = symbols[i]
+        if start <= address < start + max(size, 1):
+            return symbols[i]
+    return None
+
+
+def hotlist_pattern(name):
+    """Demangle-olt név -> sram_hotlist.txt minta (a fordító klónjaira is illeszkedik)"""
+    base = name.split(" [clone ", 1)[0]
+    return GLOB_SPECIAL.sub(r"[\1]", base) + "*"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PC minta profil -> sram_hotlist.txt javaslat")
+    parser.add_argument("log", help="a soros napló a PCPROF sorokkal")
+    parser.add_argument("elf", help="a profilozott build firmware.elf fájlja")
+    parser.add_argument("--nm", default=DEFAULT_NM if os.path.isfile(DEFAULT_NM) else "arm-none-eabi-nm", help="arm-none-eabi-nm elérési útja")
+    parser.add_argument("--budget", type=int, default=16384, help="a javasolt kód SRAM kerete bájtban")
+    parser.add_argument("--top", type=int, default=40, help="ennyi függvény kerül a rangsorba")
+    parser.add_argument("--write", help="a javasolt code sorok kiírása ebbe a fájlba")
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.nm, args.elf)
+    addresses = [s[0] for s in symbols]
+
+    samples = {}  # (cím, méret, név) -> [mag0, mag1]
+    unknown = 0
+    with open(args.log, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            total = TOTAL_LINE.search(line)
+            if total:
+                core, flash, ram, rom, dropped = (int(v) for v in total.groups())
+                all_samples = flash + ram + rom
+                print(f"core{core}: {all_samples} minta, flash {flash}, ram {ram}, rom {rom}, eldobva {dropped}")
+                continue
+            match = PROFILE_LINE.search(line)
+            if not match:
+                continue
+            core, address, count = int(match.group(1)), int(match.group(2), 16), int(match.group(3))
+            symbol = find_symbol(symbols, addresses, address)
+            if symbol is None:
+                unknown += count
+                continue
+            samples.setdefault(symbol, [0, 0])[core] += count
+
+    total_samples = sum(sum(c) for c in samples.values()) + unknown
+    if total_samples == 0:
+        sys.exit("nincs PCPROF minta a naplóban (__CODE_PROFILE build?)")
+
+    ranked = sorted(samples.items(), key=lambda item: -sum(item[1]))
+    print(f"\n{'minta':>7} {'%':>6} {'core0':>7} {'core1':>7} {'méret':>6} {'halmozott':>9}  függvény")
+    cumulative = 0
+    suggested = []
+    for (address, size, name), counts in ranked[: args.top]:
+        count = sum(counts)
+        fits = cumulative + size <= args.budget
+        if fits:
+            cumulative += size
+            suggested.append(name)
+        print(f"{count:7d} {100.0 * count / total_samples:5.1f}% {counts[0]:7d} {counts[1]:7d} {size:6d} {cumulative if fits else '-':>9}  {name}")
+    if unknown:
+        print(f"{unknown:7d} {100.0 * unknown / total_samples:5.1f}%  (szimbólum nélküli cím)")
+
+    lines = [f"code {hotlist_pattern(name)}" for name in suggested]
+    print(f"\nJavaslat ({cumulative} bájt, keret {args.budget} bájt):")
+    print("\n".join(lines))
+    if args.write:
+        with open(args.write, "w", encoding="utf-8") as f:
+            f.write("\n".join(lines) + "\n")
+        print(f"{args.write}: {len(lines)} sor")
+
+
+if __name__ == "__main__":
+    main()
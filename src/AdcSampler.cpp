@@ -0,0 +1,82 @@
+#include "AdcSampler.h"
+#include "defines.h"
+#include "pins.h"
+
+#include <hardware/adc.h>
+#include <hardware/dma.h>
+
+constexpr uint8_t ADC_FIRST_GPIO = 26;       // A0
+constexpr uint8_t ADC_TEMPERATURE_INPUT = 4; // Belső hőmérő
+constexpr float ADC_CLOCK_HZ = 48000000.0f;  // Az ADC órajele (USB PLL)
+
+// A round-robin növekvő bemenet sorrendben halad: a Channel sorrendnek ezt kell követnie
+static_assert(PIN_VBUS_EXTERNAL_MEASURE_INPUT < PIN_LIGHT_SENSOR && PIN_LIGHT_SENSOR < PIN_VSYS_EXTERNAL_MEASURE_INPUT, "AdcSampler::Channel order must follow the ADC inputs");
+
+/**
+ * ADC, DMA csatornák beállítása és a folyamatos mintavétel indítása
+ */
+void AdcSampler::begin() {
+    dmaChannelA = dma_claim_unused_channel(false);
+    dmaChannelB = dma_claim_unused_channel(false);
+    if (dmaChannelA < 0 || dmaChannelB < 0) {
+        DEBUG("AdcSampler: no free DMA channel\n");
+        return;
+    }
+
+    const uint8_t inputs[] = {PIN_VBUS_EXTERNAL_MEASURE_INPUT - ADC_FIRST_GPIO, PIN_LIGHT_SENSOR - ADC_FIRST_GPIO, PIN_VSYS_EXTERNAL_MEASURE_INPUT - ADC_FIRST_GPIO};
+    uint8_t roundRobinMask = 1 << ADC_TEMPERATURE_INPUT;
+    adc_init();
+    for (uint8_t input : inputs) {
+        adc_gpio_init(ADC_FIRST_GPIO + input);
+        roundRobinMask |= 1 << input;
+    }
+    adc_set_temp_sensor_enabled(true);
+
+    // Az első konverzió a legkisebb bemenettel indul, így a gyűrű i. mintája az (i % CHANNEL_COUNT). csatornáé
+    adc_select_input(inputs[0]);
+    adc_set_round_robin(roundRobinMask);
+    adc_fifo_setup(true, true, 1, false, false);    // FIFO + DREQ minden mintánál, 12 bites minták (nincs 8 bitre léptetés)
+    adc_set_clkdiv(ADC_CLOCK_HZ / SAMPLE_RATE - 1); // Konverzió (1 + div) ADC órajelenként
+    adc_fifo_drain();
+
+    // Két csatorna felváltva tölti a gyűrűt és indítja a másikat: a mintavétel sosem áll meg, nem kell megszakítás.
+    // A ring mód miatt a cím a puffer végén visszafordul, az újraindított csatorna számlálója pedig a kezdeti értékről indul.
+    const int channels[] = {dmaChannelA, dmaChannelB};
+    for (uint8_t i = 0; i < 2; i++) {
+        dma_channel_config dmaConfig = dma_channel_get_default_config(channels[i]);
+        channel_config_set_transfer_data_size(&dmaConfig, DMA_SIZE_16);
+        channel_config_set_read_increment(&dmaConfig, false);
+        channel_config_set_write_increment(&dmaConfig, true);
+        channel_config_set_ring(&dmaConfig, true, __builtin_ctz(sizeof(ring)));
+        channel_config_set_dreq(&dmaConfig, DREQ_ADC);
+        channel_config_set_chain_to(&dmaConfig, channels[1 - i]);
+        dma_channel_configure(channels[i], &dmaConfig, ring, &adc_hw->fifo, RING_SAMPLES, false);
+    }
+
+    startMillis = millis();
+    dma_channel_start(dmaChannelA);
+    adc_run(true);
+}
+
+/**
+ * A szűrt értékek frissítése a gyűrű pufferből
+ */
+void AdcSampler::update() {
+    // Az első teljes gyűrűig a puffer még részben üres
+    if (dmaChannelA < 0 || millis() - startMillis < RING_PERIOD_MS) {
+        return;
+    }
+
+    // Az összegzés közben a DMA már felülírhat néhány mintát: azok ugyanannak a csatornának az újabb mintái
+    uint32_t sums[CHANNEL_COUNT] = {};
+    for (uint16_t i = 0; i < RING_SAMPLES; i += CHANNEL_COUNT) {
+        for (uint8_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+            sums[channel] += ring[i + channel];
+        }
+    }
+
+    // 64 db 12 bites minta összege 18 bites: 16 bitre skálázva
+    for (uint8_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+        filtered[channel].store(sums[channel] * 16 / SAMPLES_PER_CHANNEL, std::memory_order_relaxed);
+    }
+}
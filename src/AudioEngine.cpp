@@ -0,0 +1,263 @@
+#include "AudioEngine.h"
+#include "pins.h"
+
+#include <hardware/clocks.h>
+#include <hardware/gpio.h>
+#include <hardware/pwm.h>
+
+// --- Hang táblák ---
+
+// Érintés pittyenés: 800Hz, 10ms
+static const AudioSegment TICK_SEGMENTS[] = {
+    {800, 800, 10},
+};
+
+// Hiba: 500Hz, 300ms
+static const AudioSegment ERROR_SEGMENTS[] = {
+    {500, 500, 300},
+};
+
+// Traffipax figyelmeztetés: 3 rövid 1200Hz, szünet, 2 hosszabb 1800Hz
+static const AudioSegment ALERT_SEGMENTS[] = {
+    {1200, 1200, 60}, {0, 0, 40}, {1200, 1200, 60}, {0, 0, 40}, {1200, 1200, 60}, {0, 0, 140}, //
+    {1800, 1800, 80}, {0, 0, 40}, {1800, 1800, 80}, {0, 0, 40},                                 //
+};
+
+// Sziréna: 600Hz -> 1800Hz -> 600Hz csúszás (40Hz / 4ms lépés ütemében), majd 100ms szünet
+static const AudioSegment SIREN_SEGMENTS[] = {
+    {600, 1800, 124},
+    {1800, 600, 124},
+    {0, 0, 100},
+};
+
+#define SEGMENT_COUNT(segments) (sizeof(segments) / sizeof(segments[0]))
+
+const AudioEngine::SoundDefinition AudioEngine::SOUNDS[static_cast<uint8_t>(Sound::COUNT)] = {
+    {TICK_SEGMENTS, SEGMENT_COUNT(TICK_SEGMENTS), 1, PRIORITY_UI},       // Tick
+    {ERROR_SEGMENTS, SEGMENT_COUNT(ERROR_SEGMENTS), 1, PRIORITY_NOTIFY}, // Error
+    {ALERT_SEGMENTS, SEGMENT_COUNT(ALERT_SEGMENTS), 1, PRIORITY_ALARM},  // Alert
+    {SIREN_SEGMENTS, SEGMENT_COUNT(SIREN_SEGMENTS), 2, PRIORITY_ALARM},  // Siren
+};
+
+/**
+ * PWM és időzítő inicializálása
+ */
+void AudioEngine::begin() {
+    critical_section_init(&lock);
+
+    // A buzzer lába a saját PWM szeletére kerül, a számláló órajele fix, a frekvenciát a TOP (wrap) adja
+    gpio_set_function(PIN_BUZZER, GPIO_FUNC_PWM);
+    slice = pwm_gpio_to_slice_num(PIN_BUZZER);
+    channel = pwm_gpio_to_channel(PIN_BUZZER);
+    pwmClockHz = clock_get_hz(clk_sys) / PWM_CLKDIV;
+
+    pwm_config pwmConfig = pwm_get_default_config();
+    pwm_config_set_clkdiv_int(&pwmConfig, PWM_CLKDIV);
+    pwm_init(slice, &pwmConfig, false);
+    pwm_set_chan_level(slice, channel, 0);
+    pwm_set_enabled(slice, true);
+}
+
+/**
+ * Hang lejátszásának kérése
+ */
+bool AudioEngine::play(Sound sound) {
+    const Priority priority = SOUNDS[static_cast<uint8_t>(sound)].priority;
+    bool accepted = true;
+
+    critical_section_enter_blocking(&lock);
+    if (!playing && !pcmActive) {
+        start(sound);
+    } else if (playing && priority > SOUNDS[static_cast<uint8_t>(currentSound)].priority) {
+        // Magasabb prioritás: azonnal félbeszakítja az aktuálisat (az eldobódik, nem folytatódik)
+        start(sound);
+    } else if (queueCount < QUEUE_SIZE) {
+        // Beszúrás prioritás szerint, azonos prioritáson belül érkezési sorrendben (PCM lejátszás alatt mindig ide kerül)
+        uint8_t pos = queueCount;
+        while (pos > 0 && SOUNDS[static_cast<uint8_t>(queue[pos - 1])].priority < priority) {
+            queue[pos] = queue[pos - 1];
+            pos--;
+        }
+        queue[pos] = sound;
+        queueCount++;
+    } else {
+        accepted = false;
+    }
+    critical_section_exit(&lock);
+
+    startTimerIfNeeded();
+    return accepted;
+}
+
+/**
+ * Az időzítő indítása, ha van mit játszani
+ */
+void AudioEngine::startTimerIfNeeded() {
+    critical_section_enter_blocking(&lock);
+    bool startTimer = playing && !timerRunning;
+    if (startTimer) {
+        timerRunning = true;
+    }
+    critical_section_exit(&lock);
+
+    // Az időzítő csak lejátszás alatt fut, a megszakítás a hívó (Core0) magján jön
+    if (startTimer) {
+        add_repeating_timer_ms(-TICK_MS, onTimer, this, &timer);
+    }
+}
+
+/**
+ * Egy hang leállítása
+ */
+void AudioEngine::stop(Sound sound) {
+    critical_section_enter_blocking(&lock);
+
+    // Várakozó példányok törlése
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < queueCount; i++) {
+        if (queue[i] != sound) {
+            queue[kept++] = queue[i];
+        }
+    }
+    queueCount = kept;
+
+    if (playing && currentSound == sound) {
+        startNext();
+    }
+    critical_section_exit(&lock);
+}
+
+/**
+ * A PWM szelet átadása PCM lejátszáshoz
+ */
+void AudioEngine::acquirePcm(uint16_t top) {
+    critical_section_enter_blocking(&lock);
+
+    // A szóló hang eldobódik, az időzítő a következő lépésben magától leáll (playing == false)
+    playing = false;
+    pcmActive = true;
+    currentFreq = 0;
+    pwm_set_chan_level(slice, channel, 0);
+    pwm_set_clkdiv_int_frac(slice, 1, 0);
+    pwm_set_wrap(slice, top);
+    critical_section_exit(&lock);
+}
+
+/**
+ * A PWM szelet visszavétele a PCM lejátszástól
+ */
+void AudioEngine::releasePcm() {
+    critical_section_enter_blocking(&lock);
+    pwm_set_chan_level(slice, channel, 0);
+    pwm_set_clkdiv_int_frac(slice, PWM_CLKDIV, 0);
+    currentFreq = 0;
+    pcmActive = false;
+
+    // A PCM alatt felgyűlt kérések folytatása
+    if (queueCount > 0) {
+        startNext();
+    }
+    critical_section_exit(&lock);
+
+    startTimerIfNeeded();
+}
+
+/**
+ * Az időzítő megszakítás belépési pontja
+ */
+bool AudioEngine::onTimer(repeating_timer_t *rt) {
+    AudioEngine *engine = static_cast<AudioEngine *>(rt->user_data);
+
+    critical_section_enter_blocking(&engine->lock);
+    bool keepRunning = engine->tick();
+    if (!keepRunning) {
+        engine->timerRunning = false;
+    }
+    critical_section_exit(&engine->lock);
+
+    return keepRunning;
+}
+
+/**
+ * Egy 1 ms-os lépés
+ */
+bool AudioEngine::tick() {
+    if (!playing) {
+        return false;
+    }
+
+    const SoundDefinition &definition = SOUNDS[static_cast<uint8_t>(currentSound)];
+    segmentElapsedMs += TICK_MS;
+
+    // Szakasz vége: következő szakasz, ismétlés, vagy a következő várakozó hang
+    if (segmentElapsedMs >= definition.segments[segmentIndex].durationMs) {
+        segmentElapsedMs = 0;
+        if (++segmentIndex >= definition.segmentCount) {
+            segmentIndex = 0;
+            if (--repeatsLeft == 0) {
+                startNext();
+                return playing;
+            }
+        }
+    }
+
+    // Csúszó hangnál a frekvencia a szakaszon belül lineárisan változik
+    const AudioSegment &segment = definition.segments[segmentIndex];
+    int32_t freq = segment.startFreq + ((int32_t)segment.endFreq - segment.startFreq) * segmentElapsedMs / segment.durationMs;
+    setFrequency(freq);
+    return true;
+}
+
+/**
+ * Hang indítása az elejéről
+ */
+void AudioEngine::start(Sound sound) {
+    currentSound = sound;
+    segmentIndex = 0;
+    segmentElapsedMs = 0;
+    repeatsLeft = SOUNDS[static_cast<uint8_t>(sound)].repeat;
+    playing = true;
+    setFrequency(SOUNDS[static_cast<uint8_t>(sound)].segments[0].startFreq);
+}
+
+/**
+ * A következő várakozó hang indítása, vagy elhallgatás
+ */
+void AudioEngine::startNext() {
+    if (queueCount == 0) {
+        playing = false;
+        setFrequency(0);
+        return;
+    }
+
+    Sound next = queue[0];
+    queueCount--;
+    for (uint8_t i = 0; i < queueCount; i++) {
+        queue[i] = queue[i + 1];
+    }
+    start(next);
+}
+
+/**
+ * A PWM frekvencia beállítása
+ *
+ * A TOP és a kitöltés regiszter a PWM periódus végén töltődik be, így a váltás glitch-mentes.
+ */
+void AudioEngine::setFrequency(uint16_t freq) {
+    if (freq == currentFreq) {
+        return;
+    }
+    currentFreq = freq;
+
+    if (freq == 0) {
+        pwm_set_chan_level(slice, channel, 0);
+        return;
+    }
+
+    uint32_t top = pwmClockHz / freq - 1;
+    if (top > 0xFFFF) {
+        top = 0xFFFF;
+    }
+    pwm_set_wrap(slice, top);
+    pwm_set_chan_level(slice, channel, (top + 1) / 2); // 50% kitöltés
+}
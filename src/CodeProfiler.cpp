@@ -0,0 +1,145 @@
+#include "CodeProfiler.h"
+
+#include <hardware/irq.h>
+#include <hardware/regs/addressmap.h>
+#include <hardware/structs/xip_ctrl.h>
+#include <hardware/timer.h>
+
+#ifdef __CODE_PROFILE
+/**
+ * @brief A mintavételező alarm megszakításának C része (SRAM-ban, hogy a mérés ne terhelje az XIP cache-t)
+ */
+extern "C" void __not_in_flash_func(codeProfilerSample)(uint32_t pc) { codeProfiler.onSample(pc); }
+
+/**
+ * @brief A mintavételező alarm megszakítás belépési pontja
+ *
+ * A Cortex-M0+ a belépéskor a veremre menti az r0-r3, r12, lr, pc, xPSR regisztereket; a 7. szó (sp + 24) a megszakított
+ * utasítás címe. Az arduino-pico mindkét magon az MSP-t használja, így a keret mindig a belépéskori sp-n van.
+ * A C részre ugrás után annak visszatérése (bx lr, EXC_RETURN) már a kivételből tér vissza.
+ */
+extern "C" void __attribute__((naked)) __not_in_flash_func(codeProfilerIrq)() {
+    asm volatile("mov r0, sp\n"
+                 "ldr r0, [r0, #24]\n"
+                 "ldr r1, =codeProfilerSample\n"
+                 "bx r1\n"
+                 ".ltorg\n");
+}
+#endif
+
+/**
+ * A cache számlálók kiolvasása és nullázása
+ */
+void CodeProfiler::sampleXipCache() {
+    uint32_t hits = xip_ctrl_hw->ctr_hit;
+    uint32_t accesses = xip_ctrl_hw->ctr_acc;
+    xip_ctrl_hw->ctr_hit = 0; // Bármilyen írás nulláz
+    xip_ctrl_hw->ctr_acc = 0;
+
+    xipTotalHits += hits;
+    xipTotalAccesses += accesses;
+    xipWindowHitPermille = accesses ? (uint16_t)((uint64_t)hits * 1000 / accesses) : 0;
+}
+
+/**
+ * A cache statisztika (és a PC minták) nullázása
+ */
+void CodeProfiler::reset() {
+    xipTotalHits = 0;
+    xipTotalAccesses = 0;
+
+#ifdef __CODE_PROFILE
+    // A másik mag megszakítása közben is írhat: diagnosztikához egy-két elveszett minta elfogadható
+    for (CoreProfile &profile : profiles) {
+        memset(profile.bucketKey, 0, sizeof(profile.bucketKey));
+        memset(profile.bucketCount, 0, sizeof(profile.bucketCount));
+        profile.flashSamples = 0;
+        profile.ramSamples = 0;
+        profile.romSamples = 0;
+        profile.droppedSamples = 0;
+    }
+#endif
+}
+
+/**
+ * Mintavételezés indítása a hívó magon
+ */
+void CodeProfiler::begin() {
+#ifdef __CODE_PROFILE
+    CoreProfile &profile = profiles[get_core_num()];
+    profile.alarm = hardware_alarm_claim_unused(true);
+
+    // A megszakítás csak a hívó mag NVIC-jében engedélyezett, így a minta mindig ennek a magnak a PC-je
+    uint irq = TIMER_IRQ_0 + profile.alarm;
+    irq_set_exclusive_handler(irq, codeProfilerIrq);
+    hw_set_bits(&timer_hw->inte, 1u << profile.alarm);
+    irq_set_enabled(irq, true);
+    timer_hw->alarm[profile.alarm] = timer_hw->timerawl + 1000000 / PROFILE_SAMPLE_HZ;
+    DEBUG("CodeProfiler: core%u sampling at %lu Hz (alarm %d)\n", get_core_num(), (unsigned long)PROFILE_SAMPLE_HZ, profile.alarm);
+#endif
+}
+
+#ifdef __CODE_PROFILE
+/**
+ * Egy PC minta rögzítése
+ */
+__not_in_flash("CodeProfiler") void CodeProfiler::onSample(uint32_t pc) {
+    CoreProfile &profile = profiles[get_core_num()];
+
+    // Újraélesítés kis véletlen eltolással, hogy a minták ne szinkronizálódjanak az ütemező ms-os periódusaihoz
+    uint32_t now = timer_hw->timerawl;
+    uint32_t jitter = (now * 2654435761u) >> 26; // 0..63 µs
+    timer_hw->alarm[profile.alarm] = now + 1000000 / PROFILE_SAMPLE_HZ - 32 + jitter;
+    hw_clear_bits(&timer_hw->intr, 1u << profile.alarm);
+
+    if (pc >= SRAM_BASE) {
+        profile.ramSamples++;
+        return;
+    }
+    if (pc < XIP_BASE) {
+        profile.romSamples++;
+        return;
+    }
+    profile.flashSamples++;
+
+    // Nyílt címzésű hash tábla a vödör kulcsokra (Fibonacci hash, lineáris próbálkozás)
+    uint32_t key = (pc >> PROFILE_BUCKET_SHIFT) + 1;
+    uint16_t slot = (key * 2654435761u) >> (32 - __builtin_ctz(PROFILE_TABLE_SIZE));
+    for (uint8_t probe = 0; probe < PROFILE_MAX_PROBE; probe++) {
+        if (profile.bucketKey[slot] == key) {
+            profile.bucketCount[slot]++;
+            return;
+        }
+        if (profile.bucketKey[slot] == 0) {
+            profile.bucketKey[slot] = key;
+            profile.bucketCount[slot] = 1;
+            return;
+        }
+        slot = (slot + 1) & (PROFILE_TABLE_SIZE - 1);
+    }
+    profile.droppedSamples++;
+}
+#endif
+
+/**
+ * A cache statisztika és a PC profil kiírása a soros portra
+ */
+void CodeProfiler::dump() const {
+    uint16_t totalPermille = getXipTotalHitPermille();
+    DEBUG("---- XIP cache hit rate: last %u.%u%%, total %u.%u%% (%lu k accesses) ----\n", xipWindowHitPermille / 10, xipWindowHitPermille % 10, totalPermille / 10, totalPermille % 10,
+          (unsigned long)(xipTotalAccesses / 1000));
+
+#ifdef __CODE_PROFILE
+    // A sram_profile.py ezeket a sorokat dolgozza fel
+    for (uint8_t core = 0; core < 2; core++) {
+        const CoreProfile &profile = profiles[core];
+        DEBUG("PCPROF_TOTAL %u flash=%lu ram=%lu rom=%lu dropped=%lu\n", core, (unsigned long)profile.flashSamples, (unsigned long)profile.ramSamples, (unsigned long)profile.romSamples,
+              (unsigned long)profile.droppedSamples);
+        for (uint16_t i = 0; i < PROFILE_TABLE_SIZE; i++) {
+            if (profile.bucketKey[i] != 0) {
+                DEBUG("PCPROF %u 0x%08lx %lu\n", core, (unsigned long)((profile.bucketKey[i] - 1) << PROFILE_BUCKET_SHIFT), (unsigned long)profile.bucketCount[i]);
+            }
+        }
+    }
+#endif
+}
@@ -21,7 +21,7 @@ const Config_t DEFAULT_CONFIG = {
     .gpsTraffiSirenAlarmEnabled = true, // GPS traffipax sziréna riasztás engedélyezése
 
     // GPS debug opciók
-    .debugGpsSerialOnInternalFastLed = false, // GPS érvényes NMEA mondatok esetén a Zero belső LED villogtatása
+    .debugGpsSerialOnInternalFastLed = false, // GPS állapot (fix mód, hibakódok) kijelzése a Zero belső LED-jén
     .debugGpsSerialData = false,              // GPS soros adat kiírása a soros portra
     .debugGpsSatellitesDatabase = false,
 
@@ -33,33 +33,166 @@ const Config_t DEFAULT_CONFIG = {
 // Globális konfiguráció példány
 Config config;
 
+/**
+ * A Config_t mezőinek leírása a mező szintű változás detektáláshoz
+ */
+struct ConfigFieldInfo {
+    uint16_t offset;
+    uint16_t size;
+    ConfigFieldMask mask;
+};
+
+#define CONFIG_FIELD(member, bit) {offsetof(Config_t, member), sizeof(Config_t::member), ConfigField::bit}
+
+static const ConfigFieldInfo CONFIG_FIELDS[] = {
+    CONFIG_FIELD(tftCalibrateData, TFT_CALIBRATE_DATA),
+    CONFIG_FIELD(tftAutoBrightnessActive, TFT_AUTO_BRIGHTNESS_ACTIVE),
+    CONFIG_FIELD(tftManualBrightnessValue, TFT_MANUAL_BRIGHTNESS_VALUE),
+    CONFIG_FIELD(beeperEnabled, BEEPER_ENABLED),
+    CONFIG_FIELD(screenSaverTimeout, SCREEN_SAVER_TIMEOUT),
+    CONFIG_FIELD(gpsTraffiAlarmDistance, GPS_TRAFFI_ALARM_DISTANCE),
+    CONFIG_FIELD(gpsTraffiAlarmEnabled, GPS_TRAFFI_ALARM_ENABLED),
+    CONFIG_FIELD(gpsTraffiSirenAlarmEnabled, GPS_TRAFFI_SIREN_ALARM_ENABLED),
+    CONFIG_FIELD(debugGpsSerialOnInternalFastLed, DEBUG_GPS_SERIAL_ON_INTERNAL_FAST_LED),
+    CONFIG_FIELD(debugGpsSerialData, DEBUG_GPS_SERIAL_DATA),
+    CONFIG_FIELD(debugGpsSatellitesDatabase, DEBUG_GPS_SATELLITES_DATABASE),
+    CONFIG_FIELD(externalTemperatureMode, EXTERNAL_TEMPERATURE_MODE),
+    CONFIG_FIELD(externalVoltageMode, EXTERNAL_VOLTAGE_MODE),
+};
+
+/**
+ * @brief A két adatpéldány között eltérő mezők bitmaszkja
+ */
+ConfigFieldMask Config::changedFields(const Config_t &a, const Config_t &b) {
+    ConfigFieldMask changed = 0;
+    for (const ConfigFieldInfo &field : CONFIG_FIELDS) {
+        if (memcmp(reinterpret_cast<const uint8_t *>(&a) + field.offset, reinterpret_cast<const uint8_t *>(&b) + field.offset, field.size) != 0) {
+            changed |= field.mask;
+        }
+    }
+    return changed;
+}
+
 /**
  * @brief Feliratkoztat egy komponenst a konfiguráció változásainak figyelésére
  * @param callback A függvény, amit változáskor meg kell hívni
- * @return Index a leiratkozáshoz
+ * @param fields A figyelt mezők (ConfigField bitek)
+ * @param core A mag, amelyiken a callback fut
+ * @return Azonosító a leiratkozáshoz: a generáció és a slot index
  */
-size_t Config::registerChangeCallback(ConfigChangeCallback callback) {
-    changeCallbacks.push_back(callback);
-    return changeCallbacks.size() - 1;
+size_t Config::registerChangeCallback(ConfigChangeCallback callback, ConfigFieldMask fields, ConfigCore core) {
+    uint8_t boundCore = core == ConfigCore::Current ? rp2040.cpuid() : static_cast<uint8_t>(core);
+
+    critical_section_enter_blocking(&registryLock);
+    for (uint8_t i = 0; i < MAX_CHANGE_CALLBACKS; i++) {
+        CallbackSlot &slot = callbackSlots[i];
+        if (!slot.used) {
+            slot.callback = callback;
+            slot.fields = fields;
+            slot.core = boundCore;
+            slot.used = true;
+            size_t callbackId = (static_cast<size_t>(slot.generation) << 8) | i;
+            critical_section_exit(&registryLock);
+            return callbackId;
+        }
+    }
+    critical_section_exit(&registryLock);
+
+    DEBUG("Config: nincs szabad callback slot (max %d)\n", MAX_CHANGE_CALLBACKS);
+    return INVALID_CALLBACK_ID;
 }
 
 /**
- * @brief Leiratkoztat egy komponenst index alapján
- * @param callbackId A registerChangeCallback által visszaadott index
+ * @brief Leiratkoztat egy komponenst azonosító alapján
+ * @param callbackId A registerChangeCallback által visszaadott azonosító
  */
 void Config::unregisterCallback(size_t callbackId) {
-    if (callbackId < changeCallbacks.size()) {
-        changeCallbacks[callbackId] = nullptr; // Egyszerűen nullptr-re állítjuk
+    if (callbackId == INVALID_CALLBACK_ID) {
+        return;
     }
+    uint8_t index = callbackId & 0xFF;
+    uint8_t generation = (callbackId >> 8) & 0xFF;
+    if (index >= MAX_CHANGE_CALLBACKS) {
+        return;
+    }
+
+    critical_section_enter_blocking(&registryLock);
+    CallbackSlot &slot = callbackSlots[index];
+    // Egy régi (már felszabadított) azonosító nem törölheti a slot új tulajdonosát
+    if (slot.used && slot.generation == generation) {
+        slot.used = false;
+        slot.generation++;
+        slot.fields = 0;
+        slot.callback = nullptr;
+    }
+    critical_section_exit(&registryLock);
 }
 
 /**
  * @brief Értesíti a feliratkozott komponenseket a változásról
  */
-void Config::notifyChange() {
-    for (auto &callback : changeCallbacks) {
-        if (callback) { // Csak a nem-null callback-eket hívjuk meg
-            callback();
+void Config::notifyChange(ConfigFieldMask changed) {
+    notifiedData = data;
+    if (changed == 0) {
+        return;
+    }
+
+    // A másik mag feliratkozói a postaládán keresztül, a saját magon lévők azonnal
+    uint8_t core = rp2040.cpuid();
+    post(core ^ 1, changed);
+    invokeCallbacks(core, changed);
+}
+
+/**
+ * @brief Változás küldése a másik mag postaládájába
+ */
+void Config::post(uint8_t core, ConfigFieldMask changed) {
+    changed |= undelivered[core];
+    if (mailbox[core].push(changed)) {
+        undelivered[core] = 0;
+    } else {
+        // A másik mag épp nem kézbesít (pl. flash írás miatt áll): a változás nem veszhet el, később újraküldjük
+        undelivered[core] = changed;
+    }
+}
+
+/**
+ * @brief A hívó mag postaládájában várakozó változások kézbesítése
+ */
+void Config::dispatchPending() {
+    uint8_t core = rp2040.cpuid();
+
+    // A másik magnak korábban nem kézbesíthető változások újraküldése
+    if (undelivered[core ^ 1] != 0) {
+        post(core ^ 1, 0);
+    }
+
+    ConfigFieldMask changed = 0;
+    ConfigFieldMask mask;
+    while (mailbox[core].pop(mask)) {
+        changed |= mask;
+    }
+    if (changed != 0) {
+        invokeCallbacks(core, changed);
+    }
+}
+
+/**
+ * @brief Az adott maghoz kötött, érintett feliratkozók meghívása
+ *
+ * A callback a záron kívül fut (akár fel- vagy leiratkozhat közben). Egy maghoz kötött slotot csak a saját magja
+ * szabadíthat fel, így a hívás közben a slot nem cserélődhet ki.
+ */
+void Config::invokeCallbacks(uint8_t core, ConfigFieldMask changed) {
+    for (uint8_t i = 0; i < MAX_CHANGE_CALLBACKS; i++) {
+        CallbackSlot &slot = callbackSlots[i];
+
+        critical_section_enter_blocking(&registryLock);
+        ConfigFieldMask slotChanged = slot.used && slot.core == core ? slot.fields & changed : 0;
+        critical_section_exit(&registryLock);
+
+        if (slotChanged != 0 && slot.callback) {
+            slot.callback(slotChanged);
         }
     }
-}
\ No newline at end of file
+}
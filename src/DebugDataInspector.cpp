@@ -2,7 +2,7 @@
 
 #include "Config.h"
 #include "defines.h"
-#include "utils.h"
+#include "Utils.h"
 
 /**
  * @brief Kiírja a Config struktúra tartalmát a soros portra.
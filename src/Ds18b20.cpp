@@ -0,0 +1,124 @@
+#include "Ds18b20.h"
+#include "defines.h"
+
+// DS18B20 parancsok
+constexpr uint8_t CMD_MATCH_ROM = 0x55;
+constexpr uint8_t CMD_SKIP_ROM = 0xCC;
+constexpr uint8_t CMD_CONVERT_T = 0x44;
+constexpr uint8_t CMD_READ_SCRATCHPAD = 0xBE;
+
+constexpr uint8_t SCRATCHPAD_LENGTH = 9;
+constexpr uint8_t SCRATCHPAD_CONFIG = 4;         // A konfigurációs regiszter indexe
+constexpr uint8_t SCRATCHPAD_CONFIG_MASK = 0x1F; // A konfigurációs regiszter alsó 5 bitje mindig 1
+
+/**
+ * A busz indítása és a szenzorok felderítése
+ */
+uint8_t Ds18b20::begin(uint8_t pin) {
+    if (!bus.begin(pin)) {
+        return 0;
+    }
+
+    sensorCount = bus.search(roms, MAX_SENSORS);
+    DEBUG("Ds18b20: %d sensor(s) found\n", sensorCount);
+
+    // Az első mérés azonnal indulhat
+    cycleStartMs = millis() - READ_INTERVAL_MS;
+    return sensorCount;
+}
+
+/**
+ * A mérési állapotgép léptetése
+ */
+void Ds18b20::loop() {
+    if (sensorCount == 0) {
+        return;
+    }
+
+    switch (state) {
+        case State::Idle: {
+            if (millis() - cycleStartMs < READ_INTERVAL_MS) {
+                return;
+            }
+            cycleStartMs = millis();
+
+            // Az összes szenzor egyszerre kezdi a konverziót
+            static const uint8_t convertAll[] = {CMD_SKIP_ROM, CMD_CONVERT_T};
+            bus.startTransaction(true, convertAll, sizeof(convertAll), 0);
+            state = State::StartConversion;
+            break;
+        }
+
+        case State::StartConversion:
+            switch (bus.poll()) {
+                case OneWirePio::Status::Done:
+                    conversionStartMs = millis();
+                    state = State::Converting;
+                    break;
+                case OneWirePio::Status::NoPresence:
+                    DEBUG("Ds18b20: no presence on the bus\n");
+                    state = State::Idle;
+                    break;
+                default:
+                    break;
+            }
+            break;
+
+        case State::Converting:
+            if (millis() - conversionStartMs >= CONVERSION_TIME_MS) {
+                readIndex = 0;
+                startReadScratchpad();
+            }
+            break;
+
+        case State::ReadScratchpad:
+            switch (bus.poll()) {
+                case OneWirePio::Status::Done:
+                    storeScratchpad(bus.getReceived());
+                    break;
+                case OneWirePio::Status::NoPresence:
+                    valid[readIndex] = false;
+                    break;
+                default:
+                    return;
+            }
+
+            // A következő szenzor, vagy vége a ciklusnak
+            if (++readIndex < sensorCount) {
+                startReadScratchpad();
+            } else {
+                state = State::Idle;
+            }
+            break;
+    }
+}
+
+/**
+ * A következő szenzor scratchpad olvasásának indítása
+ */
+void Ds18b20::startReadScratchpad() {
+    uint8_t tx[1 + sizeof(uint64_t) + 1];
+    tx[0] = CMD_MATCH_ROM;
+    memcpy(&tx[1], &roms[readIndex], sizeof(uint64_t));
+    tx[sizeof(tx) - 1] = CMD_READ_SCRATCHPAD;
+
+    bus.startTransaction(true, tx, sizeof(tx), SCRATCHPAD_LENGTH);
+    state = State::ReadScratchpad;
+}
+
+/**
+ * A kiolvasott scratchpad ellenőrzése és az eredmény eltárolása
+ */
+void Ds18b20::storeScratchpad(const uint8_t *scratchpad) {
+    // A CRC egy csupa 0 (zárlatos busz) olvasásra is helyes, ezért a konfigurációs regiszter fix bitjeit is nézzük
+    if (OneWirePio::crc8(scratchpad, SCRATCHPAD_LENGTH) != 0 || (scratchpad[SCRATCHPAD_CONFIG] & SCRATCHPAD_CONFIG_MASK) != SCRATCHPAD_CONFIG_MASK) {
+#ifdef DEBUG_DS18B20
+        DEBUG("Ds18b20: scratchpad error, sensor %d\n", readIndex);
+#endif
+        valid[readIndex] = false;
+        return;
+    }
+
+    rawTemperature[readIndex] = (int16_t)(scratchpad[0] | (scratchpad[1] << 8));
+    valid[readIndex] = true;
+}
@@ -0,0 +1,144 @@
+#include "FlashWriteService.h"
+#include "defines.h"
+
+#include <hardware/flash.h>
+
+/**
+ * Írási feladat kérése
+ */
+bool FlashWriteService::request(Job job, void *context) {
+    uint8_t count = jobCount.load(std::memory_order_relaxed);
+    for (uint8_t i = 0; i < count; i++) {
+        if (jobs[i].job == job && jobs[i].context == context) {
+            return true; // Már várakozik: a futáskor úgyis a legfrissebb adatot írja
+        }
+    }
+    if (count >= MAX_JOBS) {
+        DEBUG("FlashWriteService: job queue full, request dropped\n");
+        return false;
+    }
+    jobs[count] = {job, context};
+    jobCount.store(count + 1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Fix epocha jelzése
+ */
+void FlashWriteService::onFixEpoch(bool alertActive) {
+    this->alertActive.store(alertActive, std::memory_order_relaxed);
+    fixEpochMicros.store(micros(), std::memory_order_relaxed);
+
+    // Van várakozó írás: a Core0 feladat még ebben a csendes ablakban fusson le
+    if (!alertActive && jobCount.load(std::memory_order_relaxed) > 0 && processTaskId != TaskScheduler::INVALID_TASK) {
+        core0Scheduler.signal(processTaskId);
+    }
+}
+
+/**
+ * UART kiolvasás után
+ */
+void FlashWriteService::onGpsPoll(uint32_t lastRxMicros) {
+    this->lastRxMicros.store(lastRxMicros, std::memory_order_relaxed);
+
+    // Egy ébresztés csendes szakaszonként: a process() újra beállítja, ha a törlés továbbra is vár
+    if (eraseWaiting.load(std::memory_order_relaxed) && !alertActive.load(std::memory_order_relaxed) && processTaskId != TaskScheduler::INVALID_TASK && isQuietTail(micros())) {
+        eraseWaiting.store(false, std::memory_order_relaxed);
+        core0Scheduler.signal(processTaskId);
+    }
+}
+
+/**
+ * Az epocha sorozata utáni csendes szakasz
+ */
+bool FlashWriteService::isQuietTail(uint32_t now) const {
+    uint32_t sinceFixEpoch = now - fixEpochMicros.load(std::memory_order_relaxed);
+    uint32_t sinceRx = now - lastRxMicros.load(std::memory_order_relaxed);
+    return sinceRx >= QUIET_GAP_US && sinceFixEpoch < ERASE_DEADLINE_US;
+}
+
+/**
+ * Milyen írás futhat most
+ */
+FlashWriteService::Window FlashWriteService::currentWindow() const {
+    if (alertActive.load(std::memory_order_relaxed)) {
+        return Window::None;
+    }
+    uint32_t now = micros();
+    uint32_t sinceFixEpoch = now - fixEpochMicros.load(std::memory_order_relaxed);
+    if (sinceFixEpoch > NO_FIX_TIMEOUT_MS * 1000 || isQuietTail(now)) {
+        return Window::Erase;
+    }
+    return sinceFixEpoch < SAFE_WINDOW_US ? Window::PostEpoch : Window::None;
+}
+
+/**
+ * A várakozó feladatok futtatása
+ */
+void FlashWriteService::process() {
+    uint8_t count = jobCount.load(std::memory_order_relaxed);
+    if (count == 0) {
+        return;
+    }
+    Window window = currentWindow();
+    if (window == Window::None) {
+        return;
+    }
+
+    // A törlést igénylő feladatok a sor elején maradnak a csendes szakaszig
+    eraseAllowed = window == Window::Erase;
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        jobStallMicros = 0;
+        jobDeferred = false;
+        jobs[i].job(jobs[i].context);
+
+        if (jobDeferred) {
+            jobs[kept++] = jobs[i];
+            DEBUG("FlashWriteService: erase deferred to the quiet tail, stall %u us\n", (unsigned)jobStallMicros);
+            continue;
+        }
+        lastStallMicros.store(jobStallMicros, std::memory_order_relaxed);
+        writeCount.store(writeCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        DEBUG("FlashWriteService: write done, stall %u us (max %u us)\n", (unsigned)jobStallMicros, (unsigned)getMaxStallMicros());
+    }
+    eraseAllowed = true;
+    jobCount.store(kept, std::memory_order_relaxed);
+    eraseWaiting.store(kept > 0, std::memory_order_relaxed);
+}
+
+/**
+ * Egy flash művelet leállásának elszámolása
+ */
+void FlashWriteService::accountStall(uint32_t stallMicros) {
+    jobStallMicros += stallMicros;
+    if (stallMicros > maxStallMicros.load(std::memory_order_relaxed)) {
+        maxStallMicros.store(stallMicros, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Egy szektor törlése
+ */
+void FlashWriteService::eraseSector(uint32_t flashOffset) {
+    uint32_t start = micros();
+    noInterrupts();
+    rp2040.idleOtherCore(); // A másik mag a RAM-ban futó FIFO megszakításában vár
+    flash_range_erase(flashOffset, FLASH_SECTOR_SIZE);
+    rp2040.resumeOtherCore();
+    interrupts();
+    accountStall(micros() - start);
+}
+
+/**
+ * Egy lap programozása
+ */
+void FlashWriteService::programPage(uint32_t flashOffset, const uint8_t *page) {
+    uint32_t start = micros();
+    noInterrupts();
+    rp2040.idleOtherCore();
+    flash_range_program(flashOffset, page, FLASH_PAGE_SIZE);
+    rp2040.resumeOtherCore();
+    interrupts();
+    accountStall(micros() - start);
+}
@@ -1,38 +1,31 @@
 #include "GpsManager.h"
 #include "Config.h"
+#include "LatencyProbe.h"
+#include "StatusLed.h"
 #include "Utils.h"
 #include "defines.h"
 
-// Belső LED;  PICO: LED_BUILTIN (sima LED), Zero: GP16 (WS2812 RGB LED)
-#define INTERNAL_RGB_LED_PIN 16
-#define INTERNAL_RGB_LED_BRIGHTNESS 10
-#define INTERNAL_RGB_LED_NUM 1
+constexpr uint8_t MAX_SATELLITES = 50;
 
-// PICO ZERO WS2812 RGB LED driver
-#define FASTLED_INTERNAL
-#include <FastLED.h>
-#define FASTLED_FORCE_SOFTWARE_SPI
-#define FASTLED_FORCE_SOFTWARE_PINS
-CRGB leds[INTERNAL_RGB_LED_NUM];
-#define INTERNAL_LED_COLOR CRGB::Red // Pirosan villogjon, ha GPS adat érkezik
+// A státusz LED hibakódjai (villanások száma)
+constexpr uint8_t STATUS_LED_ERROR_NO_DATA = 1;
+constexpr uint8_t STATUS_LED_ERROR_CHECKSUM = 2;
 
-constexpr uint8_t MAX_SATELLITES = 50;
+// Fix epocha: mely mondatok érkeztek már be az aktuális időbélyeggel
+constexpr uint8_t EPOCH_RMC = 1 << 0;
+constexpr uint8_t EPOCH_GGA = 1 << 1;
+constexpr uint8_t EPOCH_COMPLETE = EPOCH_RMC | EPOCH_GGA;
+constexpr uint8_t EPOCH_PUBLISHED = 1 << 7;
 
 /**
  * Konstruktor
  */
 GpsManager::GpsManager(HardwareSerial &serial) : gpsSerial(serial) {
     // Feliratkozás a config változásokra
-    configCallbackId = config.registerChangeCallback([this]() { this->onConfigChanged(); });
+    configCallbackId = config.registerChangeCallback([this](ConfigFieldMask changed) { this->onConfigChanged(changed); }, ConfigField::DEBUG_GPS);
 
     // Kezdeti értékek felvétele
-    onConfigChanged();
-
-    // inicializáljuk a FastLED-et: Pico Zero WS2812 RGB LED
-    FastLED.addLeds<WS2812, INTERNAL_RGB_LED_PIN, GRB>(leds, INTERNAL_RGB_LED_NUM);
-    FastLED.setBrightness(INTERNAL_RGB_LED_BRIGHTNESS); // Fényerő beállítása
-    FastLED.clear();
-    FastLED.show();
+    onConfigChanged(ConfigField::ALL);
 
     // TinyGPSCustom objektumok inicializálása GSV feldolgozáshoz - fő GSV mezők
     gsv_msg_num.begin(gps, "GPGSV", 1);          // Üzenet sorszáma
@@ -53,6 +46,10 @@ GpsManager::GpsManager(HardwareSerial &serial) : gpsSerial(serial) {
         gsv_snr[i].begin(gps, "GPGSV", 7 + 4 * i);       // offsets 7, 11, 15, 19
     }
 
+    // Fix epocha detektálásához: az RMC és a GGA mondat 1. mezője az UTC időbélyeg
+    rmc_time.begin(gps, "GPRMC", 1);
+    gga_time.begin(gps, "GPGGA", 1);
+
     // Ekkor indultunk
     bootStartTime = millis();
     gpsBootTime = 0;
@@ -66,7 +63,7 @@ GpsManager::~GpsManager() { config.unregisterCallback(configCallbackId); }
 /**
  * @brief Callback függvény, amit a Config hív meg változás esetén
  */
-void GpsManager::onConfigChanged() {
+void GpsManager::onConfigChanged(ConfigFieldMask changed) {
     // DEBUG("GpsManager::onConfigChanged() - Debug flag-ek frissítése.\n");
     debugGpsSerialOnInternalFastLed = config.data.debugGpsSerialOnInternalFastLed;
     debugGpsSerialData = config.data.debugGpsSerialData;
@@ -145,15 +142,38 @@ String GpsManager::getGpsQualityString() {
 /**
  * GPS üzemmód lekérdezése
  */
-String GpsManager::getGpsModeToString() {
+String GpsManager::getGpsModeToString() { return fixModeToString(getFixMode()); }
+
+/**
+ * GPS üzemmód lekérdezése (heap foglalás nélkül)
+ */
+GpsManager::FixMode GpsManager::getFixMode() {
     switch (gps.location.FixMode()) {
         case TinyGPSLocation::N:
-            return "No Fix";
+            return FixMode::NoFix;
         case TinyGPSLocation::A:
-            return "Auto 2D/3D";
+            return FixMode::Auto;
         case TinyGPSLocation::D:
-            return "Differential";
+            return FixMode::Differential;
         case TinyGPSLocation::E:
+            return FixMode::Estimated;
+        default:
+            return FixMode::Unknown;
+    }
+}
+
+/**
+ * GPS üzemmód szöveges neve
+ */
+const char *GpsManager::fixModeToString(FixMode mode) {
+    switch (mode) {
+        case FixMode::NoFix:
+            return "No Fix";
+        case FixMode::Auto:
+            return "Auto 2D/3D";
+        case FixMode::Differential:
+            return "Differential";
+        case FixMode::Estimated:
             return "Estimated";
         default:
             return "Unknown";
@@ -207,6 +227,86 @@ void GpsManager::processGSVMessages() {
     if (debugGpsSatellitesDatabase) {
         satelliteDb.debugSatDb(num_sats_in_view);
     }
+
+    // A teljes GSV blokk beérkezett, a műholdas képernyő frissülhet
+    publishEvent(GpsEvent::GSV_BLOCK);
+}
+
+/**
+ * Fix epocha lezárásának ellenőrzése
+ *
+ * Egy epocha akkor teljes, ha azonos időbélyeggel az RMC (sebesség, dátum) és a GGA (magasság, műholdak, HDOP)
+ * mondat is beérkezett. Ekkor a TinyGPSPlus összes UI által olvasott mezője ugyanabból a mérésből származik.
+ */
+void GpsManager::processFixEpoch(uint32_t rxMicros) {
+
+    uint8_t sentence;
+    const char *time;
+    if (rmc_time.isUpdated()) {
+        sentence = EPOCH_RMC;
+        time = rmc_time.value();
+    } else if (gga_time.isUpdated()) {
+        sentence = EPOCH_GGA;
+        time = gga_time.value();
+    } else {
+        return;
+    }
+
+    // Időbélyeg nélkül (nincs még fix idő) nincs epocha, a UI watchdog időzítője frissít
+    if (time[0] == '\0') {
+        return;
+    }
+
+    // Új időbélyeg: új epocha kezdődik
+    if (strcmp(time, epochTime) != 0) {
+        strlcpy(epochTime, time, sizeof(epochTime));
+        epochSentences = 0;
+    }
+    epochSentences |= sentence;
+
+    // Az RMC (sebesség, pozíció) utolsó bájtja a riasztási késleltetés mérés kiindulópontja
+    if (sentence == EPOCH_RMC) {
+        epochRxMicros = rxMicros;
+        latencyProbe.record(LatencyProbe::UART_RECEIVE, pollGapMicros);
+        latencyProbe.recordSince(LatencyProbe::SENTENCE_COMPLETE, rxMicros);
+    }
+
+    if ((epochSentences & EPOCH_COMPLETE) == EPOCH_COMPLETE && !(epochSentences & EPOCH_PUBLISHED)) {
+        epochSentences |= EPOCH_PUBLISHED;
+        updateSpeedFilter();
+        publishEvent(GpsEvent::FIX_EPOCH, epochRxMicros);
+        fixEpochForCore1 = true;
+        latencyProbe.recordSince(LatencyProbe::FIX_PUBLISHED, epochRxMicros);
+    }
+}
+
+/**
+ * A sebesség szűrő frissítése a lezárt fix epocha adataival
+ */
+void GpsManager::updateSpeedFilter() {
+    SpeedFilter::Measurement m;
+    m.gpsTimeMillis = ((gps.time.hour() * 60UL + gps.time.minute()) * 60UL + gps.time.second()) * 1000UL + gps.time.centisecond() * 10UL;
+    m.speedValid = gps.speed.isValid();
+    m.speedMps = gps.speed.mps();
+    m.courseValid = gps.course.isValid();
+    m.courseDeg = gps.course.deg();
+    m.positionValid = gps.location.isValid();
+    m.lat = gps.location.lat();
+    m.lng = gps.location.lng();
+    m.hdopValid = gps.hdop.isValid();
+    m.hdop = gps.hdop.hdop();
+
+    speedFilter.update(m, millis());
+}
+
+/**
+ * Esemény küldése a UI-nak (Core0)
+ */
+void GpsManager::publishEvent(GpsEvent::Type type, uint32_t rxMicros) {
+    // Tele sor esetén a UI épp nem fogyaszt (pl. flash írás), az eseményt eldobjuk: a watchdog időzítő pótolja
+    if (!eventQueue.push({type, millis(), rxMicros})) {
+        DEBUG("GpsManager: event queue full, event %u dropped\n", type);
+    }
 }
 
 /**
@@ -216,10 +316,21 @@ void GpsManager::loop() {
 
     bool isValidSentence = false;
 
+    // A most kiolvasott bájtok legfeljebb az előző kiolvasás óta várakoztak a soros pufferben
+    uint32_t pollMicros = micros();
+    pollGapMicros = pollMicros - lastPollMicros;
+    lastPollMicros = pollMicros;
+
     while (gpsSerial.available() > 0) {
         char c = gpsSerial.read();
+        uint32_t rxMicros = micros();
+        lastRxMicros = rxMicros;
         if (gps.encode(c)) {
             isValidSentence = true;
+
+            // Mondatonként dolgozzuk fel, így egy hosszabb soros burst-ben sem vész el GSV üzenet vagy epocha határ
+            processGSVMessages();
+            processFixEpoch(rxMicros);
         }
 
         // Debug: kiírjuk a GPS soros porton küldött karaktereit
@@ -230,28 +341,47 @@ void GpsManager::loop() {
 
     // Ha van érvényes GPS NMEA mondat
     if (isValidSentence) {
-
-        // GPS mondatok feldolgozása
-        processGSVMessages();
+        lastSentenceMillis = millis();
 
         // GPS boot idő számítása (első érvényes műholdadat)
         if (gpsBootTime == 0 && gps.satellites.isValid() && gps.satellites.age() < GPS_DATA_MAX_AGE && gps.satellites.value() > 0) {
             gpsBootTime = (millis() - bootStartTime) / 1000;
         }
+    }
+}
 
-        // beépített RGB LED villogtatása, ha volt érvényes bejövő GPS mondat
-        if (debugGpsSerialOnInternalFastLed) {
-            leds[0] = INTERNAL_LED_COLOR;
-            FastLED.show();
-
-            leds[0] = CRGB::Black;
-            FastLED.show();
-        }
+/**
+ * A GPS állapotának kijelzése a beépített RGB LED-en
+ */
+void GpsManager::updateStatusLed() {
+    if (!debugGpsSerialOnInternalFastLed) {
+        statusLed.setPattern(StatusLed::Pattern::Off);
+        return;
     }
 
-    // Műhold adatbázis karbantartása másodpercenként
-    static long lastWiseSatellitesData = millis();
-    if (Utils::timeHasPassed(lastWiseSatellitesData, 1000)) {
-        satelliteDb.deleteUntrackedSatellites();
+    // Hibakódok: 1 = nem jön NMEA adat, 2 = hibás ellenőrzőösszegű mondatok (zajos vonal, rossz baud)
+    uint32_t failedChecksums = gps.failedChecksum();
+    bool checksumErrors = failedChecksums != lastFailedChecksums;
+    lastFailedChecksums = failedChecksums;
+
+    if (lastSentenceMillis == 0 || millis() - lastSentenceMillis > GPS_DATA_MAX_AGE) {
+        statusLed.showErrorCode(STATUS_LED_ERROR_NO_DATA);
+    } else if (checksumErrors) {
+        statusLed.showErrorCode(STATUS_LED_ERROR_CHECKSUM);
+    } else {
+        switch (getFixMode()) {
+            case FixMode::Auto:
+                statusLed.setPattern(StatusLed::Pattern::FixAuto);
+                break;
+            case FixMode::Differential:
+                statusLed.setPattern(StatusLed::Pattern::FixDifferential);
+                break;
+            case FixMode::Estimated:
+                statusLed.setPattern(StatusLed::Pattern::FixEstimated);
+                break;
+            default:
+                statusLed.setPattern(StatusLed::Pattern::NoFix);
+                break;
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "LatencyProbe.h"
+
+/**
+ * Egy mérés hozzáadása
+ */
+void LatencyHistogram::add(uint32_t micros) {
+    // Vödör index: az érték bithossza (0 -> 0, 1 -> 1, 2..3 -> 2, 4..7 -> 3, ...)
+    uint8_t bucket = micros == 0 ? 0 : 32 - __builtin_clz(micros);
+    if (bucket >= BUCKET_COUNT) {
+        bucket = BUCKET_COUNT - 1;
+    }
+    buckets[bucket]++;
+
+    if (count == 0 || micros < minMicros) {
+        minMicros = micros;
+    }
+    if (micros > maxMicros) {
+        maxMicros = micros;
+    }
+    sumMicros += micros;
+    count++;
+}
+
+/**
+ * Törlés
+ */
+void LatencyHistogram::reset() {
+    memset(buckets, 0, sizeof(buckets));
+    count = 0;
+    minMicros = 0;
+    maxMicros = 0;
+    sumMicros = 0;
+}
+
+/**
+ * Percentilis becslése a vödrök felső határával
+ */
+uint32_t LatencyHistogram::percentile(uint8_t pct) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    uint32_t target = ((uint64_t)count * pct + 99) / 100;
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < BUCKET_COUNT; i++) {
+        cumulative += buckets[i];
+        if (cumulative >= target) {
+            // A vödör felső határa, de sosem nagyobb a valaha mért maximumnál
+            uint32_t upper = i == 0 ? 0 : (1UL << i) - 1;
+            return upper < maxMicros ? upper : maxMicros;
+        }
+    }
+    return maxMicros;
+}
+
+/**
+ * Egy fázis megjelenítendő neve
+ */
+const char *LatencyProbe::stageName(Stage stage) {
+    switch (stage) {
+        case UART_RECEIVE:
+            return "UART rx wait";
+        case SENTENCE_COMPLETE:
+            return "Sentence parsed";
+        case FIX_PUBLISHED:
+            return "Fix published";
+        case PROXIMITY_COMPUTED:
+            return "Proximity done";
+        case DRAW_STARTED:
+            return "Draw started";
+        case SPI_PUSH_DONE:
+            return "SPI push done";
+        case SIREN_STARTED:
+            return "Siren started";
+        case TOUCH_DISPATCHED:
+            return "Touch dispatched";
+        case TOUCH_FEEDBACK:
+            return "Touch feedback";
+        default:
+            return "?";
+    }
+}
+
+/**
+ * Az összes hisztogram törlése
+ */
+void LatencyProbe::reset() {
+    for (auto &histogram : histograms) {
+        histogram.reset();
+    }
+}
+
+/**
+ * Késleltetés formázása
+ */
+void LatencyProbe::formatMicros(uint32_t micros, char *buf, size_t len) {
+    if (micros < 10000) {
+        snprintf(buf, len, "%luus", (unsigned long)micros);
+    } else {
+        // A float snprintf nem megbízható, ezért egészekkel: 1 tizedes ms
+        snprintf(buf, len, "%lu.%lums", (unsigned long)(micros / 1000), (unsigned long)(micros % 1000 / 100));
+    }
+}
+
+/**
+ * Az összes hisztogram kiírása a soros portra
+ */
+void LatencyProbe::dump() const {
+    char minBuf[12], avgBuf[12], p50Buf[12], p95Buf[12], maxBuf[12];
+
+    DEBUG("---- Alert latency (t0 = last RMC byte read) ----\n");
+    DEBUG("%-16s %6s %9s %9s %9s %9s %9s\n", "stage", "n", "min", "avg", "p50", "p95", "max");
+    for (uint8_t s = 0; s < STAGE_COUNT; s++) {
+        const LatencyHistogram &h = histograms[s];
+        formatMicros(h.minMicros, minBuf, sizeof(minBuf));
+        formatMicros(h.average(), avgBuf, sizeof(avgBuf));
+        formatMicros(h.percentile(50), p50Buf, sizeof(p50Buf));
+        formatMicros(h.percentile(95), p95Buf, sizeof(p95Buf));
+        formatMicros(h.maxMicros, maxBuf, sizeof(maxBuf));
+        DEBUG("%-16s %6lu %9s %9s %9s %9s %9s\n", stageName((Stage)s), (unsigned long)h.count, minBuf, avgBuf, p50Buf, p95Buf, maxBuf);
+
+        // Hisztogram: csak a nem üres vödrök
+        for (uint8_t i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+            if (h.buckets[i]) {
+                DEBUG("    < %7lu us: %lu\n", i == 0 ? 1UL : (1UL << i), (unsigned long)h.buckets[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,299 @@
+#include "OneWirePio.h"
+#include "defines.h"
+
+#include <hardware/clocks.h>
+
+// OneWire PIO program (a pico-examples onewire_library programja, pioasm kimenet), 1 ciklus = 1µs
+// A busz meghajtása a pin irányával történik (side-set pindirs): kimenet = alacsony, bemenet = a felhúzó ellenállás húzza fel
+//
+//  .program onewire
+//  .side_set 1 pindirs
+//
+//  PUBLIC reset_bus:
+//          set x, 28       side 1  [15]    ; a busz alacsonyra húzása         16
+//  loop_a: jmp x-- loop_a  side 1  [15]    ;                             29 x 16
+//          set x, 8        side 0  [6]     ; elengedés                         7
+//  loop_b: jmp x-- loop_b  side 0  [6]     ;                               9 x 7
+//          mov isr, pins   side 0          ; presence mintavétel               1
+//          push            side 0          ;                                   1
+//          set x, 24       side 0  [7]     ;                                   8
+//  loop_c: jmp x-- loop_c  side 0  [15]    ;                             25 x 16
+//
+//  .wrap_target
+//  PUBLIC fetch_bit:
+//          out x, 1        side 0          ; a következő bit (autopull)        1
+//          jmp !x  send_0  side 1  [5]     ; a busz alacsonyra, '0' ág         6
+//  send_1:
+//          set x, 2        side 0  [8]     ; elengedés, várunk a slave-re      9
+//          in pins, 1      side 0  [4]     ; a busz mintavétele (autopush)     5
+//  loop_e: jmp x-- loop_e  side 0  [15]    ;                              3 x 16
+//          jmp fetch_bit   side 0          ;                                   1
+//  send_0:
+//          set x, 2        side 1  [5]     ; a busz alacsonyan marad           6
+//  loop_d: jmp x-- loop_d  side 1  [15]    ;                              3 x 16
+//          in null, 1      side 0  [8]     ; elengedés, 0 az ISR-be            9
+//  .wrap
+//
+static const uint16_t ONEWIRE_PROGRAM_INSTRUCTIONS[] = {
+    0xff3c, //  0: set    x, 28           side 1 [15]
+    0x1f41, //  1: jmp    x--, 1          side 1 [15]
+    0xe628, //  2: set    x, 8            side 0 [6]
+    0x0643, //  3: jmp    x--, 3          side 0 [6]
+    0xa0c0, //  4: mov    isr, pins       side 0
+    0x8020, //  5: push   block           side 0
+    0xe738, //  6: set    x, 24           side 0 [7]
+    0x0f47, //  7: jmp    x--, 7          side 0 [15]
+    0x6021, //  8: out    x, 1            side 0
+    0x152e, //  9: jmp    !x, 14          side 1 [5]
+    0xe822, // 10: set    x, 2            side 0 [8]
+    0x4401, // 11: in     pins, 1         side 0 [4]
+    0x0f4c, // 12: jmp    x--, 12         side 0 [15]
+    0x0008, // 13: jmp    8               side 0
+    0xf522, // 14: set    x, 2            side 1 [5]
+    0x1f4f, // 15: jmp    x--, 15         side 1 [15]
+    0x4861, // 16: in     null, 1         side 0 [8]
+};
+static const pio_program_t ONEWIRE_PROGRAM = {
+    .instructions = ONEWIRE_PROGRAM_INSTRUCTIONS,
+    .length = 17,
+    .origin = -1,
+};
+constexpr uint8_t ONEWIRE_OFFSET_RESET_BUS = 0;
+constexpr uint8_t ONEWIRE_OFFSET_FETCH_BIT = 8;
+constexpr uint8_t ONEWIRE_WRAP_TARGET = 8;
+constexpr uint8_t ONEWIRE_WRAP = 16;
+constexpr uint32_t ONEWIRE_CYCLE_HZ = 1000000; // 1µs / ciklus
+
+// OneWire ROM parancsok
+constexpr uint8_t ONEWIRE_CMD_SEARCH_ROM = 0xF0;
+
+/**
+ * PIO program betöltése és az állapotgép indítása
+ */
+bool OneWirePio::begin(uint8_t pin) {
+    this->pin = pin;
+
+    pio = pio0;
+    if (!pio_can_add_program(pio, &ONEWIRE_PROGRAM)) {
+        pio = pio1;
+        if (!pio_can_add_program(pio, &ONEWIRE_PROGRAM)) {
+            DEBUG("OneWirePio: no room for the PIO program\n");
+            return false;
+        }
+    }
+    int claimed = pio_claim_unused_sm(pio, false);
+    if (claimed < 0) {
+        DEBUG("OneWirePio: no free state machine\n");
+        return false;
+    }
+    sm = claimed;
+    offset = pio_add_program(pio, &ONEWIRE_PROGRAM);
+
+    // A láb kimeneti szintje mindig 0, a buszt az irány váltása húzza le / engedi el
+    pio_gpio_init(pio, pin);
+    pio_sm_set_pins_with_mask(pio, sm, 0, 1u << pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, false);
+
+    pio_sm_config smConfig = pio_get_default_sm_config();
+    sm_config_set_wrap(&smConfig, offset + ONEWIRE_WRAP_TARGET, offset + ONEWIRE_WRAP);
+    sm_config_set_sideset(&smConfig, 1, false, true);
+    sm_config_set_sideset_pins(&smConfig, pin);
+    sm_config_set_set_pins(&smConfig, pin, 1);
+    sm_config_set_in_pins(&smConfig, pin);
+    sm_config_set_out_shift(&smConfig, true, true, 8); // LSB először (OneWire), bájtonként automatikus pull
+    sm_config_set_in_shift(&smConfig, true, true, 8);  // A válasz bitek is bájtonként kerülnek az RX FIFO-ba
+    sm_config_set_clkdiv(&smConfig, (float)clock_get_hz(clk_sys) / ONEWIRE_CYCLE_HZ);
+    pio_sm_init(pio, sm, offset + ONEWIRE_OFFSET_FETCH_BIT, &smConfig);
+    pio_sm_set_enabled(pio, sm, true);
+    return true;
+}
+
+/**
+ * Busz reset
+ */
+bool OneWirePio::reset() {
+    pio_sm_exec(pio, sm, pio_encode_jmp(offset + ONEWIRE_OFFSET_RESET_BUS));
+
+    // A presence mintavétele: alacsony busz = van eszköz
+    return (pio_sm_get_blocking(pio, sm) & 1) == 0;
+}
+
+/**
+ * Egy bájt kiküldése és a busz válaszának visszaolvasása
+ */
+uint8_t OneWirePio::exchange(uint8_t value) {
+    pio_sm_put_blocking(pio, sm, value);
+
+    // Jobbra léptetett ISR: a 8 bit a szó felső bájtjában van
+    return pio_sm_get_blocking(pio, sm) >> 24;
+}
+
+/**
+ * Az állapotgép bitszámának átállítása
+ */
+void OneWirePio::setBitsPerWord(uint8_t bits) {
+    pio_sm_set_enabled(pio, sm, false);
+    pio->sm[sm].shiftctrl = (pio->sm[sm].shiftctrl & ~(PIO_SM0_SHIFTCTRL_PULL_THRESH_BITS | PIO_SM0_SHIFTCTRL_PUSH_THRESH_BITS)) | //
+                            ((bits & 0x1fu) << PIO_SM0_SHIFTCTRL_PULL_THRESH_LSB) | ((bits & 0x1fu) << PIO_SM0_SHIFTCTRL_PUSH_THRESH_LSB);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(offset + ONEWIRE_OFFSET_FETCH_BIT));
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+/**
+ * Search ROM hármas
+ */
+uint8_t OneWirePio::triplet(uint8_t &direction) {
+    // Bit módban a beolvasott bit a szó legfelső bitjébe kerül
+    pio_sm_put_blocking(pio, sm, 1);
+    uint8_t idBit = pio_sm_get_blocking(pio, sm) >> 31;
+    pio_sm_put_blocking(pio, sm, 1);
+    uint8_t complementBit = pio_sm_get_blocking(pio, sm) >> 31;
+
+    // Nincs ütközés: az irányt a bit határozza meg
+    if (idBit != complementBit) {
+        direction = idBit;
+    }
+    pio_sm_put_blocking(pio, sm, direction);
+    pio_sm_get_blocking(pio, sm);
+
+    return idBit | (complementBit << 1);
+}
+
+/**
+ * Az eszközök ROM kódjainak felderítése
+ */
+uint8_t OneWirePio::search(uint64_t *roms, uint8_t maxCount) {
+    uint8_t count = 0;
+    uint8_t lastDiscrepancy = 0; // Az utolsó ütközés bit pozíciója (1..64), ahol 0-t választottunk
+    uint64_t rom = 0;
+
+    while (count < maxCount) {
+        if (!reset()) {
+            break;
+        }
+        write(ONEWIRE_CMD_SEARCH_ROM);
+
+        setBitsPerWord(1);
+        uint8_t lastZero = 0;
+        bool error = false;
+        for (uint8_t bitNumber = 1; bitNumber <= 64; bitNumber++) {
+            // Az előző ütközés előtt az előző utat követjük, az ütközésnél most az 1-es ágra megyünk
+            uint8_t direction;
+            if (bitNumber < lastDiscrepancy) {
+                direction = (rom >> (bitNumber - 1)) & 1;
+            } else {
+                direction = bitNumber == lastDiscrepancy;
+            }
+
+            uint8_t bits = triplet(direction);
+            if (bits == 0x03) {
+                error = true; // Senki nem válaszolt
+                break;
+            }
+            if (bits == 0x00 && direction == 0) {
+                lastZero = bitNumber;
+            }
+            rom = (rom & ~(1ull << (bitNumber - 1))) | ((uint64_t)direction << (bitNumber - 1));
+        }
+        setBitsPerWord(8);
+
+        if (error) {
+            break;
+        }
+        if (crc8((const uint8_t *)&rom, 8) == 0) {
+            roms[count++] = rom;
+        } else {
+            DEBUG("OneWirePio: ROM CRC error\n");
+        }
+
+        lastDiscrepancy = lastZero;
+        if (lastDiscrepancy == 0) {
+            break; // Ez volt az utolsó eszköz
+        }
+    }
+    return count;
+}
+
+/**
+ * Nem blokkoló tranzakció indítása
+ */
+bool OneWirePio::startTransaction(bool withReset, const uint8_t *tx, uint8_t txLength, uint8_t rxLength) {
+    if (status == Status::Busy || txLength + rxLength > MAX_TRANSACTION_BYTES) {
+        return false;
+    }
+
+    memcpy(buffer, tx, txLength);
+    this->txLength = txLength;
+    totalLength = txLength + rxLength;
+    sentCount = 0;
+    receivedCount = 0;
+    status = Status::Busy;
+
+    // A reset után előbb a presence választ várjuk, csak utána küldünk
+    waitingPresence = withReset;
+    if (withReset) {
+        pio_sm_exec(pio, sm, pio_encode_jmp(offset + ONEWIRE_OFFSET_RESET_BUS));
+    }
+    return true;
+}
+
+/**
+ * A tranzakció léptetése
+ */
+OneWirePio::Status OneWirePio::poll() {
+    if (status != Status::Busy) {
+        return status;
+    }
+
+    if (waitingPresence) {
+        if (pio_sm_is_rx_fifo_empty(pio, sm)) {
+            return status;
+        }
+        waitingPresence = false;
+        if (pio_sm_get(pio, sm) & 1) {
+            status = Status::NoPresence;
+            return status;
+        }
+    }
+
+    // Amennyit a FIFO elbír; olvasáshoz 0xFF megy ki
+    while (sentCount < totalLength && !pio_sm_is_tx_fifo_full(pio, sm)) {
+        pio_sm_put(pio, sm, sentCount < txLength ? buffer[sentCount] : 0xFF);
+        sentCount++;
+    }
+
+    // Minden kiküldött bájtra jön egy válasz; az írt bájtok visszhangja eldobható
+    while (!pio_sm_is_rx_fifo_empty(pio, sm)) {
+        uint8_t value = pio_sm_get(pio, sm) >> 24;
+        if (receivedCount >= txLength) {
+            buffer[receivedCount] = value;
+        }
+        receivedCount++;
+    }
+
+    if (receivedCount >= totalLength) {
+        status = Status::Done;
+    }
+    return status;
+}
+
+/**
+ * Dallas CRC8 (x^8 + x^5 + x^4 + 1, LSB először)
+ */
+uint8_t OneWirePio::crc8(const uint8_t *data, uint8_t length) {
+    uint8_t crc = 0;
+    while (length--) {
+        uint8_t value = *data++;
+        for (uint8_t i = 0; i < 8; i++) {
+            uint8_t mix = (crc ^ value) & 0x01;
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8C;
+            }
+            value >>= 1;
+        }
+    }
+    return crc;
+}
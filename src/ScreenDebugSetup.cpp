@@ -20,7 +20,7 @@ void ScreenDebugSetup::layoutComponents() {
 
     // LED gomb
     int row = 0;
-    addChild(std::make_shared<UIButton>(                                                                      //
+    addChild(makeComponent<UIButton>(                                                                         //
         10,                                                                                                   // id
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH),                                                 // rect
         "Pico-Zero LED",                                                                                      // label
@@ -36,7 +36,7 @@ void ScreenDebugSetup::layoutComponents() {
 
     // GPS On Serial
     row++;
-    addChild(std::make_shared<UIButton>(                      //
+    addChild(makeComponent<UIButton>(                         //
         11,                                                   // id
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH), // rect
         "GPS On Serial",                                      // label
@@ -56,7 +56,7 @@ void ScreenDebugSetup::layoutComponents() {
 
     // SatDB on Serial
     row++;
-    addChild(std::make_shared<UIButton>(                      //
+    addChild(makeComponent<UIButton>(                         //
         12,                                                   // id
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH), // rect
         "SatDB On Serial",                                    // label
@@ -74,8 +74,21 @@ void ScreenDebugSetup::layoutComponents() {
         }) //
     );
 
+    // Riasztási késleltetés képernyő bal alsó sarokban
+    addChild(makeComponent<UIButton>(                                                                                               //
+        13,                                                                                                                         //
+        Rect(0, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
+        "Latency",                                                                                                                  //
+        UIButton::ButtonType::Pushable,                                                                                             //
+        [this](const UIButton::ButtonEvent &event) {
+            if (event.state == UIButton::EventButtonState::Clicked) {
+                getScreenManager()->switchToScreen(ScreenId::Latency);
+            }
+        }) //
+    );
+
     // Back gomb jobb alsó sarokban
-    addChild(std::make_shared<UIButton>(                                                                                                                                  //
+    addChild(makeComponent<UIButton>(                                                                                                                                     //
         1,                                                                                                                                                                //
         Rect(::SCREEN_W - UIButton::DEFAULT_BUTTON_WIDTH, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
         "Back",                                                                                                                                                           //
@@ -18,7 +18,7 @@ void ScreenGPSSetup::layoutComponents() {
 
     // Trafi Alarm gomb
     int row = 0;
-    addChild(std::make_shared<UIButton>(                                                            //
+    addChild(makeComponent<UIButton>(                                                               //
         10,                                                                                         //
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH),                                       //
         "Traffi Alarm",                                                                             //
@@ -45,7 +45,7 @@ void ScreenGPSSetup::layoutComponents() {
 
     // Alarm Distance gomb
     row++;
-    gpsTraffiAlarmDistanceBtn = std::make_shared<UIButton>(   //
+    gpsTraffiAlarmDistanceBtn = makeComponent<UIButton>(      //
         11,                                                   //
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH), //
         "Alarm Distance",                                     //
@@ -55,7 +55,7 @@ void ScreenGPSSetup::layoutComponents() {
             if (event.state == UIButton::EventButtonState::Clicked) {
                 static int gpsTraffiAlarmDistance = static_cast<int>(config.data.gpsTraffiAlarmDistance);
 
-                auto dialog = std::make_shared<ValueChangeDialog>(
+                auto dialog = makeDialog<ValueChangeDialog>(
                     this, "Trafi Alarm Distance", "Set distance level (100-1500 meters)", //
                     &gpsTraffiAlarmDistance, MIN_DISTANCE, MAX_DISTANCE, STEP_DISTANCE,   //
                     [this, MIN_DISTANCE, MAX_DISTANCE](const std::variant<int, float, bool> &newValue) {
@@ -80,7 +80,7 @@ void ScreenGPSSetup::layoutComponents() {
     addChild(gpsTraffiAlarmDistanceBtn);
 
     row++;
-    addChild(std::make_shared<UIButton>(                                                                 //
+    addChild(makeComponent<UIButton>(                                                                    //
         12,                                                                                              //
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH),                                            //
         "Alarm Siren",                                                                                   //
@@ -94,7 +94,7 @@ void ScreenGPSSetup::layoutComponents() {
     );
 
     // Vissza gomb
-    addChild(std::make_shared<UIButton>( //                                                                                                                                  //
+    addChild(makeComponent<UIButton>(    //                                                                                                                                  //
         1,                               //
         Rect(::SCREEN_W - UIButton::DEFAULT_BUTTON_WIDTH, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
         "Back", UIButton::ButtonType::Pushable, [this](const UIButton::ButtonEvent &event) {
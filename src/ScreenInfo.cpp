@@ -12,13 +12,15 @@ extern GpsManager *gpsManager;
 #include "SensorUtils.h"
 extern SensorUtils sensorUtils;
 
+#include "TaskScheduler.h"
+
 // Demó mód
 extern bool demoMode;
 
 /**
  * @brief ScreenInfo konstruktor
  */
-ScreenInfo::ScreenInfo() : UIScreen(SCREEN_NAME_INFO) {
+ScreenInfo::ScreenInfo() : UIScreen(ScreenId::Info) {
 
     // Padding kiszámítása
     tft.setFreeFont();
@@ -38,7 +40,7 @@ ScreenInfo::ScreenInfo() : UIScreen(SCREEN_NAME_INFO) {
 void ScreenInfo::layoutComponents() {
 
     // Vissza gomb
-    addChild(std::make_shared<UIButton>( //                                                                                                                                  //
+    addChild(makeComponent<UIButton>(    //                                                                                                                                  //
         1,                               //
         Rect(::SCREEN_W - UIButton::DEFAULT_BUTTON_WIDTH, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
         "Back",                                                                                                                                                           //
@@ -170,6 +172,10 @@ void ScreenInfo::drawContent() {
     tableY += lineHeight;
     tft.drawString("Mode", tableX, tableY);
     tableY += lineHeight;
+    tft.drawString("Core0 idle", tableX, tableY);
+    tableY += lineHeight;
+    tft.drawString("Core1 idle", tableX, tableY);
+    tableY += lineHeight;
 
     // 2. tábla 1 oszlop prompt
     tableX = 100;
@@ -250,6 +256,12 @@ void ScreenInfo::handleOwnLoop() {
     tft.setTextPadding(textPadding);
     tft.drawString(::demoMode ? "Demo" : "Normal", x, y);
     y += lineHeight;
+    snprintf(valueBuffer, sizeof(valueBuffer), "%u%%", core0Scheduler.getIdlePercent());
+    tft.drawString(valueBuffer, x, y);
+    y += lineHeight;
+    snprintf(valueBuffer, sizeof(valueBuffer), "%u%%", core1Scheduler.getIdlePercent());
+    tft.drawString(valueBuffer, x, y);
+    y += lineHeight;
 
     // 1. oszlop
     x = 120;
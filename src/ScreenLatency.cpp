@@ -0,0 +1,202 @@
+#include "ScreenLatency.h"
+#include "CodeProfiler.h"
+#include "LatencyProbe.h"
+#include "ScreenManager.h"
+#include "TaskScheduler.h"
+#include "Utils.h"
+#include "defines.h"
+
+// Táblázat elrendezés
+constexpr int16_t TABLE_Y = 70;
+constexpr uint8_t LINE_HEIGHT = 22;
+constexpr int16_t STAGE_COLUMN_X = 10;
+constexpr int16_t VALUE_COLUMNS_X[] = {175, 225, 275, 325, 375, 425}; // n, min, avg, p50, p95, max (jobbra igazítva)
+constexpr int16_t XIP_LINE_Y = 57;                                    // XIP cache találati arány sora (jobbra igazítva)
+
+extern ScreenManager *screenManager;
+
+/**
+ * @brief ScreenLatency konstruktor
+ */
+ScreenLatency::ScreenLatency() : UIScreen(ScreenId::Latency) {
+
+    // Padding kiszámítása
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    textPadding = tft.textWidth("888.8ms");
+
+    lastUpdated = 0;
+
+    // Komponensek elrendezése
+    layoutComponents();
+}
+
+/**
+ * UI komponensek elhelyezése
+ */
+void ScreenLatency::layoutComponents() {
+
+    // Hisztogramok törlése
+    addChild(makeComponent<UIButton>(                                                                                           //
+        2,                                                                                                                      //
+        Rect(0, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
+        "Reset",                                                                                                                //
+        UIButton::ButtonType::Pushable,                                                                                         //
+        [this](const UIButton::ButtonEvent &event) {
+            if (event.state == UIButton::EventButtonState::Clicked) {
+                latencyProbe.reset();
+                codeProfiler.reset();
+                core0Scheduler.resetStats();
+                core1Scheduler.resetStats();
+                drawValues();
+            }
+        }) //
+    );
+
+    // Kiírás a soros portra
+    addChild(makeComponent<UIButton>(                                                                                                                             //
+        3,                                                                                                                                                        //
+        Rect(UIButton::DEFAULT_BUTTON_WIDTH + 10, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
+        "Dump",                                                                                                                                                   //
+        UIButton::ButtonType::Pushable,                                                                                                                           //
+#ifdef __DEBUG
+        UIButton::ButtonState::Off,
+#else
+        UIButton::ButtonState::Disabled, // Ha nincs Serial, akkor nincs értelme
+#endif
+        [this](const UIButton::ButtonEvent &event) {
+            if (event.state == UIButton::EventButtonState::Clicked) {
+                latencyProbe.dump();
+                core0Scheduler.dump();
+                core1Scheduler.dump();
+                codeProfiler.dump();
+            }
+        }) //
+    );
+
+    // Navigációs soak teszt (a heap töredezettség méréséhez, az eredmény a soros portra megy)
+    addChild(makeComponent<UIButton>(                                                                                                                                   //
+        4,                                                                                                                                                              //
+        Rect(2 * (UIButton::DEFAULT_BUTTON_WIDTH + 10), ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
+        "Soak",                                                                                                                                                         //
+        UIButton::ButtonType::Pushable,                                                                                                                                 //
+#ifdef __DEBUG
+        UIButton::ButtonState::Off,
+#else
+        UIButton::ButtonState::Disabled, // Ha nincs Serial, akkor nincs értelme
+#endif
+        [](const UIButton::ButtonEvent &event) {
+            if (event.state == UIButton::EventButtonState::Clicked) {
+                ::screenManager->startNavigationSoak();
+            }
+        }) //
+    );
+
+    // Vissza gomb
+    addChild(makeComponent<UIButton>(                                                                                                                                     //
+        1,                                                                                                                                                                //
+        Rect(::SCREEN_W - UIButton::DEFAULT_BUTTON_WIDTH, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
+        "Back",                                                                                                                                                           //
+        UIButton::ButtonType::Pushable,                                                                                                                                   //
+        [this](const UIButton::ButtonEvent &event) {
+            if (event.state == UIButton::EventButtonState::Clicked) {
+                getScreenManager()->goBack();
+            }
+        }) //
+    );
+}
+
+/**
+ * Kirajzolja a képernyő saját tartalmát
+ */
+void ScreenLatency::drawContent() {
+    // Háttér törlése
+    tft.fillScreen(TFT_BLACK);
+
+    // Címsor
+    tft.setTextSize(1);
+    tft.setTextDatum(MC_DATUM);
+    tft.setFreeFont(&FreeSansBold18pt7b);
+    tft.setTextColor(TFT_CYAN, TFT_BLACK);
+    tft.drawString("Latency", ::SCREEN_W / 2, 20);
+
+    tft.setFreeFont();
+    tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
+    tft.drawString("t0 = last RMC byte from the GPS UART (alert), PENIRQ edge (touch)", ::SCREEN_W / 2, 45);
+
+    // Fejléc
+    static constexpr const char *HEADERS[] = {"n", "min", "avg", "p50", "p95", "max"};
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.setTextDatum(ML_DATUM);
+    tft.drawString("Stage", STAGE_COLUMN_X, TABLE_Y);
+    tft.setTextDatum(MR_DATUM);
+    for (uint8_t i = 0; i < ARRAY_ITEM_COUNT(HEADERS); i++) {
+        tft.drawString(HEADERS[i], VALUE_COLUMNS_X[i], TABLE_Y);
+    }
+    tft.drawFastHLine(STAGE_COLUMN_X, TABLE_Y + LINE_HEIGHT / 2, ::SCREEN_W - 2 * STAGE_COLUMN_X, TFT_DARKGREY);
+
+    // Fázisok nevei
+    tft.setTextDatum(ML_DATUM);
+    tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
+    for (uint8_t s = 0; s < LatencyProbe::STAGE_COUNT; s++) {
+        tft.drawString(LatencyProbe::stageName((LatencyProbe::Stage)s), STAGE_COLUMN_X, TABLE_Y + (s + 1) * LINE_HEIGHT);
+    }
+
+    drawValues();
+}
+
+/**
+ * Kezeli a képernyő saját ciklusát (dinamikus frissítés)
+ */
+void ScreenLatency::handleOwnLoop() {
+
+    // 1 másodperces frissítés
+    if (!Utils::timeHasPassed(lastUpdated, 1000)) {
+        return;
+    }
+    lastUpdated = millis();
+
+    drawValues();
+}
+
+/**
+ * A táblázat értékeinek kirajzolása
+ */
+void ScreenLatency::drawValues() {
+    char valueBuffer[12];
+
+    tft.setFreeFont();
+    tft.setTextSize(1);
+    tft.setTextPadding(textPadding);
+    tft.setTextDatum(MR_DATUM);
+    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+
+    for (uint8_t s = 0; s < LatencyProbe::STAGE_COUNT; s++) {
+        const LatencyHistogram &h = latencyProbe.getHistogram((LatencyProbe::Stage)s);
+        const uint32_t values[] = {h.minMicros, h.average(), h.percentile(50), h.percentile(95), h.maxMicros};
+        int16_t y = TABLE_Y + (s + 1) * LINE_HEIGHT;
+
+        snprintf(valueBuffer, sizeof(valueBuffer), "%lu", (unsigned long)h.count);
+        tft.drawString(valueBuffer, VALUE_COLUMNS_X[0], y);
+
+        for (uint8_t i = 0; i < ARRAY_ITEM_COUNT(values); i++) {
+            if (h.count == 0) {
+                strlcpy(valueBuffer, "--", sizeof(valueBuffer));
+            } else {
+                LatencyProbe::formatMicros(values[i], valueBuffer, sizeof(valueBuffer));
+            }
+            tft.drawString(valueBuffer, VALUE_COLUMNS_X[i + 1], y);
+        }
+    }
+
+    // XIP cache találati arány (az utolsó másodperc és a nullázás óta)
+    uint16_t lastPermille = codeProfiler.getXipHitPermille();
+    uint16_t totalPermille = codeProfiler.getXipTotalHitPermille();
+    char xipBuffer[40];
+    snprintf(xipBuffer, sizeof(xipBuffer), "XIP cache hit %u.%u%% / %u.%u%%", lastPermille / 10, lastPermille % 10, totalPermille / 10, totalPermille % 10);
+    tft.setTextPadding(tft.textWidth("XIP cache hit 100.0% / 100.0%"));
+    tft.setTextColor(TFT_GREEN, TFT_BLACK);
+    tft.drawString(xipBuffer, ::SCREEN_W - STAGE_COLUMN_X, XIP_LINE_Y);
+
+    tft.setTextPadding(0);
+}
@@ -1,9 +1,13 @@
 #include "ScreenManager.h"
+#include "AudioEngine.h"
 #include "GpsManager.h"
+#include "LatencyProbe.h"
+#include "MessageDialog.h"
 
 #include "ScreenDebugSetup.h"
 #include "ScreenGPSSetup.h"
 #include "ScreenInfo.h"
+#include "ScreenLatency.h"
 #include "ScreenMain.h"
 #include "ScreenSats.h"
 #include "ScreenScreenSaver.h"
@@ -11,21 +15,58 @@
 #include "ScreenSystemSetup.h"
 #include "ScreenTFTSetup.h"
 #include "ScreenTest.h"
+#include "TouchSampler.h"
+#include "TraffipaxAlertEvaluator.h"
+#include "Utils.h"
+#include "VoicePrompt.h"
 
 extern GpsManager *gpsManager;
 
+/**
+ * @brief Fordítási idejű képernyő regisztráció
+ *
+ * A képernyő a komponenseivel együtt egy képernyő slab-be kerül, ami a képernyő megszűnésekor egyben ürül ki.
+ */
+template <typename T> std::shared_ptr<UIScreen> createScreen() { return screenArenaPool.make<T>(); }
+
+struct ScreenDescriptor {
+    ScreenId id;
+    ScreenFactory factory; // nullptr: nincs regisztrálva
+    bool cached;           // A példány megmarad a váltások között
+};
+
+// A sorrend a ScreenId sorrendje (az azonosító a tábla indexe)
+constexpr ScreenDescriptor SCREEN_REGISTRY[] = {
+    {ScreenId::Main, createScreen<ScreenMain>, true},
+    {ScreenId::Info, createScreen<ScreenInfo>, false},
+    {ScreenId::Sats, createScreen<ScreenSats>, true},
+    {ScreenId::Setup, createScreen<ScreenSetup>, false},
+    {ScreenId::TftSetup, createScreen<ScreenTFTSetup>, false},
+    {ScreenId::SystemSetup, createScreen<ScreenSystemSetup>, false},
+    {ScreenId::GpsSetup, createScreen<ScreenGPSSetup>, false},
+    {ScreenId::DebugSetup, createScreen<ScreenDebugSetup>, false},
+    {ScreenId::Latency, createScreen<ScreenLatency>, false},
+    {ScreenId::ScreenSaver, createScreen<ScreenScreenSaver>, false},
+    {ScreenId::Test, createScreen<ScreenTest>, false},
+    {ScreenId::Empty, nullptr, false}, // createScreen<ScreenEmpty>
+};
+static_assert(ARRAY_ITEM_COUNT(SCREEN_REGISTRY) == (uint8_t)ScreenId::Count, "SCREEN_REGISTRY must have an entry for every ScreenId");
+
+constexpr bool registryInOrder(uint8_t i = 0) { return i == (uint8_t)ScreenId::Count || (SCREEN_REGISTRY[i].id == (ScreenId)i && registryInOrder(i + 1)); }
+static_assert(registryInOrder(), "SCREEN_REGISTRY must be in ScreenId order");
+
 /**
  * @brief Képernyőkezelő osztály konstruktor
  */
 ScreenManager::ScreenManager() {
     // Feliratkozás a config változásokra
-    configCallbackId = config.registerChangeCallback([this]() { this->onConfigChanged(); });
+    configCallbackId = config.registerChangeCallback([this](ConfigFieldMask changed) { this->onConfigChanged(changed); }, ConfigField::SCREEN_SAVER_TIMEOUT);
 
     lastActivityTime = millis(); // Inicializáljuk az aktivitás időt
-    registerDefaultScreenFactories();
+    createCachedScreens();
 
     // Kezdeti értékek beállítása
-    onConfigChanged();
+    onConfigChanged(ConfigField::ALL);
 }
 
 /**
@@ -36,35 +77,24 @@ ScreenManager::~ScreenManager() { config.unregisterCallback(configCallbackId); }
 /**
  * @brief Callback függvény, amit a Config hív meg változás esetén
  */
-void ScreenManager::onConfigChanged() {
+void ScreenManager::onConfigChanged(ConfigFieldMask changed) {
     // DEBUG("ScreenManager::onConfigChanged() - Képernyővédő időtúllépés újraszámolása.\n");
     screenSaverTimeoutMs = config.data.screenSaverTimeout * 60 * 1000;
 }
 
 /**
- * @brief Regisztrálja az alapértelmezett képernyőgyárakat
+ * @brief A gyorsítótárazott képernyők létrehozása
+ *
+ * Induláskor, egymás után foglalódnak: a heap elején, egy tömbben maradnak, a hosszú használat sem aprózza fel őket.
  */
-void ScreenManager::registerDefaultScreenFactories() {
-    // Fő képernyő regisztrálása
-    registerScreenFactory(SCREEN_NAME_MAIN, []() { return std::make_shared<ScreenMain>(); });
-
-    // Információs képernyők regisztrálása
-    registerScreenFactory(SCREEN_NAME_INFO, []() { return std::make_shared<ScreenInfo>(); });
-    registerScreenFactory(SCREEN_NAME_SATS, []() { return std::make_shared<ScreenSats>(); });
-
-    // Setup képernyők regisztrálása
-    registerScreenFactory(SCREEN_NAME_SETUP, []() { return std::make_shared<ScreenSetup>(); });
-    registerScreenFactory(SCREEN_NAME_TFT_SETUP, []() { return std::make_shared<ScreenTFTSetup>(); });
-    registerScreenFactory(SCREEN_NAME_SYSTEM_SETUP, []() { return std::make_shared<ScreenSystemSetup>(); });
-    registerScreenFactory(SCREEN_NAME_GPS_SETUP, []() { return std::make_shared<ScreenGPSSetup>(); });
-    registerScreenFactory(SCREEN_NAME_DEBUG_SETUP, []() { return std::make_shared<ScreenDebugSetup>(); });
-
-    // ScrenSaver képernyő regisztrálása
-    registerScreenFactory(SCREEN_NAME_SCREENSAVER, []() { return std::make_shared<ScreenScreenSaver>(); });
-
-    // Teszt képernyők regisztrálása
-    registerScreenFactory(SCREEN_NAME_TEST, []() { return std::make_shared<ScreenTest>(); });
-    // registerScreenFactory(SCREEN_NAME_EMPTY, []() { return std::make_shared<ScreenEmpty>(); });
+void ScreenManager::createCachedScreens() {
+    for (const ScreenDescriptor &descriptor : SCREEN_REGISTRY) {
+        if (descriptor.cached && descriptor.factory) {
+            std::shared_ptr<UIScreen> screen = descriptor.factory();
+            screen->setScreenManager(this);
+            cachedScreens[(uint8_t)descriptor.id] = screen;
+        }
+    }
 }
 
 /**
@@ -73,97 +103,114 @@ void ScreenManager::registerDefaultScreenFactories() {
 std::shared_ptr<UIScreen> ScreenManager::getCurrentScreen() const { return currentScreen; }
 
 /**
- * @brief Előző képernyő nevének lekérése
- */
-String ScreenManager::getPreviousScreenName() const { return previousScreenName; }
-
-/**
- *  @brief Képernyőgyár regisztrálása egyedi képernyőkhöz
+ * @brief Képernyőváltás elhalasztása a feldolgozás végéig
  */
-void ScreenManager::registerScreenFactory(const char *screenName, ScreenFactory factory) { screenFactories[screenName] = factory; }
-
-/**
- * @brief Képernyőkezelő fő loop függvénye
- */
-void ScreenManager::deferSwitchToScreen(const char *screenName, void *params) { deferredActions.push(DeferredAction(DeferredAction::SwitchScreen, screenName, params)); }
+void ScreenManager::deferSwitchToScreen(ScreenId screenId, void *params) {
+    if (!deferredActions.push(DeferredAction(DeferredAction::SwitchScreen, screenId, params))) {
+        DEBUG("ScreenManager: deferred action queue full, switch to '%s' dropped\n", screenName(screenId));
+    }
+}
 
-void ScreenManager::deferGoBack() { deferredActions.push(DeferredAction(DeferredAction::GoBack)); }
+void ScreenManager::deferGoBack() {
+    if (!deferredActions.push(DeferredAction(DeferredAction::GoBack))) {
+        DEBUG("ScreenManager: deferred action queue full, go back dropped\n");
+    }
+}
 
 /**
  * @brief Függvény a Deferred Action Queue feldolgozására (képernyőváltások biztonságos kezelése)
  */
 void ScreenManager::processDeferredActions() {
-    while (!deferredActions.empty()) {
-        const DeferredAction &action = deferredActions.front();
+    DeferredAction action;
+    while (deferredActions.pop(action)) {
         if (action.type == DeferredAction::SwitchScreen) {
-            immediateSwitch(action.screenName, action.params);
+            immediateSwitch(action.screenId, action.params);
         } else if (action.type == DeferredAction::GoBack) {
             immediateGoBack();
         }
-        deferredActions.pop();
     }
 }
 
 /**
  *  @brief Képernyőváltás egy adott képernyőre
  */
-bool ScreenManager::switchToScreen(const char *screenName, void *params) {
+bool ScreenManager::switchToScreen(ScreenId screenId, void *params) {
     if (processingEvents) {
-        deferSwitchToScreen(screenName, params);
+        deferSwitchToScreen(screenId, params);
         return true;
     } else {
-        return immediateSwitch(screenName, params);
+        return immediateSwitch(screenId, params);
     }
 }
 
+/**
+ * @brief Képernyő felvétele a navigációs stack-re (tele stack esetén a legrégebbi elem kiesik)
+ */
+void ScreenManager::pushNavigation(ScreenId screenId) {
+    if (navigationDepth == MAX_NAVIGATION_DEPTH) {
+        memmove(&navigationStack[0], &navigationStack[1], (MAX_NAVIGATION_DEPTH - 1) * sizeof(ScreenId));
+        navigationDepth--;
+    }
+    navigationStack[navigationDepth++] = screenId;
+}
+
 /**
  * @brief Azonnali képernyőváltás
  */
-bool ScreenManager::immediateSwitch(const char *screenName, void *params, bool isBackNavigation) {
+bool ScreenManager::immediateSwitch(ScreenId screenId, void *params, bool isBackNavigation) {
 
-    if (currentScreen && STREQ(currentScreen->getName(), screenName)) {
+    if (currentScreen && currentScreen->getId() == screenId) {
         return true;
     }
 
-    auto it = screenFactories.find(screenName);
-    if (it == screenFactories.end()) {
-        DEBUG("ScreenManager: Screen factory nem található '%s'\n", screenName);
+    if (screenId >= ScreenId::Count || SCREEN_REGISTRY[(uint8_t)screenId].factory == nullptr) {
+        DEBUG("ScreenManager: Screen factory nem található '%s'\n", screenName(screenId));
         return false;
     }
+    const ScreenDescriptor &descriptor = SCREEN_REGISTRY[(uint8_t)screenId];
+    uint32_t startMicros = micros();
 
     if (currentScreen && !isBackNavigation) {
-        const char *currentName = currentScreen->getName();
-        if (STREQ(screenName, SCREEN_NAME_SCREENSAVER)) {
-            screenBeforeScreenSaver = String(currentName);
-        } else if (!STREQ(currentName, SCREEN_NAME_SCREENSAVER)) {
-            navigationStack.push_back(String(currentName));
+        ScreenId currentId = currentScreen->getId();
+        if (screenId == ScreenId::ScreenSaver) {
+            screenBeforeScreenSaver = currentId;
+        } else if (currentId != ScreenId::ScreenSaver) {
+            pushNavigation(currentId);
         }
     }
 
     if (currentScreen) {
-        const char *currentName = currentScreen->getName();
-        if (!STREQ(screenName, SCREEN_NAME_SCREENSAVER)) {
-            previousScreenName = currentName;
+        if (screenId != ScreenId::ScreenSaver) {
+            previousScreen = currentScreen->getId();
         }
+        // A gyorsítótárazott példány a cachedScreens-ben megmarad, a többi itt szűnik meg
         currentScreen->deactivate();
         currentScreen.reset();
     }
 
     ::tft.fillScreen(TFT_BLACK);
-    currentScreen = it->second();
+    if (descriptor.cached) {
+        currentScreen = cachedScreens[(uint8_t)screenId];
+    } else {
+        currentScreen = descriptor.factory();
+        if (currentScreen) {
+            currentScreen->setScreenManager(this);
+        }
+    }
+
     if (currentScreen) {
-        currentScreen->setScreenManager(this);
         if (params) {
             currentScreen->setParameters(params);
         }
         // Aktivitás idő frissítése minden képernyőváltásnál (kivéve screensaver aktiválás)
-        if (!STREQ(screenName, SCREEN_NAME_SCREENSAVER)) {
+        if (screenId != ScreenId::ScreenSaver) {
             lastActivityTime = millis();
         }
         currentScreen->activate();
+        DEBUG("ScreenManager: -> '%s' (%s) %lu us\n", currentScreen->getName(), descriptor.cached ? "cached" : "created", (unsigned long)(micros() - startMicros));
         return true;
     } else {
-        DEBUG("ScreenManager: Képernyő létrehozása nem sikerült '%s'\n", screenName);
+        DEBUG("ScreenManager: Képernyő létrehozása nem sikerült '%s'\n", screenName(screenId));
     }
 
     return false;
@@ -186,24 +233,22 @@ bool ScreenManager::goBack() {
  */
 bool ScreenManager::immediateGoBack() {
 
-    if (currentScreen && STREQ(currentScreen->getName(), SCREEN_NAME_SCREENSAVER)) {
-        if (!screenBeforeScreenSaver.isEmpty()) {
-            String targetScreen = screenBeforeScreenSaver;
-            screenBeforeScreenSaver = String();
+    if (isCurrentScreenScreensaver()) {
+        if (screenBeforeScreenSaver != ScreenId::None) {
+            ScreenId targetScreen = screenBeforeScreenSaver;
+            screenBeforeScreenSaver = ScreenId::None;
             // Screensaver-ből való kilépéskor frissítjük az aktivitás időt
             lastActivityTime = millis();
-            return immediateSwitch(targetScreen.c_str(), nullptr, true);
+            return immediateSwitch(targetScreen, nullptr, true);
         }
     }
 
-    if (!navigationStack.empty()) {
-        String previousScreen = navigationStack.back();
-        navigationStack.pop_back();
-        return immediateSwitch(previousScreen.c_str(), nullptr, true);
+    if (navigationDepth > 0) {
+        return immediateSwitch(navigationStack[--navigationDepth], nullptr, true);
     }
 
-    if (previousScreenName != nullptr) {
-        return immediateSwitch(previousScreenName, nullptr, true);
+    if (previousScreen != ScreenId::None) {
+        return immediateSwitch(previousScreen, nullptr, true);
     }
     return false;
 }
@@ -213,7 +258,7 @@ bool ScreenManager::immediateGoBack() {
  */
 bool ScreenManager::handleTouch(const TouchEvent &event) {
     if (currentScreen) {
-        if (!STREQ(currentScreen->getName(), SCREEN_NAME_SCREENSAVER)) {
+        if (currentScreen->getId() != ScreenId::ScreenSaver) {
             lastActivityTime = millis();
         }
         processingEvents = true;
@@ -232,6 +277,50 @@ void ScreenManager::loop() {
     // Feldolgozzuk a függőben lévő képernyőváltásokat
     processDeferredActions();
 
+    // Navigációs soak teszt: körönként egy képernyő
+    if (soakCyclesLeft > 0) {
+        stepNavigationSoak();
+    }
+
+    // A TouchSampler által szűrt érintés események; a lenyomás késleltetése a PENIRQ éltől mérve
+    uint32_t touchT0Micros = 0;
+    TouchEvent touchEvent;
+    while (touchSampler.popEvent(touchEvent)) {
+        handleTouch(touchEvent);
+        if (touchEvent.pressed && touchEvent.t0Micros) {
+            latencyProbe.recordSince(LatencyProbe::TOUCH_DISPATCHED, touchEvent.t0Micros);
+            touchT0Micros = touchEvent.t0Micros;
+        }
+    }
+
+    // A Core1-ről érkezett GPS események továbbítása az aktív képernyőnek
+    GpsEvent gpsEvent;
+    while (gpsManager && gpsManager->popEvent(gpsEvent)) {
+        if (currentScreen) {
+            currentScreen->onGpsEvent(gpsEvent);
+        }
+    }
+
+    // A Core1 traffipax riasztásai: a hang (bejelentés, ha vannak klipek, különben sziréna) bármelyik képernyőn szól,
+    // a megjelenítés a képernyő dolga
+    TraffipaxAlertEvent alertEvent;
+    while (traffipaxAlertEvaluator && traffipaxAlertEvaluator->popEvent(alertEvent)) {
+        if (alertEvent.siren == TraffipaxAlertEvent::SIREN_START) {
+            if (!voicePrompt.announceCamera(alertEvent.distance)) {
+                audioEngine.play(AudioEngine::Sound::Siren);
+            }
+            if (alertEvent.rxMicros) {
+                latencyProbe.recordSince(LatencyProbe::SIREN_STARTED, alertEvent.rxMicros);
+            }
+        } else if (alertEvent.siren == TraffipaxAlertEvent::SIREN_STOP) {
+            voicePrompt.stop();
+            audioEngine.stop(AudioEngine::Sound::Siren);
+        }
+        if (currentScreen) {
+            currentScreen->onTraffipaxAlert(alertEvent);
+        }
+    }
+
     if (currentScreen) {
         // GPS sebesség ellenőrzése a screensaver logikához
         float currentSpeed = 0.0f;
@@ -253,7 +342,7 @@ void ScreenManager::loop() {
                 lastActivityTime = millis();
             } else if (millis() - lastActivityTime > screenSaverTimeoutMs) { // Csak álló helyzetben aktiválódjon a screensaver
 
-                switchToScreen(SCREEN_NAME_SCREENSAVER);
+                switchToScreen(ScreenId::ScreenSaver);
             }
         }
 
@@ -262,6 +351,11 @@ void ScreenManager::loop() {
         }
         currentScreen->loop();
     }
+
+    // A lenyomás vizuális visszajelzése (pl. a gomb újrarajzolása) ebben a körben kikerült
+    if (touchT0Micros) {
+        latencyProbe.recordSince(LatencyProbe::TOUCH_FEEDBACK, touchT0Micros);
+    }
 }
 
 /**
@@ -280,5 +374,70 @@ bool ScreenManager::isCurrentScreenDialogActive() {
  */
 bool ScreenManager::isCurrentScreenScreensaver() const {
     //
-    return currentScreen && STREQ(currentScreen->getName(), SCREEN_NAME_SCREENSAVER);
-}
\ No newline at end of file
+    return currentScreen && currentScreen->getId() == ScreenId::ScreenSaver;
+}
+
+/**
+ * @brief Scriptelt navigációs soak teszt indítása
+ */
+void ScreenManager::startNavigationSoak(uint16_t cycles) {
+    if (soakCyclesLeft > 0 || cycles == 0 || !currentScreen) {
+        return;
+    }
+
+    // A visszatéréshez: az indító képernyő és a navigációs stack
+    soakReturnScreen = currentScreen->getId();
+    memcpy(soakNavigationStack, navigationStack, sizeof(navigationStack));
+    soakNavigationDepth = navigationDepth;
+
+    soakCycles = soakCyclesLeft = cycles;
+    soakScreenIndex = 0;
+    soakHeapBefore = Utils::getHeapStats();
+    DEBUG("ScreenManager: navigation soak started, %d cycles\n", cycles);
+}
+
+/**
+ * @brief A navigációs soak teszt egy lépése
+ */
+void ScreenManager::stepNavigationSoak() {
+
+    const ScreenDescriptor &descriptor = SCREEN_REGISTRY[soakScreenIndex];
+    if (++soakScreenIndex == (uint8_t)ScreenId::Count) {
+        soakScreenIndex = 0;
+        soakCyclesLeft--;
+    }
+
+    if (descriptor.factory && immediateSwitch(descriptor.id)) {
+        currentScreen->draw();
+
+        // Dialógus megnyitása és bezárása: a dialógus slab-ek és a dialógus stack terhelése
+        std::shared_ptr<MessageDialog> dialog = dialogArenaPool.make<MessageDialog>(currentScreen.get(), "Soak", "Navigation soak test", MessageDialog::ButtonsType::OkCancel);
+        currentScreen->showDialog(dialog);
+        currentScreen->draw();
+        dialog->close(UIDialogBase::DialogResult::Dismissed);
+    }
+
+    if (soakCyclesLeft == 0) {
+        finishNavigationSoak();
+    }
+}
+
+/**
+ * @brief A navigációs soak teszt vége
+ *
+ * A heap állapotát az indító képernyőn méri, így az előtte/utána értékek ugyanarra az állapotra vonatkoznak.
+ */
+void ScreenManager::finishNavigationSoak() {
+
+    immediateSwitch(soakReturnScreen, nullptr, true);
+    memcpy(navigationStack, soakNavigationStack, sizeof(navigationStack));
+    navigationDepth = soakNavigationDepth;
+    screenBeforeScreenSaver = ScreenId::None;
+
+    Utils::HeapStats after = Utils::getHeapStats();
+    DEBUG("ScreenManager: navigation soak done, %d cycles x %d screens\n", soakCycles, (uint8_t)ScreenId::Count);
+    DEBUG("  heap before: top %lu, used %lu, free %lu, free chunks %lu\n", soakHeapBefore.top, soakHeapBefore.used, soakHeapBefore.free, soakHeapBefore.freeChunks);
+    DEBUG("  heap after:  top %lu, used %lu, free %lu, free chunks %lu\n", after.top, after.used, after.free, after.freeChunks);
+    screenArenaPool.dump("screenArena");
+    dialogArenaPool.dump("dialogArena");
+}
@@ -23,13 +23,29 @@ constexpr int16_t CIRCLE_HEIGHT = 200;
 /**
  * @brief Konstruktor
  */
-ScreenSats::ScreenSats() : UIScreen(SCREEN_NAME_SATS), lastSatCount(0), firstDraw(true), currentSortType(SatelliteDb::BY_SNR), sortOrderChanged(false) { layoutComponents(); }
+ScreenSats::ScreenSats() : UIScreen(ScreenId::Sats), lastSatCount(0), firstDraw(true), currentSortType(SatelliteDb::BY_SNR), sortOrderChanged(false) { layoutComponents(); }
 
 /**
  * @brief Destruktor
  */
 ScreenSats::~ScreenSats() {}
 
+/**
+ * @brief Képernyő aktiválása
+ */
+void ScreenSats::activate() {
+    // A képernyő törlődött, amíg más képernyő volt aktív: mindent elölről rajzolunk
+    firstDraw = true;
+    sortOrderChanged = false;
+    lastSatellites.clear();
+    lastSatCount = 0;
+    gsvBlockPending = false;
+    lastUpdate = millis();
+    markForRedraw(true);
+
+    UIScreen::activate();
+}
+
 /**
  * @brief Képernyő tartalmának rajzolása
  */
@@ -72,22 +88,31 @@ void ScreenSats::drawContent() {
  * @brief Kezeli a képernyő saját ciklusát
  */
 void ScreenSats::handleOwnLoop() {
-    // 2 másodperces frissítés
-    static long lastUpdate = 0;
-    if (!Utils::timeHasPassed(lastUpdate, 2000)) {
+    // Frissítés a teljes GSV blokkra, a 2 másodperces időzítő csak watchdog
+    if (!gsvBlockPending && !Utils::timeHasPassed(lastUpdate, 2000)) {
         return;
     }
+    gsvBlockPending = false;
     lastUpdate = millis();
 
     markForRedraw();
 }
 
+/**
+ * @brief GPS esemény kezelése
+ */
+void ScreenSats::onGpsEvent(const GpsEvent &event) {
+    if (event.type == GpsEvent::GSV_BLOCK) {
+        gsvBlockPending = true;
+    }
+}
+
 /**
  * @brief UI komponensek elhelyezése
  */
 void ScreenSats::layoutComponents() {
     // Back gomb jobb alsó sarokban
-    auto backButton = std::make_shared<UIButton>(                                                                                                                         //
+    auto backButton = makeComponent<UIButton>(                                                                                                                            //
         1,                                                                                                                                                                //
         Rect(::SCREEN_W - UIButton::DEFAULT_BUTTON_WIDTH, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
         "Back",                                                                                                                                                           //
@@ -9,7 +9,7 @@ extern GpsManager *gpsManager;
 /**
  * @brief Konstruktor
  */
-ScreenScreenSaver::ScreenScreenSaver() : UIScreen(SCREEN_NAME_SCREENSAVER) {
+ScreenScreenSaver::ScreenScreenSaver() : UIScreen(ScreenId::ScreenSaver) {
     DEBUG("ScreenScreenSaver: Constructor called\n");
     layoutComponents();
 }
@@ -16,18 +16,18 @@ void ScreenSetup::layoutComponents() {
     int buttonY = 80;
 
     // TFT beállítások gomb
-    addChild(std::make_shared<UIButton>( //
+    addChild(makeComponent<UIButton>(    //
         10, Rect(buttonXGap, buttonY, btnW, btnH), "TFT", UIButton::ButtonType::Pushable, [this](const UIButton::ButtonEvent &event) {
             if (event.state == UIButton::EventButtonState::Clicked) {
-                getScreenManager()->switchToScreen(SCREEN_NAME_TFT_SETUP);
+                getScreenManager()->switchToScreen(ScreenId::TftSetup);
             }
         }));
 
     // System beállítások button
-    addChild(std::make_shared<UIButton>( //
+    addChild(makeComponent<UIButton>(    //
         11, Rect((::SCREEN_W - btnW) - buttonXGap, buttonY, btnW, btnH), "System", UIButton::ButtonType::Pushable, [this](const UIButton::ButtonEvent &event) {
             if (event.state == UIButton::EventButtonState::Clicked) {
-                getScreenManager()->switchToScreen(SCREEN_NAME_SYSTEM_SETUP);
+                getScreenManager()->switchToScreen(ScreenId::SystemSetup);
             }
         }));
 
@@ -35,33 +35,33 @@ void ScreenSetup::layoutComponents() {
     buttonY = 170;
 
     // GPS beállítások gomb
-    addChild(std::make_shared<UIButton>(       //
+    addChild(makeComponent<UIButton>(          //
         12,                                    //
         Rect(buttonXGap, buttonY, btnW, btnH), //
         "GPS Alarm",                           //
         UIButton::ButtonType::Pushable,        //
         [this](const UIButton::ButtonEvent &event) {
             if (event.state == UIButton::EventButtonState::Clicked) {
-                getScreenManager()->switchToScreen(SCREEN_NAME_GPS_SETUP);
+                getScreenManager()->switchToScreen(ScreenId::GpsSetup);
             }
         }) //
     );
 
     // Debug beállítások gomb
-    addChild(std::make_shared<UIButton>(                             //
+    addChild(makeComponent<UIButton>(                                //
         13,                                                          //
         Rect((::SCREEN_W - btnW) - buttonXGap, buttonY, btnW, btnH), //
         "Debug",                                                     //
         UIButton::ButtonType::Pushable,
         [this](const UIButton::ButtonEvent &event) {
             if (event.state == UIButton::EventButtonState::Clicked) {
-                getScreenManager()->switchToScreen(SCREEN_NAME_DEBUG_SETUP);
+                getScreenManager()->switchToScreen(ScreenId::DebugSetup);
             }
         }) //
     );
 
     // Back gomb jobb alsó sarokban
-    addChild(std::make_shared<UIButton>(                                                                                                                                  //
+    addChild(makeComponent<UIButton>(                                                                                                                                     //
         1,                                                                                                                                                                //
         Rect(::SCREEN_W - UIButton::DEFAULT_BUTTON_WIDTH, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
         "Back",                                                                                                                                                           //
@@ -18,7 +18,7 @@ void ScreenSystemSetup::layoutComponents() {
 
     // Beeper gomb
     int row = 0;
-    addChild(std::make_shared<UIButton>(                                                    //
+    addChild(makeComponent<UIButton>(                                                       //
         10,                                                                                 //
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH),                               //
         "Beeper",                                                                           //
@@ -34,7 +34,7 @@ void ScreenSystemSetup::layoutComponents() {
 
     // Demo mód
     row++;
-    addChild(std::make_shared<UIButton>( //
+    addChild(makeComponent<UIButton>(    //
         11,                              // id
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH),
         "Demo Mode",                                                         // label
@@ -49,7 +49,7 @@ void ScreenSystemSetup::layoutComponents() {
 
     // Screen Saver gomb
     row++;
-    addChild(std::make_shared<UIButton>(                      //
+    addChild(makeComponent<UIButton>(                         //
         12,                                                   //
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH), //
         "Screen Saver",                                       //
@@ -59,7 +59,7 @@ void ScreenSystemSetup::layoutComponents() {
             if (event.state == UIButton::EventButtonState::Clicked) {
                 static int screenSaverTimeout = static_cast<int>(config.data.screenSaverTimeout);
 
-                auto dialog = std::make_shared<ValueChangeDialog>(
+                auto dialog = makeDialog<ValueChangeDialog>(
                     this, "Screen Saver Timeout", "Set timeout (0-60 minutes, 0->off)", //
                     &screenSaverTimeout, 0, 60, 1,
                     [this](const std::variant<int, float, bool> &newValue) {
@@ -82,7 +82,7 @@ void ScreenSystemSetup::layoutComponents() {
     );
 
     // Vissza gomb
-    addChild(std::make_shared<UIButton>( //                                                                                                                                  //
+    addChild(makeComponent<UIButton>(    //                                                                                                                                  //
         1,                               //
         Rect(::SCREEN_W - UIButton::DEFAULT_BUTTON_WIDTH, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
         "Back", UIButton::ButtonType::Pushable, [this](const UIButton::ButtonEvent &event) {
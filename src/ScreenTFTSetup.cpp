@@ -21,7 +21,7 @@ void ScreenTFTSetup::layoutComponents() {
 
     // Auto Brightness gomb
     int row = 0;
-    addChild(std::make_shared<UIButton>(                                                              //
+    addChild(makeComponent<UIButton>(                                                                 //
         10,                                                                                           //
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH),                                         //
         "Auto Brightness",                                                                            //
@@ -44,7 +44,7 @@ void ScreenTFTSetup::layoutComponents() {
 
     // Manual Brightness gomb
     row++;
-    manualBrightnessBtn = std::make_shared<UIButton>(         //
+    manualBrightnessBtn = makeComponent<UIButton>(            //
         11,                                                   //
         Rect(btnX, btnY + row * (btnH + btnGap), btnW, btnH), //
         "Manual Brightness",                                  //
@@ -56,7 +56,7 @@ void ScreenTFTSetup::layoutComponents() {
                 // Lokális int változó a dialog számára
                 static int brightnessValue = static_cast<int>(config.data.tftManualBrightnessValue);
 
-                auto dialog = std::make_shared<ValueChangeDialog>(
+                auto dialog = makeDialog<ValueChangeDialog>(
                     this,                           // parent screen
                     "Manual Brightness",            // title
                     "Set brightness level (5-255)", // message
@@ -96,7 +96,7 @@ void ScreenTFTSetup::layoutComponents() {
     addChild(manualBrightnessBtn);
 
     // Vissza gomb
-    addChild(std::make_shared<UIButton>( //                                                                                                                                  //
+    addChild(makeComponent<UIButton>(    //                                                                                                                                  //
         1,                               //
         Rect(::SCREEN_W - UIButton::DEFAULT_BUTTON_WIDTH, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
         "Back", UIButton::ButtonType::Pushable, [this](const UIButton::ButtonEvent &event) {
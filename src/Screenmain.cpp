@@ -1,42 +1,97 @@
 #include "ScreenMain.h"
 #include "Config.h"
+#include "LatencyProbe.h"
 #include "LinearMeter.h"
+#include "TftBackLightAdjuster.h"
 #include "UIButton.h"
 #include "Utils.h"
 #include "defines.h"
 #include <Arduino.h>
 
-extern TraffipaxManager traffipaxManager;
+extern TftBackLightAdjuster tftBackLightAdjuster;
 
 constexpr uint16_t SPRITE_VERTICAL_LINEAR_METER_HEIGHT = 10 * (10 + 2) + 40; // max n=10, h=10, g=2
 constexpr uint8_t SPRITE_VERTICAL_LINEAR_METER_WIDTH = 70;
+constexpr uint16_t VERTICAL_LINEAR_METER_BAR_Y = 250;
+constexpr uint8_t VERTICAL_LINEAR_METER_SEGMENTS = 10;
+
+// A mérők sávszínei fordítási időben előállítva
+constexpr auto VOLTAGE_METER_COLORS = verticalLinearMeterColorTable<VERTICAL_LINEAR_METER_SEGMENTS>(RED2GREEN);
+constexpr auto TEMPERATURE_METER_COLORS = verticalLinearMeterColorTable<VERTICAL_LINEAR_METER_SEGMENTS>(BLUE2RED);
+
+// Idő sprite mérete és pozíciója: középre, 50px magasságban
+constexpr uint8_t TIME_SPRITE_Y = 50;
+constexpr uint8_t TIME_SPRITE_HEIGHT = 40; // elegendő magasság a fontnak
+#define TIME_SPRITE_X (::SCREEN_W / 2 - 70 - 30)
 
 constexpr uint8_t ALERT_BAR_HEIGHT = 80;
 constexpr uint8_t ALERT_TEXT_PADDING = 5;
 
-// Sprite a vertikális bar-oknak
-TFT_eSprite spriteVerticalLinearMeter(&tft);
+// A sebesség a fixek között 10 Hz-en frissül a szűrő predikciójából; ez alatt álló helyzetet mutatunk
+constexpr uint8_t SPEED_DISPLAY_INTERVAL_MS = 100;
+constexpr double SPEED_STANDSTILL_KMPH = 1.0;
+
+// A traffipax távolság legfeljebb ennyi ideig jelezhető előre a legutóbbi fixből
+constexpr uint16_t ALERT_DISTANCE_MAX_EXTRAPOLATION_MS = 1200;
+
+// A widget frissítő feladatokhoz tartozó mezők (DisplayData::ChangedField bitek)
+constexpr uint16_t HEADER_FIELDS = ScreenMain::DisplayData::SATELLITES | ScreenMain::DisplayData::FIX_MODE | ScreenMain::DisplayData::DATE | ScreenMain::DisplayData::TIME;
+constexpr uint16_t INFO_FIELDS = ScreenMain::DisplayData::ALTITUDE | ScreenMain::DisplayData::HDOP | ScreenMain::DisplayData::MAX_SPEED;
+constexpr uint16_t METER_FIELDS = ScreenMain::DisplayData::VOLTAGE | ScreenMain::DisplayData::TEMPERATURE;
+
+// 4 bpp palettás sprite-ok a vertikális bar-oknak (70x160: 5600 byte/db a 16 bites 22400 byte helyett)
+// Mindkét mérőnek saját sprite-ja van, így téma váltáskor újrarenderelés nélkül újra kitolhatók
+TFT_eSprite spriteVoltageMeter(&tft);
+TFT_eSprite spriteTemperatureMeter(&tft);
+
+// A mérők legutóbb kirajzolt állapota (a sprite-okkal együtt élnek), csak a változott sávok rajzolódnak újra
+VerticalLinearMeterState voltageMeterState;
+VerticalLinearMeterState temperatureMeterState;
 
-// Sprite csak az idő kirajzolásához (flicker csökkentés)
+// 4 bpp palettás sprite csak az idő kirajzolásához (flicker csökkentés)
 TFT_eSprite spriteTime(&tft);
 
+// A traffipax riasztó sáv előre összeállított, 4 bpp palettás sprite-jai: bal oldalt város/utca, jobb oldalt a távolság
+// A piros/narancs állapotváltás csak palettacsere, a távolság változásakor csak a kis távolság sprite frissül
+TFT_eSprite spriteAlertInfo(&tft);
+TFT_eSprite spriteAlertDistance(&tft);
+
 // Demó mód
 extern bool demoMode;
 
 /**
  * @brief ScreenMain konstruktor
  */
-ScreenMain::ScreenMain() : UIScreen(SCREEN_NAME_MAIN) {
+ScreenMain::ScreenMain()
+    : UIScreen(ScreenId::Main),                          //
+      satCountField(30, 15, ML_DATUM),                   //
+      fixModeField(65, 15, ML_DATUM),                    //
+      dateField(::SCREEN_W / 2 - 50, 12, ML_DATUM),      //
+      altitudeField(::SCREEN_W - 90, 13, ML_DATUM),      //
+      hdopField(35, 63, ML_DATUM),                       //
+      maxSpeedField(::SCREEN_W - 90, 60, ML_DATUM),      //
+      speedField(::SCREEN_W / 2 - 11, 240, MC_DATUM) {
+
+    // A mezők színe a témát követi
+    satCountField.getFormatter().nightTheme = &_nightTheme;
+    fixModeField.getFormatter().nightTheme = &_nightTheme;
+    dateField.getFormatter().nightTheme = &_nightTheme;
+    altitudeField.getFormatter().nightTheme = &_nightTheme;
+    hdopField.getFormatter().nightTheme = &_nightTheme;
+    maxSpeedField.getFormatter().nightTheme = &_nightTheme;
+    speedField.getFormatter().nightTheme = &_nightTheme;
 
     DEBUG("ScreenMain: Constructor called\n");
 
     // Feliratkozás a config változásokra
-    configCallbackId = config.registerChangeCallback([this]() { this->onConfigChanged(); });
+    configCallbackId = config.registerChangeCallback([this](ConfigFieldMask changed) { this->onConfigChanged(changed); },
+                                                     ConfigField::BEEPER_ENABLED | ConfigField::EXTERNAL_TEMPERATURE_MODE | ConfigField::EXTERNAL_VOLTAGE_MODE);
 
     layoutComponents();
+    registerRefreshTasks();
 
     // Kezdeti érték beállítása
-    onConfigChanged();
+    onConfigChanged(ConfigField::ALL);
 }
 
 /**
@@ -47,16 +102,16 @@ ScreenMain::~ScreenMain() { config.unregisterCallback(configCallbackId); }
 /**
  * @brief Callback függvény, amit a Config hív meg változás esetén
  */
-void ScreenMain::onConfigChanged() {
+void ScreenMain::onConfigChanged(ConfigFieldMask changed) {
     // DEBUG("ScreenMain::onConfigChanged() - Konfiguráció frissítése.\n");
-    _isTraffiAlarmEnabled = config.data.gpsTraffiAlarmEnabled;
     _isBeeperEnabled = config.data.beeperEnabled;
-    _gpsTraffiAlarmDistance = config.data.gpsTraffiAlarmDistance;
-    _isGpsTraffiSirenAlarmEnabled = config.data.gpsTraffiSirenAlarmEnabled;
 
-    // Ha a mód megváltozott, a méterek újrarajzolásának kényszerítése
-    if (_isExternalVoltageMode != config.data.externalVoltageMode || _isExternalTemperatureMode != config.data.externalTemperatureMode) {
-        lastVerticalLinearSpriteUpdate = 0;
+    // Ha a mód megváltozott, a méterek teljes újrarajzolásának kényszerítése
+    if (_isExternalVoltageMode != config.data.externalVoltageMode) {
+        voltageMeterState.invalidate();
+    }
+    if (_isExternalTemperatureMode != config.data.externalTemperatureMode) {
+        temperatureMeterState.invalidate();
     }
     _isExternalVoltageMode = config.data.externalVoltageMode;
     _isExternalTemperatureMode = config.data.externalTemperatureMode;
@@ -67,28 +122,28 @@ void ScreenMain::onConfigChanged() {
  */
 void ScreenMain::layoutComponents() {
     // Info gomb bal alsó sarokban
-    addChild(std::make_shared<UIButton>(
+    addChild(makeComponent<UIButton>(
         1,                                                                                                                          // Info gomb azonosítója
         Rect(0, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH - 8, UIButton::DEFAULT_BUTTON_HEIGHT), //
         "Info",                                                                                                                     //
         UIButton::ButtonType::Pushable,
         [this](const UIButton::ButtonEvent &event) {
             if (event.state == UIButton::EventButtonState::Clicked) {
-                getScreenManager()->switchToScreen(SCREEN_NAME_INFO);
+                getScreenManager()->switchToScreen(ScreenId::Info);
             }
         },
         UIColorPalette::createDarkButtonScheme()) // sötét gomb színséma
     );
 
     // Setup gomb jobb alsó sarokban
-    addChild(std::make_shared<UIButton>(
+    addChild(makeComponent<UIButton>(
         2,                                                                                                                                                                // Setup gomb azonosítója
         Rect(::SCREEN_W - UIButton::DEFAULT_BUTTON_WIDTH, ::SCREEN_H - UIButton::DEFAULT_BUTTON_HEIGHT, UIButton::DEFAULT_BUTTON_WIDTH, UIButton::DEFAULT_BUTTON_HEIGHT), //
         "Setup",                                                                                                                                                          //
         UIButton::ButtonType::Pushable,
         [this](const UIButton::ButtonEvent &event) {
             if (event.state == UIButton::EventButtonState::Clicked) {
-                getScreenManager()->switchToScreen(SCREEN_NAME_SETUP);
+                getScreenManager()->switchToScreen(ScreenId::Setup);
             }
         },
         UIColorPalette::createDarkButtonScheme()) // sötét gomb színséma
@@ -105,13 +160,134 @@ void ScreenMain::activate() {
     // Beállítjuk a kényszerített újrarajzolás flag-et
     this->forceRedraw = true;
 
+    // A sprite-ok globálisak, túlélik a képernyőt: palettájukat az aktuális témához igazítjuk,
+    // a mérőket pedig teljesen újrarajzoljuk, mert a képernyő törlődött
+    createSprites();
+    voltageMeterState.invalidate();
+    temperatureMeterState.invalidate();
+    _nightTheme = tftBackLightAdjuster.isNightTheme();
+    applySpriteTheme(false);
+
     // a következő ciklusban kényszerítjük az újrarajzolást
     markForRedraw(true); // a képernyőt és a gyerekeit  újrarajzolásra jelöljük
 
+    // A riasztás más képernyőn is élhet: a kiértékelő utolsó állapotával indulunk (késleltetés mérés nélkül)
+    if (traffipaxAlertEvaluator) {
+        pendingAlert = traffipaxAlertEvaluator->getCurrentAlert();
+        pendingAlert.rxMicros = 0;
+        alertPending = true;
+    }
+
     // Ős activate() metódus hívása
     UIScreen::activate();
 }
 
+/**
+ * @brief Dialógus bezárása
+ *
+ * Az utolsó dialógus bezárásakor a UIScreen törli a képernyőt és csak a statikus részeket rajzolja újra; a változás
+ * vezérelt widgetek (sebesség, mérők, fejléc) az activate()-hez hasonlóan kényszerített frissítést kapnak, különben a
+ * nem változó értékek üresen maradnának.
+ */
+void ScreenMain::onDialogClosed(UIDialogBase *closedDialog) {
+    UIScreen::onDialogClosed(closedDialog);
+    if (isDialogActive()) {
+        return;
+    }
+    this->forceRedraw = true;
+
+    // A riasztás sávja is törlődött: a kiértékelő utolsó állapotával, teljes sávval jelenik meg újra
+    traffipaxAlert.shownTraffipax = nullptr;
+    traffipaxAlert.shownState = TraffipaxAlertEvent::INACTIVE;
+    traffipaxAlert.shownDistance = -1;
+    if (traffipaxAlertEvaluator) {
+        pendingAlert = traffipaxAlertEvaluator->getCurrentAlert();
+        pendingAlert.rxMicros = 0;
+        alertPending = true;
+    }
+}
+
+/**
+ * @brief A 4 bpp palettás sprite-ok létrehozása (ha még nem léteznek)
+ */
+void ScreenMain::createSprites() {
+    if (!spriteVoltageMeter.created()) {
+        spriteVoltageMeter.setColorDepth(4);
+        spriteVoltageMeter.createSprite(SPRITE_VERTICAL_LINEAR_METER_WIDTH, SPRITE_VERTICAL_LINEAR_METER_HEIGHT);
+    }
+    if (!spriteTemperatureMeter.created()) {
+        spriteTemperatureMeter.setColorDepth(4);
+        spriteTemperatureMeter.createSprite(SPRITE_VERTICAL_LINEAR_METER_WIDTH, SPRITE_VERTICAL_LINEAR_METER_HEIGHT);
+    }
+    if (!spriteTime.created()) {
+        // Az idő szöveg szélessége (fix formátum: "88:88:88") + padding
+        tft.setFreeFont(&FreeSansBold18pt7b);
+        tft.setTextSize(1);
+        const int timeTextW = tft.textWidth("88:88:88") + 60;
+        tft.setFreeFont();
+
+        spriteTime.setColorDepth(4);
+        spriteTime.createSprite(timeTextW, TIME_SPRITE_HEIGHT);
+    }
+    if (!spriteAlertDistance.created()) {
+        // A távolság sprite a legszélesebb kiírható távolsághoz ("8888m") igazodik
+        spriteAlertDistance.setFreeFont(&FreeSerifBold24pt7b);
+        spriteAlertDistance.setTextSize(1);
+        const int distanceW = spriteAlertDistance.textWidth("8888m") + 2 * ALERT_TEXT_PADDING;
+
+        spriteAlertDistance.setColorDepth(4);
+        spriteAlertDistance.createSprite(distanceW, ALERT_BAR_HEIGHT);
+        spriteAlertInfo.setColorDepth(4);
+        spriteAlertInfo.createSprite(::SCREEN_W - distanceW, ALERT_BAR_HEIGHT);
+    }
+}
+
+/**
+ * @brief A sprite-ok palettájának beállítása az aktuális (nappali/éjszakai) témára
+ *
+ * A sprite-ok paletta indexeket tárolnak, így a téma váltás csak palettacsere,
+ * a tartalmuk újrarenderelése nélkül. A közvetlenül a kijelzőre írt szövegek színe a themeColor()-on megy át,
+ * azok a téma váltásakor újrarajzolódnak.
+ */
+void ScreenMain::applySpriteTheme(bool repush) {
+    verticalLinearMeterPalette(&spriteVoltageMeter, VOLTAGE_METER_COLORS.data(), VERTICAL_LINEAR_METER_SEGMENTS, _nightTheme);
+    verticalLinearMeterPalette(&spriteTemperatureMeter, TEMPERATURE_METER_COLORS.data(), VERTICAL_LINEAR_METER_SEGMENTS, _nightTheme);
+    UIColorPalette::applySpritePalette(spriteTime, UIColorPalette::TIME_SPRITE_PALETTE, ARRAY_ITEM_COUNT(UIColorPalette::TIME_SPRITE_PALETTE), _nightTheme);
+
+    if (!repush) {
+        return;
+    }
+
+    // A még ki nem rajzolt mérőket nem toljuk ki
+    if (voltageMeterState.isDrawn()) {
+        spriteVoltageMeter.pushSprite(0, VERTICAL_LINEAR_METER_BAR_Y + 10 - SPRITE_VERTICAL_LINEAR_METER_HEIGHT);
+    }
+    if (temperatureMeterState.isDrawn()) {
+        spriteTemperatureMeter.pushSprite(::SCREEN_W - SPRITE_VERTICAL_LINEAR_METER_WIDTH, VERTICAL_LINEAR_METER_BAR_Y + 10 - SPRITE_VERTICAL_LINEAR_METER_HEIGHT);
+    }
+
+    // Az idő sprite a traffipax sáv alá esik, riasztás alatt nem toljuk ki
+    if (!traffiAlarmActive && lastData.timeString[0] != '\0') {
+        spriteTime.pushSprite(TIME_SPRITE_X, TIME_SPRITE_Y - (TIME_SPRITE_HEIGHT / 2));
+    }
+
+    // A nem sprite szövegek (feliratok, érték mezők, sebesség) az új színekkel rajzolódnak újra;
+    // a riasztás alatt a fejléc a sáv alatt van, azt a riasztás vége úgyis teljesen újrarajzolja
+    if (!traffiAlarmActive) {
+        drawContent();
+    }
+    this->forceRedraw = true;
+    lastUpdate = 0;
+
+    // A riasztás sávja a kiértékelő utolsó állapotával, az új palettával kerül ki újra (újrarenderelés nélkül)
+    if (traffiAlarmActive && traffipaxAlertEvaluator) {
+        traffipaxAlert.shownState = TraffipaxAlertEvent::INACTIVE;
+        pendingAlert = traffipaxAlertEvaluator->getCurrentAlert();
+        pendingAlert.rxMicros = 0;
+        alertPending = true;
+    }
+}
+
 /**
  * Műhold ikon rajzolása
  */
@@ -147,7 +323,7 @@ void ScreenMain::drawSatelliteIcon(int16_t x, int16_t y) {
 
     // Felirat
     tft.setTextDatum(ML_DATUM); // Middle Left - bal oldal, középre igazítva
-    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.setTextColor(themeColor(TFT_YELLOW), TFT_BLACK);
     tft.setFreeFont();
     tft.setTextSize(1);
     tft.drawString("sats", x, y + 28);
@@ -202,7 +378,7 @@ void ScreenMain::drawAltitudeIcon(int16_t x, int16_t y) {
 
     // Felirat
     tft.setTextDatum(MC_DATUM); // Middle Center - középre igazítva
-    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.setTextColor(themeColor(TFT_YELLOW), TFT_BLACK);
     tft.setFreeFont();
     tft.setTextSize(1);
     tft.drawString("altit", x + 20, y + 27);
@@ -232,7 +408,7 @@ void ScreenMain::drawGpsAccuracyIcon(int16_t x, int16_t y) {
 
     // Felirat
     tft.setTextDatum(ML_DATUM); // Middle Left - bal oldal, középre igazítva
-    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.setTextColor(themeColor(TFT_YELLOW), TFT_BLACK);
     tft.setFreeFont();
     tft.setTextSize(1);
     tft.setTextPadding(0); // ne töröljön bele felesleges pixelbe
@@ -302,7 +478,7 @@ void ScreenMain::drawSpeedometerIcon(int16_t x, int16_t y) {
 
     // Felirat
     tft.setTextDatum(MC_DATUM); // Middle Center - középre igazítva
-    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.setTextColor(themeColor(TFT_YELLOW), TFT_BLACK);
     tft.setFreeFont();
     tft.setTextSize(1);
     tft.setTextPadding(0); // ne töröljön bele felesleges pixelbe
@@ -318,7 +494,7 @@ void ScreenMain::drawContent() {
     tft.setFreeFont(); // Alapértelmezett font
     tft.setTextSize(1);
     tft.setTextPadding(0); // ne töröljön bele felesleges pixelbe
-    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.setTextColor(themeColor(TFT_YELLOW), TFT_BLACK);
     tft.setTextDatum(MR_DATUM);
 
     // Magasság mértékegység felirat
@@ -330,7 +506,7 @@ void ScreenMain::drawContent() {
     // Sebesség mértékegység felirat
     tft.setTextDatum(MC_DATUM);
     tft.setTextSize(2);
-    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.setTextColor(themeColor(TFT_WHITE), TFT_BLACK);
     tft.drawString("km/h", ::SCREEN_W / 2, 105);
 
     // Műhold ikon bal oldalon
@@ -358,27 +534,24 @@ ScreenMain::DisplayData ScreenMain::collectRealData() {
     // Műhold adatok
     data.satelliteValid = gpsManager->getSatellites().isValid() && gpsManager->getSatellites().age() < GPS_DATA_MAX_AGE;
     data.satelliteCount = data.satelliteValid ? gpsManager->getSatellites().value() : 0;
-    data.gpsMode = gpsManager->getGpsModeToString();
+    data.fixMode = gpsManager->getFixMode();
 
     // Dátum
     GpsManager::LocalDateTime localDateTime = gpsManager->getLocalDateTime();
     if (localDateTime.dateValid) {
-        char dateStr[11];
-        sprintf(dateStr, "%04d-%02d-%02d", localDateTime.year, localDateTime.month, localDateTime.day);
-        data.dateString = String(dateStr);
+        // A % a kiírás hosszát a buffer méretéhez köti (érvényes dátumnál nem változtat az értéken)
+        snprintf(data.dateString, sizeof(data.dateString), "%04d-%02d-%02d", localDateTime.year % 10000, localDateTime.month % 100, localDateTime.day % 100);
     } else {
-        data.dateString = "----.--.--";
+        strlcpy(data.dateString, "----.--.--", sizeof(data.dateString));
     }
 
     // Idő
     if (localDateTime.timeValid) {
-        char timeStr[9];
-        sprintf(timeStr, "%02d:%02d:%02d", localDateTime.hour, localDateTime.minute, localDateTime.second);
-        data.timeString = String(timeStr);
-
+        snprintf(data.timeString, sizeof(data.timeString), "%02d:%02d:%02d", localDateTime.hour % 100, localDateTime.minute % 100, localDateTime.second % 100);
     } else {
-        data.timeString = "--:--:--";
+        strlcpy(data.timeString, "--:--:--", sizeof(data.timeString));
     }
+    data.dateTimeValid = localDateTime.dateValid && localDateTime.timeValid;
 
     // Pozíció
     data.positionValid = gpsManager->getLocation().isValid() && gpsManager->getLocation().age() < GPS_DATA_MAX_AGE;
@@ -393,16 +566,13 @@ ScreenMain::DisplayData ScreenMain::collectRealData() {
     data.hdopValid = gpsManager->getHdop().isValid() && gpsManager->getHdop().age() < GPS_DATA_MAX_AGE;
     data.hdop = data.hdopValid ? gpsManager->getHdop().hdop() : 0.0;
 
-    // Sebesség - 1km/h esetén indulunk el
-    data.speedValid = gpsManager->getSpeed().isValid() && gpsManager->getSpeed().age() < GPS_DATA_MAX_AGE && gpsManager->getSpeed().kmph() > 1;
-    data.currentSpeed = data.speedValid ? gpsManager->getSpeed().kmph() : 0.0;
+    // Sebesség: a Core1 Kalman-szűrőjének becslése, a fixek között előre jelezve
+    SpeedFilter::Estimate speedEstimate = gpsManager->getSpeedEstimate();
+    data.speedValid = speedEstimate.valid && millis() - speedEstimate.epochMillis < GPS_DATA_MAX_AGE;
+    data.currentSpeed = data.speedValid ? displaySpeed(speedEstimate) : 0.0;
 
-    // Maximum sebesség (statikus változó)
-    static double maxSpeedValue = 0.0;
-    if (data.speedValid && data.currentSpeed > maxSpeedValue) {
-        maxSpeedValue = data.currentSpeed;
-    }
-    data.maxSpeed = maxSpeedValue;
+    // Maximum sebesség: a displaySpeed() követi
+    data.maxSpeed = maxSpeedKmph;
 
     // Szenzorok
     if (_isExternalVoltageMode) { // Feszmérő mód: true = VBus, false = VSys
@@ -437,19 +607,19 @@ ScreenMain::DisplayData ScreenMain::collectDemoData() {
     data.satelliteValid = true;
     switch (random(0, 4)) {
         case 0:
-            data.gpsMode = "No Fix";
+            data.fixMode = GpsManager::FixMode::NoFix;
             break;
         case 1:
-            data.gpsMode = "Auto 2D/3D";
+            data.fixMode = GpsManager::FixMode::Auto;
             break;
         case 2:
-            data.gpsMode = "Differential";
+            data.fixMode = GpsManager::FixMode::Differential;
             break;
         case 3:
-            data.gpsMode = "Estimated";
+            data.fixMode = GpsManager::FixMode::Estimated;
             break;
         default:
-            data.gpsMode = "Unknown";
+            data.fixMode = GpsManager::FixMode::Unknown;
             break;
     }
 
@@ -457,17 +627,15 @@ ScreenMain::DisplayData ScreenMain::collectDemoData() {
     static unsigned long demoStartTime = millis();
     unsigned long elapsed = (millis() - demoStartTime) / 1000;
 
-    data.dateString = "2025-08-23";
+    strlcpy(data.dateString, "2025-08-23", sizeof(data.dateString));
 
-    int startHour = 17, startMin = 42, startSec = 30;
-    int totalSeconds = startHour * 3600 + startMin * 60 + startSec + elapsed;
-    int hour = (totalSeconds / 3600) % 24;
-    int minute = (totalSeconds % 3600) / 60;
-    int second = totalSeconds % 60;
+    unsigned long startHour = 17, startMin = 42, startSec = 30;
+    unsigned long totalSeconds = startHour * 3600 + startMin * 60 + startSec + elapsed;
+    uint8_t hour = (totalSeconds / 3600) % 24;
+    uint8_t minute = (totalSeconds % 3600) / 60;
+    uint8_t second = totalSeconds % 60;
 
-    char timeStr[9];
-    sprintf(timeStr, "%02d:%02d:%02d", hour, minute, second);
-    data.timeString = String(timeStr);
+    snprintf(data.timeString, sizeof(data.timeString), "%02d:%02d:%02d", hour, minute, second);
     data.dateTimeValid = true;
 
     // Pozíció
@@ -519,6 +687,66 @@ ScreenMain::DisplayData ScreenMain::collectDemoData() {
     return data;
 }
 
+/**
+ * @brief A megváltozott mezők bitmaszkja egy korábbi állapothoz képest
+ */
+uint16_t ScreenMain::DisplayData::changedFrom(const DisplayData &previous) const {
+    uint16_t mask = 0;
+    if (satelliteCount != previous.satelliteCount || satelliteValid != previous.satelliteValid) {
+        mask |= SATELLITES;
+    }
+    if (fixMode != previous.fixMode) {
+        mask |= FIX_MODE;
+    }
+    if (!STREQ(dateString, previous.dateString)) {
+        mask |= DATE;
+    }
+    if (!STREQ(timeString, previous.timeString)) {
+        mask |= TIME;
+    }
+    if (latitude != previous.latitude || longitude != previous.longitude || positionValid != previous.positionValid) {
+        mask |= POSITION;
+    }
+    if (altitude != previous.altitude || altitudeValid != previous.altitudeValid) {
+        mask |= ALTITUDE;
+    }
+    if (hdop != previous.hdop || hdopValid != previous.hdopValid) {
+        mask |= HDOP;
+    }
+    if (currentSpeed != previous.currentSpeed || speedValid != previous.speedValid) {
+        mask |= SPEED;
+    }
+    if (maxSpeed != previous.maxSpeed) {
+        mask |= MAX_SPEED;
+    }
+    if (voltage != previous.voltage) {
+        mask |= VOLTAGE;
+    }
+    if (temperature != previous.temperature) {
+        mask |= TEMPERATURE;
+    }
+    return mask;
+}
+
+/**
+ * @brief Az idő kirajzolása a 4 bpp idő sprite-ba és kitolása a kijelzőre
+ */
+void ScreenMain::drawTime(const char *timeString) {
+    spriteTime.fillSprite(UIColorPalette::TIME_SPRITE_PAL_BACKGROUND);
+    spriteTime.setFreeFont(&FreeSansBold24pt7b);
+    spriteTime.setTextSize(1);
+    spriteTime.setTextDatum(ML_DATUM);
+    spriteTime.setTextPadding(0);
+    spriteTime.setTextColor(UIColorPalette::TIME_SPRITE_PAL_TEXT, UIColorPalette::TIME_SPRITE_PAL_BACKGROUND);
+
+    // Rajzolás sprite-on belül: bal középre
+    spriteTime.drawString(timeString, 0, TIME_SPRITE_HEIGHT / 2);
+    spriteTime.setFreeFont();
+
+    // Idő pozícionálása a képernyőn: középre és 50px magasságban
+    spriteTime.pushSprite(TIME_SPRITE_X, TIME_SPRITE_Y - (TIME_SPRITE_HEIGHT / 2));
+}
+
 /**
  * Alert bar törlése
  */
@@ -526,397 +754,350 @@ void ScreenMain::clearTraffipaxAlert() {
     // Egyszerűen töröljük a riasztás sávját a tft-n
     tft.fillRect(0, 0, tft.width(), ALERT_BAR_HEIGHT, TFT_BLACK);
 
-    // Ha vansziréna, akkor azt most lelőjük
-    Utils::stopNonBlockingSiren();
+    // A következő riasztás ismét teljes sávval indul
+    traffipaxAlert.shownTraffipax = nullptr;
+    traffipaxAlert.shownState = TraffipaxAlertEvent::INACTIVE;
+    traffipaxAlert.shownDistance = -1;
 }
 
 /**
  * Traffipax figyelmeztető sáv megjelenítése
+ *
+ * A sáv képernyőn kívül, két 4 bpp sprite-ban áll össze, és egyben kerül ki a kijelzőre (nincs törlés-majd-rajzolás villanás):
+ * - új traffipax: a város/utca sprite újrarenderelése + mindkét sprite kitolása
+ * - piros <-> narancs állapotváltás: csak palettacsere + kitolás, újrarenderelés nélkül
+ * - távolság változás: csak a kis távolság sprite renderelése és kitolása
  */
-void ScreenMain::displayTraffipaxAlert(const TraffipaxManager::TraffipaxRecord *traffipax, double distance) {
-
-    static uint16_t lastBackgroundColor = 0xFFFF;
-    static const TraffipaxManager::TraffipaxRecord *lastTraffipaxPtr = nullptr;
-    static char lastCityText[MAX_CITY_LEN] = {0};
-    static char lastStreetText[MAX_STREET_LEN] = {0};
-    static int lastDistance = -1;
+void ScreenMain::displayTraffipaxAlert(const TraffipaxManager::TraffipaxRecord *traffipax, double distance, uint32_t rxMicros) {
 
     if (traffipax == nullptr) {
         return;
     }
 
-    // Háttérszín meghatározása állapot szerint
-    uint16_t backgroundColor;
-    uint16_t textColor;
-
+    // Paletta meghatározása állapot szerint
+    const uint16_t *palette;
     switch (traffipaxAlert.currentState) {
-        case TraffipaxAlert::APPROACHING:
-        case TraffipaxAlert::NEARBY_STOPPED:
-            backgroundColor = TFT_RED;
-            textColor = TFT_WHITE;
+        case TraffipaxAlertEvent::APPROACHING:
+        case TraffipaxAlertEvent::NEARBY_STOPPED:
+            palette = UIColorPalette::TRAFFIPAX_ALERT_NEAR_PALETTE;
             break;
-        case TraffipaxAlert::DEPARTING:
-            backgroundColor = TFT_ORANGE;
-            textColor = TFT_BLACK;
+        case TraffipaxAlertEvent::DEPARTING:
+            palette = UIColorPalette::TRAFFIPAX_ALERT_DEPARTING_PALETTE;
             break;
         default:
             return; // INACTIVE
     }
 
-    bool fullRedraw = false;
-    // Ha háttérszín vagy traffipax rekord változott, teljes újrarajzolás
-    if (backgroundColor != lastBackgroundColor || traffipax != lastTraffipaxPtr) {
-        fullRedraw = true;
-        lastBackgroundColor = backgroundColor;
-        lastTraffipaxPtr = traffipax;
+    const bool newAlert = traffipax != traffipaxAlert.shownTraffipax;
+    const bool stateChanged = newAlert || traffipaxAlert.currentState != traffipaxAlert.shownState;
+    const int intDistance = (int)distance;
+    const bool distanceChanged = newAlert || intDistance != traffipaxAlert.shownDistance;
 
-        // Város és utca szöveg mentése
-        strncpy(lastCityText, traffipax->city, MAX_CITY_LEN);
-        strncpy(lastStreetText, traffipax->street_or_km, MAX_STREET_LEN);
+    if (!stateChanged && !distanceChanged) {
+        return;
+    }
+
+    // Új riasztásnál a döntéstől az első kitolt sprite-ig (az első látható pixelekig) eltelt idő mérése,
+    // és a fázisok késleltetése a GPS epocha t0-jához mérve
+    const uint32_t decisionMicros = micros();
+    const bool measureLatency = newAlert && rxMicros;
+    if (measureLatency) {
+        latencyProbe.recordSince(LatencyProbe::DRAW_STARTED, rxMicros);
     }
 
-    if (fullRedraw) {
-        // Háttér sáv
-        tft.fillRect(0, 0, tft.width(), ALERT_BAR_HEIGHT, backgroundColor);
+    // Város és utca: csak új traffipax esetén rendereljük újra
+    if (newAlert) {
+        spriteAlertInfo.fillSprite(UIColorPalette::TRAFFIPAX_ALERT_PAL_BACKGROUND);
+        spriteAlertInfo.setTextDatum(TL_DATUM);
+        spriteAlertInfo.setTextColor(UIColorPalette::TRAFFIPAX_ALERT_PAL_TEXT, UIColorPalette::TRAFFIPAX_ALERT_PAL_BACKGROUND);
+        spriteAlertInfo.setFreeFont(&FreeSans9pt7b);
 
         // Város (első sor, balra igazítva)
-        tft.setTextDatum(TL_DATUM);
-        tft.setTextColor(textColor, backgroundColor);
-        tft.setFreeFont(&FreeSans9pt7b);
-        tft.setTextSize(2);
-        tft.drawString(lastCityText, ALERT_TEXT_PADDING, 10);
+        spriteAlertInfo.setTextSize(2);
+        spriteAlertInfo.drawString(traffipax->city, ALERT_TEXT_PADDING, 10);
 
         // Utca/km (második sor, balra igazítva)
-        tft.setTextSize(1);
-        tft.drawString(lastStreetText, ALERT_TEXT_PADDING, 55);
+        spriteAlertInfo.setTextSize(1);
+        spriteAlertInfo.drawString(traffipax->street_or_km, ALERT_TEXT_PADDING, 55);
+        spriteAlertInfo.setFreeFont();
     }
 
-    // Távolság (jobbra, vertikálisan középre) csak akkor töröljük, ha változott
-    int intDistance = (int)distance;
-    if (intDistance != lastDistance || fullRedraw) {
-
+    // Távolság (jobbra, vertikálisan középre): a saját sprite-ja teljes újrarenderelése, padding törlés nélkül
+    if (distanceChanged) {
         char distanceText[16];
         snprintf(distanceText, sizeof(distanceText), "%dm", intDistance);
 
-        tft.setTextDatum(MR_DATUM);
-        tft.setFreeFont(&FreeSerifBold24pt7b);
-        tft.setTextSize(1);
-        tft.setTextPadding(tft.textWidth("8888m"));
-        tft.setTextColor(textColor, backgroundColor);
-        tft.drawString(distanceText, ::SCREEN_W - ALERT_TEXT_PADDING, ALERT_BAR_HEIGHT / 2);
-        lastDistance = intDistance;
+        spriteAlertDistance.fillSprite(UIColorPalette::TRAFFIPAX_ALERT_PAL_BACKGROUND);
+        spriteAlertDistance.setTextDatum(MR_DATUM);
+        spriteAlertDistance.setFreeFont(&FreeSerifBold24pt7b);
+        spriteAlertDistance.setTextSize(1);
+        spriteAlertDistance.setTextColor(UIColorPalette::TRAFFIPAX_ALERT_PAL_TEXT, UIColorPalette::TRAFFIPAX_ALERT_PAL_BACKGROUND);
+        spriteAlertDistance.drawString(distanceText, spriteAlertDistance.width() - ALERT_TEXT_PADDING, ALERT_BAR_HEIGHT / 2);
+        spriteAlertDistance.setFreeFont();
     }
 
-    tft.setFreeFont();
+    // Állapotváltás (vagy téma váltás): csak a paletta cserélődik
+    if (stateChanged) {
+        UIColorPalette::applySpritePalette(spriteAlertInfo, palette, 2, _nightTheme);
+        UIColorPalette::applySpritePalette(spriteAlertDistance, palette, 2, _nightTheme);
+        spriteAlertInfo.pushSprite(0, 0);
+    }
+    if (newAlert) {
+        traffipaxAlert.timeToFirstPixelMicros = micros() - decisionMicros;
+        DEBUG("ScreenMain: traffipax alert time-to-first-pixel: %lu us\n", (unsigned long)traffipaxAlert.timeToFirstPixelMicros);
+    }
+    spriteAlertDistance.pushSprite(spriteAlertInfo.width(), 0);
+
+    if (measureLatency) {
+        latencyProbe.recordSince(LatencyProbe::SPI_PUSH_DONE, rxMicros);
+    }
+
+    traffipaxAlert.shownTraffipax = traffipax;
+    traffipaxAlert.shownState = traffipaxAlert.currentState;
+    traffipaxAlert.shownDistance = intDistance;
 }
 
 /**
- * Intelligens traffipax figyelmeztető rendszer
- * - 800m-en belül: piros sáv + város/utca + távolság
- * - Közeledés esetén: 10mp-enként szirénázás
- * - Megállás esetén: nincs szirénázás, csak a piros sáv
- * - Távolodás esetén: narancssárga sáv, nincs szirénázás
+ * A kijelzett sebesség a szűrt becslésből: az aktuális időpontra előre jelezve, álló helyzet küszöbbel
  *
- * Állapotok:
- * - INACTIVE: Nincs közeli traffipax (> 800m)
- * - APPROACHING: Közeledik (piros háttér + szirénázás)
- * - NEARBY_STOPPED: Megállt közel (piros háttér, nincs szirénázás)
- * - DEPARTING: Távolodik (narancssárga háttér, nincs szirénázás)
+ * A maximum a kijelzett értékből frissül, így a kiírt maximum sosem kisebb a valaha kiírt sebességnél.
+ * Csak a beállt szűrő számít, így a felálláskor egy kiugró fix nem ragad be.
+ */
+double ScreenMain::displaySpeed(const SpeedFilter::Estimate &estimate) {
+    double speed = estimate.predictKmph(millis());
+    speed = speed < SPEED_STANDSTILL_KMPH ? 0.0 : speed;
+    if (estimate.settled && speed > maxSpeedKmph) {
+        maxSpeedKmph = speed;
+    }
+    return speed;
+}
+
+/**
+ * GPS esemény kezelése: a következő loop a friss epocha adataival rajzol
  */
-void ScreenMain::processIntelligentTraffipaxAlert(double currentLat, double currentLon, bool positionValid) {
+void ScreenMain::onGpsEvent(const GpsEvent &event) {
+    if (event.type == GpsEvent::FIX_EPOCH && !demoMode) {
+        gpsEpochPending = true;
+    }
+}
 
-    // Trafipax riasztás stabilizálása: csak tartósan nagy távolság után tűnik el a sprite
-    static unsigned long outOfRangeStart = 0;
+/**
+ * Traffipax riasztás esemény a Core1 kiértékelőtől: a következő loop jeleníti meg
+ */
+void ScreenMain::onTraffipaxAlert(const TraffipaxAlertEvent &event) {
+    pendingAlert = event;
+    alertPending = true;
+}
 
-    // Nincs érvényes GPS pozíció adat - riasztás kikapcsolása ha éppen aktív
-    if (!positionValid) {
-        if (traffipaxAlert.currentState != TraffipaxAlert::INACTIVE) {
-            traffipaxAlert.currentState = TraffipaxAlert::INACTIVE;
+/**
+ * A kiértékelő által küldött riasztási állapot megjelenítése
+ */
+void ScreenMain::applyTraffipaxAlert(const TraffipaxAlertEvent &event) {
+
+    // A riasztás véget ért (vagy ki lett kapcsolva): sáv törlése, a takart widgetek teljes újrarajzolása
+    if (event.state == TraffipaxAlertEvent::INACTIVE || event.traffipax == nullptr) {
+        if (traffiAlarmActive) {
+            traffipaxAlert.currentState = TraffipaxAlertEvent::INACTIVE;
             traffipaxAlert.activeTraffipax = nullptr;
             traffiAlarmActive = false;
             clearTraffipaxAlert();
             this->forceRedraw = true;
             markForRedraw(true);
         }
-        outOfRangeStart = 0;
         return;
     }
 
-    // Legközelebbi trafipax keresése
-    double minDistance = 999999.0;
-    const TraffipaxManager::TraffipaxRecord *closestTraffipax = traffipaxManager.getClosestTraffipax(currentLat, currentLon, minDistance);
-    const unsigned long currentTime = millis();
+    traffiAlarmActive = true;
+    traffipaxAlert.currentState = event.state;
+    traffipaxAlert.activeTraffipax = event.traffipax;
+    traffipaxAlert.currentDistance = event.distance;
+    traffipaxAlert.distanceMillis = event.timestamp;
+    displayTraffipaxAlert(event.traffipax, event.distance, event.rxMicros);
+}
 
-    // Ha nincs közeli traffipax a kritikus távolságon belül
-    if (minDistance > _gpsTraffiAlarmDistance) {
-        // Először jegyezzük fel, mikor kerültünk ki a tartományból
-        if (outOfRangeStart == 0) {
-            outOfRangeStart = currentTime;
-        }
-        // Ha már legalább 3 másodperce kívül vagyunk, akkor kapcsoljuk ki a riasztást
-        if (currentTime - outOfRangeStart > 3000) {
-            if (traffipaxAlert.currentState != TraffipaxAlert::INACTIVE) {
-                traffipaxAlert.currentState = TraffipaxAlert::INACTIVE;
-                traffipaxAlert.activeTraffipax = nullptr;
-                traffiAlarmActive = false;
-                clearTraffipaxAlert();
-                this->forceRedraw = true;
-                markForRedraw(true);
-            }
-            return;
-        } else {
-            // Még nem telt le a stabilizációs idő, a sprite maradjon!
-            if (traffipaxAlert.currentState != TraffipaxAlert::INACTIVE && traffipaxAlert.activeTraffipax) {
-                traffiAlarmActive = true;
-                traffipaxAlert.currentDistance = minDistance;
-                displayTraffipaxAlert(traffipaxAlert.activeTraffipax, minDistance);
-            }
-            return;
-        }
-    } else {
-        // Visszaléptünk a tartományba, nullázzuk az időzítőt
-        outOfRangeStart = 0;
+/**
+ * Kezeli a képernyő saját ciklusát (dinamikus frissítés)
+ *
+ * Itt csak az adatmodell frissül (GPS epochára, vagy watchdog időzítővel), és a megváltozott mezők widgetjei
+ * piszkosnak jelölődnek. A rajzolást a UIScreen multi-rate ütemezője végzi a widgetek saját frissítési rátájával.
+ */
+void ScreenMain::handleOwnLoop() {
+    // Téma váltás (a TftBackLightAdjuster jelzi a Core1-ről): a sprite-oknál csak palettacsere, nem kell kivárni az 1mp-es frissítést
+    bool nightTheme = tftBackLightAdjuster.isNightTheme();
+    if (nightTheme != _nightTheme) {
+        _nightTheme = nightTheme;
+        applySpriteTheme(true);
+    }
+
+    // A Core1 riasztás eseménye azonnal megjelenik, nem vár a következő GPS epochára
+    if (alertPending) {
+        alertPending = false;
+        applyTraffipaxAlert(pendingAlert);
     }
 
-    // Van közeli traffipax - állapot meghatározása
-    bool isApproaching = minDistance < (traffipaxAlert.lastDistance - 10.0);
-    bool isDeparting = minDistance > (traffipaxAlert.lastDistance + 10.0);
+    // Frissítés az új GPS fix epochára; az időzítő csak watchdog (nincs fix, nincs GPS).
+    // Demó módban nincs GPS epocha, az adatok másodpercenként generálódnak.
+    // Kényszerített újrarajzoláskor (visszatérés, riasztás vége) nem várunk.
+    if (!forceRedraw && !gpsEpochPending && !Utils::timeHasPassed(lastUpdate, demoMode ? 1000 : GPS_EPOCH_WATCHDOG_MS)) {
+        return;
+    }
+    gpsEpochPending = false;
+    lastUpdate = millis();
 
-    TraffipaxAlert::State newState = traffipaxAlert.currentState;
-    if (traffipaxAlert.currentState == TraffipaxAlert::INACTIVE) {
-        newState = TraffipaxAlert::APPROACHING;
-    } else if (isApproaching) {
-        newState = TraffipaxAlert::APPROACHING;
-    } else if (isDeparting) {
-        newState = TraffipaxAlert::DEPARTING;
+    // Adatok legyűjtése (demó vagy valós mód szerint)
+    DisplayData data = demoMode ? collectDemoData() : collectRealData();
+
+    // Kényszerített újrarajzoláskor minden widget elölről rajzol, azonnal
+    if (this->forceRedraw) {
+        this->forceRedraw = false;
+        satCountField.invalidate();
+        fixModeField.invalidate();
+        dateField.invalidate();
+        altitudeField.invalidate();
+        hdopField.invalidate();
+        maxSpeedField.invalidate();
+        speedField.invalidate();
+        voltageMeterState.invalidate();
+        temperatureMeterState.invalidate();
+        data.changed = DisplayData::ALL;
+        markAllRefreshDirty();
+    } else {
+        data.changed = data.changedFrom(lastData);
     }
+    lastData = data;
 
-    if (newState != traffipaxAlert.currentState) {
-        traffipaxAlert.currentState = newState;
-        traffipaxAlert.lastStateChange = currentTime;
-        traffipaxAlert.activeTraffipax = closestTraffipax;
+    // A megváltozott mezők widgetjei a saját frissítési rátájukkal rajzolódnak
+    pendingChanged |= data.changed;
+    if (pendingChanged & HEADER_FIELDS) {
+        markRefreshDirty(headerRefreshTask);
+    }
+    if (pendingChanged & INFO_FIELDS) {
+        markRefreshDirty(infoRefreshTask);
     }
+    if (pendingChanged & METER_FIELDS) {
+        markRefreshDirty(metersRefreshTask);
+    }
+}
 
-    // Figyelmeztető sáv megjelenítése minden ciklusban, amíg aktív
-    traffiAlarmActive = true;
-    traffipaxAlert.currentDistance = minDistance;
-    displayTraffipaxAlert(closestTraffipax, minDistance);
-
-    // Szirénázás csak közeledés esetén, 10mp-enként, ha engedélyezve van
-    if (_isGpsTraffiSirenAlarmEnabled) {
-        if (traffipaxAlert.currentState == TraffipaxAlert::APPROACHING) {
-            if (currentTime - traffipaxAlert.lastSirenTime >= TraffipaxAlert::SIREN_INTERVAL) {
-                Utils::startNonBlockingSiren(2, 600, 1800, 40, 4, 100);
-                traffipaxAlert.lastSirenTime = currentTime;
-            }
+/**
+ * Widget frissítő feladatok regisztrálása a UIScreen ütemezőjébe
+ *
+ * - gyors sáv (10 Hz): sebesség, traffipax távolság - a fixek között előre jelezve
+ * - lassú sáv: óra és fejléc 1 Hz, magasság/HDOP/max sebesség 0.5 Hz, mérők 0.2 Hz
+ */
+void ScreenMain::registerRefreshTasks() {
+    addRefreshTask(RefreshLane::Fast, SPEED_DISPLAY_INTERVAL_MS, [this]() { refreshSpeed(); }, true);
+    addRefreshTask(RefreshLane::Fast, SPEED_DISPLAY_INTERVAL_MS, [this]() { refreshAlertDistance(); }, true);
+    headerRefreshTask = addRefreshTask(RefreshLane::Slow, 1000, [this]() { refreshHeader(); });
+    infoRefreshTask = addRefreshTask(RefreshLane::Slow, 2000, [this]() { refreshInfo(); });
+    metersRefreshTask = addRefreshTask(RefreshLane::Slow, 5000, [this]() { refreshMeters(); });
+}
+
+/**
+ * Aktuális sebesség: a szűrő predikciójából (demó módban a generált értékből)
+ */
+void ScreenMain::refreshSpeed() {
+    double speed = -1.0; // érvénytelen: piros 0
+    if (demoMode) {
+        if (lastData.speedValid) {
+            speed = lastData.currentSpeed;
+        }
+    } else {
+        SpeedFilter::Estimate speedEstimate = gpsManager->getSpeedEstimate();
+        if (speedEstimate.valid && millis() - speedEstimate.epochMillis < GPS_DATA_MAX_AGE) {
+            speed = displaySpeed(speedEstimate);
         }
     }
+    speedField.update(speed);
 
-    // Távolság frissítése - csak 5m+ változásnál
-    if (abs(minDistance - traffipaxAlert.lastDistance) >= 5.0) {
-        traffipaxAlert.lastDistance = minDistance;
+    // A maximum a predikcióval együtt nő, nem várja ki a lassú sávot (a riasztó sáv alatt a végi újrarajzolás hozza)
+    if (!demoMode && maxSpeedKmph > lastData.maxSpeed) {
+        lastData.maxSpeed = maxSpeedKmph;
+        if (!traffiAlarmActive) {
+            maxSpeedField.update(maxSpeedKmph);
+        }
     }
 }
 
 /**
- * Kezeli a képernyő saját ciklusát (dinamikus frissítés)
+ * Traffipax távolság a fixek között: közeledéskor a szűrt sebességgel előre jelezve
  */
-
-void ScreenMain::handleOwnLoop() {
-    // 1 másodperces frissítés
-    if (!Utils::timeHasPassed(lastUpdate, 1000)) {
+void ScreenMain::refreshAlertDistance() {
+    if (demoMode || !traffiAlarmActive || traffipaxAlert.currentState != TraffipaxAlertEvent::APPROACHING || traffipaxAlert.shownTraffipax == nullptr) {
         return;
     }
-    lastUpdate = millis();
 
-    // Adatok legyűjtése (demó vagy valós mód szerint)
-    DisplayData data = demoMode ? collectDemoData() : collectRealData();
+    SpeedFilter::Estimate speedEstimate = gpsManager->getSpeedEstimate();
+    if (!speedEstimate.valid) {
+        return;
+    }
 
-    // Demó logika kiszervezése
-    if (demoMode) {
-        handleDemoMode(data);
+    uint32_t elapsedMs = millis() - traffipaxAlert.distanceMillis;
+    if (elapsedMs > ALERT_DISTANCE_MAX_EXTRAPOLATION_MS) {
+        elapsedMs = ALERT_DISTANCE_MAX_EXTRAPOLATION_MS;
     }
+    double distance = traffipaxAlert.currentDistance - speedEstimate.speedKmph / 3.6 * elapsedMs / 1000.0;
+    displayTraffipaxAlert(traffipaxAlert.shownTraffipax, distance < 0.0 ? 0.0 : distance);
+}
 
-    // Trafipax figyelmeztetés feldolgozása, ha engedélyezve van
-    if (_isTraffiAlarmEnabled) {
-        processIntelligentTraffipaxAlert(data.latitude, data.longitude, data.positionValid);
+/**
+ * Fejléc: műholdak, GPS mód, dátum, idő
+ */
+void ScreenMain::refreshHeader() {
+    // A riasztó sáv takarja, a riasztás végén teljes újrarajzolás jön
+    if (this->traffiAlarmActive) {
+        return;
     }
 
-    // Általános buffer a megjelenítéshez
-    char buf[11];
+    if (pendingChanged & DisplayData::SATELLITES) {
+        satCountField.update(lastData.satelliteCount);
+    }
+    if (pendingChanged & DisplayData::FIX_MODE) {
+        fixModeField.update(lastData.fixMode);
+    }
+    if (pendingChanged & DisplayData::DATE) {
+        dateField.update(lastData.dateString);
+    }
 
-    // Ha nincs traffipax riasztás, akkor mehet a felső részek rajzolása is
-    if (!this->traffiAlarmActive) {
+    // Idő: csak az idő legyen egy kis sprite-on, hogy ne töröljön semmit a fejlécben
+    if (pendingChanged & DisplayData::TIME) {
+        drawTime(lastData.timeString);
+    }
 
-        // Műholdak száma + GPS működési mód
-        if (this->forceRedraw) {
-            lastSatCount = 255;
-            lastGpsMode = "";
-        }
-        // Műholdak száma
-        UIScreen::updateUIValue<uint8_t>(
-            lastSatCount, data.satelliteCount,
-            [&]() {
-                tft.setTextDatum(ML_DATUM);
-                tft.setTextColor(TFT_WHITE, TFT_BLACK);
-                tft.setFreeFont();
-                tft.setTextSize(2);
-                tft.setTextPadding(tft.textWidth("88") + 10);
-                snprintf(valueBuffer, sizeof(valueBuffer), "%u", data.satelliteCount);
-                tft.drawString(valueBuffer, 30, 15, 2);
-                tft.setFreeFont();
-            },
-            0, this->forceRedraw);
-
-        // GPS működési mód
-        UIScreen::updateUIValue<String>(
-            lastGpsMode, data.gpsMode,
-            [&]() {
-                tft.setTextDatum(ML_DATUM);
-                tft.setTextColor(TFT_WHITE, TFT_BLACK);
-                tft.setFreeFont();
-                tft.setTextSize(1);
-                uint16_t fgcolor = gpsManager->getLocation().FixMode() == TinyGPSLocation::N ? TFT_ORANGE : TFT_GREEN;
-                tft.setTextColor(fgcolor, TFT_BLACK);
-                tft.setTextPadding(tft.textWidth("Differential"));
-                tft.drawString(data.gpsMode, 65, 15, 1);
-                tft.setFreeFont();
-            },
-            0, this->forceRedraw);
-
-        // Dátum és idő
-        snprintf(valueBuffer, sizeof(valueBuffer), "%s%s", data.dateString.c_str(), data.timeString.c_str());
-        UIScreen::updateUIValue<String>(
-            lastDateTime, String(valueBuffer),
-            [&]() {
-                // Dátum
-                tft.setTextSize(2);
-                tft.setFreeFont();
-                tft.setTextDatum(ML_DATUM);
-                tft.setTextColor(TFT_WHITE, TFT_BLACK);
-                tft.setTextPadding(tft.textWidth("8888-88-88") + 10);
-                tft.drawString(data.dateString, ::SCREEN_W / 2 - 50, 12, 1);
-                // Idő: csak az idő legyen egy kis sprite-on, hogy ne töröljön semmit a fejlécben
-                tft.setFreeFont(&FreeSansBold18pt7b);
-                tft.setTextSize(1);
-
-// Idő sprite pozíciója: bal középre, 50px magasságban
-#define TIME_SPRITE_Y 50
-
-                spriteTime.fillSprite(TFT_BLACK);
-
-                // Megszerezzük az idő szöveg szélességét (fix formátum: "88:88:88")
-                spriteTime.setFreeFont(&FreeSansBold24pt7b);
-                spriteTime.setTextSize(1);
-                spriteTime.setTextDatum(ML_DATUM);
-                spriteTime.setTextPadding(0);
-                const int timeTextW = tft.textWidth("88:88:88") + 60; // szélesség + padding
-                const int timeTextH = 40;                             // elegendő magasság a fontnak
-
-                if (!spriteTime.created()) {
-                    spriteTime.createSprite(timeTextW, timeTextH);
-                }
-
-                // Rajzolás sprite-on belül: bal középre
-                spriteTime.drawString(data.timeString, 0, timeTextH / 2);
-                spriteTime.setFreeFont();
-
-                // Idő pozícionálása a képernyőn: középre és 50px magasságban
-                const int pushX = ::SCREEN_W / 2 - 70 - 30;
-                const int pushY = TIME_SPRITE_Y - (timeTextH / 2);
-                spriteTime.pushSprite(pushX, pushY);
-            },
-            0, this->forceRedraw);
-
-        // Magasság
-        UIScreen::updateUIValue<double>(
-            lastAltitude, data.altitudeValid ? data.altitude : -9999.0,
-            [&]() {
-                tft.setTextDatum(ML_DATUM);
-                tft.setTextColor(TFT_WHITE, TFT_BLACK);
-                tft.setFreeFont();
-                tft.setTextSize(2);
-                int paddingWidth = tft.textWidth("8888", 2) + 10;
-                tft.setTextPadding(paddingWidth);
-                if (data.altitudeValid) {
-                    snprintf(valueBuffer, sizeof(valueBuffer), "%d", (int)data.altitude);
-                } else {
-                    strcpy(valueBuffer, "-- ");
-                }
-                tft.drawString(valueBuffer, ::SCREEN_W - 90, 13, 2);
-            },
-            1.0, this->forceRedraw);
-
-        // GPS HDOP
-        UIScreen::updateUIValue<double>(
-            lastHdop, data.hdopValid ? data.hdop : -1.0,
-            [&]() {
-                tft.setTextDatum(ML_DATUM);
-                tft.setTextColor(TFT_WHITE, TFT_BLACK);
-                tft.setFreeFont();
-                tft.setTextSize(2);
-                tft.setTextPadding(tft.textWidth("88.88") + 15);
-                if (data.hdopValid) {
-                    dtostrf(data.hdop, 0, 2, valueBuffer);
-                    tft.drawString(valueBuffer, 35, 63, 2);
-                } else {
-                    tft.drawString("--", 35, 63, 2);
-                }
-                tft.setFreeFont();
-            },
-            0.1, this->forceRedraw);
-
-        // Maximum sebesség
-        UIScreen::updateUIValue<double>(
-            lastMaxSpeed, data.maxSpeed,
-            [&]() {
-                tft.setTextDatum(ML_DATUM);
-                tft.setTextColor(TFT_WHITE, TFT_BLACK);
-                tft.setFreeFont();
-                tft.setTextSize(2);
-                tft.setTextPadding(tft.textWidth("888") + 10);
-                // Ha a maxSpeed > 0, kiírjuk, egyébként "--"
-                if (data.maxSpeed > 0) {
-                    snprintf(valueBuffer, sizeof(valueBuffer), "%d", (int)data.maxSpeed);
-                } else {
-                    strcpy(valueBuffer, "--");
-                }
-                tft.drawString(valueBuffer, ::SCREEN_W - 90, 60, 2);
-                tft.setFreeFont();
-            },
-            0.1, this->forceRedraw);
-    }
-
-    // Aktuális sebesség
-    UIScreen::updateUIValue<double>(
-        lastSpeed, data.speedValid ? data.currentSpeed : -1.0,
-        [&]() {
-            tft.loadFont(Arial_Narrow_Bold120);
-            tft.setTextDatum(MC_DATUM);
-            tft.setTextPadding(tft.textWidth("888") + 10);
-            dtostrf(data.speedValid ? data.currentSpeed : 0, 0, 0, buf);
-            tft.setTextColor(data.speedValid ? TFT_WHITE : TFT_RED, TFT_BLACK);
-            tft.drawString(buf, ::SCREEN_W / 2 - 11, 240);
-            tft.unloadFont();
-        },
-        0.1, this->forceRedraw);
+    pendingChanged &= ~HEADER_FIELDS;
+}
 
-    // -- Vertikális bar komponensek  ------------------------------------
-    if (lastVerticalLinearSpriteUpdate != 0 && !Utils::timeHasPassed(lastVerticalLinearSpriteUpdate, 5000)) {
+/**
+ * Magasság, HDOP, maximum sebesség
+ */
+void ScreenMain::refreshInfo() {
+    // A riasztó sáv takarja, a riasztás végén teljes újrarajzolás jön
+    if (this->traffiAlarmActive) {
         return;
     }
-    lastVerticalLinearSpriteUpdate = millis();
 
-    // Sprite legyártása, ha még nem létezik
-    if (!spriteVerticalLinearMeter.created()) {
-        spriteVerticalLinearMeter.createSprite(SPRITE_VERTICAL_LINEAR_METER_WIDTH, SPRITE_VERTICAL_LINEAR_METER_HEIGHT);
+    if (pendingChanged & DisplayData::ALTITUDE) {
+        altitudeField.update(lastData.altitudeValid ? lastData.altitude : -9999.0);
+    }
+    if (pendingChanged & DisplayData::HDOP) {
+        hdopField.update(lastData.hdopValid ? lastData.hdop : -1.0);
+    }
+    if (pendingChanged & DisplayData::MAX_SPEED) {
+        maxSpeedField.update(lastData.maxSpeed);
     }
 
-#define VERTICAL_LINEAR_METER_BAR_Y 250
+    pendingChanged &= ~INFO_FIELDS;
+}
+
+/**
+ * Vertikális mérők: csak a megváltozott sávok és számjegyek rajzolódnak újra
+ */
+void ScreenMain::refreshMeters() {
+
     // Vertical Line bar - Battery (sprite-os)
-    verticalLinearMeter(&spriteVerticalLinearMeter, SPRITE_VERTICAL_LINEAR_METER_HEIGHT, SPRITE_VERTICAL_LINEAR_METER_WIDTH,
+    verticalLinearMeter(&spriteVoltageMeter, voltageMeterState, SPRITE_VERTICAL_LINEAR_METER_HEIGHT, SPRITE_VERTICAL_LINEAR_METER_WIDTH,
                         _isExternalVoltageMode ? "Vbus [V]" : "Vsys [V]",               // Feszmérő mód: true = VBus, false = VSys
-                        data.voltage,                                                   // value
+                        lastData.voltage,                                               // value
                         _isExternalVoltageMode ? VBUS_BARMETER_MIN : VSYS_BARMETER_MIN, // minVal
                         _isExternalVoltageMode ? VBUS_BARMETER_MAX : VSYS_BARMETER_MAX, // maxVal
                         0,                                                              // x
@@ -924,13 +1105,12 @@ void ScreenMain::handleOwnLoop() {
                         30,                                                             // bar-w
                         10,                                                             // bar-h
                         2,                                                              // gap
-                        10,                                                             // n
-                        RED2GREEN);                                                     // color
+                        VERTICAL_LINEAR_METER_SEGMENTS);                                // n (színek: VOLTAGE_METER_COLORS)
 
     // Vertical Line bar - Temperature
-    verticalLinearMeter(&spriteVerticalLinearMeter, SPRITE_VERTICAL_LINEAR_METER_HEIGHT, SPRITE_VERTICAL_LINEAR_METER_WIDTH,
+    verticalLinearMeter(&spriteTemperatureMeter, temperatureMeterState, SPRITE_VERTICAL_LINEAR_METER_HEIGHT, SPRITE_VERTICAL_LINEAR_METER_WIDTH,
                         _isExternalTemperatureMode ? "Ext [C]" : "CPU [C]", // category
-                        data.temperature,                                   // value
+                        lastData.temperature,                               // value
                         TEMP_BARMETER_MIN,                                  // minVal
                         TEMP_BARMETER_MAX,                                  // maxVal
                         tft.width() - SPRITE_VERTICAL_LINEAR_METER_WIDTH,   // x: sprite szélesség beszámítva
@@ -938,45 +1118,10 @@ void ScreenMain::handleOwnLoop() {
                         30,                                                 // bar-w
                         10,                                                 // bar-h
                         2,                                                  // gap
-                        10,                                                 // n
-                        BLUE2RED,                                           // color
+                        VERTICAL_LINEAR_METER_SEGMENTS,                     // n (színek: TEMPERATURE_METER_COLORS)
                         true);                                              // bal oldalt legyenek az értékek
 
-    // Ha kényszerített újrarajzolás volt, akkor reseteljük a flag-et
-    if (this->forceRedraw) {
-        this->forceRedraw = false;
-    }
-}
-
-/**
- * Demó logika kiszervezése
- */
-void ScreenMain::handleDemoMode(DisplayData &data) {
-    bool isTraffipaxManagerDemoActive = traffipaxManager.isDemoActive();
-
-    // Ha a demó aktív volt és most nem az, rögzítjük a befejezési időt.
-    if (wasDemoActive && !isTraffipaxManagerDemoActive) {
-        lastDemoEndTime = millis();
-        DEBUG("Traffi Demo Fázis: 2 perc várakozás\n");
-    }
-    wasDemoActive = isTraffipaxManagerDemoActive;
-
-    // Ha a demó nem aktív:
-    if (!isTraffipaxManagerDemoActive) {
-        // Ha ez az első futás (lastDemoEndTime 0 és wasDemoActive kezdetben hamis)
-        // VAGY ha a várakozási időszak letelt az utolsó demó befejezése óta.
-        if (lastDemoEndTime == 0 || Utils::timeHasPassed(lastDemoEndTime, 2 * 60 * 1000)) {
-            traffipaxManager.startDemo();
-            lastDemoEndTime = 0; // Visszaállítás a következő várakozási időszakra
-        }
-    }
-
-    // Ha a demó aktív, dolgozzuk fel.
-    if (isTraffipaxManagerDemoActive) {
-        traffipaxManager.processDemo();
-        traffipaxManager.getDemoCoords(data.latitude, data.longitude);
-        data.positionValid = true;
-    }
+    pendingChanged &= ~METER_FIELDS;
 }
 
 /**
@@ -997,7 +1142,7 @@ bool ScreenMain::handleTouch(const TouchEvent &event) {
     if (event.x >= satIconX && event.x < satIconX + satIconWidth && event.y >= satIconY && event.y < satIconY + satIconHeight) {
 
         // Átkapcsolás a műhold képernyőre
-        getScreenManager()->switchToScreen(SCREEN_NAME_SATS);
+        getScreenManager()->switchToScreen(ScreenId::Sats);
 
         // Pittyentünk, ha az engedélyezve van
         if (_isBeeperEnabled) {
@@ -0,0 +1,198 @@
+#include <TinyGPS++.h>
+
+#include "SpeedFilter.h"
+
+// Folyamat zaj: a rángás (jerk) spektrális sűrűsége, (m/s^3)^2 / Hz
+constexpr float PROCESS_JERK_NOISE = 1.0f;
+
+// Mérési zaj HDOP = 1 mellett: Doppler sebesség (m/s) és pozíció (m)
+constexpr float SPEED_SIGMA_MPS = 0.3f;
+constexpr float POSITION_SIGMA_M = 2.5f;
+
+// Kiugró értékek szűrése
+constexpr float MAX_HDOP = 5.0f;           // Ennél rosszabb geometria esetén csak predikció
+constexpr float MAX_ACCEL_MPS2 = 8.0f;     // ~0.8 g, ennél nagyobb sebességváltozás fizikailag nem valószínű
+constexpr float INNOVATION_GATE = 3.0f;    // 3 szigma kapu az innovációra
+constexpr uint8_t MAX_REJECTED_IN_ROW = 3; // Ennyi egymás utáni eldobás után a mérésnek hiszünk (pl. alagút után)
+
+// A pozícióból számolt sebességet csak ekkora sebesség felett használjuk (alatta a course megbízhatatlan)
+constexpr float MIN_SPEED_FOR_POSITION_MPS = 2.0f;
+
+// Ennél hosszabb kiesés után a szűrő újraindul
+constexpr float MAX_EPOCH_GAP_SEC = 3.0f;
+
+// Beállt a szűrő: ennyi elfogadott mérés az újraindítás óta
+constexpr uint8_t SETTLED_ACCEPTED_COUNT = 3;
+
+// A UI legfeljebb ennyi ideig extrapolál a gyorsulással, utána tartja az értéket
+constexpr float MAX_EXTRAPOLATION_SEC = 1.2f;
+
+constexpr float MPS_TO_KMPH = 3.6f;
+constexpr uint32_t DAY_MILLIS = 24UL * 60 * 60 * 1000;
+
+/**
+ * Előre jelzett sebesség egy adott időpontra
+ */
+float SpeedFilter::Estimate::predictKmph(uint32_t nowMillis) const {
+    float dt = (nowMillis - epochMillis) / 1000.0f;
+    if (dt > MAX_EXTRAPOLATION_SEC) {
+        dt = MAX_EXTRAPOLATION_SEC;
+    }
+    float speed = speedKmph + accelKmphPerSec * dt;
+    return speed < 0.0f ? 0.0f : speed;
+}
+
+/**
+ * Szűrő újraindítása
+ */
+void SpeedFilter::reset(float speedMps, float variance) {
+    v = speedMps;
+    a = 0.0f;
+    p00 = variance;
+    p01 = 0.0f;
+    p11 = MAX_ACCEL_MPS2 * MAX_ACCEL_MPS2 / 4.0f;
+    initialized = true;
+    acceptedCount = 1;
+    rejectedInRow = 0;
+}
+
+/**
+ * Predikció: x = F x, P = F P F' + Q (F = [[1, dt], [0, 1]])
+ */
+void SpeedFilter::predict(float dt) {
+    v += a * dt;
+
+    const float dt2 = dt * dt;
+    p00 += 2.0f * dt * p01 + dt2 * p11 + PROCESS_JERK_NOISE * dt2 * dt / 3.0f;
+    p01 += dt * p11 + PROCESS_JERK_NOISE * dt2 / 2.0f;
+    p11 += PROCESS_JERK_NOISE * dt;
+}
+
+/**
+ * Sebesség mérés beépítése (H = [1, 0])
+ */
+bool SpeedFilter::correct(float z, float variance, float speedBefore, float dt) {
+
+    // Fizikai határ: az előző becsléshez képest elérhetetlen gyorsulás
+    if (fabsf(z - speedBefore) > MAX_ACCEL_MPS2 * dt) {
+        return false;
+    }
+
+    // Innováció kapu
+    const float y = z - v;
+    const float s = p00 + variance;
+    if (y * y > INNOVATION_GATE * INNOVATION_GATE * s) {
+        return false;
+    }
+
+    const float k0 = p00 / s;
+    const float k1 = p01 / s;
+    v += k0 * y;
+    a += k1 * y;
+
+    p11 -= k1 * p01;
+    p01 *= 1.0f - k0;
+    p00 *= 1.0f - k0;
+    return true;
+}
+
+/**
+ * Szűrő frissítése egy új fix epochával
+ */
+void SpeedFilter::update(const Measurement &m, uint32_t epochMillis) {
+
+    // Rossz geometria vagy nincs sebesség: nem frissítünk, a korábbi becslés elöregszik
+    if (!m.speedValid || (m.hdopValid && m.hdop > MAX_HDOP)) {
+        publish(lastEpochMillis, initialized && (epochMillis - lastEpochMillis) < MAX_EPOCH_GAP_SEC * 1000);
+        return;
+    }
+
+    const float hdop = m.hdopValid && m.hdop > 1.0f ? m.hdop : 1.0f;
+    const float speedVariance = (SPEED_SIGMA_MPS * hdop) * (SPEED_SIGMA_MPS * hdop);
+
+    // Epochák közti idő a GPS órából (éjféli átfordulással)
+    float dt = 0.0f;
+    if (initialized) {
+        uint32_t gpsDelta = m.gpsTimeMillis >= lastGpsTimeMillis ? m.gpsTimeMillis - lastGpsTimeMillis : m.gpsTimeMillis + DAY_MILLIS - lastGpsTimeMillis;
+        dt = gpsDelta / 1000.0f;
+    }
+
+    bool accepted = true;
+    if (!initialized || dt <= 0.0f || dt > MAX_EPOCH_GAP_SEC) {
+        reset(m.speedMps, speedVariance);
+    } else {
+        const float speedBefore = v;
+        predict(dt);
+
+        // 1. Doppler sebesség
+        accepted = correct(m.speedMps, speedVariance, speedBefore, dt);
+
+        // 2. Az elmozdulás haladási irányra vetített sebessége
+        if (accepted && m.positionValid && lastPositionValid && m.courseValid && v > MIN_SPEED_FOR_POSITION_MPS) {
+            const double distance = TinyGPSPlus::distanceBetween(lastLat, lastLng, m.lat, m.lng);
+            const double bearing = TinyGPSPlus::courseTo(lastLat, lastLng, m.lat, m.lng);
+            const float alongTrack = distance * cos(radians(bearing - m.courseDeg)) / dt;
+            const float positionSigma = POSITION_SIGMA_M * hdop;
+            correct(alongTrack, 2.0f * positionSigma * positionSigma / (dt * dt), speedBefore, dt);
+        }
+
+        if (accepted) {
+            rejectedInRow = 0;
+            if (acceptedCount < SETTLED_ACCEPTED_COUNT) {
+                acceptedCount++;
+            }
+        } else if (++rejectedInRow >= MAX_REJECTED_IN_ROW) {
+            // Tartósan eltérő mérések: valós ugrás (pl. kiesés utáni fix), újraindulunk a mérésből
+            reset(m.speedMps, speedVariance);
+            accepted = true;
+        }
+    }
+
+    // Álló helyzetben a szűrő sem mehet negatívba
+    if (v < 0.0f) {
+        v = 0.0f;
+        if (a < 0.0f) {
+            a = 0.0f;
+        }
+    }
+
+    lastGpsTimeMillis = m.gpsTimeMillis;
+    lastPositionValid = m.positionValid;
+    lastLat = m.lat;
+    lastLng = m.lng;
+    lastEpochMillis = epochMillis;
+
+    publish(epochMillis, true);
+}
+
+/**
+ * Becslés publikálása (seqlock író oldal, csak a Core1 hívja)
+ */
+void SpeedFilter::publish(uint32_t epochMillis, bool valid) {
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    published.speedKmph = v * MPS_TO_KMPH;
+    published.accelKmphPerSec = a * MPS_TO_KMPH;
+    published.epochMillis = epochMillis;
+    published.valid = valid;
+    published.settled = valid && acceptedCount >= SETTLED_ACCEPTED_COUNT;
+
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+/**
+ * A legutóbb publikált becslés (seqlock olvasó oldal, a Core0 hívja)
+ */
+SpeedFilter::Estimate SpeedFilter::getEstimate() const {
+    Estimate estimate;
+    uint32_t seqBefore, seqAfter;
+    do {
+        seqBefore = sequence.load(std::memory_order_acquire);
+        estimate = published;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seqAfter = sequence.load(std::memory_order_relaxed);
+    } while ((seqBefore & 1) || seqBefore != seqAfter);
+    return estimate;
+}
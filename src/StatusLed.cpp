@@ -0,0 +1,164 @@
+#include "StatusLed.h"
+#include "defines.h"
+
+#include <hardware/clocks.h>
+
+// WS2812 PIO program (a pico-examples ws2812.pio programja, pioasm kimenet)
+//
+//  .program ws2812
+//  .side_set 1
+//  .define public T1 2
+//  .define public T2 5
+//  .define public T3 3
+//  .wrap_target
+//  bitloop:
+//      out x, 1       side 0 [T3 - 1] ; Az előző bit vége / alacsony szakasz
+//      jmp !x do_zero side 1 [T1 - 1] ; Minden bit magas szinttel indul
+//  do_one:
+//      jmp  bitloop   side 1 [T2 - 1] ; '1': hosszú magas
+//  do_zero:
+//      nop            side 0 [T2 - 1] ; '0': rövid magas
+//  .wrap
+//
+static const uint16_t WS2812_PROGRAM_INSTRUCTIONS[] = {
+    0x6221, //  0: out    x, 1            side 0 [2]
+    0x1123, //  1: jmp    !x, 3           side 1 [1]
+    0x1400, //  2: jmp    0               side 1 [4]
+    0xa442, //  3: nop                    side 0 [4]
+};
+static const pio_program_t WS2812_PROGRAM = {
+    .instructions = WS2812_PROGRAM_INSTRUCTIONS,
+    .length = 4,
+    .origin = -1,
+};
+constexpr uint8_t WS2812_WRAP_TARGET = 0;
+constexpr uint8_t WS2812_WRAP = 3;
+constexpr uint8_t WS2812_CYCLES_PER_BIT = 2 + 5 + 3; // T1 + T2 + T3
+constexpr uint32_t WS2812_FREQ = 800000;
+
+// Színek (0xRRGGBB)
+constexpr uint32_t COLOR_BLACK = 0x000000;
+constexpr uint32_t COLOR_RED = 0xFF0000;
+constexpr uint32_t COLOR_GREEN = 0x00FF00;
+constexpr uint32_t COLOR_CYAN = 0x00FFFF;
+constexpr uint32_t COLOR_YELLOW = 0xFFFF00;
+
+// Minta táblák
+static const StatusLed::Step OFF_STEPS[] = {{COLOR_BLACK, 250}};
+static const StatusLed::Step NO_FIX_STEPS[] = {{COLOR_RED, 100}, {COLOR_BLACK, 1900}};
+static const StatusLed::Step FIX_AUTO_STEPS[] = {{COLOR_GREEN, 100}, {COLOR_BLACK, 900}};
+static const StatusLed::Step FIX_DIFFERENTIAL_STEPS[] = {{COLOR_CYAN, 100}, {COLOR_BLACK, 900}};
+static const StatusLed::Step FIX_ESTIMATED_STEPS[] = {{COLOR_YELLOW, 100}, {COLOR_BLACK, 900}};
+
+// Hibakód: villanásonként egy be- és egy kikapcsolt lépés, a végén hosszú szünet
+constexpr uint16_t ERROR_BLINK_MS = 200;
+constexpr uint16_t ERROR_PAUSE_MS = 1500;
+
+/**
+ * PIO program betöltése, állapotgép és alarm indítása
+ */
+void StatusLed::begin() {
+    pio = pio0;
+    if (!pio_can_add_program(pio, &WS2812_PROGRAM)) {
+        pio = pio1;
+    }
+    uint offset = pio_add_program(pio, &WS2812_PROGRAM);
+    sm = pio_claim_unused_sm(pio, true);
+
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+
+    pio_sm_config smConfig = pio_get_default_sm_config();
+    sm_config_set_wrap(&smConfig, offset + WS2812_WRAP_TARGET, offset + WS2812_WRAP);
+    sm_config_set_sideset(&smConfig, 1, false, false);
+    sm_config_set_sideset_pins(&smConfig, pin);
+    sm_config_set_out_shift(&smConfig, false, true, 24); // MSB először, 24 bitenként automatikus pull
+    sm_config_set_fifo_join(&smConfig, PIO_FIFO_JOIN_TX);
+    sm_config_set_clkdiv(&smConfig, (float)clock_get_hz(clk_sys) / (WS2812_FREQ * WS2812_CYCLES_PER_BIT));
+    pio_sm_init(pio, sm, offset, &smConfig);
+    pio_sm_set_enabled(pio, sm, true);
+
+    show(COLOR_BLACK);
+
+    // Az alarm a hívó mag (Core0) alarm pool-jában fut, a visszatérési érték ütemezi újra
+    add_alarm_in_ms(OFF_STEPS[0].durationMs, onAlarm, this, true);
+}
+
+/**
+ * Az alarm megszakítás
+ */
+int64_t StatusLed::onAlarm(alarm_id_t id, void *userData) {
+    StatusLed *led = static_cast<StatusLed *>(userData);
+    Step step = led->nextStep();
+    led->show(step.rgb);
+    return -(int64_t)step.durationMs * 1000; // Negatív: az előző alarm időpontjához képest (nincs elcsúszás)
+}
+
+/**
+ * A minta következő lépése
+ */
+StatusLed::Step StatusLed::nextStep() {
+    // Minta váltás: elölről kezdjük
+    uint16_t requested = request.load(std::memory_order_relaxed);
+    if (requested != current) {
+        current = requested;
+        stepIndex = 0;
+    }
+
+    const Pattern pattern = static_cast<Pattern>(current & 0xFF);
+    const Step *steps;
+    uint8_t count;
+    switch (pattern) {
+        case Pattern::NoFix:
+            steps = NO_FIX_STEPS;
+            count = ARRAY_ITEM_COUNT(NO_FIX_STEPS);
+            break;
+        case Pattern::FixAuto:
+            steps = FIX_AUTO_STEPS;
+            count = ARRAY_ITEM_COUNT(FIX_AUTO_STEPS);
+            break;
+        case Pattern::FixDifferential:
+            steps = FIX_DIFFERENTIAL_STEPS;
+            count = ARRAY_ITEM_COUNT(FIX_DIFFERENTIAL_STEPS);
+            break;
+        case Pattern::FixEstimated:
+            steps = FIX_ESTIMATED_STEPS;
+            count = ARRAY_ITEM_COUNT(FIX_ESTIMATED_STEPS);
+            break;
+        case Pattern::ErrorCode: {
+            // A lépések számolva: 2 * hibakód villogó lépés, majd a szünet
+            const uint8_t blinkSteps = 2 * (current >> 8);
+            uint8_t index = stepIndex;
+            stepIndex = (stepIndex + 1) % (blinkSteps + 1);
+            if (index == blinkSteps) {
+                return {COLOR_BLACK, ERROR_PAUSE_MS};
+            }
+            return {(index & 1) ? COLOR_BLACK : COLOR_RED, ERROR_BLINK_MS};
+        }
+        default:
+            steps = OFF_STEPS;
+            count = ARRAY_ITEM_COUNT(OFF_STEPS);
+            break;
+    }
+
+    const Step &step = steps[stepIndex % count];
+    stepIndex = (stepIndex + 1) % count;
+    return step;
+}
+
+/**
+ * Egy szín kiküldése a LED-re
+ */
+void StatusLed::show(uint32_t rgb) {
+    if (rgb == shownRgb) {
+        return;
+    }
+    shownRgb = rgb;
+
+    uint32_t r = ((rgb >> 16) & 0xFF) * BRIGHTNESS / 255;
+    uint32_t g = ((rgb >> 8) & 0xFF) * BRIGHTNESS / 255;
+    uint32_t b = (rgb & 0xFF) * BRIGHTNESS / 255;
+
+    // A WS2812 GRB sorrendben, MSB-vel kezdve várja a 24 bitet; a FIFO szó felső 24 bitje megy ki
+    pio_sm_put(pio, sm, ((g << 16) | (r << 8) | b) << 8);
+}
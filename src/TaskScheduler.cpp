@@ -0,0 +1,160 @@
+#include "TaskScheduler.h"
+#include "defines.h"
+
+/**
+ * Periodikus feladat regisztrálása
+ */
+uint8_t TaskScheduler::addPeriodicTask(const char *name, uint32_t periodMs, TaskFunction function) { return addTask(name, periodMs, function); }
+
+/**
+ * Esemény feladat regisztrálása
+ */
+uint8_t TaskScheduler::addEventTask(const char *name, TaskFunction function) { return addTask(name, 0, function); }
+
+/**
+ * Feladat felvétele a táblába
+ */
+uint8_t TaskScheduler::addTask(const char *name, uint32_t periodMs, TaskFunction function) {
+    if (taskCount >= MAX_TASKS) {
+        DEBUG("TaskScheduler[%s]: task table full, '%s' not added\n", this->name, name);
+        return INVALID_TASK;
+    }
+
+    Task &task = tasks[taskCount];
+    task.function = function;
+    task.stats.name = name;
+    task.stats.periodMs = periodMs;
+    task.nextRunMicros = nowMicros() + (uint64_t)periodMs * 1000;
+    return taskCount++;
+}
+
+/**
+ * A feladat futtatásának kérése a következő körben
+ */
+void TaskScheduler::signal(uint8_t taskId) {
+    if (taskId >= taskCount) {
+        return;
+    }
+    tasks[taskId].signalled.store(true, std::memory_order_release);
+
+    // Ha az ütemező magja épp __wfe-ben alszik, felébresztjük
+    __sev();
+}
+
+/**
+ * Az esedékes feladatok futtatása, majd alvás a következő határidőig
+ */
+void TaskScheduler::run() {
+    uint64_t now = nowMicros();
+
+    if (resetRequested) {
+        resetRequested = false;
+        for (uint8_t i = 0; i < taskCount; i++) {
+            const char *taskName = tasks[i].stats.name;
+            uint32_t periodMs = tasks[i].stats.periodMs;
+            tasks[i].stats = TaskStats();
+            tasks[i].stats.name = taskName;
+            tasks[i].stats.periodMs = periodMs;
+        }
+        windowStartMicros = now;
+        windowIdleMicros = 0;
+    }
+    if (windowStartMicros == 0) {
+        windowStartMicros = now;
+    }
+
+    // Esedékes és jelzett feladatok futtatása, a regisztrálás sorrendjében
+    uint64_t nextDeadline = UINT64_MAX;
+    for (uint8_t i = 0; i < taskCount; i++) {
+        Task &task = tasks[i];
+
+        // A jelzést a futás előtt töröljük: a futás közben érkező újabb jelzés nem vész el
+        bool signalled = task.signalled.load(std::memory_order_acquire);
+        if (signalled) {
+            task.signalled.store(false, std::memory_order_relaxed);
+        }
+
+        bool due = task.stats.periodMs != 0 && now >= task.nextRunMicros;
+        if (signalled || due) {
+            now = runTask(task, now);
+        }
+
+        if (task.stats.periodMs != 0 && task.nextRunMicros < nextDeadline) {
+            nextDeadline = task.nextRunMicros;
+        }
+    }
+
+    // Futás közben jelzett feladat: nem alszunk, azonnal újra körbe megyünk
+    for (uint8_t i = 0; i < taskCount; i++) {
+        if (tasks[i].signalled.load(std::memory_order_relaxed)) {
+            updateIdleWindow(now);
+            return;
+        }
+    }
+
+    // Alvás a legközelebbi határidőig; megszakítás vagy __sev() (signal()) korábban is ébreszt
+    if (nextDeadline > now) {
+        if (nextDeadline != UINT64_MAX) {
+            best_effort_wfe_or_timeout(from_us_since_boot(nextDeadline));
+        } else {
+            __wfe();
+        }
+        uint64_t wakeup = nowMicros();
+        windowIdleMicros += wakeup - now;
+        now = wakeup;
+    }
+
+    updateIdleWindow(now);
+}
+
+/**
+ * Egy feladat futtatása és mérése
+ */
+uint64_t TaskScheduler::runTask(Task &task, uint64_t now) {
+    task.function();
+    uint64_t end = nowMicros();
+
+    uint32_t elapsed = end - now;
+    task.stats.runCount++;
+    task.stats.totalMicros += elapsed;
+    if (elapsed > task.stats.maxMicros) {
+        task.stats.maxMicros = elapsed;
+    }
+
+    // A következő határidő a periódus rácsán marad; ha lemaradtunk, a kimaradt futásokat nem pótoljuk
+    if (task.stats.periodMs != 0) {
+        const uint64_t periodMicros = (uint64_t)task.stats.periodMs * 1000;
+        task.nextRunMicros += periodMicros;
+        if (task.nextRunMicros <= end) {
+            task.nextRunMicros = end + periodMicros;
+        }
+    }
+    return end;
+}
+
+/**
+ * A mérési ablak lezárása, az üresjárati arány frissítése
+ */
+void TaskScheduler::updateIdleWindow(uint64_t now) {
+    uint64_t window = now - windowStartMicros;
+    if (window < IDLE_WINDOW_MICROS) {
+        return;
+    }
+    idlePercent = (uint8_t)(windowIdleMicros * 100 / window);
+    windowStartMicros = now;
+    windowIdleMicros = 0;
+}
+
+/**
+ * Statisztikák kiírása a debug soros portra
+ */
+void TaskScheduler::dump() const {
+    DEBUG("---- Scheduler %s: idle %u%% ----\n", name, idlePercent);
+    DEBUG("%-12s %7s %9s %10s %9s %9s\n", "task", "period", "runs", "total us", "avg us", "max us");
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const TaskStats &stats = tasks[i].stats;
+        unsigned long avg = stats.runCount ? (unsigned long)(stats.totalMicros / stats.runCount) : 0;
+        DEBUG("%-12s %5lums %9lu %10lu %9lu %9lu\n", stats.name, (unsigned long)stats.periodMs, (unsigned long)stats.runCount, (unsigned long)stats.totalMicros, avg,
+              (unsigned long)stats.maxMicros);
+    }
+}
@@ -2,6 +2,13 @@
 #include "Config.h"
 #include "Utils.h"
 
+#include <hardware/clocks.h>
+#include <hardware/gpio.h>
+#include <hardware/pwm.h>
+
+// Egy alarm lépésben ennyivel mozdul a (fényerő * 256) szint: a teljes skála BACKLIGHT_FADE_MSEC alatt
+constexpr uint16_t FADE_STEP = (255u << 8) * BACKLIGHT_FADE_STEP_MSEC / BACKLIGHT_FADE_MSEC;
+
 /**
  * @brief Destruktor - leiratkozás a config változásokról.
  */
@@ -11,70 +18,147 @@ TftBackLightAdjuster::~TftBackLightAdjuster() { config.unregisterCallback(config
  * @brief Inicializálja a háttérvilágítást.
  */
 void TftBackLightAdjuster::begin() {
-    pinMode(PIN_TFT_BACKGROUND_LED, OUTPUT);
-    setBacklightLevel(DEFAULT_BRIGHTNESS); // Fényerő azonnali beállítása alapértékre
 
-    // Feliratkozás a config változásokra és a kezdeti értékek betöltése
-    configCallbackId = config.registerChangeCallback([this]() { this->onConfigChanged(); });
-    onConfigChanged();
+    // A PWM, a gamma tábla és az alarm csak egyszer indul (a begin() többször is hívódhat)
+    if (!_started) {
+        _started = true;
+
+        // NIGHTLY_BRIGHTNESS alatt lineáris (a legkisebb használt kitöltés a régi), fölötte gamma görbe a teljes kitöltésig
+        const float minDuty = (float)NIGHTLY_BRIGHTNESS * BACKLIGHT_PWM_WRAP / 255;
+        for (uint16_t i = 0; i < 256; i++) {
+            if (i <= NIGHTLY_BRIGHTNESS) {
+                _gammaTable[i] = (uint16_t)((float)i * BACKLIGHT_PWM_WRAP / 255 + 0.5f);
+            } else {
+                float ratio = (float)(i - NIGHTLY_BRIGHTNESS) / (255 - NIGHTLY_BRIGHTNESS);
+                _gammaTable[i] = (uint16_t)(minDuty + powf(ratio, BACKLIGHT_GAMMA) * (BACKLIGHT_PWM_WRAP - minDuty) + 0.5f);
+            }
+        }
+
+        gpio_set_function(PIN_TFT_BACKGROUND_LED, GPIO_FUNC_PWM);
+        _slice = pwm_gpio_to_slice_num(PIN_TFT_BACKGROUND_LED);
+        _channel = pwm_gpio_to_channel(PIN_TFT_BACKGROUND_LED);
+
+        pwm_config pwmConfig = pwm_get_default_config();
+        pwm_config_set_clkdiv(&pwmConfig, (float)clock_get_hz(clk_sys) / ((BACKLIGHT_PWM_WRAP + 1) * BACKLIGHT_PWM_FREQ));
+        pwm_config_set_wrap(&pwmConfig, BACKLIGHT_PWM_WRAP);
+        pwm_init(_slice, &pwmConfig, true);
+
+        setBacklightLevel(DEFAULT_BRIGHTNESS); // Fényerő azonnali beállítása alapértékre
+        writeLevel(_currentLevel);
+
+        // Az alarm a hívó mag (Core0) alarm pool-jában fut, a visszatérési érték ütemezi újra
+        add_alarm_in_ms(BACKLIGHT_FADE_STEP_MSEC, onFadeAlarm, this, true);
+    }
+
+    // Feliratkozás a config változásokra (a Core1 loop kezeli a háttérvilágítást) és a kezdeti értékek betöltése.
+    // A begin() többször is hívódhat (splash, majd a config betöltése után), ezért előbb leiratkozunk.
+    config.unregisterCallback(configCallbackId);
+    configCallbackId = config.registerChangeCallback([this](ConfigFieldMask changed) { this->onConfigChanged(changed); }, ConfigField::TFT_BRIGHTNESS, ConfigCore::Core1);
+    onConfigChanged(ConfigField::ALL);
 }
 
 /**
  * @brief Callback függvény, amit a Config hív meg változás esetén
  */
-void TftBackLightAdjuster::onConfigChanged() {
+void TftBackLightAdjuster::onConfigChanged(ConfigFieldMask changed) {
     // DEBUG("TftBackLightAdjuster::onConfigChanged() - Fényerő beállítások frissítése.\n");
     _tftAutoBrightnessActive = config.data.tftAutoBrightnessActive;
     _manualBrightnessValue = config.data.tftManualBrightnessValue;
 
-    // Ha manuális módba váltottunk, azonnal beállítjuk a fényerőt
+    // Ha manuális módba váltottunk, azonnal beállítjuk a fényerőt, a téma a nappali lesz
     if (!_tftAutoBrightnessActive) {
         setBacklightLevel(_manualBrightnessValue);
+        _nightTheme = false;
     }
+
+    // Automata módban az érzékelő szűrése elölről indul
+    _filteredSensorValue = -1;
+    _targetSensorValue = -1;
 }
 
 /**
- * LED háttérvilágítás PWM állítgatás
+ * A cél fényerő frissítése
  */
-void TftBackLightAdjuster::loop(void) {
+void TftBackLightAdjuster::updateTarget() {
 
-    // SENSOR_CHECK_MSEC msec-enként frissítjük a célértéket
-    if (Utils::timeHasPassed(lastSensorCheckMsec, SENSOR_CHECK_MSEC)) {
-        lastSensorCheckMsec = millis();
+    if (!_tftAutoBrightnessActive) {
+        // Manuális mód: a beállított értéket használjuk
+        fadeTo(constrain(_manualBrightnessValue, NIGHTLY_BRIGHTNESS, TFT_BACKGROUND_LED_MAX_BRIGHTNESS));
+        return;
+    }
 
-        if (_tftAutoBrightnessActive) {
-            // Automata mód: szenzor alapján állítunk
-            int lightSensorValue = analogRead(PIN_LIGHT_SENSOR);
+    // Automata mód: szenzor alapján állítunk (az ADC már túlmintavételezett, itt egy lassú IIR szűrő simítja az árnyékokat)
+    int32_t sensorValue = getSensorValue();
+    if (_filteredSensorValue < 0) {
+        _filteredSensorValue = sensorValue << SENSOR_FILTER_SHIFT;
+    } else {
+        _filteredSensorValue += sensorValue - (_filteredSensorValue >> SENSOR_FILTER_SHIFT);
+    }
+    int32_t lightSensorValue = _filteredSensorValue >> SENSOR_FILTER_SHIFT;
 
-            if (lightSensorValue < SENSOR_VALUE_NIGHT) {
-                new_brightness = NIGHTLY_BRIGHTNESS;
-            } else if (lightSensorValue > SENSOR_VALUE_DAILY) {
-                new_brightness = DAILY_BRIGHTNESS;
-            } else {
-                new_brightness = map(lightSensorValue, SENSOR_VALUE_NIGHT, SENSOR_VALUE_DAILY, DAILY_BRIGHTNESS, NIGHTLY_BRIGHTNESS);
-            }
+    // Éjszakai téma váltása hiszterézissel, hogy a határon ne villogjon a kijelző
+    if (lightSensorValue < SENSOR_VALUE_NIGHT) {
+        _nightTheme = true;
+    } else if (lightSensorValue > SENSOR_VALUE_NIGHT + SENSOR_VALUE_NIGHT_THEME_HYSTERESIS) {
+        _nightTheme = false;
+    }
 
-        } else {
-            // Manuális mód: a beállított értéket használjuk
-            new_brightness = _manualBrightnessValue;
-        }
+    // Új cél fényerő csak elég nagy változásnál, hogy a fényerő ne kövesse a zajt
+    if (_targetSensorValue >= 0 && abs(lightSensorValue - _targetSensorValue) < SENSOR_VALUE_TARGET_HYSTERESIS) {
+        return;
     }
+    _targetSensorValue = lightSensorValue;
 
-    // Fényerő állítása, ha szükséges
-    if (new_brightness != brightness) {
-        // 15 msec-enként léptetünk a fényerőn
-        if (millis() - lastAdjustMsec > LED_ADJUST_MSEC) {
-            lastAdjustMsec = millis();
+    // A fényerő skála már perceptuális (gamma), így a lineáris leképezés egyenletes érzetű átmenetet ad
+    uint8_t brightness;
+    if (lightSensorValue < SENSOR_VALUE_NIGHT) {
+        brightness = NIGHTLY_BRIGHTNESS;
+    } else if (lightSensorValue > SENSOR_VALUE_DAILY) {
+        brightness = DAILY_BRIGHTNESS;
+    } else {
+        brightness = map(lightSensorValue, SENSOR_VALUE_NIGHT, SENSOR_VALUE_DAILY, NIGHTLY_BRIGHTNESS, DAILY_BRIGHTNESS);
+    }
+    fadeTo(brightness);
+}
 
-            if (new_brightness > brightness) {
-                brightness++;
-            } else {
-                brightness--;
-            }
+/**
+ * Az átmenet alarm megszakítása: egy lépés a cél felé
+ */
+int64_t TftBackLightAdjuster::onFadeAlarm(alarm_id_t id, void *userData) {
+    TftBackLightAdjuster *adjuster = static_cast<TftBackLightAdjuster *>(userData);
 
-            // A setBacklightLevel már kezeli a 0 és 255 speciális esetet, de PWM-mel.
-            // A direkt digitalWrite hatékonyabb lehet, de a sima analogWrite is megteszi.
-            setBacklightLevel(brightness);
-        }
+    uint32_t request = adjuster->_request.load(std::memory_order_relaxed);
+    uint16_t target = request & 0xFFFF;
+    uint16_t jumpSequence = request >> 16;
+
+    uint16_t level = adjuster->_currentLevel;
+    if (jumpSequence != adjuster->_jumpSequence) {
+        // Azonnali beállítás kérése
+        adjuster->_jumpSequence = jumpSequence;
+        level = target;
+    } else if (level < target) {
+        level = target - level > FADE_STEP ? level + FADE_STEP : target;
+    } else if (level > target) {
+        level = level - target > FADE_STEP ? level - FADE_STEP : target;
+    }
+
+    if (level != adjuster->_currentLevel) {
+        adjuster->_currentLevel = level;
+        adjuster->writeLevel(level);
+    }
+    return -(int64_t)BACKLIGHT_FADE_STEP_MSEC * 1000; // Negatív: az előző alarm időpontjához képest
+}
+
+/**
+ * A (fényerő * 256) szint kiírása a PWM-re gamma korrekcióval
+ */
+void TftBackLightAdjuster::writeLevel(uint16_t level) {
+    // A két szomszédos táblaelem között lineárisan interpolálunk: 12 bites kitöltés, 1/256 fényerő lépésekkel
+    uint8_t index = level >> 8;
+    uint8_t fraction = level & 0xFF;
+    uint16_t duty = _gammaTable[index];
+    if (index < 255) {
+        duty += ((_gammaTable[index + 1] - duty) * fraction) >> 8;
     }
+    pwm_set_chan_level(_slice, _channel, duty);
 }
@@ -0,0 +1,145 @@
+#include "TouchSampler.h"
+#include "TaskScheduler.h"
+#include "defines.h"
+#include "pins.h"
+
+extern uint8_t uiTaskId;
+
+TouchSampler *TouchSampler::instance = nullptr;
+
+/**
+ * PENIRQ láb és megszakítás beállítása
+ */
+void TouchSampler::begin(uint8_t sampleTaskId) {
+    this->sampleTaskId = sampleTaskId;
+    instance = this;
+
+    // Az XPT2046 PENIRQ kimenete nyitott drain jellegű: felhúzás kell
+    pinMode(PIN_TOUCH_IRQ, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(PIN_TOUCH_IRQ), onPenIrq, FALLING);
+}
+
+/**
+ * A PENIRQ megszakítás kezelője
+ *
+ * Konverzió alatt az XPT2046 a PENIRQ-t is billegteti: csak a nyugalmi állapotból érkező első él számít,
+ * a többit (a saját SPI olvasásaink visszhangját) figyelmen kívül hagyjuk, különben a feladat önmagát ébresztgetné.
+ */
+void TouchSampler::onPenIrq() {
+    if (!instance || instance->pressed || instance->validCount != 0 || instance->penIrqMicros != 0) {
+        return;
+    }
+    instance->penIrqMicros = micros() | 1; // 0 a "nincs" jelzés
+    core0Scheduler.signal(instance->sampleTaskId);
+}
+
+/**
+ * Le van-e nyomva a panel
+ */
+bool TouchSampler::isPenDown() { return digitalRead(PIN_TOUCH_IRQ) == LOW; }
+
+/**
+ * Egy mintavételi lépés
+ */
+void TouchSampler::sample() {
+    // Elengedve és a PENIRQ sem jelez: nincs SPI forgalom
+    if (!pressed && validCount == 0 && !isPenDown()) {
+        penIrqMicros = 0;
+        return;
+    }
+
+    uint16_t x, y;
+    bool valid = isPenDown() && readFiltered(x, y);
+
+    if (!pressed) {
+        if (!valid) {
+            // Pergés vagy túl gyenge nyomás: elölről
+            validCount = 0;
+            penIrqMicros = 0;
+            return;
+        }
+
+        // Az első érvényes minta inicializálja az IIR szűrőt
+        if (validCount == 0) {
+            filteredX = (int32_t)x << 4;
+            filteredY = (int32_t)y << 4;
+        } else {
+            filteredX += (((int32_t)x << 4) - filteredX) >> IIR_SHIFT;
+            filteredY += (((int32_t)y << 4) - filteredY) >> IIR_SHIFT;
+        }
+
+        if (++validCount >= PRESS_DEBOUNCE_SAMPLES) {
+            pressed = true;
+            invalidCount = 0;
+            uint32_t t0 = penIrqMicros;
+            publish(TouchEvent(filteredX >> 4, filteredY >> 4, true, t0 ? t0 : micros()));
+        }
+        return;
+    }
+
+    // Lenyomva: a koordináta követése, felengedés pergésmentesítéssel
+    if (valid) {
+        invalidCount = 0;
+        filteredX += (((int32_t)x << 4) - filteredX) >> IIR_SHIFT;
+        filteredY += (((int32_t)y << 4) - filteredY) >> IIR_SHIFT;
+        return;
+    }
+
+    if (++invalidCount >= RELEASE_DEBOUNCE_SAMPLES) {
+        pressed = false;
+        validCount = 0;
+        penIrqMicros = 0;
+        publish(TouchEvent(filteredX >> 4, filteredY >> 4, false));
+    }
+}
+
+/**
+ * Szűrt, kalibrált koordináta olvasása
+ */
+bool TouchSampler::readFiltered(uint16_t &x, uint16_t &y) {
+    if (tft.getTouchRawZ() < Z_THRESHOLD) {
+        return false;
+    }
+
+    // Medián: a nyers minták rendezése beszúrással (kevés elem)
+    uint16_t rawX[MEDIAN_SAMPLES], rawY[MEDIAN_SAMPLES];
+    for (uint8_t i = 0; i < MEDIAN_SAMPLES; i++) {
+        uint16_t sampleX, sampleY;
+        tft.getTouchRaw(&sampleX, &sampleY);
+
+        uint8_t pos = i;
+        while (pos > 0 && rawX[pos - 1] > sampleX) {
+            rawX[pos] = rawX[pos - 1];
+            pos--;
+        }
+        rawX[pos] = sampleX;
+
+        pos = i;
+        while (pos > 0 && rawY[pos - 1] > sampleY) {
+            rawY[pos] = rawY[pos - 1];
+            pos--;
+        }
+        rawY[pos] = sampleY;
+    }
+
+    // A mintázás közben felengedett panel utolsó mintái szemetek lehetnek
+    if (tft.getTouchRawZ() < Z_THRESHOLD) {
+        return false;
+    }
+
+    x = rawX[MEDIAN_SAMPLES / 2];
+    y = rawY[MEDIAN_SAMPLES / 2];
+    tft.convertRawXY(&x, &y);
+    return x < tft.width() && y < tft.height();
+}
+
+/**
+ * Az esemény beírása a sorba és a képernyőkezelő felébresztése
+ */
+void TouchSampler::publish(const TouchEvent &event) {
+    if (!eventQueue.push(event)) {
+        DEBUG("TouchSampler: event queue full, event dropped\n");
+        return;
+    }
+    core0Scheduler.signal(uiTaskId);
+}
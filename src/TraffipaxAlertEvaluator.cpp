@@ -0,0 +1,217 @@
+#include "TraffipaxAlertEvaluator.h"
+#include "Config.h"
+#include "GpsManager.h"
+#include "LatencyProbe.h"
+#include "Utils.h"
+
+extern GpsManager *gpsManager;
+extern TraffipaxManager traffipaxManager;
+
+// Demó mód
+extern bool demoMode;
+
+/**
+ * Konstruktor
+ */
+TraffipaxAlertEvaluator::TraffipaxAlertEvaluator() {
+    // Feliratkozás a config változásokra
+    configCallbackId = config.registerChangeCallback([this](ConfigFieldMask changed) { this->onConfigChanged(changed); }, ConfigField::GPS_TRAFFI);
+
+    // Kezdeti értékek felvétele
+    onConfigChanged(ConfigField::ALL);
+}
+
+/**
+ * Destruktor
+ */
+TraffipaxAlertEvaluator::~TraffipaxAlertEvaluator() { config.unregisterCallback(configCallbackId); }
+
+/**
+ * Callback függvény, amit a Config hív meg változás esetén
+ */
+void TraffipaxAlertEvaluator::onConfigChanged(ConfigFieldMask changed) {
+    alarmEnabled = config.data.gpsTraffiAlarmEnabled;
+    sirenAlarmEnabled = config.data.gpsTraffiSirenAlarmEnabled;
+    alarmDistance = config.data.gpsTraffiAlarmDistance;
+}
+
+/**
+ * Core1 loop
+ */
+void TraffipaxAlertEvaluator::loop() {
+
+    // Demó módban a szimulált pozíció másodpercenként lép
+    if (demoMode) {
+        if (!Utils::timeHasPassed(lastEvaluation, 1000)) {
+            return;
+        }
+        lastEvaluation = millis();
+
+        double lat = 0.0, lon = 0.0;
+        bool positionValid = processDemo(lat, lon);
+        evaluate(lat, lon, positionValid, 0);
+        return;
+    }
+
+    // Közvetlenül az új fix epocha publikálása után; ha nem jön epocha (nincs fix), a watchdog időzítő értékel ki
+    uint32_t rxMicros = 0;
+    bool newEpoch = gpsManager->consumeFixEpoch(rxMicros);
+    if (!newEpoch && !Utils::timeHasPassed(lastEvaluation, GPS_EPOCH_WATCHDOG_MS)) {
+        return;
+    }
+    lastEvaluation = millis();
+
+    TinyGPSLocation location = gpsManager->getLocation();
+    bool positionValid = location.isValid() && location.age() < GPS_DATA_MAX_AGE;
+    evaluate(location.lat(), location.lng(), positionValid, newEpoch ? rxMicros : 0);
+
+    if (newEpoch) {
+        latencyProbe.recordSince(LatencyProbe::PROXIMITY_COMPUTED, rxMicros);
+    }
+}
+
+/**
+ * Kiértékelés egy pozícióra
+ */
+void TraffipaxAlertEvaluator::evaluate(double lat, double lon, bool positionValid, uint32_t rxMicros) {
+
+    // Kikapcsolt riasztás vagy nincs érvényes GPS pozíció adat - riasztás kikapcsolása ha éppen aktív
+    if (!alarmEnabled || !positionValid) {
+        deactivate(rxMicros);
+        outOfRangeStart = 0;
+        return;
+    }
+
+    // Legközelebbi trafipax keresése
+    double minDistance = 999999.0;
+    const TraffipaxManager::TraffipaxRecord *closestTraffipax = traffipaxManager.getClosestTraffipax(lat, lon, minDistance);
+    const unsigned long currentTime = millis();
+
+    // Ha nincs közeli traffipax a kritikus távolságon belül
+    if (minDistance > alarmDistance) {
+        // Először jegyezzük fel, mikor kerültünk ki a tartományból
+        if (outOfRangeStart == 0) {
+            outOfRangeStart = currentTime;
+        }
+        // Ha már legalább 3 másodperce kívül vagyunk, akkor kapcsoljuk ki a riasztást
+        if (currentTime - outOfRangeStart > OUT_OF_RANGE_HOLD_MS) {
+            deactivate(rxMicros);
+        } else if (state != TraffipaxAlertEvent::INACTIVE && activeTraffipax) {
+            // Még nem telt le a stabilizációs idő, a sáv maradjon!
+            publish(activeTraffipax, minDistance, TraffipaxAlertEvent::SIREN_NONE, rxMicros);
+        }
+        return;
+    }
+
+    // Visszaléptünk a tartományba, nullázzuk az időzítőt
+    outOfRangeStart = 0;
+
+    // Van közeli traffipax - állapot meghatározása
+    bool isApproaching = minDistance < (lastDistance - 10.0);
+    bool isDeparting = minDistance > (lastDistance + 10.0);
+
+    TraffipaxAlertEvent::State newState = state;
+    if (state == TraffipaxAlertEvent::INACTIVE || isApproaching) {
+        newState = TraffipaxAlertEvent::APPROACHING;
+    } else if (isDeparting) {
+        newState = TraffipaxAlertEvent::DEPARTING;
+    }
+
+    if (newState != state) {
+        state = newState;
+        activeTraffipax = closestTraffipax;
+    }
+
+    // Szirénázás csak közeledés esetén, 10mp-enként, ha engedélyezve van
+    TraffipaxAlertEvent::Siren siren = TraffipaxAlertEvent::SIREN_NONE;
+    if (sirenAlarmEnabled && state == TraffipaxAlertEvent::APPROACHING && currentTime - lastSirenTime >= SIREN_INTERVAL) {
+        siren = TraffipaxAlertEvent::SIREN_START;
+        lastSirenTime = currentTime;
+    }
+
+    // Figyelmeztetés minden kiértékeléskor, amíg aktív
+    publish(closestTraffipax, minDistance, siren, rxMicros);
+
+    // Távolság frissítése - csak 5m+ változásnál
+    if (abs(minDistance - lastDistance) >= 5.0) {
+        lastDistance = minDistance;
+    }
+}
+
+/**
+ * A riasztás kikapcsolása (ha aktív volt)
+ */
+void TraffipaxAlertEvaluator::deactivate(uint32_t rxMicros) {
+    if (state == TraffipaxAlertEvent::INACTIVE && !resendPending) {
+        return;
+    }
+
+    state = TraffipaxAlertEvent::INACTIVE;
+    activeTraffipax = nullptr;
+    lastDistance = 999999.0;
+
+    // Ha van sziréna, akkor azt most lelőjük
+    publish(nullptr, 0.0, TraffipaxAlertEvent::SIREN_STOP, rxMicros);
+}
+
+/**
+ * Eredmény küldése a Core0-nak
+ */
+void TraffipaxAlertEvaluator::publish(const TraffipaxManager::TraffipaxRecord *traffipax, double distance, TraffipaxAlertEvent::Siren siren, uint32_t rxMicros) {
+    TraffipaxAlertEvent event;
+    event.traffipax = traffipax;
+    event.distance = distance;
+    event.state = state;
+    event.siren = siren;
+    event.timestamp = millis();
+    event.rxMicros = rxMicros;
+
+    // Tele sor esetén (a Core0 épp nem fogyaszt, pl. flash írás) a következő kiértékelés újraküldi az állapotot
+    resendPending = !eventQueue.push(event);
+    if (resendPending) {
+        DEBUG("TraffipaxAlertEvaluator: event queue full, alert event dropped\n");
+    }
+}
+
+/**
+ * A következő riasztás esemény kivétele (Core0)
+ */
+bool TraffipaxAlertEvaluator::popEvent(TraffipaxAlertEvent &event) {
+    if (!eventQueue.pop(event)) {
+        return false;
+    }
+    currentAlert = event;
+    return true;
+}
+
+/**
+ * Demó pozíció léptetése
+ *
+ * A demó a két percenként újrainduló traffipax közeledés/távolodás szimuláció.
+ */
+bool TraffipaxAlertEvaluator::processDemo(double &lat, double &lon) {
+    bool isTraffipaxManagerDemoActive = traffipaxManager.isDemoActive();
+
+    // Ha a demó aktív volt és most nem az, rögzítjük a befejezési időt.
+    if (wasDemoActive && !isTraffipaxManagerDemoActive) {
+        lastDemoEndTime = millis();
+        DEBUG("Traffi Demo Fázis: 2 perc várakozás\n");
+    }
+    wasDemoActive = isTraffipaxManagerDemoActive;
+
+    // Ha a demó nem aktív:
+    if (!isTraffipaxManagerDemoActive) {
+        // Ha ez az első futás (lastDemoEndTime 0 és wasDemoActive kezdetben hamis)
+        // VAGY ha a várakozási időszak letelt az utolsó demó befejezése óta.
+        if (lastDemoEndTime == 0 || Utils::timeHasPassed(lastDemoEndTime, 2 * 60 * 1000)) {
+            traffipaxManager.startDemo();
+            lastDemoEndTime = 0; // Visszaállítás a következő várakozási időszakra
+        }
+        return false;
+    }
+
+    // Ha a demó aktív, dolgozzuk fel.
+    traffipaxManager.processDemo();
+    traffipaxManager.getDemoCoords(lat, lon);
+    return true;
+}
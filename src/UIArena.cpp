@@ -0,0 +1,51 @@
+#include "UIArena.h"
+
+UIArena *UIArena::constructionArena = nullptr;
+
+/**
+ * @brief Foglalás a slab-ből (ha nem fér bele, a heap-ről)
+ */
+void *UIArena::allocate(size_t size, size_t alignment) {
+
+    size_t offset = (used + alignment - 1) & ~(alignment - 1);
+    if (buffer == nullptr || offset + size > capacity) {
+        // Nem fér bele: a heap-re kerül, a deallocate() a címből tudja, hogy nem a slab-é
+        heapFallbacks++;
+        DEBUG("UIArena: slab full (%u/%u), %u bytes from heap\n", used, capacity, (unsigned)size);
+        return ::operator new(size);
+    }
+
+    used = offset + size;
+    if (used > highWater) {
+        highWater = used;
+    }
+    liveObjects++;
+    return buffer + offset;
+}
+
+/**
+ * @brief Felszabadítás: a slab-beli objektumot csak leszámolja, a heap-ről foglaltat felszabadítja
+ */
+void UIArena::deallocate(void *p) {
+
+    uint8_t *bytes = static_cast<uint8_t *>(p);
+    if (bytes < buffer || bytes >= buffer + capacity) {
+        ::operator delete(p);
+        return;
+    }
+
+    // Az utolsó élő objektummal a slab egyben kiürül (ha a tulajdonos már nem foglal bele)
+    if (--liveObjects == 0 && !reserved) {
+        used = 0;
+    }
+}
+
+/**
+ * @brief A lefoglalás feloldása: innentől az élő objektumok tartják meg a slab-ot
+ */
+void UIArena::release() {
+    reserved = false;
+    if (liveObjects == 0) {
+        used = 0;
+    }
+}
@@ -178,12 +178,12 @@ void UIDialogBase::createCloseButton() {
     int16_t closeBtnX = bounds.x + bounds.width - CLOSE_BTN_SIZE - CLOSE_BTN_MARGIN;
     int16_t closeBtnY = bounds.y + CLOSE_BTN_MARGIN;
     Rect closeBtnBounds(closeBtnX, closeBtnY, CLOSE_BTN_SIZE, CLOSE_BTN_SIZE);                    // Bezáró gomb létrehozása központi színpalettával
-    closeButton = std::make_shared<UIButton>(DIALOG_DEFAULT_CLOSE_BUTTON_ID, closeBtnBounds, "X", //
-                                             [this](const UIButton::ButtonEvent &event) {
-                                                 if (event.state == UIButton::EventButtonState::Clicked) {
-                                                     this->close(DialogResult::Dismissed);
-                                                 }
-                                             });
+    closeButton = makeComponent<UIButton>(DIALOG_DEFAULT_CLOSE_BUTTON_ID, closeBtnBounds, "X",    //
+                                          [this](const UIButton::ButtonEvent &event) {
+                                              if (event.state == UIButton::EventButtonState::Clicked) {
+                                                  this->close(DialogResult::Dismissed);
+                                              }
+                                          });
 
     addChild(closeButton);
 }
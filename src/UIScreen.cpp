@@ -4,13 +4,13 @@
 // Konstruktorok és inicializálás
 // ================================
 /**
- * @brief UIScreen konstruktor névvel
+ * @brief UIScreen konstruktor azonosítóval
  * @param tft TFT display referencia
- * @param name Képernyő egyedi neve
+ * @param id Képernyő egyedi azonosítója
  * * Automatikusan teljes képernyő méretet használ (0,0 SCREEN_W, SCREEN_H).
- * Az UIContainerComponent konstruktor hívása után a név beállítása történik.
+ * Az UIContainerComponent konstruktor hívása után az azonosító beállítása történik.
  */
-UIScreen::UIScreen(const char *name) : UIContainerComponent({0, 0, SCREEN_W, SCREEN_H}), name(name) {}
+UIScreen::UIScreen(ScreenId id) : UIContainerComponent({0, 0, SCREEN_W, SCREEN_H}), id(id), refreshBudgetMicros(DEFAULT_REFRESH_BUDGET_MICROS) {}
 
 // ================================
 // UIComponent Override Methods - Event Handling és Rendering
@@ -30,12 +30,9 @@ UIScreen::UIScreen(const char *name) : UIContainerComponent({0, 0, SCREEN_W, SCR
 bool UIScreen::isRedrawNeeded() const {
 
     // Aktív dialógus újrarajzolási igény ellenőrzése
-    if (isDialogActive()) {
-        for (const auto &weakDialog : dialogStack) {
-            auto dialog = weakDialog.lock();
-            if (dialog && dialog->isRedrawNeeded()) {
-                return true;
-            }
+    for (uint8_t i = 0; i < dialogDepth; i++) {
+        if (dialogStack[i]->isRedrawNeeded()) {
+            return true;
         }
     }
 
@@ -94,17 +91,9 @@ void UIScreen::draw() {
     // ===============================
     // 2. Rétegzett dialógusok rajzolása (felső rétegek)
     // ===============================
-    if (!dialogStack.empty()) {
-
-        // Összes látható dialógus kirajzolása stack sorrendjében (alulról felfelé)
-        int dialogCount = 0;
-        for (auto &weakDialog : dialogStack) {
-            auto dialog = weakDialog.lock();
-            if (dialog) {
-                dialog->draw();
-                dialogCount++;
-            }
-        }
+    // Összes látható dialógus kirajzolása stack sorrendjében (alulról felfelé)
+    for (uint8_t i = 0; i < dialogDepth; i++) {
+        dialogStack[i]->draw();
     }
 }
 
@@ -126,10 +115,9 @@ void UIScreen::draw() {
 bool UIScreen::handleTouch(const TouchEvent &event) {
 
     if (isDialogActive()) {
-        auto topDialog = dialogStack.back().lock();
-        if (topDialog) {
-            return topDialog->handleTouch(event);
-        }
+        // Saját referencia: a dialógus a kezelés közben bezáródhat (és kikerülhet a stack-ből)
+        std::shared_ptr<UIDialogBase> topDialog = dialogStack[dialogDepth - 1];
+        return topDialog->handleTouch(event);
     }
 
     return UIContainerComponent::handleTouch(event);
@@ -155,12 +143,10 @@ bool UIScreen::handleTouch(const TouchEvent &event) {
 void UIScreen::loop() {
 
     if (isDialogActive()) {
-        auto topDialog = dialogStack.back().lock();
-        if (topDialog) {
-            topDialog->loop();
-            // Process any deferred closes from the dialog
-            topDialog->processDeferredClose();
-        }
+        std::shared_ptr<UIDialogBase> topDialog = dialogStack[dialogDepth - 1];
+        topDialog->loop();
+        // Process any deferred closes from the dialog
+        topDialog->processDeferredClose();
 
         // Ha van aktív dialógus, csak annak loop-ja fut
         return;
@@ -168,6 +154,111 @@ void UIScreen::loop() {
 
     // Ha nincs aktív dialógus, akkor az alap képernyő komponensek loop-ja fut
     UIContainerComponent::loop();
+
+    // Majd az esedékes widget frissítések
+    runRefreshTasks();
+}
+
+// ================================
+// Multi-rate Refresh Scheduler Implementation
+// ================================
+
+/**
+ * @brief Periodikus widget frissítő feladat regisztrálása
+ */
+uint8_t UIScreen::addRefreshTask(RefreshLane lane, uint16_t periodMs, std::function<void()> refresh, bool periodic) {
+    // Az első futás azonnal esedékes
+    refreshTasks.push_back({refresh, periodMs, lane, periodic, true, millis() - periodMs, 0});
+    return refreshTasks.size() - 1;
+}
+
+/**
+ * @brief Feladat megjelölése a következő esedékességkori futásra
+ */
+void UIScreen::markRefreshDirty(uint8_t taskId) {
+    if (taskId < refreshTasks.size()) {
+        refreshTasks[taskId].dirty = true;
+    }
+}
+
+/**
+ * @brief Az összes feladat megjelölése azonnali futásra
+ */
+void UIScreen::markAllRefreshDirty() {
+    uint32_t now = millis();
+    for (auto &task : refreshTasks) {
+        task.dirty = true;
+        task.lastRunMillis = now - task.periodMs;
+    }
+}
+
+/**
+ * @brief Egy feladat futtatása és költségének mérése
+ */
+void UIScreen::runRefreshTask(RefreshTask &task, uint32_t now) {
+    uint32_t start = micros();
+    task.refresh();
+    uint32_t cost = micros() - start;
+
+    // Mozgó átlag (1/4 súllyal az új mérés), az első mérés közvetlenül
+    task.avgCostMicros = task.avgCostMicros == 0 ? cost : (task.avgCostMicros * 3 + cost) / 4;
+    task.lastRunMillis = now;
+    task.dirty = false;
+}
+
+/**
+ * @brief Az esedékes frissítő feladatok futtatása
+ *
+ * 1. A gyors sáv minden esedékes feladata lefut, így a határidejük nem csúszik.
+ * 2. A lassú sávból a legrégebben esedékes feladatok futnak, amíg a becsült költségük belefér a keret idő költségvetésébe.
+ *    Ha sok lassú widget egyszerre válik érvényetlenné, azok több keretre oszlanak el, így a következő keret (és benne
+ *    a gyors sáv) legfeljebb a költségvetésnyi késést szenved. Az éhezés ellen: üres keretben egy lassú feladat mindig lefut.
+ */
+void UIScreen::runRefreshTasks() {
+    if (refreshTasks.empty()) {
+        return;
+    }
+
+    const uint32_t now = millis();
+    const uint32_t frameStart = micros();
+    bool anyRan = false;
+
+    auto isDue = [now](const RefreshTask &task) { return (task.dirty || task.periodic) && now - task.lastRunMillis >= task.periodMs; };
+
+    // Gyors sáv
+    for (auto &task : refreshTasks) {
+        if (task.lane == RefreshLane::Fast && isDue(task)) {
+            runRefreshTask(task, now);
+            anyRan = true;
+        }
+    }
+
+    // Lassú sáv: a legnagyobb késésben lévő először
+    while (true) {
+        RefreshTask *next = nullptr;
+        uint32_t nextLateness = 0;
+        for (auto &task : refreshTasks) {
+            if (task.lane != RefreshLane::Slow || !isDue(task)) {
+                continue;
+            }
+            uint32_t lateness = now - task.lastRunMillis - task.periodMs;
+            if (next == nullptr || lateness > nextLateness) {
+                next = &task;
+                nextLateness = lateness;
+            }
+        }
+        if (next == nullptr) {
+            break;
+        }
+
+        uint32_t spent = micros() - frameStart;
+        if (anyRan && spent + next->avgCostMicros > refreshBudgetMicros) {
+            break; // A többi a következő keretben
+        }
+
+        runRefreshTask(*next, now);
+        anyRan = true;
+    }
 }
 
 // ================================
@@ -178,49 +269,57 @@ void UIScreen::loop() {
  * @brief Dialógus megjelenítése a layered dialog rendszerben
  * @param dialog Megjelenítendő dialógus shared_ptr
  *
- * A showDialog metódus implementálja a dual stack dialog rendszer magját:
- *
  * 1. Előző dialógus inaktiválása (ha van)
- * 2. Új dialógus hozzáadása mindkét stack-hez:
- *    - _dialogStack: weak_ptr (gyors elérés)
- *    - _dialogSharedStack: shared_ptr (memória védelem)
+ * 2. Az új dialógus a stack tetejére kerül (a stack tartja életben)
  * 3. Dialógus aktiválása és megjelenítése
  * 4. Képernyő újrarajzolási flag beállítása
  *
- * A dual stack rendszer biztosítja, hogy:
- * - A dialógusok ne kerüljenek korai destrukcióra
- * - Gyors elérés biztosított legyen a weak_ptr-eken keresztül
- * - Automatikus cleanup történjen a shared_ptr-ek segítségével
- *
- * @note Ha dialog nullptr, akkor a metódus nem csinál semmit
+ * @note Ha dialog nullptr, vagy a stack tele van, akkor a metódus nem csinál semmit
  */
 void UIScreen::showDialog(std::shared_ptr<UIDialogBase> dialog) {
 
-    if (dialog) {
-        // 1. Előző dialógus inaktiválása (de látható marad)
-        //    és a topDialog flagjének false-ra állítása
-        if (!dialogStack.empty()) {
-            auto previousTopDialog = dialogStack.back().lock();
-            if (previousTopDialog) {
-                previousTopDialog->setTopDialog(false);
-            }
-        }
+    if (!dialog) {
+        return;
+    }
+    if (dialogDepth == MAX_DIALOG_DEPTH) {
+        DEBUG("UIScreen::showDialog() - dialog stack full (%d), dialog dropped\n", MAX_DIALOG_DEPTH);
+        return;
+    }
+
+    // 1. Előző dialógus inaktiválása (de látható marad)
+    //    és a topDialog flagjének false-ra állítása
+    if (dialogDepth > 0) {
+        dialogStack[dialogDepth - 1]->setTopDialog(false);
+    }
 
-        // 2. Dual stack tárolás - a layered dialog rendszer magja
-        dialogStack.push_back(dialog);       // weak_ptr automatikus konverzió
-        dialogSharedStack.push_back(dialog); // shared_ptr tárolás (életben tartás)
+    // 2. Stack tárolás - a layered dialog rendszer magja
+    dialogStack[dialogDepth++] = dialog;
 
-        // 3. Dialógus aktiválása és megjelenítése
-        //    Az új dialógus lesz a legfelső.
-        dialog->setTopDialog(true);
-        dialog->show();
+    // 3. Dialógus aktiválása és megjelenítése
+    //    Az új dialógus lesz a legfelső.
+    dialog->setTopDialog(true);
+    dialog->show();
 
-        // currentDialog frissítése az új aktív dialógusra
-        // (Bár a dialogStack.back() is használható a legfelső elérésére)
-        currentDialog = dialog;
+    // 4. Képernyő újrarajzolás triggering
+    this->markForRedraw();
+}
 
-        // 4. Képernyő újrarajzolás triggering
-        this->markForRedraw();
+/**
+ * @brief A bezárt dialógus eltávolítása a stack-ből
+ * @param closedDialog A bezárt dialógus pointer
+ *
+ * Leggyakrabban a legfelső dialógus záródik be, de a középső dialógusok bezárását is kezeli (pl. láncolt bezárás).
+ * Ha a stack volt az utolsó referencia, a dialógus itt szűnik meg (és a slab-je felszabadul).
+ */
+void UIScreen::removeDialog(UIDialogBase *closedDialog) {
+    for (uint8_t i = dialogDepth; i-- > 0;) {
+        if (dialogStack[i].get() == closedDialog) {
+            for (uint8_t j = i; j + 1 < dialogDepth; j++) {
+                dialogStack[j] = std::move(dialogStack[j + 1]);
+            }
+            dialogStack[--dialogDepth].reset();
+            return;
+        }
     }
 }
 
@@ -232,9 +331,9 @@ void UIScreen::showDialog(std::shared_ptr<UIDialogBase> dialog) {
  * Automatikusan meghívódik amikor egy dialógus bezáródik (OK/Cancel gomb).
  *
  * Fő funkciók:
- * 1. **Dialog Stack Cleanup**: A bezárt dialógus eltávolítása mindkét stack-ből
+ * 1. **Dialog Stack Cleanup**: A bezárt dialógus eltávolítása a stack-ből
  * 2. **Navigation Logic**: Visszatérés az előző dialógushoz vagy a főképernyőhöz
- * 3. **Memory Management**: Automatikus shared_ptr cleanup
+ * 3. **Memory Management**: A stack elengedi a dialógust (a slab-je felszabadul)
  * 4. **Visual Refresh**: Teljes képernyő újrarajzolás a tiszta megjelenéshez
  *
  * Navigation logika:
@@ -246,55 +345,17 @@ void UIScreen::showDialog(std::shared_ptr<UIDialogBase> dialog) {
 void UIScreen::onDialogClosed(UIDialogBase *closedDialog) {
 
     // ===============================
-    // 1. Aktuális dialógus referencia cleanup
+    // 1. Dialog Stack Cleanup
     // ===============================
-    if (currentDialog.get() == closedDialog) {
-        currentDialog.reset();
-    }
+    removeDialog(closedDialog);
 
     // ===============================
-    // 2. Dialog Stack Cleanup - Weak Pointer Stack
+    // 2. Navigation Logic - Visszatérés főképernyőhöz vagy előző dialógushoz
     // ===============================
-    bool dialogRemoved = false;
-
-    // Optimalizáció: Top dialog ellenőrzése először (leggyakoribb eset)
-    if (!dialogStack.empty()) {
-        auto topDialog = dialogStack.back().lock();
-        if (topDialog && topDialog.get() == closedDialog) {
-            dialogStack.pop_back();
-            dialogRemoved = true;
-        }
-    }
-
-    // Fallback: Keresés a stack középső elemei között (ritkább eset)
-    if (!dialogRemoved) {
-        for (auto it = dialogStack.begin(); it != dialogStack.end(); ++it) {
-            auto dialog = it->lock();
-            if (dialog && dialog.get() == closedDialog) {
-                dialogStack.erase(it);
-                dialogRemoved = true;
-                break;
-            }
-        }
-    }
-
-    // ===============================
-    // 3. Shared Pointer Stack Cleanup - Memory Protection
-    // ===============================
-    for (auto it = dialogSharedStack.begin(); it != dialogSharedStack.end(); ++it) {
-        if (it->get() == closedDialog) {
-            dialogSharedStack.erase(it);
-            break;
-        }
-    }
 
-    // ===============================
-    // 4. Navigation Logic - Visszatérés főképernyőhöz vagy előző dialógushoz
-    // ===============================
-
-    if (dialogStack.empty()) {
+    if (dialogDepth == 0) {
         // ===========================================
-        // 4A. UTOLSÓ DIALÓGUS BEZÁRVA - Visszatérés főképernyőhöz
+        // 2A. UTOLSÓ DIALÓGUS BEZÁRVA - Visszatérés főképernyőhöz
         // ===========================================
 
         // Teljes képernyő törlése - tiszta újrakezdés
@@ -309,36 +370,27 @@ void UIScreen::onDialogClosed(UIDialogBase *closedDialog) {
 
     } else {
         // ===========================================
-        // 4B. VAN MÉG DIALÓGUS - Visszanavigálás előző dialógushoz
+        // 2B. VAN MÉG DIALÓGUS - Visszanavigálás előző dialógushoz
         // ===========================================
-        auto topDialog = dialogStack.back().lock();
-        if (topDialog) {
-
-            // Teljes képernyő törlése - tiszta rétegzett újrakezdés
-            tft.fillScreen(TFT_BLACK);
-
-            // Előző dialógus reaktiválása
-            topDialog->setTopDialog(true);
-            topDialog->resetVeilDrawnFlag(); // Fátyol újrarajzolásának engedélyezése
-            topDialog->markForRedraw(true);  // A `true` paraméter a gyerekeket is megjelöli (gombok, stb.)
-            currentDialog = topDialog;
-
-            // Alapképernyő komponenseinek újrarajzolási flag beállítása
-            markForRedraw(true);
-
-            // Összes maradék dialógus újrarajzolási flag beállítása
-            for (auto &weakDialog : dialogStack) {
-                auto dialog = weakDialog.lock();
-                if (dialog) {
-                    dialog->markForRedraw(true); // A `true` paraméter a gyerekeket is megjelöli (gombok, stb.)
-                }
-            }
+        std::shared_ptr<UIDialogBase> &topDialog = dialogStack[dialogDepth - 1];
+
+        // Teljes képernyő törlése - tiszta rétegzett újrakezdés
+        tft.fillScreen(TFT_BLACK);
+
+        // Előző dialógus reaktiválása
+        topDialog->setTopDialog(true);
+        topDialog->resetVeilDrawnFlag(); // Fátyol újrarajzolásának engedélyezése
 
-            // Teljes rétegzett újrarajzolás - alap képernyő + összes dialógus
-            draw(); // Ez rajzolja az alap képernyőt + összes dialógust
-        } else {
-            DEBUG("UIScreen::onDialogClosed() - ERROR: Previous dialog pointer is null!\n");
+        // Alapképernyő komponenseinek újrarajzolási flag beállítása
+        markForRedraw(true);
+
+        // Összes maradék dialógus újrarajzolási flag beállítása
+        for (uint8_t i = 0; i < dialogDepth; i++) {
+            dialogStack[i]->markForRedraw(true); // A `true` paraméter a gyerekeket is megjelöli (gombok, stb.)
         }
+
+        // Teljes rétegzett újrarajzolás - alap képernyő + összes dialógus
+        draw(); // Ez rajzolja az alap képernyőt + összes dialógust
     }
 }
 
@@ -351,50 +403,12 @@ void UIScreen::onDialogClosed(UIDialogBase *closedDialog) {
 void UIScreen::performDialogCleanupWithoutDraw(UIDialogBase *closedDialog) {
 
     // ===============================
-    // 1. Aktuális dialógus referencia cleanup
-    // ===============================
-    if (currentDialog.get() == closedDialog) {
-        currentDialog.reset();
-    }
-
-    // ===============================
-    // 2. Dialog Stack Cleanup - Weak Pointer Stack
+    // 1. Dialog Stack Cleanup
     // ===============================
-    bool dialogRemoved = false;
-
-    // Optimalizáció: Top dialog ellenőrzése először (leggyakoribb eset)
-    if (!dialogStack.empty()) {
-        auto topDialog = dialogStack.back().lock();
-        if (topDialog && topDialog.get() == closedDialog) {
-            dialogStack.pop_back();
-            dialogRemoved = true;
-        }
-    }
-
-    // Fallback: Keresés a stack középső elemei között (ritkább eset)
-    if (!dialogRemoved) {
-        for (auto it = dialogStack.begin(); it != dialogStack.end(); ++it) {
-            auto dialog = it->lock();
-            if (dialog && dialog.get() == closedDialog) {
-                dialogStack.erase(it);
-                dialogRemoved = true;
-                break;
-            }
-        }
-    }
-
-    // ===============================
-    // 3. Shared Pointer Stack Cleanup - Memory Protection
-    // ===============================
-    for (auto it = dialogSharedStack.begin(); it != dialogSharedStack.end(); ++it) {
-        if (it->get() == closedDialog) {
-            dialogSharedStack.erase(it);
-            break;
-        }
-    }
+    removeDialog(closedDialog);
 
     // ===============================
-    // 4. Screen cleanup - készítjük elő a rajzoláshoz
+    // 2. Screen cleanup - készítjük elő a rajzoláshoz
     // ===============================
 
     // Teljes képernyő törlése - tiszta újrakezdés
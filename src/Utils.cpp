@@ -1,26 +1,10 @@
 #include "Utils.h"
+#include <malloc.h>
+
 #include "defines.h"
-#include "pins.h"
 
 namespace Utils {
 
-// Nem-blokkoló sziréna állapotváltozói
-namespace {
-bool sirenActive = false;
-int siren_cycles;
-int siren_minFreq;
-int siren_maxFreq;
-int siren_step;
-int siren_toneMs;
-int siren_pauseMs;
-
-unsigned long lastSirenActionTime = 0;
-int currentFreq;
-bool sweepingUp = true;
-int cyclesDone = 0;
-bool isPaused = false;
-} // namespace
-
 /**
  * @brief Átalakít egy másodperc értéket "perc:mp" formátumú szöveggé
  * @param sec Időérték másodpercben
@@ -48,65 +32,6 @@ char *floatToString(float value, int decimalPlaces, char *buffer, size_t bufferS
     return buffer;
 }
 
-/**
- * Várakozás a soros port megnyitására
- * @param tft a TFT kijelző példánya
- */
-void debugWaitForSerial(TFT_eSPI &tft) {
-#ifdef __DEBUG
-    beepError();
-    tft.setTextColor(TFT_WHITE);
-    tft.setTextSize(2);
-    tft.drawString("Nyisd meg a soros portot!", 0, 0);
-    while (!Serial) {
-    }
-    tft.fillScreen(TFT_BLACK);
-    beepTick();
-#endif
-}
-
-/**
- * TFT érintőképernyő kalibráció
- * @param tft TFT kijelző példánya
- * @param calData kalibrációs adatok
- */
-void tftTouchCalibrate(TFT_eSPI &tft, uint16_t (&calData)[5]) {
-    tft.fillScreen(TFT_BLACK);
-    tft.setTextFont(2);
-    tft.setTextSize(2);
-    const char *txt = "TFT touch kalibracio kell!\n";
-    tft.setCursor((tft.width() - tft.textWidth(txt)) / 2, tft.height() / 2 - 60);
-    tft.setTextColor(TFT_ORANGE, TFT_BLACK);
-    tft.println(txt);
-
-    tft.setTextSize(1);
-    txt = "Erintsd meg a jelzett helyeken a sarkokat!\n";
-    tft.setCursor((tft.width() - tft.textWidth(txt)) / 2, tft.height() / 2 + 20);
-    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-    tft.println(txt);
-
-    // TFT_eSPI 'bóti' kalibráció indítása
-    tft.calibrateTouch(calData, TFT_YELLOW, TFT_BLACK, 15);
-
-    txt = "Kalibracio befejezodott!";
-    tft.fillScreen(TFT_BLACK);
-    tft.setCursor((tft.width() - tft.textWidth(txt)) / 2, tft.height() / 2);
-    tft.setTextColor(TFT_GREEN, TFT_BLACK);
-    tft.setTextSize(1);
-    tft.println(txt);
-
-    DEBUG("// Használd ezt a kalibrációs kódot a setup()-ban:\n");
-    DEBUG("  uint16_t calData[5] = { ");
-    for (uint8_t i = 0; i < 5; i++) {
-        DEBUG("%d", calData[i]);
-        if (i < 4) {
-            DEBUG(", ");
-        }
-    }
-    DEBUG(" };\n");
-    DEBUG("  tft.setTouch(calData);\n");
-}
-
 /**
  * ISO-8859-2 ékezetes karakterek cseréje
  */
@@ -175,142 +100,6 @@ void removeAccents(char *text) {
     }
 }
 
-/**
- *  Pitty hangjelzés
- */
-void beepTick() {
-    tone(PIN_BUZZER, 800);
-    delay(10);
-    noTone(PIN_BUZZER);
-}
-
-/**
- * Hiba jelzés
- */
-void beepError() {
-    tone(PIN_BUZZER, 500);
-    delay(100);
-    tone(PIN_BUZZER, 500);
-    delay(100);
-    tone(PIN_BUZZER, 500);
-    delay(100);
-    noTone(PIN_BUZZER);
-}
-
-/**
- * Trafipax riasztó hangjelzés
- */
-void beepAlert() {
-    for (int i = 0; i < 3; i++) {
-        tone(PIN_BUZZER, 1200);
-        delay(60);
-        noTone(PIN_BUZZER);
-        delay(40);
-    }
-    delay(100);
-    for (int i = 0; i < 2; i++) {
-        tone(PIN_BUZZER, 1800);
-        delay(80);
-        noTone(PIN_BUZZER);
-        delay(40);
-    }
-}
-
-/**
- * Sziréna hangjelzés (felfutó-lefutó) - BLOKKOLÓ
- */
-void beepSiren(int cycles, int minFreq, int maxFreq, int step, int toneMs, int pauseMs) {
-    for (int c = 0; c < cycles; c++) {
-        for (int f = minFreq; f <= maxFreq; f += step) {
-            tone(PIN_BUZZER, f);
-            delay(toneMs);
-        }
-        for (int f = maxFreq; f >= minFreq; f -= step) {
-            tone(PIN_BUZZER, f);
-            delay(toneMs);
-        }
-        noTone(PIN_BUZZER);
-        delay(pauseMs);
-    }
-}
-
-/**
- * Sziréna hangjelzés indítása - Nem blokkoló
- */
-void startNonBlockingSiren(int cycles, int minFreq, int maxFreq, int step, int toneMs, int pauseMs) {
-    if (sirenActive)
-        return;
-    siren_cycles = cycles;
-    siren_minFreq = minFreq;
-    siren_maxFreq = maxFreq;
-    siren_step = step;
-    siren_toneMs = toneMs;
-    siren_pauseMs = pauseMs;
-    sirenActive = true;
-    isPaused = false;
-    cyclesDone = 0;
-    currentFreq = siren_minFreq;
-    sweepingUp = true;
-    lastSirenActionTime = millis();
-    tone(PIN_BUZZER, currentFreq);
-}
-
-/**
- * Sziréna hangjelzés leállítása - Nem blokkoló
- */
-void stopNonBlockingSiren() {
-    sirenActive = false;
-    noTone(PIN_BUZZER);
-}
-
-/**
- * Sziréna hangjelzés kezelése  - Nem blokkoló
- */
-void handleNonBlockingSiren() {
-    if (!sirenActive) {
-        return;
-    }
-
-    unsigned long currentTime = millis();
-
-    if (isPaused) {
-        if (currentTime - lastSirenActionTime >= (unsigned long)siren_pauseMs) {
-            isPaused = false;
-            cyclesDone++;
-            if (cyclesDone >= siren_cycles) {
-                stopNonBlockingSiren();
-                return;
-            }
-            sweepingUp = true;
-            currentFreq = siren_minFreq;
-            tone(PIN_BUZZER, currentFreq);
-            lastSirenActionTime = currentTime;
-        }
-        return;
-    }
-
-    if (currentTime - lastSirenActionTime >= (unsigned long)siren_toneMs) {
-        lastSirenActionTime = currentTime;
-
-        if (sweepingUp) {
-            currentFreq += siren_step;
-            if (currentFreq > siren_maxFreq) {
-                currentFreq = siren_maxFreq;
-                sweepingUp = false;
-            }
-        } else {
-            currentFreq -= siren_step;
-            if (currentFreq < siren_minFreq) {
-                currentFreq = siren_minFreq;
-                noTone(PIN_BUZZER);
-                isPaused = true;
-                return;
-            }
-        }
-        tone(PIN_BUZZER, currentFreq);
-    }
-}
-
 /**
  * @brief CRC16 számítás (CCITT algoritmus)
  */
@@ -325,4 +114,18 @@ uint16_t calcCRC16(const uint8_t *data, size_t length) {
     return crc;
 }
 
+/**
+ * @brief A heap pillanatnyi állapota
+ *
+ * A newlib a heap tetejét (sbrk) nem engedi vissza, így az "arena" mező a csúcs kihasználtság.
+ */
+HeapStats getHeapStats() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2(); // Hoszt (native) build: a glibc-ben a mallinfo() elavult
+#else
+    struct mallinfo info = mallinfo();
+#endif
+    return {(uint32_t)info.arena, (uint32_t)info.uordblks, (uint32_t)info.fordblks, (uint32_t)info.ordblks};
+}
+
 }; // namespace Utils
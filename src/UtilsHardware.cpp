@@ -0,0 +1,84 @@
+#include <TFT_eSPI.h>
+
+#include "AudioEngine.h"
+#include "Utils.h"
+#include "defines.h"
+
+// A TFT-hez és a hanghoz kötött segédfüggvények (a hoszt build nélkülük fordítja az Utils.cpp-t)
+namespace Utils {
+
+/**
+ * Várakozás a soros port megnyitására
+ * @param tft a TFT kijelző példánya
+ */
+void debugWaitForSerial(TFT_eSPI &tft) {
+#ifdef __DEBUG
+    beepError();
+    tft.setTextColor(TFT_WHITE);
+    tft.setTextSize(2);
+    tft.drawString("Nyisd meg a soros portot!", 0, 0);
+    while (!Serial) {
+    }
+    tft.fillScreen(TFT_BLACK);
+    beepTick();
+#endif
+}
+
+/**
+ * TFT érintőképernyő kalibráció
+ * @param tft TFT kijelző példánya
+ * @param calData kalibrációs adatok
+ */
+void tftTouchCalibrate(TFT_eSPI &tft, uint16_t (&calData)[5]) {
+    tft.fillScreen(TFT_BLACK);
+    tft.setTextFont(2);
+    tft.setTextSize(2);
+    const char *txt = "TFT touch kalibracio kell!\n";
+    tft.setCursor((tft.width() - tft.textWidth(txt)) / 2, tft.height() / 2 - 60);
+    tft.setTextColor(TFT_ORANGE, TFT_BLACK);
+    tft.println(txt);
+
+    tft.setTextSize(1);
+    txt = "Erintsd meg a jelzett helyeken a sarkokat!\n";
+    tft.setCursor((tft.width() - tft.textWidth(txt)) / 2, tft.height() / 2 + 20);
+    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.println(txt);
+
+    // TFT_eSPI 'bóti' kalibráció indítása
+    tft.calibrateTouch(calData, TFT_YELLOW, TFT_BLACK, 15);
+
+    txt = "Kalibracio befejezodott!";
+    tft.fillScreen(TFT_BLACK);
+    tft.setCursor((tft.width() - tft.textWidth(txt)) / 2, tft.height() / 2);
+    tft.setTextColor(TFT_GREEN, TFT_BLACK);
+    tft.setTextSize(1);
+    tft.println(txt);
+
+    DEBUG("// Használd ezt a kalibrációs kódot a setup()-ban:\n");
+    DEBUG("  uint16_t calData[5] = { ");
+    for (uint8_t i = 0; i < 5; i++) {
+        DEBUG("%d", calData[i]);
+        if (i < 4) {
+            DEBUG(", ");
+        }
+    }
+    DEBUG(" };\n");
+    DEBUG("  tft.setTouch(calData);\n");
+}
+
+/**
+ *  Pitty hangjelzés
+ */
+void beepTick() { audioEngine.play(AudioEngine::Sound::Tick); }
+
+/**
+ * Hiba jelzés
+ */
+void beepError() { audioEngine.play(AudioEngine::Sound::Error); }
+
+/**
+ * Trafipax riasztó hangjelzés
+ */
+void beepAlert() { audioEngine.play(AudioEngine::Sound::Alert); }
+
+}; // namespace Utils
@@ -180,7 +180,7 @@ void ValueChangeDialog::createDialogContent() {
     // Itt csak az érték-specifikus gombokat kell létrehozni.    // Érték módosító gombok (csak integer és float esetén)
     if (_valueType == ValueType::Integer || _valueType == ValueType::Float || _valueType == ValueType::UInt8) {
         // Csökkentő gomb (-)
-        _decreaseButton = std::make_shared<UIButton>( //
+        _decreaseButton = makeComponent<UIButton>(    //
             BUTTON_DECREASE_ID,                       //
             Rect(0, 0, BUTTON_WIDTH, BUTTON_HEIGHT),  //
             "-",                                      //
@@ -198,7 +198,7 @@ void ValueChangeDialog::createDialogContent() {
         addChild(_decreaseButton);
 
         // Növelő gomb (+)
-        _increaseButton = std::make_shared<UIButton>( //
+        _increaseButton = makeComponent<UIButton>(    //
             BUTTON_INCREASE_ID,                       //
             Rect(0, 0, BUTTON_WIDTH, BUTTON_HEIGHT),  //
             "+",                                      //
@@ -216,7 +216,7 @@ void ValueChangeDialog::createDialogContent() {
 
     } else {
         // Boolean esetén FALSE/TRUE gombok létrehozása
-        _decreaseButton = std::make_shared<UIButton>(     //
+        _decreaseButton = makeComponent<UIButton>(        //
             BUTTON_DECREASE_ID,                           //
             Rect(0, 0, BUTTON_WIDTH + 10, BUTTON_HEIGHT), //
             "FALSE",                                      //
@@ -232,7 +232,7 @@ void ValueChangeDialog::createDialogContent() {
         //_decreaseButton->setUseMiniFont(true);
         addChild(_decreaseButton);
 
-        _increaseButton = std::make_shared<UIButton>(     //
+        _increaseButton = makeComponent<UIButton>(        //
             BUTTON_INCREASE_ID,                           //
             Rect(0, 0, BUTTON_WIDTH + 10, BUTTON_HEIGHT), //
             "TRUE",                                       //
@@ -0,0 +1,361 @@
+#include "VoicePrompt.h"
+#include "AudioEngine.h"
+#include "TaskScheduler.h"
+#include "defines.h"
+
+#include <algorithm>
+#include <hardware/clocks.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/pwm.h>
+#include <hardware/sync.h>
+
+// A klipek fájlnevei (a /voice könyvtárban, .adp kiterjesztéssel)
+const char *const VoicePrompt::CLIP_FILES[static_cast<uint8_t>(Clip::COUNT)] = {
+    "traffipax", "100", "200", "300", "400", "500", "600", "700", "800", "900", "1000", "meter",
+};
+
+VoicePrompt *VoicePrompt::instance = nullptr;
+
+/**
+ * DMA csatorna, DMA időzítő és megszakítás lefoglalása, a klipek meglétének ellenőrzése
+ */
+void VoicePrompt::begin(uint8_t refillTaskId) {
+    this->refillTaskId = refillTaskId;
+
+    // Minden klipnek meg kell lennie, a mintavételi frekvenciát az első fejléce adja
+    char path[24];
+    for (uint8_t i = 0; i < static_cast<uint8_t>(Clip::COUNT); i++) {
+        clipPath(static_cast<Clip>(i), path, sizeof(path));
+        if (!LittleFS.exists(path)) {
+            DEBUG("VoicePrompt: %s nem található, a bejelentések kikapcsolva\n", path);
+            return;
+        }
+    }
+    clipPath(Clip::Traffipax, path, sizeof(path));
+    File file = LittleFS.open(path, "r");
+    VoiceClipHeader header;
+    bool headerOk = file && file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) && memcmp(header.magic, "VPA1", 4) == 0 && header.sampleRate != 0;
+    file.close();
+    if (!headerOk) {
+        DEBUG("VoicePrompt: hibás klip fejléc: %s\n", path);
+        return;
+    }
+    sampleRate = header.sampleRate;
+
+    // A DMA cél a buzzer szeletének CC regisztere; a 32 bites írás a szelet másik csatornáját 0-ra állítja,
+    // de annak a lába (PIN_DS18B20_TEMP_SENSOR) nem PWM funkciójú
+    uint slice = audioEngine.getPwmSlice();
+    pwmCc = &pwm_hw->slice[slice].cc;
+    ccShift = audioEngine.getPwmChannel() ? 16 : 0;
+
+    dmaChannel = dma_claim_unused_channel(false);
+    dmaTimer = dma_claim_unused_timer(false);
+    if (dmaChannel < 0 || dmaTimer < 0) {
+        DEBUG("VoicePrompt: nincs szabad DMA csatorna/időzítő\n");
+        return;
+    }
+
+    // A mintavételi ütem: clk_sys * X / Y (X = 1)
+    dma_timer_set_fraction(dmaTimer, 1, clock_get_hz(clk_sys) / sampleRate);
+
+    dma_channel_config dmaConfig = dma_channel_get_default_config(dmaChannel);
+    channel_config_set_transfer_data_size(&dmaConfig, DMA_SIZE_32);
+    channel_config_set_read_increment(&dmaConfig, true);
+    channel_config_set_write_increment(&dmaConfig, false);
+    channel_config_set_dreq(&dmaConfig, dma_get_timer_dreq(dmaTimer));
+    dma_channel_configure(dmaChannel, &dmaConfig, pwmCc, buffers[0], BUFFER_SAMPLES, false);
+
+    // A megszakítás a hívó (Core0) magján fut
+    instance = this;
+    dma_channel_set_irq1_enabled(dmaChannel, true);
+    irq_add_shared_handler(DMA_IRQ_1, onDmaIrq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    available = true;
+    DEBUG("VoicePrompt: klipek rendben, %u Hz\n", sampleRate);
+}
+
+/**
+ * Traffipax bejelentés a távolsággal
+ */
+bool VoicePrompt::announceCamera(float distanceMeters) {
+    // 100 méterre kerekítve, 100..1900 között: "traffipax [ezer] [N száz] méter"
+    int hundreds = (int)((distanceMeters + 50.0f) / 100.0f);
+    hundreds = constrain(hundreds, 1, 19);
+
+    Clip clips[MAX_PHRASE_CLIPS];
+    uint8_t count = 0;
+    clips[count++] = Clip::Traffipax;
+    if (hundreds >= 10) {
+        clips[count++] = Clip::N1000;
+        hundreds -= 10;
+    }
+    if (hundreds > 0) {
+        clips[count++] = static_cast<Clip>(static_cast<uint8_t>(Clip::N100) + hundreds - 1);
+    }
+    clips[count++] = Clip::Meters;
+
+    return play(clips, count);
+}
+
+/**
+ * Klip sorozat lejátszása
+ */
+bool VoicePrompt::play(const Clip *clips, uint8_t count) {
+    if (!available || count == 0) {
+        return false;
+    }
+
+    // A futó bejelentés helyére lép, a PWM közben nálunk marad (a kimenet a csend szintjén vár),
+    // különben a 0 kitöltésről úszik fel a csend szintjére
+    if (playing) {
+        halt();
+        parkOutput();
+        fadeInLeft = 0;
+    } else {
+        audioEngine.acquirePcm(PCM_TOP);
+        fadeInLeft = FADE_SAMPLES;
+    }
+
+    phraseLength = std::min<uint8_t>(count, MAX_PHRASE_CLIPS);
+    memcpy(phrase, clips, phraseLength * sizeof(Clip));
+    phrasePos = 0;
+    endOfPhrase = false;
+    fadingOut = false;
+    readyCount = 0;
+    playIndex = 0;
+    fillIndex = 0;
+    playing = true;
+
+    // Az első pufferek azonnal, a többit a "voice" feladat tölti
+    refill();
+    return true;
+}
+
+/**
+ * A bejelentés leállítása
+ */
+void VoicePrompt::stop() {
+    if (!playing || fadingOut) {
+        return;
+    }
+
+    // A félbehagyott klip helyett a csend szintjéről úszik le a kimenet, a végén a refill() adja vissza a PWM-et
+    halt();
+    parkOutput();
+    endOfPhrase = true;
+    fadingOut = true;
+    readyCount = 0;
+    playIndex = 0;
+    fillIndex = 0;
+    queueBuffer(fillFadeOut(buffers[fillIndex]));
+}
+
+/**
+ * A leúsztatás után
+ */
+void VoicePrompt::finish() {
+    halt();
+    playing = false;
+    fadingOut = false;
+    audioEngine.releasePcm();
+}
+
+/**
+ * A kimenet a csend szintjére
+ */
+void VoicePrompt::parkOutput() {
+    // A szelet másik csatornáját nem bántjuk
+    hw_write_masked(pwmCc, ccValue(PCM_MIDPOINT), 0xFFFFu << ccShift);
+}
+
+/**
+ * A DMA leállítása, a klip bezárása
+ */
+void VoicePrompt::halt() {
+    // Az abort is kiválthat megszakítást: arra az időre letiltjuk
+    dma_channel_set_irq1_enabled(dmaChannel, false);
+    dma_channel_abort(dmaChannel);
+    dma_channel_acknowledge_irq1(dmaChannel);
+    dma_channel_set_irq1_enabled(dmaChannel, true);
+    dmaRunning = false;
+
+    if (clipFile) {
+        clipFile.close();
+    }
+    samplesLeft = 0;
+}
+
+/**
+ * A szabad pufferek feltöltése
+ */
+void VoicePrompt::refill() {
+    if (!playing) {
+        return;
+    }
+
+    while (!endOfPhrase && readyCount < BUFFER_COUNT) {
+        uint16_t length = fillBuffer(buffers[fillIndex]);
+        if (length == 0) {
+            // A klipek elfogytak: utolsó pufferként a leúsztatás
+            length = fillFadeOut(buffers[fillIndex]);
+            endOfPhrase = true;
+            fadingOut = true;
+        }
+        queueBuffer(length);
+    }
+
+    // Minden elhangzott (a leúsztatás is): a PWM vissza az AudioEngine-nek
+    if (endOfPhrase && readyCount == 0) {
+        finish();
+    }
+}
+
+/**
+ * Puffer sorba állítása
+ */
+void VoicePrompt::queueBuffer(uint16_t length) {
+    bufferLength[fillIndex] = length;
+    fillIndex = (fillIndex + 1) % BUFFER_COUNT;
+
+    // A megszakítás csökkentheti a számlálót: a növelés alatt nem szólhat közbe
+    uint32_t irqState = save_and_disable_interrupts();
+    readyCount = readyCount + 1;
+    bool startNow = !dmaRunning;
+    if (startNow) {
+        dmaRunning = true;
+    }
+    restore_interrupts(irqState);
+
+    // Alulcsordulás után (vagy a legelején) újraindítjuk a DMA-t
+    if (startNow) {
+        startDma();
+    }
+}
+
+/**
+ * A DMA megszakítás kezelője
+ */
+void VoicePrompt::onDmaIrq() {
+    if (instance && instance->dmaChannel >= 0 && dma_channel_get_irq1_status(instance->dmaChannel)) {
+        dma_channel_acknowledge_irq1(instance->dmaChannel);
+        instance->onBufferDone();
+    }
+}
+
+/**
+ * A puffer végén
+ */
+void VoicePrompt::onBufferDone() {
+    readyCount = readyCount - 1;
+    playIndex = (playIndex + 1) % BUFFER_COUNT;
+
+    if (readyCount > 0) {
+        startDma();
+    } else {
+        // Alulcsordulás vagy vége: a csend szintje, amíg a töltő feladat újra nem indítja (a vége már 0-ra úszott)
+        dmaRunning = false;
+        if (!fadingOut) {
+            parkOutput();
+        }
+    }
+
+    core0Scheduler.signal(refillTaskId);
+}
+
+/**
+ * A következő feltöltött puffer DMA átvitelének indítása
+ */
+void VoicePrompt::startDma() { dma_channel_transfer_from_buffer_now(dmaChannel, buffers[playIndex], bufferLength[playIndex]); }
+
+/**
+ * Egy puffer feltöltése a klipekből
+ */
+uint16_t VoicePrompt::fillBuffer(uint32_t *dst) {
+    // Egyszerre ennyi ADPCM bájtot olvasunk (két minta / bájt)
+    static constexpr uint16_t CHUNK_BYTES = 32;
+    uint8_t adpcm[CHUNK_BYTES];
+    int16_t pcm[CHUNK_BYTES * 2];
+
+    // A minták száma klipenként páros (a kódoló így készíti), ezért mindig egész bájtokat olvasunk
+    uint16_t filled = 0;
+
+    // A bejelentés eleje: a 0 kitöltésről (acquirePcm) fel a csend szintjére
+    while (fadeInLeft > 0 && filled < BUFFER_SAMPLES) {
+        dst[filled++] = ccValue((uint32_t)PCM_MIDPOINT * (FADE_SAMPLES - fadeInLeft + 1) / FADE_SAMPLES);
+        fadeInLeft--;
+    }
+
+    while (filled < BUFFER_SAMPLES) {
+        if (samplesLeft == 0 && !openNextClip()) {
+            break;
+        }
+
+        uint32_t samples = std::min<uint32_t>({(uint32_t)(BUFFER_SAMPLES - filled), samplesLeft, CHUNK_BYTES * 2u});
+        uint16_t bytes = samples / 2;
+        if (clipFile.read(adpcm, bytes) != bytes) {
+            DEBUG("VoicePrompt: olvasási hiba\n");
+            samplesLeft = 0;
+            clipFile.close();
+            continue;
+        }
+        ImaAdpcm::decode(decoderState, adpcm, bytes, pcm);
+
+        // 16 bites előjeles minta -> PWM kitöltés (0..PCM_TOP), a csatorna helyére tolva
+        for (uint32_t i = 0; i < samples; i++) {
+            dst[filled++] = ccValue((uint32_t)(pcm[i] + 32768) >> (16 - PCM_BITS));
+        }
+        samplesLeft -= samples;
+        if (samplesLeft == 0) {
+            clipFile.close();
+        }
+    }
+    return filled;
+}
+
+/**
+ * A leúsztató minták
+ */
+uint16_t VoicePrompt::fillFadeOut(uint32_t *dst) {
+    // A felvett beszéd csenddel ér véget, ezért a csend szintjéről indulunk
+    for (uint16_t i = 0; i < FADE_SAMPLES; i++) {
+        dst[i] = ccValue((uint32_t)PCM_MIDPOINT * (FADE_SAMPLES - 1 - i) / FADE_SAMPLES);
+    }
+    return FADE_SAMPLES;
+}
+
+/**
+ * A bejelentés következő klipjének megnyitása
+ */
+bool VoicePrompt::openNextClip() {
+    while (phrasePos < phraseLength) {
+        char path[24];
+        clipPath(phrase[phrasePos++], path, sizeof(path));
+
+        clipFile = LittleFS.open(path, "r");
+        VoiceClipHeader header;
+        if (!clipFile || clipFile.read((uint8_t *)&header, sizeof(header)) != sizeof(header) || memcmp(header.magic, "VPA1", 4) != 0) {
+            DEBUG("VoicePrompt: hibás klip: %s\n", path);
+            clipFile.close();
+            continue;
+        }
+
+        // Eltérő mintavételű klipet nem játszunk le (a DMA időzítő egy bejelentésen belül nem vált)
+        if (header.sampleRate != sampleRate) {
+            DEBUG("VoicePrompt: %s mintavétele %u Hz, elvárt %u Hz\n", path, header.sampleRate, sampleRate);
+            clipFile.close();
+            continue;
+        }
+
+        samplesLeft = header.sampleCount & ~1u;
+        decoderState = ImaAdpcm::State();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * A klip fájl neve
+ */
+void VoicePrompt::clipPath(Clip clip, char *path, size_t size) { snprintf(path, size, "/voice/%s.adp", CLIP_FILES[static_cast<uint8_t>(clip)]); }
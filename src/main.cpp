@@ -10,6 +10,9 @@ TFT_eSPI tft;
 uint16_t SCREEN_W;
 uint16_t SCREEN_H;
 
+#include "AdcSampler.h"
+AdcSampler adcSampler; // Szabadon futó ADC (DMA gyűrű puffer + túlmintavételezés)
+
 #include "SensorUtils.h"
 SensorUtils sensorUtils;
 
@@ -19,7 +22,29 @@ TftBackLightAdjuster tftBackLightAdjuster;
 #include "TraffipaxManager.h"
 TraffipaxManager traffipaxManager; // Automatikusan betölti a CSV-t
 
+#include "AudioEngine.h"
+AudioEngine audioEngine; // Nem blokkoló buzzer hangok (PWM + időzítő megszakítás)
+
+#include "VoicePrompt.h"
+VoicePrompt voicePrompt; // LittleFS-en tárolt ADPCM bejelentések (PWM + DMA)
+
+#include "LatencyProbe.h"
+LatencyProbe latencyProbe; // Riasztási és érintési késleltetés mérés (UART / PENIRQ -> pixelek)
+
+#include "CodeProfiler.h"
+CodeProfiler codeProfiler; // XIP cache találati arány, __CODE_PROFILE esetén PC mintavételezés
+
+#include "TouchSampler.h"
+TouchSampler touchSampler(tft); // PENIRQ vezérelt, szűrt érintés mintavétel
+
+#include "StatusLed.h"
+StatusLed statusLed(PIN_INTERNAL_RGB_LED); // PIO vezérelt WS2812 státusz LED
+
 //-------------------- Screens
+#include "UIArena.h"
+ScreenArenaPool screenArenaPool; // A képernyők és komponenseik slab-jai (bump allokátor, nem aprózza a heap-et)
+DialogArenaPool dialogArenaPool; // A dialógusok és gombjaik slab-jai
+
 // Globális képernyőkezelő pointer - inicializálás a setup()-ban történik
 #include "ScreenManager.h"
 ScreenManager *screenManager = nullptr;
@@ -29,6 +54,31 @@ IScreenManager **iScreenManager = (IScreenManager **)&screenManager; // A UIComp
 #include "GpsManager.h"
 GpsManager *gpsManager = nullptr;
 
+//-------------------- Traffipax riasztás kiértékelés (Core1)
+#include "TraffipaxAlertEvaluator.h"
+TraffipaxAlertEvaluator *traffipaxAlertEvaluator = nullptr;
+
+//-------------------- Flash írások
+#include "FlashWriteService.h"
+FlashWriteService flashWriteService; // Flash írások biztonságos pontra ütemezése (fix epocha után, riasztás nélkül)
+
+//-------------------- Ütemezők
+#include "TaskScheduler.h"
+TaskScheduler core0Scheduler("core0");
+TaskScheduler core1Scheduler("core1");
+uint8_t uiTaskId = TaskScheduler::INVALID_TASK;    // Core0: képernyőkezelő (a Core1 GPS/riasztás eseményei ébresztik)
+uint8_t alertTaskId = TaskScheduler::INVALID_TASK; // Core1: traffipax kiértékelő (az új fix epocha ébreszti)
+
+// Core0/Core1 feladatok periódusai
+#define TOUCH_TASK_INTERVAL_MS 10                  // Érintés mintavétel lenyomva (elengedve csak a PENIRQ lábat nézi)
+#define UI_TASK_INTERVAL_MS 10                     // Képernyőkezelő loop (ha nincs esemény)
+#define CONFIG_DISPATCH_INTERVAL_MS 50             // A másik magról jelzett config változások kézbesítése
+#define CONFIG_SAVE_CHECK_INTERVAL (1000 * 60 * 5) // 5 perc
+#define GPS_TASK_INTERVAL_MS 2                     // GPS UART kiolvasás (9600 baud ~ 1 bájt/ms)
+#define ALERT_TASK_INTERVAL_MS 100                 // Traffipax kiértékelő watchdog/demó időzítője
+#define SATELLITE_DB_MAINTENANCE_INTERVAL_MS 1000  // Műhold adatbázis karbantartás
+#define STATUS_LED_UPDATE_INTERVAL_MS 500          // GPS állapot -> státusz LED minta
+
 //-------------------- Global Runtime variables
 bool demoMode = false;              // Demó mód
 volatile bool configLoaded = false; // Jelezzük, hogy a config betöltődött
@@ -82,6 +132,35 @@ void drawSplashScreen() {
     tft.drawString(countBuffer, tft.width() / 2, 272, 1);
 }
 
+/**
+ * @brief Core0 feladatok regisztrálása
+ */
+void registerCore0Tasks() {
+    // Érintés mintavétel: a PENIRQ él azonnal ébreszti, lenyomva periodikusan követi a felengedésig
+    uint8_t touchTaskId = core0Scheduler.addPeriodicTask("touch", TOUCH_TASK_INTERVAL_MS, []() { touchSampler.sample(); });
+    touchSampler.begin(touchTaskId);
+
+    // Deferred actions feldolgozása - biztonságos képernyőváltások végrehajtása, GPS/riasztás események, rajzolás
+    uiTaskId = core0Scheduler.addPeriodicTask("ui", UI_TASK_INTERVAL_MS, []() { screenManager->loop(); });
+
+    // A Core1-ről jelzett config változások kézbesítése a Core0 feliratkozóinak
+    core0Scheduler.addPeriodicTask("config", CONFIG_DISPATCH_INTERVAL_MS, []() { config.dispatchPending(); });
+
+    // Konfig mentés figyelése (csak a változások kerülnek a flash naplóba)
+    core0Scheduler.addPeriodicTask("cfgsave", CONFIG_SAVE_CHECK_INTERVAL, []() { config.checkSave(); });
+
+    // Függő flash írások végrehajtása biztonságos ponton (a Core1 a fix epocha után ébreszti)
+    uint8_t flashTaskId = core0Scheduler.addPeriodicTask("flash", FlashWriteService::PROCESS_INTERVAL_MS, []() { flashWriteService.process(); });
+    flashWriteService.begin(flashTaskId);
+
+    // Beszédhang pufferek dekódolása előre (a DMA megszakítás ébreszti)
+    uint8_t voiceTaskId = core0Scheduler.addEventTask("voice", []() { voicePrompt.refill(); });
+    voicePrompt.begin(voiceTaskId);
+
+    // XIP cache számlálók gyűjtése (a hardveres számlálók túlcsordulása előtt)
+    core0Scheduler.addPeriodicTask("xipstat", CodeProfiler::XIP_SAMPLE_INTERVAL_MS, []() { codeProfiler.sampleXipCache(); });
+}
+
 /**
  * @brief Setup függvény
  */
@@ -92,9 +171,11 @@ void setup() {
     Serial.begin(115200);
 #endif
 
-    // Beeper
-    pinMode(PIN_BUZZER, OUTPUT);
-    digitalWrite(PIN_BUZZER, LOW);
+    // Beeper: PWM szelet + időzítő megszakítás a Core0-n
+    audioEngine.begin();
+
+    // Státusz LED: PIO állapotgép + alarm a Core0-n
+    statusLed.begin();
 
     // TFT
     tft.begin();
@@ -126,7 +207,7 @@ void setup() {
     delay(1000);
 
     // Config
-    StoreEepromBase<Config_t>::init(); // Meghívjuk a statikus init metódust
+    StoreJournalBase<Config_t>::init(); // Meghívjuk a statikus init metódust
 
     uint16_t x, y;
     if (tft.getTouch(&x, &y)) {
@@ -141,7 +222,7 @@ void setup() {
 
             // és el is mentjük
             DEBUG("Save default settings...\n");
-            config.checkSave();
+            config.forceSave();
 
             Utils::beepTick();
             DEBUG("Default settings restored!\n");
@@ -162,7 +243,7 @@ void setup() {
     if (Utils::isZeroArray(config.data.tftCalibrateData)) {
         Utils::beepError();
         Utils::tftTouchCalibrate(tft, config.data.tftCalibrateData);
-        config.checkSave(); // el is mentjük a kalibrációs adatokat
+        config.forceSave(); // el is mentjük a kalibrációs adatokat
     }
     // Beállítjuk a touch scren-t
     tft.setTouch(config.data.tftCalibrateData);
@@ -174,64 +255,73 @@ void setup() {
     if (screenManager == nullptr) {
         screenManager = new ScreenManager();
     }
-    screenManager->switchToScreen(SCREEN_NAME_MAIN); // A kezdő képernyőre kapcsolás
+    screenManager->switchToScreen(ScreenId::Main); // A kezdő képernyőre kapcsolás
+
+    // Core0 feladatok
+    registerCore0Tasks();
+    codeProfiler.begin();
 
     // Pittyentünk egyet, hogy üzemkészek vagyunk
     Utils::beepTick();
 }
 
 /**
- *
+ * Core0 loop: az esedékes feladatok futtatása, közben alvás
+ */
+void loop() { core0Scheduler.run(); }
+
+// ------------------------------------------------------------------------------------------------------------------------------
+// Core1
+// ------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Core1 feladatok regisztrálása
  */
-void loop() {
-
-    // Handle non-blocking siren
-    Utils::handleNonBlockingSiren();
-
-    //------------------- Touch esemény kezelése
-    uint16_t touchX, touchY;
-    bool touchedRaw = tft.getTouch(&touchX, &touchY);
-    bool validCoordinates = true;
-    if (touchedRaw) {
-        if (touchX > tft.width() || touchY > tft.height()) {
-            validCoordinates = false;
+void registerCore1Tasks() {
+    // A Core0-n mentett config változások kézbesítése a Core1 feliratkozóinak (GPS, traffipax, háttérvilágítás)
+    core1Scheduler.addPeriodicTask("config", CONFIG_DISPATCH_INTERVAL_MS, []() { config.dispatchPending(); });
+
+    // GPS olvasás; az új fix epocha azonnal ébreszti a riasztás kiértékelőt, a kész események a Core0 képernyőkezelőt,
+    // a UART elcsendesedése a halasztott flash törlést
+    core1Scheduler.addPeriodicTask("gps", GPS_TASK_INTERVAL_MS, []() {
+        gpsManager->loop();
+        if (gpsManager->isFixEpochPending()) {
+            core1Scheduler.signal(alertTaskId);
+            flashWriteService.onFixEpoch(traffipaxAlertEvaluator->isAlertActive());
         }
-    }
+        flashWriteService.onGpsPoll(gpsManager->getLastRxMicros());
+        if (gpsManager->hasPendingEvents()) {
+            core0Scheduler.signal(uiTaskId);
+        }
+    });
 
-    static bool lastTouchState = false;
-    static uint16_t lastTouchX = 0, lastTouchY = 0;
-    bool touched = touchedRaw && validCoordinates;
-
-    // Touch press event (immediate response)
-    if (touched && !lastTouchState) {
-        TouchEvent touchEvent(touchX, touchY, true);
-        screenManager->handleTouch(touchEvent);
-        lastTouchX = touchX;
-        lastTouchY = touchY;
-    } else if (!touched && lastTouchState) { // Touch release event (immediate response)
-        TouchEvent touchEvent(lastTouchX, lastTouchY, false);
-        screenManager->handleTouch(touchEvent);
-    }
+    // Traffipax közelség kiértékelése az új fix epochára
+    alertTaskId = core1Scheduler.addPeriodicTask("alert", ALERT_TASK_INTERVAL_MS, []() {
+        traffipaxAlertEvaluator->loop();
+        if (traffipaxAlertEvaluator->hasPendingEvents()) {
+            core0Scheduler.signal(uiTaskId);
+        }
+    });
 
-    lastTouchState = touched;
+    // Műhold adatbázis karbantartása
+    core1Scheduler.addPeriodicTask("satdb", SATELLITE_DB_MAINTENANCE_INTERVAL_MS, []() { gpsManager->maintainSatelliteDb(); });
 
-    if (screenManager) {
-        // Deferred actions feldolgozása - biztonságos képernyőváltások végrehajtása
-        screenManager->loop();
-    }
+    // GPS állapot kijelzése a státusz LED-en (a villogtatást a PIO + alarm végzi, itt csak a minta választás)
+    core1Scheduler.addPeriodicTask("gpsled", STATUS_LED_UPDATE_INTERVAL_MS, []() { gpsManager->updateStatusLed(); });
 
-//------------------- EEPROM mentés figyelése
-#define EEPROM_SAVE_CHECK_INTERVAL 1000 * 60 * 5 // 5 perc
-    static uint32_t lastEepromSaveCheck = 0;
-    if (Utils::timeHasPassed(lastEepromSaveCheck, EEPROM_SAVE_CHECK_INTERVAL)) {
-        config.checkSave();
-        lastEepromSaveCheck = millis();
-    }
-}
+    // Háttérvilágitás cél fényerejének frissítése - csak ha nem screensaver aktív (az átmenetet a Core0 hardver alarm lépteti)
+    core1Scheduler.addPeriodicTask("light", SENSOR_CHECK_MSEC, []() {
+        if (screenManager && !screenManager->isCurrentScreenScreensaver()) {
+            tftBackLightAdjuster.updateTarget();
+        }
+    });
 
-// ------------------------------------------------------------------------------------------------------------------------------
-// Core1
-// ------------------------------------------------------------------------------------------------------------------------------
+    // ADC csatornák szűrt értékeinek frissítése (a mintákat a DMA gyűjti)
+    core1Scheduler.addPeriodicTask("adc", AdcSampler::RING_PERIOD_MS, []() { adcSampler.update(); });
+
+    // Szenzorok karbantartása
+    core1Scheduler.addPeriodicTask("sensors", SENSORS_LOOP_INTERVAL_MS, []() { sensorUtils.loop(); });
+}
 
 /**
  * Core1 setup
@@ -250,23 +340,19 @@ void setup1() {
     // GPS Init + konfiguráció
     gpsManager = new GpsManager(Serial1);
 
+    // Traffipax riasztás kiértékelő (a GPS epochákra ébred)
+    traffipaxAlertEvaluator = new TraffipaxAlertEvaluator();
+
     // Szenzor inicializálása
+    adcSampler.begin();
     sensorUtils.init();
+
+    // Core1 feladatok
+    registerCore1Tasks();
+    codeProfiler.begin();
 }
 
 /**
- * Core1 loop
+ * Core1 loop: az esedékes feladatok futtatása, közben alvás (a GPS UART megszakítása is ébreszt)
  */
-void loop1() {
-
-    // GPS olvasás
-    gpsManager->loop();
-
-    // Háttérvilágitás vezérlése - csak ha nem screensaver aktív
-    if (screenManager && !screenManager->isCurrentScreenScreensaver()) {
-        tftBackLightAdjuster.loop();
-    }
-
-    // Szenzorok karbantartása
-    sensorUtils.loop();
-}
+void loop1() { core1Scheduler.run(); }
@@ -0,0 +1,250 @@
+// Az encode_voice.py --test-vectors kimenete, kézzel nem szerkesztendő
+#pragma once
+
+#include <stdint.h>
+
+namespace AdpcmVectors {
+
+static constexpr uint32_t CLIP_SIZE = 1012;
+static constexpr uint32_t SAMPLE_COUNT = 2000;
+
+// A teljes .adp fájl (fejléc + ADPCM adat)
+static const uint8_t CLIP[CLIP_SIZE] = {
+    86, 80, 65, 49, 64, 31, 0, 0, 208, 7, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    119, 119, 119, 119, 119, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 255, 255, 255, 255, 255, 159, 128, 8, 136, 128, 8, 136, 128, 8,
+    136, 128, 8, 136, 128, 8, 136, 128, 8, 136, 128, 8, 136, 128, 8, 136,
+    128, 8, 136, 128, 8, 136, 128, 8, 136, 128, 128, 128, 128, 128, 8, 8,
+    136, 128, 128, 144, 119, 119, 119, 119, 119, 23, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 255, 159, 128, 8, 136, 128,
+    8, 136, 128, 8, 136, 128, 8, 136, 128, 8, 136, 128, 8, 136, 128, 8,
+    136, 128, 8, 136, 128, 8, 136, 128, 8, 136, 128, 8, 136, 128, 128, 128,
+    128, 128, 8, 8, 136, 128, 128, 144, 119, 119, 119, 119, 119, 4, 8, 128,
+    128, 136, 136, 153, 153, 169, 154, 154, 136, 16, 67, 53, 52, 36, 34, 0,
+    186, 205, 188, 172, 138, 24, 83, 52, 36, 18, 153, 204, 188, 155, 25, 83,
+    52, 20, 128, 203, 188, 155, 32, 69, 35, 130, 203, 189, 138, 49, 69, 18,
+    169, 189, 154, 49, 53, 3, 217, 172, 137, 67, 36, 160, 204, 138, 50, 37,
+    160, 188, 138, 83, 35, 185, 174, 24, 52, 146, 235, 10, 66, 18, 202, 155,
+    81, 19, 217, 154, 65, 19, 218, 139, 67, 2, 219, 26, 83, 144, 172, 48,
+    20, 202, 11, 52, 161, 173, 65, 2, 188, 40, 21, 201, 26, 36, 200, 138,
+    36, 176, 140, 67, 176, 140, 52, 200, 11, 52, 201, 26, 21, 186, 57, 133,
+    187, 81, 162, 156, 36, 200, 25, 4, 187, 66, 177, 12, 21, 202, 64, 161,
+    11, 20, 187, 81, 176, 42, 133, 156, 51, 202, 72, 178, 44, 131, 156, 36,
+    187, 97, 184, 73, 161, 43, 149, 12, 132, 154, 35, 172, 51, 203, 66, 201,
+    80, 200, 48, 184, 88, 184, 64, 184, 88, 184, 64, 200, 49, 201, 49, 186,
+    67, 172, 20, 140, 3, 12, 148, 43, 195, 73, 192, 48, 201, 35, 141, 148,
+    42, 194, 56, 200, 34, 140, 148, 59, 210, 48, 170, 4, 28, 195, 72, 185,
+    4, 28, 178, 64, 155, 132, 60, 192, 34, 12, 179, 89, 154, 148, 74, 184,
+    3, 61, 192, 18, 44, 193, 33, 28, 194, 33, 28, 194, 33, 45, 193, 2,
+    59, 192, 131, 76, 153, 164, 73, 11, 195, 33, 45, 176, 148, 90, 138, 195,
+    17, 59, 184, 165, 72, 28, 177, 164, 73, 27, 210, 147, 73, 28, 177, 164,
+    56, 44, 168, 181, 17, 76, 10, 194, 163, 56, 61, 153, 196, 130, 57, 44,
+    168, 197, 130, 57, 60, 138, 211, 163, 1, 91, 43, 152, 212, 163, 16, 91,
+    43, 137, 211, 180, 146, 56, 61, 59, 137, 210, 180, 163, 16, 91, 60, 59,
+    10, 210, 180, 179, 146, 16, 92, 60, 59, 26, 136, 210, 180, 196, 163, 145,
+    0, 57, 76, 60, 75, 59, 43, 9, 144, 194, 196, 180, 196, 179, 179, 179,
+    179, 179, 163, 145, 0, 57, 76, 76, 60, 75, 60, 75, 60, 75, 59, 60,
+    59, 75, 59, 59, 60, 59, 42, 26, 123, 153, 89, 43, 211, 10, 98, 186,
+    166, 9, 17, 27, 181, 177, 0, 89, 26, 242, 129, 145, 132, 77, 168, 144,
+    148, 42, 161, 50, 13, 25, 124, 11, 41, 2, 63, 59, 139, 72, 9, 160,
+    10, 133, 80, 200, 129, 227, 178, 48, 76, 153, 131, 44, 57, 171, 51, 79,
+    144, 40, 248, 16, 40, 225, 2, 161, 137, 168, 21, 13, 131, 41, 92, 11,
+    177, 33, 137, 57, 35, 63, 28, 74, 136, 128, 63, 41, 27, 192, 132, 9,
+    196, 144, 72, 26, 9, 34, 13, 74, 58, 185, 121, 43, 57, 60, 177, 177,
+    19, 31, 40, 58, 9, 15, 72, 0, 58, 28, 138, 163, 213, 3, 139, 137,
+    36, 140, 129, 181, 168, 48, 137, 213, 32, 32, 248, 130, 40, 184, 150, 160,
+    195, 25, 212, 145, 131, 177, 134, 152, 145, 147, 26, 32, 248, 136, 120, 42,
+    138, 145, 75, 200, 215, 147, 8, 106, 154, 16, 88, 152, 152, 168, 183, 180,
+    32, 60, 9, 136, 41, 105, 136, 107, 137, 210, 130, 41, 155, 120, 136, 40,
+    168, 169, 183, 34, 45, 193, 128, 56, 168, 181, 161, 145, 16, 166, 0, 136,
+    136, 128, 128, 0, 136, 128, 0, 8, 136, 0, 136, 128, 0, 136, 0, 8,
+    136, 0, 136, 128, 0, 136, 0, 136, 0, 136, 0, 136, 0, 136, 128, 128,
+    128, 128, 0, 8, 8, 8, 8, 8, 9, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0,
+};
+
+// A Python dekóder (decode_nibble) mintái
+static const int16_t EXPECTED[SAMPLE_COUNT] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 11, 41, 104, 240,
+    533, 1164, 2521, 5431, 11667, 25039, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32756, 32726, 32663, 32527, 32234, 31603, 30246, 27336, 21100, 7728, -20938, -32768,
+    -29044, -32429, -32768, -29970, -32513, -32768, -30666, -32577, -32768, -31189, -32624, -32768,
+    -31582, -32660, -32768, -31877, -32687, -32768, -32099, -32707, -32768, -32265, -32722, -32768,
+    -32390, -32733, -32768, -32484, -32742, -32768, -32555, -32749, -32768, -32608, -32753, -32768,
+    -32648, -32757, -32768, -32678, -32760, -32768, -32700, -32761, -32768, -32717, -32763, -32768,
+    -32730, -32764, -32768, -32740, -32766, -32768, -32747, -32766, -32768, -32752, -32766, -32768,
+    -32756, -32767, -32768, -32759, -32767, -32768, -32762, -32768, -32763, -32768, -32764, -32768,
+    -32765, -32768, -32765, -32767, -32768, -32766, -32768, -32766, -32767, -32768, -32767, -32768,
+    -32767, -32768, -32767, -32768, -32757, -32727, -32664, -32528, -32235, -31604, -30247, -27337,
+    -21101, -7729, 20937, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767,
+    32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767, 32756, 32726, 32663, 32527,
+    32234, 31603, 30246, 27336, 21100, 7728, -20938, -32768, -29044, -32429, -32768, -29970,
+    -32513, -32768, -30666, -32577, -32768, -31189, -32624, -32768, -31582, -32660, -32768, -31877,
+    -32687, -32768, -32099, -32707, -32768, -32265, -32722, -32768, -32390, -32733, -32768, -32484,
+    -32742, -32768, -32555, -32749, -32768, -32608, -32753, -32768, -32648, -32757, -32768, -32678,
+    -32760, -32768, -32700, -32761, -32768, -32717, -32763, -32768, -32730, -32764, -32768, -32740,
+    -32766, -32768, -32747, -32766, -32768, -32752, -32766, -32768, -32756, -32767, -32768, -32759,
+    -32767, -32768, -32762, -32768, -32763, -32768, -32764, -32768, -32765, -32768, -32765, -32767,
+    -32768, -32766, -32768, -32766, -32767, -32768, -32767, -32768, -32767, -32768, -32767, -32768,
+    -32757, -32727, -32664, -32528, -32235, -31604, -30247, -27337, -21101, -7729, 9471, 11783,
+    9681, 11592, 13329, 11750, 13185, 11880, 10694, 9616, 8636, 7745, 5314, 3105,
+    1097, -728, -2388, -4904, -7191, -8437, -10327, -11357, -11669, -11953, -11695, -10992,
+    -9500, -7754, -5173, -2769, 42, 2688, 5780, 7858, 9748, 11465, 11777, 12061,
+    10770, 9128, 6782, 3971, 569, -2633, -6375, -8891, -11178, -11593, -11971, -10941,
+    -8756, -5632, -1890, 1632, 5749, 8516, 11032, 12404, 11158, 10024, 6932, 3190,
+    -1339, -5599, -9473, -10982, -12354, -11108, -8462, -4683, -154, 4106, 9087, 11095,
+    11703, 11150, 7628, 3511, -1470, -6157, -10417, -12077, -11574, -9287, -4714, 765,
+    5921, 9269, 12312, 11759, 8237, 4120, -1968, -7641, -11324, -11993, -10168, -6294,
+    -759, 5871, 10328, 12759, 10550, 7202, 506, -5734, -9786, -11995, -9987, -5727,
+    361, 6034, 11190, 11859, 10034, 3946, -3348, -8250, -10924, -11734, -6578, -551,
+    6743, 11645, 12536, 8484, 1854, -6169, -11562, -12542, -8085, -2412, 5691, 11084,
+    12064, 7607, 313, -6550, -11007, -11817, -6661, 705, 7568, 12025, 9594, 4438,
+    -4268, -10200, -11278, -8337, -314, 7236, 12138, 9464, 3791, -5786, -12312, -11126,
+    -5733, 3092, 9024, 12259, 7357, -666, -8216, -11157, -8483, 432, 8737, 11972,
+    9031, -775, -7301, -10860, -7625, 1200, 9505, 12740, 7838, -1968, -11104, -12290,
+    -4740, 4085, 10017, 11095, 4232, -5574, -12100, -8541, -991, 9795, 11230, 7315,
+    -3364, -10542, -9237, -932, 8776, 12691, 6759, -2949, -12085, -10899, -1191, 7945,
+    11504, 6111, -4675, -11853, -7938, 2741, 9919, 11224, 545, -9504, -10809, -4877,
+    6988, 11725, 7419, -4328, -12224, -7918, 3829, 11725, 10290, -1457, -9353, -10788,
+    959, 8855, 10290, 1154, -9525, -10960, -1824, 8855, 10290, 1154, -9525, -10960,
+    787, 11841, 10406, -1341, -12395, -10960, 787, 11841, 7535, -4212, -12108, -7802,
+    6555, 12288, 3602, -7452, -11758, -2622, 10430, 8693, -2361, -12410, -8495, 4557,
+    13243, 5347, -7575, -12786, 1428, 10983, 9246, -4968, -10701, -5490, 8724, 10635,
+    -1525, -12579, -5401, 6346, 11083, 1034, -10713, -9134, 6659, 12965, 3410, -12226,
+    -10124, 7076, 14013, 3502, -9875, -8138, 6076, 11809, -351, -11405, -7099, 7258,
+    9169, -2991, -10887, -3709, 10648, 8737, -6899, -13205, 172, 12332, 4436, -8486,
+    -10223, 3991, 13546, 1386, -12828, -3273, 8887, 7308, -5614, -10825, 3389, 12944,
+    784, -10270, -5964, 11004, 8692, -6023, -11756, 3880, 10186, 631, -11529, -3633,
+    12160, 5854, -11346, -9034, 9886, 7343, -4219, -10525, 2852, 11538, -2676, -12231,
+    -71, 10983, 934, -10813, -2917, 10005, 4794, -9420, -7509, 11601, 9058, -11754,
+    -8956, 8849, 6537, -8178, -10089, 9021, 6478, -9709, -7607, 9593, 7281, -7434,
+    -9345, 9765, 7222, -8965, -6863, 10337, 8025, -10895, -3265, 12922, 6616, -10584,
+    -3647, 11068, 1513, -10647, 407, 13329, -2307, -12818, 4382, 11319, -7601, -10144,
+    6043, 8145, -9055, -6743, 12177, 4547, -11640, -1129, 12248, -3388, -9694, 7506,
+    9818, -9102, -6559, 9628, 3322, -13878, 2309, 12820, -8202, -11000, 11893, 2661,
+    -11329, 1389, 12951, -5969, -8512, 7675, 5573, -11627, -65, 10446, -6754, -9066,
+    9854, 2224, -13963, 752, 10307, -8803, -6260, 9927, -584, -10139, 5497, 7599,
+    -9601, -2664, 12051, -5149, -7461, 11459, 3829, -12358, 6562, 9105, -11707, -3313,
+    9405, -6782, -4680, 12520, -3667, -9973, 7227, 4915, -14005, 3800, 6112, -12808,
+    -90, 11472, -7448, -4905, 11282, -3433, -9166, 9944, -2774, -9711, 9209, 1579,
+    -9983, 8937, 6394, -9793, 4922, 6833, -12277, 5528, 7840, -11080, 1638, 8575,
+    -10345, 2373, 9310, -9610, -1980, 9582, -9338, -1708, 9854, -9066, -1436, 10126,
+    -8794, -1164, 10398, -8522, -892, 10670, -12454, 2934, 11328, -11565, 3823, 6621,
+    -11184, 5003, 7105, -10095, 6092, 3990, -13210, 7602, -792, -8422, 12390, -1600,
+    -9230, 11582, -8004, -5461, 10726, -8194, -564, 10998, -12126, 3262, 6060, -11745,
+    9067, 673, -12045, 13392, -3536, -6613, 12973, -9920, -688, 7706, -10099, 6088,
+    3986, -9391, 9719, -2999, -5311, 13609, -9284, -52, 8342, -9463, 11349, -2641,
+    -10271, 10541, -9045, -1415, 10147, -12977, 8566, 172, -7458, 13354, -11829, -1673,
+    7559, -12027, 10866, -4522, -7320, 10485, -10327, 3663, 1120, -10442, 12682, -8861,
+    -467, 7163, -13649, 11534, -5394, -2317, 11673, -11220, 10323, -3667, -6210, 9977,
+    -13147, 8396, 2, -7628, 13184, -11999, 4929, 1852, -6542, 11263, -9549, 4441,
+    1898, -9664, 13460, -14240, 4381, 996, -8236, 11350, -11543, 10000, -3990, -6533,
+    9654, -13470, 8073, -5917, 1713, 4025, -10690, 10332, -9254, 3464, 1152, -5154,
+    12046, -13391, 10308, -5080, -2282, 5348, -10839, 12285, -9258, 4732, -2898, -5210,
+    9505, -11517, 13666, -10033, 5355, -3039, -5582, 10605, -12519, 9024, -10562, 7243,
+    306, -1796, 7759, -11351, 11542, -10001, 9585, -3133, -821, 5485, -7892, 11218,
+    -11675, 9868, -9718, 8087, -3475, -1373, 8182, -10928, 11965, -9578, 10008, -7797,
+    3765, -2541, -630, 4581, -9633, 11389, -13794, 9905, -11638, 7948, -4770, 2167,
+    65, -1846, 6840, -10532, 10280, -9306, 13587, -14113, 11956, -4972, 4260, -4134,
+    -1591, 721, -5585, 7792, -7844, 11076, -11817, 9726, -9860, 13033, -8510, 11076,
+    -6729, 4833, -1473, 438, 2175, -2562, 4616, -7131, 7083, -10117, 10695, -8891,
+    14002, -13698, 12371, -11328, 10215, -9371, 8434, -7753, 6962, -6415, 5745, -5309,
+    4740, -1786, 1773, -1462, -482, 409, -2022, 3134, -2893, 4401, -4424, 6255,
+    -6667, 5493, -5561, 7361, -8275, 6440, -6937, 8699, -10221, 7584, -8603, 10317,
+    -7488, 8699, -10221, 7584, -8603, 6112, -7265, 8371, -6344, 7033, -5127, 5927,
+    -6995, 5165, -5889, 4160, -2366, 3566, -1827, 1114, -5126, 7031, 1820, -2917,
+    -7223, 7134, -6243, 2443, 13497, -2296, -12807, -10896, -2210, 18321, 4331, -13474,
+    16588, -3890, -15062, -11677, -2445, 5949, -11856, -4919, 18205, -3338, 5056, -12749,
+    -10437, -8335, -14068, 5042, -7676, -739, 9772, -18894, -6608, -10332, -176, -9408,
+    15775, 12390, -21465, 15397, 11302, -7319, -3934, -13166, 12017, 1861, -13527, 463,
+    8093, -3469, 7042, 20419, 1309, 3852, -3085, 3221, -13979, 20708, -7961, -4237,
+    -14393, 995, 14985, 17528, -17159, 11510, -14559, 9140, -12403, -15201, -17744, 3068,
+    -5326, -2783, -471, -10982, -20537, -18800, -1428, -3740, -1638, 19384, 16586, -6307,
+    2925, 127, 17932, -12130, 8348, -17721, -14336, 7207, -17976, 12495, 209, -10963,
+    12736, 9659, -15524, 1404, -7828, 11758, -6047, -17609, -2894, 10483, -15576, 17942,
+    22037, 10865, 7480, 22868, 20070, -18085, -13990, -2818, -6203, 9185, 17579, -15489,
+    4989, 8713, 18869, 3481, -4913, -7456, -9768, -20279, 743, 9137, -18843, -15119,
+    8580, 5503, -2891, 9827, -10985, 19794, -8875, -5151, 5005, -16538, -8144, 4574,
+    -2363, -4465, -10198, 1962, 13016, 20194, 616, 20202, -2691, 6541, -7449, 15444,
+    12367, 9569, 12112, 9800, -21733, 6936, -4236, 12692, -8851, -457, 2086, -18726,
+    6457, 3072, -6160, -3362, 19531, -8169, -4445, -14601, -17678, 7505, -9423, -191,
+    -8585, -6042, 5520, 16031, -4991, -2193, -14911, 5901, -8089, 9716, 2779, -11936,
+    -17669, 8390, -17679, -751, -9983, 9603, -13290, 8253, 16647, -1158, 5779, -8936,
+    4441, 9652, -14037, -3881, -6958, 7032, -5686, 10501, 4195, 6106, -19953, -16229,
+    -19614, 8086, 11810, 15195, -193, 19393, -3500, 5732, -8258, -10801, 5386, -5125,
+    15897, -14882, 13787, 17511, -6188, -9265, -17659, -20202, 610, 14600, -8293, -11370,
+    -2976, -5519, 19918, -3781, -6858, -20848, -18305, -2118, -8424, -10335, 8775, -19205,
+    -15481, 1447, 4524, 18514, 15971, -18716, 1762, -1962, -5347, 10041, 7243, -10562,
+    19500, 7214, 10938, -5990, 15553, -9630, -19786, -10554, 14629, -22613, -10327, -21499,
+    2200, -877, 7517, -10288, 19774, 15679, 11955, 1799, 11031, 2637, 20442, 13505,
+    2994, 8727, 10464, 18360, 16925, -2653, -5451, -7994, -10306, 21227, 749, 19370,
+    2442, -635, 7759, 129, -16058, 2862, 319, -20493, 21478, -23575, 5094, -6078,
+    -9463, -6386, -20376, 12692, -7786, -18958, -15573, -6341, -9139, 18841, 15117, 4961,
+    1884, -6510, -9053, -20615, 10918, -17751, 15767, -12902, -9178, 7750, -19950, 6119,
+    -4037, -960, -3758, -6301, -13238, -2727, -8460, 14125, 11048, 8250, -9555, 20507,
+    8221, 4497, 21425, -12430, 8048, 4324, -5832, 9556, -10030, -17660, -19972, 11561,
+    7466, 3742, 357, 15745, 12947, 229, -6708, -17219, 11447, -17222, 1399, 18327,
+    -15528, 4950, 16122, -14349, -10254, -13978, -17363, 4180, 1382, -11336, 14101, -9598,
+    -366, -14356, -6726, -13663, -11561, -5828, 16757, 1369, 4167, 6710, 4398, 2296,
+    385, -1352, 227, -1208, 97, -1089, -11, 969, 78, -732, 4, -665,
+    -57, 496, -7, 450, 35, -343, 0, 312, 28, -230, 4, -209,
+    -15, 161, 1, -144, -12, 108, -1, 98, 8, -74, 0, 68,
+    7, -49, 2, -44, -2, 36, 2, -29, -1, 25, 2, -19,
+    0, 17, 1, -13, 0, 12, 1, -9, 0, 8, 1, -5,
+    1, -4, 1, -3, 1, -2, 1, -2, 0, 2, 0, 2,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+} // namespace AdpcmVectors
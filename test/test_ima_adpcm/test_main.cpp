@@ -0,0 +1,135 @@
+/**
+ * @brief Az ImaAdpcm dekóder host tesztje (pio test -e native)
+ *
+ * Az adpcm_vectors.h-t az encode_voice.py --test-vectors készíti: egy rögzített szintetikus klip kódolt bájtjai és a
+ * Python dekóder mintái. Az eszköz dekódere bitre azonos kell legyen velük, különben a kódoló rossz kódszavakat választ.
+ */
+#include <string.h>
+#include <unity.h>
+
+#include "ImaAdpcm.h"
+#include "adpcm_vectors.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+/**
+ * @brief A fájl fejléce a VoiceClipHeader szerint
+ */
+void test_clip_header() {
+    VoiceClipHeader header;
+    memcpy(&header, AdpcmVectors::CLIP, sizeof(header));
+    TEST_ASSERT_EQUAL_MEMORY("VPA1", header.magic, 4);
+    TEST_ASSERT_EQUAL_UINT16(8000, header.sampleRate);
+    TEST_ASSERT_EQUAL_UINT32(AdpcmVectors::SAMPLE_COUNT, header.sampleCount);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(header) + AdpcmVectors::SAMPLE_COUNT / 2, AdpcmVectors::CLIP_SIZE);
+}
+
+/**
+ * @brief Minden minta bitre egyezik a Python dekóderével
+ */
+void test_decode_matches_python() {
+    static int16_t decoded[AdpcmVectors::SAMPLE_COUNT];
+    ImaAdpcm::State state;
+    ImaAdpcm::decode(state, AdpcmVectors::CLIP + sizeof(VoiceClipHeader), AdpcmVectors::SAMPLE_COUNT / 2, decoded);
+
+    for (uint32_t i = 0; i < AdpcmVectors::SAMPLE_COUNT; i++) {
+        char message[32];
+        snprintf(message, sizeof(message), "minta %u", (unsigned)i);
+        TEST_ASSERT_EQUAL_INT16_MESSAGE(AdpcmVectors::EXPECTED[i], decoded[i], message);
+    }
+}
+
+/**
+ * @brief A darabokban (a VoicePrompt pufferei szerint) dekódolt klip ugyanaz, mint az egyben dekódolt
+ */
+void test_decode_in_chunks() {
+    static int16_t decoded[AdpcmVectors::SAMPLE_COUNT];
+    ImaAdpcm::State state;
+    const uint8_t *src = AdpcmVectors::CLIP + sizeof(VoiceClipHeader);
+    uint32_t bytes = AdpcmVectors::SAMPLE_COUNT / 2;
+    for (uint32_t pos = 0; pos < bytes; pos += 32) {
+        uint32_t chunk = bytes - pos < 32 ? bytes - pos : 32;
+        ImaAdpcm::decode(state, src + pos, chunk, decoded + pos * 2);
+    }
+    TEST_ASSERT_EQUAL_INT16_ARRAY(AdpcmVectors::EXPECTED, decoded, AdpcmVectors::SAMPLE_COUNT);
+}
+
+/**
+ * @brief A tesztklip eléri a korlátokat: a prediktor mindkét szélső értékét, az index 88-at és a végén újra 0-t
+ */
+void test_clip_reaches_limits() {
+    ImaAdpcm::State state;
+    const uint8_t *src = AdpcmVectors::CLIP + sizeof(VoiceClipHeader);
+    bool maxPredictor = false, minPredictor = false, maxIndex = false;
+    for (uint32_t i = 0; i < AdpcmVectors::SAMPLE_COUNT; i++) {
+        uint8_t nibble = i & 1 ? src[i / 2] >> 4 : src[i / 2] & 0x0F;
+        int16_t sample = ImaAdpcm::decodeNibble(state, nibble);
+        maxPredictor |= sample == 32767;
+        minPredictor |= sample == -32768;
+        maxIndex |= state.index == 88;
+    }
+    TEST_ASSERT_TRUE(maxPredictor);
+    TEST_ASSERT_TRUE(minPredictor);
+    TEST_ASSERT_TRUE(maxIndex);
+    TEST_ASSERT_EQUAL_UINT8(0, state.index);
+}
+
+/**
+ * @brief A prediktor felső korlátja: a legnagyobb lépés a 32767 fölé vinné
+ */
+void test_predictor_clamps_high() {
+    ImaAdpcm::State state;
+    state.predictor = 30000;
+    state.index = 88;
+    TEST_ASSERT_EQUAL_INT16(32767, ImaAdpcm::decodeNibble(state, 0x7));
+    TEST_ASSERT_EQUAL_INT16(32767, state.predictor);
+
+    // A legkisebb pozitív lépés is korlátozódik a szélen
+    TEST_ASSERT_EQUAL_INT16(32767, ImaAdpcm::decodeNibble(state, 0x0));
+}
+
+/**
+ * @brief A prediktor alsó korlátja
+ */
+void test_predictor_clamps_low() {
+    ImaAdpcm::State state;
+    state.predictor = -30000;
+    state.index = 88;
+    TEST_ASSERT_EQUAL_INT16(-32768, ImaAdpcm::decodeNibble(state, 0xF));
+    TEST_ASSERT_EQUAL_INT16(-32768, ImaAdpcm::decodeNibble(state, 0x8));
+}
+
+/**
+ * @brief Az index telítődése: 88 fölé és 0 alá nem megy
+ */
+void test_index_saturates() {
+    ImaAdpcm::State state;
+    ImaAdpcm::decodeNibble(state, 0x0);
+    TEST_ASSERT_EQUAL_UINT8(0, state.index);
+
+    // +8 lépésenként: 11 kódszó után 88, onnan nem nő tovább
+    for (int i = 0; i < 12; i++) {
+        ImaAdpcm::decodeNibble(state, i & 1 ? 0xF : 0x7);
+    }
+    TEST_ASSERT_EQUAL_UINT8(88, state.index);
+
+    // -1 lépésenként vissza 0-ig, ott megáll
+    for (int i = 0; i < 100; i++) {
+        ImaAdpcm::decodeNibble(state, i & 1 ? 0x8 : 0x0);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, state.index);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clip_header);
+    RUN_TEST(test_decode_matches_python);
+    RUN_TEST(test_decode_in_chunks);
+    RUN_TEST(test_clip_reaches_limits);
+    RUN_TEST(test_predictor_clamps_high);
+    RUN_TEST(test_predictor_clamps_low);
+    RUN_TEST(test_index_saturates);
+    return UNITY_END();
+}
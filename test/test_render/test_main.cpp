@@ -0,0 +1,49 @@
+/**
+ * @brief A képernyők renderelésének regressziós tesztje (pio test -e native_render)
+ *
+ * A native/render forgatókönyvét futtatja a repóban tárolt referencia képekkel (golden/) és SPI bájt kerettel
+ * (budgets.txt): bármelyik lépés képe pixelre eltér, vagy a legdrágább képkockája túllépi a keretet, a teszt elbukik.
+ * Az eltérő lépések képe és diff képe a .pio/render_out könyvtárba kerül.
+ *
+ * Szándékos változás után a referencia frissítése (a diff képek átnézése után):
+ *   .pio/build/native_render/program -q -g test/test_render/golden -b test/test_render/budgets.txt -u
+ */
+#include <string>
+#include <unity.h>
+
+#include "NativeRender.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+/**
+ * @brief A teszt könyvtára (a referencia fájlok helye)
+ */
+static std::string testDir() {
+    std::string file = __FILE__;
+    size_t slash = file.find_last_of('/');
+    return slash == std::string::npos ? "." : file.substr(0, slash);
+}
+
+/**
+ * @brief Minden lépés képe egyezik a referenciával, és belefér a keretbe
+ */
+void test_render_matches_golden_and_budgets() {
+    std::string goldenDir = testDir() + "/golden";
+    std::string budgetFile = testDir() + "/budgets.txt";
+
+    NativeRender::RunOptions options;
+    options.quiet = true;
+    options.outDir = ".pio/render_out";
+    options.goldenDir = goldenDir.c_str();
+    options.budgetFile = budgetFile.c_str();
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, NativeRender::run(options), "eltérő kép vagy túllépett keret, ld. a lépések táblázatát");
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_render_matches_golden_and_budgets);
+    return UNITY_END();
+}